@@ -0,0 +1,329 @@
+// Monitor-on-game interference benchmark.
+//
+// A synthetic CPU-bound "game" runs one thread per logical CPU, each
+// producing fixed-cost frames. Next to it runs the monitor's load: a 1 kHz
+// sampler tick pushing every tick through a FramePipeline, a 60 Hz render
+// pass, a 60 Hz scheduler task that appends to a file through an IoExecutor
+// about once a second, and a background worker chewing through bulk work.
+// Three runs:
+//
+//   baseline - the game alone
+//   default  - monitor threads unpinned at normal priority
+//   pinned   - every monitor thread pinned to THREAD_AFFINITY_AUTO (E-cores,
+//              or the last CPU) at the config.ini default priorities:
+//              sampler, render, pipeline stages, scheduler, I/O and workers
+//
+// Reported: game throughput and its loss against the baseline, frame time
+// p99/max, and what the monitor still got done (sampler lateness, render
+// passes, bulk chunks). The pinned run checks on each of those threads that
+// the affinity and priority actually took effect and exits with status 1 if
+// not.
+//
+// Usage: bench_affinity_interference [seconds] [gameThreads] [frameUs]
+//   seconds     - run time per configuration (default 3)
+//   gameThreads - game threads (default: logical CPUs)
+//   frameUs     - CPU cost of one game frame (default 2000)
+
+#include "frame_pipeline.h"
+#include "frame_types.h"
+#include "io_executor.h"
+#include "io_task.h"
+#include "precise_timer.h"
+#include "scheduler.h"
+#include "thread_affinity.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct MonitorSettings {
+    bool enabled = false;
+    uint64_t affinityMask = THREAD_AFFINITY_NONE;
+    ThreadPriority samplerPriority = ThreadPriority::NORMAL;
+    ThreadPriority renderPriority = ThreadPriority::NORMAL;
+    ThreadPriority workerPriority = ThreadPriority::NORMAL;
+    ThreadPriority backgroundPriority = ThreadPriority::NORMAL;  // Pipeline, scheduler, I/O
+};
+
+struct RunResult {
+    uint64_t gameFrames = 0;
+    JitterStats frameTime;  // Worst game thread
+    JitterStats samplerLateness;
+    uint64_t renderPasses = 0;
+    uint64_t bulkChunks = 0;
+    bool settingsApplied = true;
+};
+
+std::atomic<uint64_t> g_sink(0);
+
+// Integer busy work; `iterations` is calibrated to a wall-clock cost
+void Spin(uint64_t iterations) {
+    uint64_t x = 0x9E3779B97F4A7C15ull;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+    }
+    g_sink.fetch_add(x, std::memory_order_relaxed);
+}
+
+uint64_t CalibrateIterationsPerUs() {
+    uint64_t iterations = 1 << 20;
+    while (true) {
+        uint64_t start = MonotonicNowNs();
+        Spin(iterations);
+        uint64_t elapsed = MonotonicNowNs() - start;
+        if (elapsed > 50000000) return std::max<uint64_t>(1, iterations * 1000 / elapsed);
+        iterations *= 2;
+    }
+}
+
+// Whether the calling thread runs with these settings
+bool Verify(uint64_t mask, ThreadPriority priority) {
+    uint64_t resolved = ThreadAffinity::ResolveMask(mask);
+    if (resolved != THREAD_AFFINITY_NONE && ThreadAffinity::GetCurrentAffinity() != resolved) return false;
+    return ThreadAffinity::GetCurrentPriority() == priority;
+}
+
+// Applies the settings and confirms they stuck
+bool ApplyAndVerify(uint64_t mask, ThreadPriority priority) {
+    return ThreadAffinity::ApplyToCurrentThread(mask, priority) && Verify(mask, priority);
+}
+
+// Settings seen on threads the monitor doesn't start itself (pipeline sink,
+// scheduler, I/O completion), checked from inside their callbacks
+struct ThreadChecks {
+    uint64_t mask = THREAD_AFFINITY_NONE;
+    ThreadPriority priority = ThreadPriority::NORMAL;
+    std::atomic<uint32_t> sink{0};
+    std::atomic<uint32_t> scheduler{0};
+    std::atomic<uint32_t> io{0};
+    std::atomic<uint32_t> failed{0};
+
+    void Check(std::atomic<uint32_t>& count) {
+        if (!Verify(mask, priority)) failed.fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+class CheckSink : public IFrameSink {
+public:
+    explicit CheckSink(ThreadChecks* checks) : m_checks(checks) {}
+    void Consume(const FrameStats&) override {
+        if (m_checks->sink.load(std::memory_order_relaxed) == 0) m_checks->Check(m_checks->sink);
+    }
+
+private:
+    ThreadChecks* m_checks;
+};
+
+// Capture-sized append; the check runs where the coroutine resumes
+Task<void> AppendChunk(IoExecutor* io, std::filesystem::path path, ThreadChecks* checks) {
+    co_await io->WriteFile(path, std::vector<char>(4096, 'f'), IoWriteMode::APPEND);
+    checks->Check(checks->io);
+}
+
+void Run(const MonitorSettings& monitor, double seconds, size_t gameThreads, uint64_t frameIterations,
+         uint64_t iterationsPerUs, RunResult& result) {
+    std::atomic<bool> stop(false);
+    std::atomic<bool> applied(true);
+
+    std::vector<std::thread> game;
+    std::vector<uint64_t> frames(gameThreads, 0);
+    std::vector<std::unique_ptr<JitterMeter>> frameTimes;  // JitterMeter is single-writer
+    for (size_t i = 0; i < gameThreads; ++i) {
+        frameTimes.push_back(std::make_unique<JitterMeter>());
+    }
+    for (size_t i = 0; i < gameThreads; ++i) {
+        game.emplace_back([&, i]() {
+            while (!stop.load(std::memory_order_relaxed)) {
+                uint64_t start = MonotonicNowNs();
+                Spin(frameIterations);
+                frameTimes[i]->Record(MonotonicNowNs() - start);
+                frames[i]++;
+            }
+        });
+    }
+
+    std::vector<std::thread> threads;
+    std::unique_ptr<WorkStealingPool> pool;
+    std::atomic<uint64_t> bulkChunks(0);
+    std::function<void()> bulkChunk;
+    ThreadChecks checks;
+    checks.mask = monitor.affinityMask;
+    checks.priority = monitor.backgroundPriority;
+    std::unique_ptr<FramePipeline> pipeline;
+    CheckSink sink(&checks);
+    std::unique_ptr<Scheduler> scheduler;
+    std::unique_ptr<IoExecutor> io;
+    std::filesystem::path ioPath = std::filesystem::temp_directory_path() / "bench_affinity_io.bin";
+    if (monitor.enabled) {
+        // Pipeline stages: every sampler tick is a present
+        PipelineConfig pipelineConfig;
+        pipelineConfig.rejectFrameTime = 0.0f;
+        pipelineConfig.threadAffinityMask = monitor.affinityMask;
+        pipelineConfig.threadPriority = monitor.backgroundPriority;
+        pipeline = std::make_unique<FramePipeline>(pipelineConfig);
+        pipeline->AddSink(&sink);
+        pipeline->Start();
+
+        // Scheduler: 60 Hz stats task, a file append about once a second
+        io = std::make_unique<IoExecutor>();
+        io->SetThreadSettings(monitor.affinityMask, monitor.backgroundPriority);
+        scheduler = std::make_unique<Scheduler>();
+        scheduler->SetThreadSettings(monitor.affinityMask, monitor.backgroundPriority);
+        scheduler->AddPeriodic("stats", 16, 0, [&, runs = uint64_t(0)]() mutable {
+            if (runs == 0) checks.Check(checks.scheduler);
+            Spin(200 * iterationsPerUs);
+            if (runs++ % 60 == 0) Spawn(AppendChunk(io.get(), ioPath, &checks));
+        });
+        scheduler->Start();
+
+        // Sampler: 1 kHz tick with a little work per tick
+        threads.emplace_back([&]() {
+            if (monitor.affinityMask != THREAD_AFFINITY_NONE || monitor.samplerPriority != ThreadPriority::NORMAL) {
+                if (!ApplyAndVerify(monitor.affinityMask, monitor.samplerPriority)) applied = false;
+            }
+            FramePacer pacer(1000000, PacingMode::COARSE, 0);
+            pacer.Reset();
+            while (!stop.load(std::memory_order_relaxed)) {
+                Spin(20 * iterationsPerUs);
+                pipeline->PushPresent(MonotonicNowNs());
+                pacer.Wait();
+            }
+            result.samplerLateness = pacer.GetJitter();
+        });
+
+        // Render: 60 Hz, 2 ms per pass
+        threads.emplace_back([&]() {
+            if (monitor.affinityMask != THREAD_AFFINITY_NONE || monitor.renderPriority != ThreadPriority::NORMAL) {
+                if (!ApplyAndVerify(monitor.affinityMask, monitor.renderPriority)) applied = false;
+            }
+            FramePacer pacer(16666667, PacingMode::COARSE, 0);
+            pacer.Reset();
+            while (!stop.load(std::memory_order_relaxed)) {
+                Spin(2000 * iterationsPerUs);
+                result.renderPasses++;
+                pacer.Wait();
+            }
+        });
+
+        // Background: one worker kept busy with 500 us chunks. Each chunk
+        // queues the next from the worker itself, so no other thread helps
+        pool = std::make_unique<WorkStealingPool>(1, monitor.affinityMask, monitor.workerPriority);
+        bulkChunk = [&]() {
+            Spin(500 * iterationsPerUs);
+            bulkChunks.fetch_add(1, std::memory_order_relaxed);
+            if (!stop.load(std::memory_order_relaxed)) pool->Submit(bulkChunk);
+        };
+        pool->Submit(bulkChunk);
+    }
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop = true;
+    for (auto& thread : game) thread.join();
+    for (auto& thread : threads) thread.join();
+    pool.reset();
+    if (monitor.enabled) {
+        scheduler->Stop();
+        io->Drain();
+        pipeline->Stop();
+        std::error_code ignored;
+        std::filesystem::remove(ioPath, ignored);
+
+        // Each background thread has to have been seen with its settings
+        bool checked = monitor.affinityMask == THREAD_AFFINITY_NONE &&
+                       monitor.backgroundPriority == ThreadPriority::NORMAL;
+        if (!checked) {
+            checked = checks.sink > 0 && checks.scheduler > 0 && checks.io > 0 && checks.failed == 0 &&
+                      pipeline->GetMetrics().threadSettingFailures == 0;
+        }
+        if (!checked) applied = false;
+    }
+
+    for (size_t i = 0; i < gameThreads; ++i) {
+        result.gameFrames += frames[i];
+        JitterStats stats = frameTimes[i]->GetStats();
+        result.frameTime.p99Us = std::max(result.frameTime.p99Us, stats.p99Us);
+        result.frameTime.maxUs = std::max(result.frameTime.maxUs, stats.maxUs);
+    }
+    result.bulkChunks = bulkChunks.load();
+    result.settingsApplied = applied.load();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? std::atof(argv[1]) : 3.0;
+    const CpuTopology& topology = ThreadAffinity::GetTopology();
+    size_t gameThreads = argc > 2 ? static_cast<size_t>(std::atoi(argv[2])) : topology.logicalCpus;
+    uint64_t frameUs = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 2000;
+    if (seconds <= 0.0) seconds = 3.0;
+    if (gameThreads == 0) gameThreads = topology.logicalCpus;
+    if (frameUs == 0) frameUs = 2000;
+
+    std::printf("cpus: %u, mask %llx, E-cores %llx%s, auto -> %llx\n", topology.logicalCpus,
+                static_cast<unsigned long long>(topology.allMask),
+                static_cast<unsigned long long>(topology.efficiencyMask), topology.hybrid ? " (hybrid)" : "",
+                static_cast<unsigned long long>(ThreadAffinity::AutoMask(topology)));
+
+    uint64_t iterationsPerUs = CalibrateIterationsPerUs();
+    std::printf("game: %zu threads, %llu us frames, %.1f s per run\n\n", gameThreads,
+                static_cast<unsigned long long>(frameUs), seconds);
+
+    MonitorSettings baseline;
+    MonitorSettings unpinned;
+    unpinned.enabled = true;
+    MonitorSettings pinned;
+    pinned.enabled = true;
+    pinned.affinityMask = THREAD_AFFINITY_AUTO;
+    pinned.samplerPriority = ThreadPriority::NORMAL;
+    pinned.renderPriority = ThreadPriority::BELOW_NORMAL;
+    pinned.workerPriority = ThreadPriority::LOWEST;
+    pinned.backgroundPriority = ThreadPriority::BELOW_NORMAL;
+
+    const struct {
+        const char* name;
+        const MonitorSettings* settings;
+    } runs[] = {
+        {"baseline", &baseline},
+        {"default", &unpinned},
+        {"pinned", &pinned},
+    };
+
+    std::printf("%-9s %10s %7s %10s %10s %12s %8s %8s\n", "run", "frames/s", "loss", "p99 ms", "max ms",
+                "sampler p99", "renders", "bulk");
+    bool ok = true;
+    double baselineRate = 0.0;
+    for (const auto& run : runs) {
+        RunResult result;
+        Run(*run.settings, seconds, gameThreads, frameUs * iterationsPerUs, iterationsPerUs, result);
+
+        double rate = result.gameFrames / seconds;
+        if (!run.settings->enabled) baselineRate = rate;
+        double loss = baselineRate > 0.0 ? (1.0 - rate / baselineRate) * 100.0 : 0.0;
+        const JitterStats& frameTime = result.frameTime;
+
+        if (run.settings->enabled) {
+            std::printf("%-9s %10.1f %6.1f%% %10.2f %10.2f %9.0f us %8llu %8llu%s\n", run.name, rate, loss,
+                        frameTime.p99Us / 1000.0, frameTime.maxUs / 1000.0, result.samplerLateness.p99Us,
+                        static_cast<unsigned long long>(result.renderPasses),
+                        static_cast<unsigned long long>(result.bulkChunks),
+                        result.settingsApplied ? "" : "  SETTINGS NOT APPLIED");
+        } else {
+            std::printf("%-9s %10.1f %7s %10.2f %10.2f %12s %8s %8s\n", run.name, rate, "-",
+                        frameTime.p99Us / 1000.0, frameTime.maxUs / 1000.0, "-", "-", "-");
+        }
+        ok &= result.settingsApplied;
+    }
+    return ok ? 0 : 1;
+}
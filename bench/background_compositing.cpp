@@ -0,0 +1,248 @@
+// Background compositing benchmark: the cost of the overlay's translucent
+// rounded panel, drawn with per-pixel alpha into the backbuffer instead of
+// through the window's constant alpha or a second layered window.
+//
+// Per overlay size (the one-line text at 12 to 32 pixels, the graph, the
+// multi-line overlay with both widgets) and per compositor kernel the CPU
+// supports (scalar, SSE2, AVX2), times what OverlayPainter does for a full
+// repaint:
+//
+//   opaque - one fill in the background colour, the old constant-alpha path
+//   panel  - clear to transparent, then a translucent rounded panel
+//   full   - the panel with "FPS: xxx.x" composited over it
+//
+// Before timing, every kernel draws a set of scenes with clipped, odd-sized
+// rectangles and rounded panels (radius 0 to past the limit) blended over
+// translucent gradients; exits with status 1 if any kernel's pixels differ
+// from the scalar kernel's, if any pixel breaks the premultiplied invariant
+// (no channel above alpha), or if a panel's inside isn't exactly its colour
+// or its corners aren't cut.
+//
+// Usage: bench_background_compositing [updates]
+//   updates - repaints per size, kernel and mode (default 20000)
+
+#include "compositor.h"
+#include "glyph_atlas.h"
+#include "text_format.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+const CompositorKernel KERNELS[] = {
+    CompositorKernel::SCALAR,
+    CompositorKernel::SSE2,
+    CompositorKernel::AVX2,
+};
+
+struct OverlaySize {
+    const char* name;
+    int width;
+    int height;
+    int fontSize;
+};
+
+const OverlaySize SIZES[] = {
+    {"text-12",      80,  19, 12},
+    {"text-16",     140,  28, 16},
+    {"text-32",     440,  73, 32},
+    {"graph",       180,  72, 16},
+    {"everything",  220, 187, 20},
+};
+
+const uint32_t PANEL = 0x80000000u;       // Straight; the default background
+const uint32_t TEXT_COLOR = 0xFF00FF00u;
+const int RADIUS = 6;
+
+uint64_t Hash(const std::vector<uint32_t>& pixels) {
+    uint64_t hash = 1469598103934665603ull;  // FNV-1a
+    for (uint32_t pixel : pixels) {
+        hash = (hash ^ pixel) * 1099511628211ull;
+    }
+    return hash;
+}
+
+// Pixels with a channel above alpha
+int InvalidPixels(const std::vector<uint32_t>& pixels) {
+    int invalid = 0;
+    for (uint32_t pixel : pixels) {
+        uint32_t alpha = pixel >> 24;
+        if (((pixel >> 16) & 0xFFu) > alpha || ((pixel >> 8) & 0xFFu) > alpha || (pixel & 0xFFu) > alpha) {
+            ++invalid;
+        }
+    }
+    return invalid;
+}
+
+PixelBuffer BufferFor(std::vector<uint32_t>& pixels, int width, int height) {
+    pixels.assign(static_cast<size_t>(width) * height, 0);
+    PixelBuffer buffer;
+    buffer.pixels = pixels.data();
+    buffer.width = width;
+    buffer.height = height;
+    buffer.stride = width;
+    return buffer;
+}
+
+// Scenes that exercise clipping, unaligned row lengths, every radius and
+// translucent destinations; returns a hash of all of them and counts the
+// pixels that break the premultiplied invariant
+uint64_t DrawScenes(int& invalid) {
+    const int width = 97;
+    const int height = 61;
+    std::vector<uint32_t> pixels;
+    PixelBuffer buffer = BufferFor(pixels, width, height);
+
+    uint64_t hash = 0;
+    invalid = 0;
+    for (int scene = 0; scene < 96; ++scene) {
+        for (int y = 0; y < height; ++y) {
+            uint32_t shade = static_cast<uint32_t>((y * 255) / height);
+            uint32_t alpha = static_cast<uint32_t>((scene * 37 + y * 3) % 256);
+            Compositor::Fill(buffer, 0, y, width, 1,
+                             Compositor::Premultiply((alpha << 24) | (shade << 16) | 0x7030u));
+        }
+
+        uint32_t alpha = static_cast<uint32_t>((scene * 53) % 256);
+        uint32_t color = Compositor::Premultiply((alpha << 24) | (static_cast<uint32_t>(scene) * 0x0A1B2Cu & 0xFFFFFFu));
+        int x = scene % 11 - 5;
+        int y = scene % 7 - 3;
+        int w = 3 + (scene * 13) % (width + 8);
+        int h = 1 + (scene * 7) % (height + 4);
+        if (scene % 2 == 0) {
+            Compositor::BlendRect(buffer, x, y, w, h, color);
+        } else {
+            Compositor::FillRoundedRect(buffer, x, y, w, h, scene % (ROUNDED_RECT_MAX_RADIUS + 8), color);
+        }
+        invalid += InvalidPixels(pixels);
+        hash = hash * 31 + Hash(pixels);
+    }
+    return hash;
+}
+
+// A panel over transparent: exactly its colour inside, less in the corners
+bool PanelShapeOk() {
+    std::vector<uint32_t> pixels;
+    PixelBuffer buffer = BufferFor(pixels, 64, 32);
+    uint32_t color = Compositor::Premultiply(PANEL);
+    Compositor::FillRoundedRect(buffer, 0, 0, 64, 32, RADIUS, color);
+    uint32_t corners[4] = {pixels[0], pixels[63], pixels[31 * 64], pixels[31 * 64 + 63]};
+    for (uint32_t corner : corners) {
+        if ((corner >> 24) >= (color >> 24)) return false;
+    }
+    for (int y = RADIUS; y < 32 - RADIUS; ++y) {
+        for (int x = 0; x < 64; ++x) {
+            if (pixels[static_cast<size_t>(y) * 64 + x] != color) return false;
+        }
+    }
+    return pixels[RADIUS] == color && pixels[31 * 64 + 64 - RADIUS - 1] == color;
+}
+
+enum class Mode { OPAQUE, PANEL_ONLY, FULL };
+
+struct ModeResult {
+    double us = 0.0;
+    uint64_t checksum = 0;
+};
+
+// A full repaint of one overlay, `updates` times
+ModeResult RunMode(const OverlaySize& size, const GlyphAtlas& atlas, Mode mode, int updates) {
+    std::vector<uint32_t> pixels;
+    PixelBuffer buffer = BufferFor(pixels, size.width, size.height);
+    uint32_t panel = Compositor::Premultiply(PANEL);
+    wchar_t text[32];
+
+    ModeResult result;
+    auto start = std::chrono::steady_clock::now();
+    for (int update = 0; update < updates; ++update) {
+        if (mode == Mode::OPAQUE) {
+            Compositor::Fill(buffer, 0, 0, size.width, size.height, 0xFF000000u);
+        } else {
+            Compositor::Fill(buffer, 0, 0, size.width, size.height, 0);
+            Compositor::FillRoundedRect(buffer, 0, 0, size.width, size.height, RADIUS, panel);
+        }
+        if (mode != Mode::PANEL_ONLY) {
+            float fps = static_cast<float>((update * 7919) % 20000) / 10.0f + 1.0f;
+            int length = TextFormat::Format<"FPS: {:.1f}">(text, 32, fps);
+            Compositor::DrawString(buffer, atlas, 10, 5, text, length, TEXT_COLOR);
+        }
+        result.checksum += pixels[static_cast<size_t>(update % size.height) * size.width + update % size.width];
+    }
+    auto end = std::chrono::steady_clock::now();
+    result.us = std::chrono::duration<double, std::micro>(end - start).count() / updates;
+    return result;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int updates = argc > 1 ? std::atoi(argv[1]) : 20000;
+    if (updates <= 0) updates = 20000;
+
+    std::printf("Background compositing: %d repaints per size, kernel and mode, default kernel %s\n\n", updates,
+                Compositor::KernelName(Compositor::GetKernel()));
+
+    CompositorKernel defaultKernel = Compositor::GetKernel();
+    bool ok = true;
+    if (!PanelShapeOk()) {
+        std::printf("FAIL: a panel's inside isn't its colour or its corners aren't cut\n");
+        ok = false;
+    }
+
+    uint64_t reference = 0;
+    std::printf("%-8s %10s %10s\n", "kernel", "scenes", "invalid px");
+    for (CompositorKernel kernel : KERNELS) {
+        if (!Compositor::IsKernelSupported(kernel)) {
+            std::printf("%-8s %10s %10s\n", Compositor::KernelName(kernel), "n/a", "-");
+            continue;
+        }
+        Compositor::SetKernel(kernel);
+        int invalid = 0;
+        uint64_t scenes = DrawScenes(invalid);
+        bool matches = true;
+        if (kernel == CompositorKernel::SCALAR) {
+            reference = scenes;
+        } else {
+            matches = scenes == reference;
+        }
+        std::printf("%-8s %10s %10d\n", Compositor::KernelName(kernel), matches ? "match" : "DIFFER", invalid);
+        if (!matches) {
+            std::printf("FAIL: %s output differs from scalar\n", Compositor::KernelName(kernel));
+            ok = false;
+        }
+        if (invalid > 0) {
+            std::printf("FAIL: %s left %d pixels with a channel above alpha\n", Compositor::KernelName(kernel),
+                        invalid);
+            ok = false;
+        }
+    }
+
+    std::printf("\n%-11s %8s %-8s %10s %10s %10s\n", "size", "", "kernel", "opaque us", "panel us", "full us");
+    for (const OverlaySize& size : SIZES) {
+        GlyphAtlas atlas;
+        BitmapFontRasterizer rasterizer(size.fontSize);
+        atlas.Build(rasterizer);
+        uint64_t referenceChecksum = 0;
+        for (CompositorKernel kernel : KERNELS) {
+            if (!Compositor::IsKernelSupported(kernel)) continue;
+            Compositor::SetKernel(kernel);
+            ModeResult opaque = RunMode(size, atlas, Mode::OPAQUE, updates);
+            ModeResult panel = RunMode(size, atlas, Mode::PANEL_ONLY, updates);
+            ModeResult full = RunMode(size, atlas, Mode::FULL, updates);
+            std::printf("%-11s %4dx%-3d %-8s %10.3f %10.3f %10.3f\n", size.name, size.width, size.height,
+                        Compositor::KernelName(kernel), opaque.us, panel.us, full.us);
+            uint64_t checksum = opaque.checksum + panel.checksum * 3 + full.checksum * 7;
+            if (kernel == CompositorKernel::SCALAR) {
+                referenceChecksum = checksum;
+            } else if (checksum != referenceChecksum) {
+                std::printf("FAIL: %s %s repaint differs from scalar\n", size.name, Compositor::KernelName(kernel));
+                ok = false;
+            }
+        }
+    }
+    Compositor::SetKernel(defaultKernel);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,233 @@
+/*
+ * fps_core C API benchmark and self-check.
+ *
+ * Written in C against fps_core_c.h only, the way an embedder would use the
+ * library. Pusher threads feed synthetic 240 fps presents (one source each)
+ * in small groups while reader threads poll fps_core_read_stats() and
+ * fps_core_read_percentiles() as fast as they can; every frame is recorded to
+ * a capture file that is read back once the core has stopped.
+ *
+ * Reported: read latency (mean and worst per call), reads per second, the
+ * final counters and stats. Exits with status 1 if any of these fail:
+ *   - frameCount or sequence went backwards for a reader
+ *   - the measured FPS or p50 frame time is off by more than 2%
+ *   - the capture file doesn't hold exactly the frames of every source (all
+ *     accepted presents but each source's first), or the stats don't follow
+ *     one of the sources
+ *
+ * Usage: bench_core_c_api [pushers] [readers] [framesPerPusher] [capturePath]
+ *   defaults: 2 pushers, 2 readers, 50000 frames, core_c_api.fpsc
+ */
+
+#define _POSIX_C_SOURCE 200809L  /* nanosleep */
+
+#include "fps_core_c.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define TARGET_FPS   240.0
+#define PUSH_GROUP   16
+#define MAX_THREADS  8
+
+typedef struct Pusher {
+    FpsCore* core;
+    uint32_t sourceId;
+    uint64_t frames;
+    uint64_t accepted;
+} Pusher;
+
+typedef struct Reader {
+    FpsCore* core;
+    volatile int* done;
+    uint64_t reads;
+    uint64_t totalNs;
+    uint64_t worstNs;
+    uint64_t errors;
+} Reader;
+
+static void SleepUs(long us) {
+    struct timespec ts;
+    ts.tv_sec = us / 1000000;
+    ts.tv_nsec = (us % 1000000) * 1000;
+    nanosleep(&ts, NULL);
+}
+
+static void* PushLoop(void* arg) {
+    Pusher* pusher = (Pusher*)arg;
+    uint64_t frameNs = (uint64_t)(1e9 / TARGET_FPS);
+    uint64_t base = fps_core_now_ns();
+    uint64_t timestamps[PUSH_GROUP];
+    uint64_t i = 0;
+
+    /* Game time runs faster than wall time; only the deltas matter */
+    while (i < pusher->frames) {
+        uint32_t count = 0;
+        while (count < PUSH_GROUP && i < pusher->frames) {
+            timestamps[count++] = base + (++i) * frameNs;
+        }
+        pusher->accepted += fps_core_push_presents(pusher->core, pusher->sourceId, timestamps, count);
+        SleepUs(500);
+    }
+    return NULL;
+}
+
+static void* ReadLoop(void* arg) {
+    Reader* reader = (Reader*)arg;
+    uint64_t lastCount = 0;
+    uint64_t lastSequence = 0;
+    uint64_t lastPercentileSequence = 0;
+
+    while (!*reader->done) {
+        FpsStats stats;
+        FpsPercentiles percentiles;
+        uint64_t start;
+        uint64_t elapsed;
+
+        stats.size = sizeof(stats);
+        percentiles.size = sizeof(percentiles);
+
+        start = fps_core_now_ns();
+        fps_core_read_stats(reader->core, &stats);
+        fps_core_read_percentiles(reader->core, &percentiles);
+        elapsed = fps_core_now_ns() - start;
+
+        reader->reads++;
+        reader->totalNs += elapsed;
+        if (elapsed > reader->worstNs) reader->worstNs = elapsed;
+
+        if (stats.frameCount < lastCount || stats.sequence < lastSequence ||
+            percentiles.sequence < lastPercentileSequence) {
+            reader->errors++;
+        }
+        lastCount = stats.frameCount;
+        lastSequence = stats.sequence;
+        lastPercentileSequence = percentiles.sequence;
+    }
+    return NULL;
+}
+
+static int Check(int ok, const char* what) {
+    printf("  %-44s %s\n", what, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    int pushers = argc > 1 ? atoi(argv[1]) : 2;
+    int readers = argc > 2 ? atoi(argv[2]) : 2;
+    uint64_t framesPerPusher = argc > 3 ? strtoull(argv[3], NULL, 10) : 50000;
+    const char* capturePath = argc > 4 ? argv[4] : "core_c_api.fpsc";
+
+    FpsCoreConfig config;
+    FpsCore* core;
+    Pusher pusherState[MAX_THREADS];
+    Reader readerState[MAX_THREADS];
+    pthread_t pusherThreads[MAX_THREADS];
+    pthread_t readerThreads[MAX_THREADS];
+    volatile int done = 0;
+    FpsStats stats;
+    FpsPercentiles percentiles;
+    FpsCoreCounters counters;
+    FpsFrame* frames;
+    int64_t captured;
+    uint64_t reads = 0, readNs = 0, worstNs = 0, readErrors = 0, accepted = 0, statsSourceFrames = 0;
+    uint64_t start, elapsedNs;
+    double expectedMs = 1000.0 / TARGET_FPS;
+    int ok = 1;
+    int i;
+
+    if (pushers < 1 || pushers > MAX_THREADS) pushers = 2;
+    if (readers < 0 || readers > MAX_THREADS) readers = 2;
+    if (framesPerPusher == 0) framesPerPusher = 50000;
+
+    config.size = sizeof(config);
+    fps_core_default_config(&config);
+    config.queueCapacity = 4096;
+    config.capturePath = capturePath;
+
+    core = fps_core_create(&config);
+    if (!core || fps_core_start(core) != FPS_PLUGIN_OK) {
+        printf("FAIL: could not start the core\n");
+        return 1;
+    }
+
+    start = fps_core_now_ns();
+    for (i = 0; i < readers; ++i) {
+        readerState[i].core = core;
+        readerState[i].done = &done;
+        readerState[i].reads = readerState[i].totalNs = readerState[i].worstNs = readerState[i].errors = 0;
+        pthread_create(&readerThreads[i], NULL, ReadLoop, &readerState[i]);
+    }
+    for (i = 0; i < pushers; ++i) {
+        pusherState[i].core = core;
+        pusherState[i].sourceId = (uint32_t)i;  /* One source each; MAX_THREADS = 8 sources */
+        pusherState[i].frames = framesPerPusher;
+        pusherState[i].accepted = 0;
+        pthread_create(&pusherThreads[i], NULL, PushLoop, &pusherState[i]);
+    }
+
+    for (i = 0; i < pushers; ++i) {
+        pthread_join(pusherThreads[i], NULL);
+        accepted += pusherState[i].accepted;
+    }
+    fps_core_stop(core);
+    done = 1;
+    for (i = 0; i < readers; ++i) {
+        pthread_join(readerThreads[i], NULL);
+        reads += readerState[i].reads;
+        readNs += readerState[i].totalNs;
+        if (readerState[i].worstNs > worstNs) worstNs = readerState[i].worstNs;
+        readErrors += readerState[i].errors;
+    }
+    elapsedNs = fps_core_now_ns() - start;
+
+    stats.size = sizeof(stats);
+    percentiles.size = sizeof(percentiles);
+    counters.size = sizeof(counters);
+    fps_core_read_stats(core, &stats);
+    fps_core_read_percentiles(core, &percentiles);
+    fps_core_read_counters(core, &counters);
+    fps_core_destroy(core);
+
+    printf("\n%d pushers x %llu frames, %d readers, %.2f s\n", pushers, (unsigned long long)framesPerPusher,
+           readers, elapsedNs / 1e9);
+    if (reads > 0) {
+        printf("  reads: %llu (%.0f/s), stats+percentiles %.0f ns mean, %.1f us worst\n",
+               (unsigned long long)reads, reads / (elapsedNs / 1e9), (double)readNs / reads, worstNs / 1000.0);
+    }
+    printf("  presents: %llu accepted, %llu dropped, %llu rejected\n",
+           (unsigned long long)counters.presentsAccepted, (unsigned long long)counters.presentsDropped,
+           (unsigned long long)counters.framesRejected);
+    printf("  stats: %.1f fps, %llu frames, p50 %.3f ms, p99 %.3f ms\n", stats.fps,
+           (unsigned long long)stats.frameCount, percentiles.p50Ms, percentiles.p99Ms);
+
+    captured = fps_core_read_capture(capturePath, NULL, 0);
+    frames = (FpsFrame*)malloc(sizeof(FpsFrame) * (size_t)(captured > 0 ? captured : 1));
+    if (captured > 0) captured = fps_core_read_capture(capturePath, frames, (uint64_t)captured);
+    for (i = 0; i < captured; ++i) {
+        if (frames[i].sourceId == stats.sourceId) ++statsSourceFrames;
+    }
+    printf("  capture: %lld frames in %s, %llu from source %u the stats follow\n\n", (long long)captured,
+           capturePath, (unsigned long long)statsSourceFrames, stats.sourceId);
+
+    ok &= Check(readErrors == 0, "frameCount and sequence never went back");
+    ok &= Check(counters.presentsAccepted == accepted, "accepted presents match the pushers");
+    ok &= Check(fabs(stats.fps - TARGET_FPS) < TARGET_FPS * 0.02, "fps within 2% of the source rate");
+    ok &= Check(fabs(percentiles.p50Ms - expectedMs) < expectedMs * 0.02, "p50 within 2% of the source frame time");
+    ok &= Check(captured >= 0 && (uint64_t)captured == accepted - (uint64_t)pushers - counters.framesRejected,
+                "capture holds every source's frames");
+    ok &= Check(stats.sourceId < (uint32_t)pushers && statsSourceFrames > 0, "stats follow one of the sources");
+    ok &= Check(captured >= 0 && stats.frameCount <= (uint64_t)captured, "stats count no frame twice");
+    ok &= Check(counters.captureFailedWrites == 0, "no failed capture writes");
+    if (captured > 0) {
+        ok &= Check(fabs(frames[0].frameTime * 1000.0 - expectedMs) < expectedMs * 0.02,
+                    "captured frame times match the source");
+    }
+    free(frames);
+
+    remove(capturePath);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,250 @@
+// Damage tracking benchmark: how much overlay work a frame-capped session
+// leaves once unchanged updates are skipped and changed ones only repaint
+// the glyphs that differ.
+//
+// Replays three sessions of FPS readings, formatted to one decimal like the
+// overlay: capped at 60 and at 144 (the reading mostly repeats, now and
+// then it wobbles by 0.1) and uncapped (a new reading every update). Each
+// update sizes the backbuffer to the text and draws it with the compositor
+// from a bitmap-font GlyphAtlas, as Renderer::RenderOverlay does. Two ways:
+//
+//   full    - fill and draw everything, update the window every time (the
+//             renderer before damage tracking)
+//   tracked - DamageTracker; repaint the dirty rectangles only, no window
+//             update when nothing changed
+//
+// Reported per session: share of updates skipped, partial and full,
+// repainted pixels, window updates and time per update. Every tracked
+// frame is compared with a full redraw first; exits with status 1 if any
+// pixel differs, or if a capped session skips fewer than half its updates.
+//
+// Usage: bench_damage_tracking [updates] [fontSize]
+//   updates  - updates per session (default 100000)
+//   fontSize - text height in pixels (default 24)
+
+#include "compositor.h"
+#include "damage_tracker.h"
+#include "glyph_atlas.h"
+#include "text_format.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+const uint32_t BACKGROUND = 0xFF000000u;
+const uint32_t TEXT_COLOR = 0xFF00FF00u;
+const int MAX_WIDTH = 1024;  // Backbuffer stride; only grows in the renderer
+
+enum class Session {
+    CAPPED_60,
+    CAPPED_144,
+    UNCAPPED
+};
+
+const char* SessionName(Session session) {
+    switch (session) {
+        case Session::CAPPED_60: return "capped 60";
+        case Session::CAPPED_144: return "capped 144";
+        case Session::UNCAPPED: return "uncapped";
+    }
+    return "?";
+}
+
+uint32_t Noise(int update) {
+    uint32_t x = static_cast<uint32_t>(update) * 2654435761u;
+    x ^= x >> 15;
+    x *= 0x2C1B3C6Du;
+    x ^= x >> 12;
+    return x;
+}
+
+float FpsFor(Session session, int update) {
+    uint32_t noise = Noise(update);
+    float wobble = noise % 8 == 0 ? 0.1f : (noise % 8 == 1 ? -0.1f : 0.0f);
+    switch (session) {
+        case Session::CAPPED_60: return 60.0f + wobble;
+        case Session::CAPPED_144: return 144.0f + wobble;
+        case Session::UNCAPPED: return 60.0f + static_cast<float>(noise % 1200) / 10.0f;
+    }
+    return 0.0f;
+}
+
+struct Overlay {
+    std::vector<uint32_t> pixels;
+    PixelBuffer buffer;
+    DamageTracker damage;
+    wchar_t text[32];
+    int length = 0;
+    int width = 0;
+    int height = 0;
+
+    explicit Overlay(int lineHeight)
+        : pixels(static_cast<size_t>(MAX_WIDTH) * (lineHeight + 10))
+    {
+        buffer.pixels = pixels.data();
+        buffer.stride = MAX_WIDTH;
+    }
+
+    void Format(const GlyphAtlas& atlas, float fps) {
+        length = TextFormat::Format<"FPS: {:.1f}">(text, 32, fps);
+        width = atlas.MeasureText(text, length) + 20;
+        height = atlas.LineHeight() + 10;
+        buffer.width = width;
+        buffer.height = height;
+    }
+
+    // Returns pixels repainted; `windowUpdates` counts what would reach
+    // UpdateLayeredWindow
+    uint64_t DrawFull(const GlyphAtlas& atlas, uint64_t& windowUpdates) {
+        Compositor::Fill(buffer, 0, 0, width, height, BACKGROUND);
+        Compositor::DrawString(buffer, atlas, 0, 0, text, length, TEXT_COLOR);
+        ++windowUpdates;
+        return static_cast<uint64_t>(width) * height;
+    }
+
+    uint64_t DrawTracked(const GlyphAtlas& atlas, uint64_t& windowUpdates) {
+        DamageRect bounds;
+        bounds.width = width;
+        bounds.height = height;
+        damage.BeginFrame(width, height);
+        damage.UpdateText(0, atlas, text, length, 0, bounds, 0);
+        if (damage.EndFrame() == DamageKind::NONE) return 0;
+
+        uint64_t repainted = 0;
+        for (const DamageRect& dirty : damage.DirtyRects()) {
+            PixelBuffer clip = buffer;
+            clip.pixels += static_cast<size_t>(dirty.y) * buffer.stride + dirty.x;
+            clip.width = dirty.width;
+            clip.height = dirty.height;
+            Compositor::Fill(clip, 0, 0, dirty.width, dirty.height, BACKGROUND);
+            Compositor::DrawString(clip, atlas, -dirty.x, -dirty.y, text, length, TEXT_COLOR);
+            repainted += static_cast<uint64_t>(dirty.Area());
+        }
+        ++windowUpdates;
+        return repainted;
+    }
+
+    bool SameAs(const Overlay& other) const {
+        if (width != other.width || height != other.height) return false;
+        for (int y = 0; y < height; ++y) {
+            const uint32_t* a = pixels.data() + static_cast<size_t>(y) * MAX_WIDTH;
+            const uint32_t* b = other.pixels.data() + static_cast<size_t>(y) * MAX_WIDTH;
+            if (std::memcmp(a, b, static_cast<size_t>(width) * sizeof(uint32_t)) != 0) return false;
+        }
+        return true;
+    }
+};
+
+struct SessionResult {
+    double usFull = 0.0;
+    double usTracked = 0.0;
+    uint64_t pixelsFull = 0;
+    uint64_t pixelsTracked = 0;
+    uint64_t windowUpdatesFull = 0;
+    uint64_t windowUpdatesTracked = 0;
+    DamageStats stats;
+    int mismatchAt = -1;
+};
+
+SessionResult RunSession(const GlyphAtlas& atlas, Session session, int updates) {
+    SessionResult result;
+
+    // Untimed: every tracked frame against a full redraw
+    {
+        Overlay full(atlas.LineHeight());
+        Overlay tracked(atlas.LineHeight());
+        uint64_t ignored = 0;
+        for (int update = 0; update < updates && result.mismatchAt < 0; ++update) {
+            float fps = FpsFor(session, update);
+            full.Format(atlas, fps);
+            tracked.Format(atlas, fps);
+            full.DrawFull(atlas, ignored);
+            tracked.DrawTracked(atlas, ignored);
+            if (!tracked.SameAs(full)) {
+                result.mismatchAt = update;
+            }
+        }
+    }
+
+    Overlay full(atlas.LineHeight());
+    auto start = std::chrono::steady_clock::now();
+    for (int update = 0; update < updates; ++update) {
+        full.Format(atlas, FpsFor(session, update));
+        result.pixelsFull += full.DrawFull(atlas, result.windowUpdatesFull);
+    }
+    auto end = std::chrono::steady_clock::now();
+    result.usFull = std::chrono::duration<double, std::micro>(end - start).count() / updates;
+
+    Overlay tracked(atlas.LineHeight());
+    start = std::chrono::steady_clock::now();
+    for (int update = 0; update < updates; ++update) {
+        tracked.Format(atlas, FpsFor(session, update));
+        result.pixelsTracked += tracked.DrawTracked(atlas, result.windowUpdatesTracked);
+    }
+    end = std::chrono::steady_clock::now();
+    result.usTracked = std::chrono::duration<double, std::micro>(end - start).count() / updates;
+    result.stats = tracked.damage.GetStats();
+    return result;
+}
+
+double Percent(uint64_t part, uint64_t whole) {
+    return whole ? 100.0 * static_cast<double>(part) / static_cast<double>(whole) : 0.0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int updates = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int fontSize = argc > 2 ? std::atoi(argv[2]) : 24;
+    if (updates <= 0) updates = 100000;
+    if (fontSize <= 0) fontSize = 24;
+
+    GlyphAtlas atlas;
+    BitmapFontRasterizer rasterizer(fontSize);
+    if (!atlas.Build(rasterizer)) {
+        std::printf("FAIL: glyph atlas build failed\n");
+        return 1;
+    }
+
+    std::printf("Damage tracking: %d updates per session, %dpx font, %s compositor\n\n",
+                updates, fontSize, Compositor::KernelName(Compositor::GetKernel()));
+    std::printf("%-11s %8s %8s %8s %10s %12s %11s %11s\n", "session", "skipped", "partial", "full",
+                "repainted", "win updates", "full us", "tracked us");
+
+    bool ok = true;
+    const Session sessions[] = {Session::CAPPED_60, Session::CAPPED_144, Session::UNCAPPED};
+    for (Session session : sessions) {
+        SessionResult result = RunSession(atlas, session, updates);
+        const DamageStats& stats = result.stats;
+        std::printf("%-11s %7.1f%% %7.1f%% %7.1f%% %9.1f%% %5llu/%-6llu %11.3f %11.3f\n",
+                    SessionName(session),
+                    Percent(stats.skipped, stats.frames), Percent(stats.partial, stats.frames),
+                    Percent(stats.full, stats.frames), Percent(result.pixelsTracked, result.pixelsFull),
+                    static_cast<unsigned long long>(result.windowUpdatesTracked),
+                    static_cast<unsigned long long>(result.windowUpdatesFull),
+                    result.usFull, result.usTracked);
+
+        if (result.mismatchAt >= 0) {
+            std::printf("FAIL: %s: tracked frame %d differs from a full redraw\n", SessionName(session),
+                        result.mismatchAt);
+            ok = false;
+        }
+        if (session != Session::UNCAPPED && stats.skipped * 2 < stats.frames) {
+            std::printf("FAIL: %s: only %llu of %llu updates skipped\n", SessionName(session),
+                        static_cast<unsigned long long>(stats.skipped),
+                        static_cast<unsigned long long>(stats.frames));
+            ok = false;
+        }
+        if (stats.dirtyPixels != result.pixelsTracked) {
+            std::printf("FAIL: %s: tracker counted %llu dirty pixels, %llu repainted\n", SessionName(session),
+                        static_cast<unsigned long long>(stats.dirtyPixels),
+                        static_cast<unsigned long long>(result.pixelsTracked));
+            ok = false;
+        }
+    }
+    return ok ? 0 : 1;
+}
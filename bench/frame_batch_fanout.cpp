@@ -0,0 +1,238 @@
+// Frame batch fan-out benchmark.
+//
+// Publishes batches of FRAME_BATCH_CAPACITY frames to 1..8 sink threads two
+// ways: copying the frame data into every sink's queue (the naive approach),
+// and handing each sink a FrameBatchRef to one pooled batch.
+//
+// The producer thread counts what it actually writes, at the copy sites:
+// frame data (filling a batch, copying one into a queue) and handoffs (the
+// queue items themselves when they aren't frame data). Reported per sink
+// count and mode: batches/s, frame and handoff bytes per batch, and the
+// producer's measured write rate.
+//
+// Exits with status 1 if shared fan-out writes more than one batch of frame
+// data per publish, or a sink reads different data than was published.
+//
+// Usage: bench_frame_batch_fanout [batches]
+
+#include "frame_batch.h"
+#include "lockfree_queue.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Bytes written on the producer thread since the run started; the sinks'
+// pops happen on their own threads and don't count
+thread_local uint64_t t_frameBytes = 0;
+thread_local uint64_t t_handoffBytes = 0;
+
+NormalizedFrame MakeFrame(uint64_t base, size_t i) {
+    NormalizedFrame frame;
+    frame.timestampNs = base + i * 16666667ull;
+    frame.frameTime = 0.016f + static_cast<float>(i % 7) * 0.0001f;
+    frame.sourceId = FRAME_SOURCE_HOOK;
+    return frame;
+}
+
+// Copy mode's queue item: the frames themselves
+struct CopiedBatch {
+    size_t count = 0;
+    NormalizedFrame frames[FRAME_BATCH_CAPACITY];
+
+    CopiedBatch() = default;
+    CopiedBatch(const CopiedBatch& other) { *this = other; }
+    CopiedBatch& operator=(const CopiedBatch& other) {
+        count = other.count;
+        std::memcpy(frames, other.frames, count * sizeof(NormalizedFrame));
+        t_frameBytes += sizeof(count) + count * sizeof(NormalizedFrame);
+        return *this;
+    }
+
+    void Fill(uint64_t base) {
+        count = FRAME_BATCH_CAPACITY;
+        for (size_t i = 0; i < count; ++i) frames[i] = MakeFrame(base, i);
+        t_frameBytes += count * sizeof(NormalizedFrame);
+    }
+};
+
+// Shared mode's queue item: a reference to the pooled batch
+struct SharedItem {
+    FrameBatchRef batch;
+
+    SharedItem() = default;
+    explicit SharedItem(FrameBatchRef ref) : batch(std::move(ref)) {}
+    SharedItem(const SharedItem& other) : batch(other.batch) { t_handoffBytes += sizeof(SharedItem); }
+    SharedItem(SharedItem&&) noexcept = default;
+    SharedItem& operator=(const SharedItem& other) {
+        batch = other.batch;
+        t_handoffBytes += sizeof(SharedItem);
+        return *this;
+    }
+    SharedItem& operator=(SharedItem&&) noexcept = default;
+};
+
+struct Result {
+    double seconds = 0.0;
+    double frameBytesPerBatch = 0.0;
+    double handoffBytesPerBatch = 0.0;
+    double checksum = 0.0;
+};
+
+template <typename Item, typename Reader>
+Result RunSinks(size_t sinkCount, size_t batches,
+                const std::function<bool(size_t, StageQueue<Item, SpscQueue>&, std::atomic<bool>&)>& produce,
+                Reader read) {
+    std::atomic<bool> running(true);
+    std::vector<std::unique_ptr<StageQueue<Item, SpscQueue>>> queues;
+    for (size_t i = 0; i < sinkCount; ++i) {
+        queues.push_back(std::make_unique<StageQueue<Item, SpscQueue>>(64, BackpressurePolicy::BLOCK));
+    }
+
+    std::vector<double> sums(sinkCount, 0.0);
+    std::vector<std::thread> threads;
+    std::atomic<size_t> finished(0);
+    for (size_t i = 0; i < sinkCount; ++i) {
+        threads.emplace_back([&, i]() {
+            Item item;
+            size_t received = 0;
+            while (received < batches) {
+                if (queues[i]->TryPop(item)) {
+                    sums[i] += read(item);
+                    received++;
+                } else {
+                    queues[i]->WaitForItems(std::chrono::microseconds(200));
+                }
+            }
+            finished.fetch_add(1);
+        });
+    }
+
+    t_frameBytes = 0;
+    t_handoffBytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t b = 0; b < batches; ++b) {
+        for (size_t i = 0; i < sinkCount; ++i) {
+            produce(b, *queues[i], running);
+        }
+    }
+    for (auto& thread : threads) thread.join();
+    auto end = std::chrono::steady_clock::now();
+
+    Result result;
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    result.frameBytesPerBatch = static_cast<double>(t_frameBytes) / batches;
+    result.handoffBytesPerBatch = static_cast<double>(t_handoffBytes) / batches;
+    for (double sum : sums) result.checksum += sum;
+    return result;
+}
+
+double ReadFrames(const NormalizedFrame* frames, size_t count) {
+    double sum = 0.0;
+    for (size_t i = 0; i < count; ++i) sum += frames[i].frameTime;
+    return sum;
+}
+
+// What the sinks should have summed, accumulated in the same order RunSinks
+// does so the comparison can be exact
+double ExpectedChecksum(size_t sinks, size_t batches) {
+    double perSink = 0.0;
+    for (size_t b = 0; b < batches; ++b) {
+        NormalizedFrame frames[FRAME_BATCH_CAPACITY];
+        for (size_t i = 0; i < FRAME_BATCH_CAPACITY; ++i) frames[i] = MakeFrame(b * 1000, i);
+        perSink += ReadFrames(frames, FRAME_BATCH_CAPACITY);
+    }
+    double sum = 0.0;
+    for (size_t i = 0; i < sinks; ++i) sum += perSink;
+    return sum;
+}
+
+void Report(size_t sinks, const char* mode, size_t batches, const Result& r) {
+    double bytes = r.frameBytesPerBatch + r.handoffBytesPerBatch;
+    std::printf("%6zu  %-7s %14.0f %12.0f %12.0f %16.1f\n", sinks, mode, batches / r.seconds,
+                r.frameBytesPerBatch, r.handoffBytesPerBatch, bytes * batches / r.seconds / (1024.0 * 1024.0));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t batches = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 20000;
+    if (batches == 0) batches = 20000;
+    const double batchBytes = sizeof(NormalizedFrame) * FRAME_BATCH_CAPACITY;
+
+    std::printf("frame batch fan-out: %zu batches of %d frames (%.0f bytes each)\n\n",
+                batches, FRAME_BATCH_CAPACITY, batchBytes);
+    std::printf("%6s  %-7s %14s %12s %12s %16s\n", "sinks", "mode", "batches/s", "frame B/bat",
+                "handoff B/bat", "producer MB/s");
+
+    bool ok = true;
+    for (size_t sinks : {1, 2, 4, 8}) {
+        double expected = ExpectedChecksum(sinks, batches);
+
+        // Copy mode: every sink gets its own copy of the frame data
+        {
+            CopiedBatch scratch;
+            size_t currentIndex = static_cast<size_t>(-1);
+            std::function<bool(size_t, StageQueue<CopiedBatch, SpscQueue>&, std::atomic<bool>&)> produce =
+                [&](size_t b, StageQueue<CopiedBatch, SpscQueue>& queue, std::atomic<bool>& running) {
+                    if (b != currentIndex) {
+                        scratch.Fill(b * 1000);
+                        currentIndex = b;
+                    }
+                    return queue.Push(scratch, running);
+                };
+            Result r = RunSinks<CopiedBatch>(sinks, batches, produce,
+                [](const CopiedBatch& item) { return ReadFrames(item.frames, item.count); });
+            Report(sinks, "copy", batches, r);
+            if (r.checksum != expected) {
+                std::printf("FAIL: copy x%zu: the sinks read different frames than were published\n", sinks);
+                ok = false;
+            }
+        }
+
+        // Shared mode: one pooled batch, N references
+        {
+            FrameBatchPool pool(256);
+            FrameBatchWriter writer(pool);
+            SharedItem current;
+            size_t currentIndex = static_cast<size_t>(-1);
+            std::function<bool(size_t, StageQueue<SharedItem, SpscQueue>&, std::atomic<bool>&)> produce =
+                [&](size_t b, StageQueue<SharedItem, SpscQueue>& queue, std::atomic<bool>& running) {
+                    if (b != currentIndex) {
+                        for (size_t i = 0; i < FRAME_BATCH_CAPACITY; ++i) {
+                            while (!writer.Append(MakeFrame(b * 1000, i))) {
+                                std::this_thread::yield();  // Pool exhausted; sinks still hold batches
+                            }
+                            t_frameBytes += sizeof(NormalizedFrame);
+                        }
+                        current = SharedItem(writer.Publish());
+                        currentIndex = b;
+                    }
+                    return queue.Push(current, running);
+                };
+            Result r = RunSinks<SharedItem>(sinks, batches, produce,
+                [](const SharedItem& item) { return ReadFrames(item.batch->Frames(), item.batch->Count()); });
+            current = SharedItem();
+            Report(sinks, "shared", batches, r);
+            if (r.frameBytesPerBatch > batchBytes) {
+                std::printf("FAIL: shared x%zu: %.0f bytes of frame data written per publish, one batch is %.0f\n",
+                            sinks, r.frameBytesPerBatch, batchBytes);
+                ok = false;
+            }
+            if (r.checksum != expected) {
+                std::printf("FAIL: shared x%zu: the sinks read different frames than were published\n", sinks);
+                ok = false;
+            }
+        }
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,214 @@
+// Frame-time graph benchmark: what one overlay update of the scrolling
+// graph costs as its history (the graph's width in columns) grows.
+//
+// Per update the game has presented a few frames (two by default: 120 FPS
+// against a 60 Hz overlay); they are added to a FrameTimeGraph, which is
+// brought up to date and drawn into a backbuffer, the way
+// Renderer::RenderOverlay does. Two ways:
+//
+//   incremental - Update() plots only the columns that are new
+//   replot      - Invalidate() first, so every column is plotted again
+//                 (a graph that re-plots every point per update)
+//
+// Reported per width: columns plotted and time per update for both, and the
+// time of the Draw() that copies the scrolled image into the backbuffer.
+// Before timing, an incremental graph is checked against a replotted one
+// through odd sizes, wrap-around, clipping, more new frames than columns, a
+// resize and a restyle; exits with status 1 if any pixel differs, or if
+// incremental updates plot anything but the new columns.
+//
+// Usage: bench_frame_time_graph [updates] [framesPerUpdate]
+//   updates         - updates per width and mode (default 20000)
+//   framesPerUpdate - frames added per update (default 2)
+
+#include "frame_time_graph.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+const int WIDTHS[] = {128, 512, 2048, 8192};
+const int GRAPH_HEIGHT = 64;
+
+uint32_t Noise(uint64_t frame) {
+    uint32_t x = static_cast<uint32_t>(frame) * 2654435761u;
+    x ^= x >> 15;
+    x *= 0x2C1B3C6Du;
+    x ^= x >> 12;
+    return x;
+}
+
+// ~8.3 ms with jitter, a hitch every few hundred frames
+float FrameTimeFor(uint64_t frame) {
+    uint32_t noise = Noise(frame);
+    if (noise % 397 == 0) return 40.0f + static_cast<float>(noise % 60);
+    return 8.3f + static_cast<float>(noise % 200) / 100.0f - 1.0f;
+}
+
+struct Target {
+    std::vector<uint32_t> pixels;
+    PixelBuffer buffer;
+
+    Target(int width, int height)
+        : pixels(static_cast<size_t>(width) * height, 0xDEADBEEFu)
+    {
+        buffer.pixels = pixels.data();
+        buffer.width = width;
+        buffer.height = height;
+        buffer.stride = width;
+    }
+};
+
+// Incremental against replotted through the awkward cases; returns the step
+// that first differs, or -1
+int CheckAgainstReplot() {
+    FrameTimeGraph incremental;
+    FrameTimeGraph replot;
+    FrameTimeGraphStyle style;
+    style.background = 0xFF102030u;
+    style.line = 0xFFE0C020u;
+    style.scaleMs = 33.0f;
+    style.framesPerColumn = 3;
+
+    Target a(400, 60);
+    Target b(400, 60);
+    uint64_t frame = 0;
+    for (int step = 0; step < 3000; ++step) {
+        if (step == 0 || step == 1200) {
+            int width = step == 0 ? 317 : 129;
+            int height = step == 0 ? 41 : 57;
+            incremental.Resize(width, height);
+            replot.Resize(width, height);
+        }
+        if (step == 2000) {
+            style.scaleMs = 100.0f;
+            style.guideMs = 33.3f;
+            style.framesPerColumn = 1;
+        }
+        incremental.SetStyle(style);
+        replot.SetStyle(style);
+
+        // Mostly a few frames, now and then none or more than fit
+        uint32_t noise = Noise(static_cast<uint64_t>(step) + 7777);
+        int frames = noise % 50 == 0 ? 1100 : static_cast<int>(noise % 9);
+        for (int i = 0; i < frames; ++i, ++frame) {
+            incremental.AddFrameTime(FrameTimeFor(frame));
+            replot.AddFrameTime(FrameTimeFor(frame));
+        }
+        incremental.Update();
+        replot.Invalidate();
+        replot.Update();
+
+        // Partly off the target now and then
+        int x = step % 11 == 0 ? -37 : (step % 13 == 0 ? 300 : 5);
+        int y = step % 7 == 0 ? -9 : 3;
+        incremental.Draw(a.buffer, x, y);
+        replot.Draw(b.buffer, x, y);
+        if (a.pixels != b.pixels) return step;
+    }
+    return -1;
+}
+
+struct ModeResult {
+    double usPerUpdate = 0.0;
+    double columnsPerUpdate = 0.0;
+    uint64_t checksum = 0;
+};
+
+ModeResult RunMode(int width, int updates, int framesPerUpdate, bool replot) {
+    FrameTimeGraph graph;
+    graph.Resize(width, GRAPH_HEIGHT);
+    uint64_t frame = 0;
+    for (int i = 0; i < width * 2; ++i, ++frame) {  // Full history before timing
+        graph.AddFrameTime(FrameTimeFor(frame));
+    }
+    graph.Update();
+
+    FrameTimeGraphStats before = graph.GetStats();
+    auto start = std::chrono::steady_clock::now();
+    for (int update = 0; update < updates; ++update) {
+        for (int i = 0; i < framesPerUpdate; ++i, ++frame) {
+            graph.AddFrameTime(FrameTimeFor(frame));
+        }
+        if (replot) graph.Invalidate();
+        graph.Update();
+    }
+    auto end = std::chrono::steady_clock::now();
+    FrameTimeGraphStats after = graph.GetStats();
+
+    ModeResult result;
+    result.usPerUpdate = std::chrono::duration<double, std::micro>(end - start).count() / updates;
+    result.columnsPerUpdate = static_cast<double>(after.plottedColumns - before.plottedColumns) / updates;
+    return result;
+}
+
+// Draw() after each single-column update, so the ring's seam keeps moving
+ModeResult DrawTime(int width, int updates) {
+    FrameTimeGraph graph;
+    graph.Resize(width, GRAPH_HEIGHT);
+    for (int i = 0; i < width; ++i) {
+        graph.AddFrameTime(FrameTimeFor(static_cast<uint64_t>(i)));
+    }
+    graph.Update();
+
+    Target target(width + 20, GRAPH_HEIGHT + 40);
+    ModeResult result;
+    auto start = std::chrono::steady_clock::now();
+    for (int update = 0; update < updates; ++update) {
+        graph.AddFrameTime(FrameTimeFor(static_cast<uint64_t>(update)));
+        graph.Update();
+        graph.Draw(target.buffer, 0, 30);
+        result.checksum += target.pixels[static_cast<size_t>(update % GRAPH_HEIGHT + 30) * (width + 20) + update % width];
+    }
+    auto end = std::chrono::steady_clock::now();
+    result.usPerUpdate = std::chrono::duration<double, std::micro>(end - start).count() / updates;
+    return result;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int updates = argc > 1 ? std::atoi(argv[1]) : 20000;
+    int framesPerUpdate = argc > 2 ? std::atoi(argv[2]) : 2;
+    if (updates <= 0) updates = 20000;
+    if (framesPerUpdate <= 0) framesPerUpdate = 2;
+
+    std::printf("Frame-time graph: %d updates per width and mode, %d frames per update, %dpx high\n\n",
+                updates, framesPerUpdate, GRAPH_HEIGHT);
+
+    bool ok = true;
+    int mismatch = CheckAgainstReplot();
+    if (mismatch >= 0) {
+        std::printf("FAIL: incremental graph differs from a full replot at step %d\n", mismatch);
+        ok = false;
+    }
+
+    std::printf("%-7s %13s %13s %13s %13s %10s\n", "width", "incr cols", "incr us", "replot cols",
+                "replot us", "draw us");
+    for (int width : WIDTHS) {
+        // Replotting the widest graphs is slow; fewer updates keep the run short
+        int replotUpdates = std::max(updates / (width / 128), 100);
+        ModeResult incremental = RunMode(width, updates, framesPerUpdate, false);
+        ModeResult replot = RunMode(width, replotUpdates, framesPerUpdate, true);
+        ModeResult draw = DrawTime(width, updates);
+
+        std::printf("%-7d %13.1f %13.3f %13.1f %13.3f %10.3f\n", width, incremental.columnsPerUpdate,
+                    incremental.usPerUpdate, replot.columnsPerUpdate, replot.usPerUpdate, draw.usPerUpdate);
+
+        if (incremental.columnsPerUpdate != static_cast<double>(framesPerUpdate)) {
+            std::printf("FAIL: width %d: incremental updates plotted %.2f columns, %d were new\n", width,
+                        incremental.columnsPerUpdate, framesPerUpdate);
+            ok = false;
+        }
+        if (draw.checksum == 0) {
+            std::printf("FAIL: width %d: nothing was drawn into the backbuffer\n", width);
+            ok = false;
+        }
+    }
+    return ok ? 0 : 1;
+}
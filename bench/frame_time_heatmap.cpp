@@ -0,0 +1,302 @@
+// Frame-time heatmap benchmark: the per-frame and per-update cost of the
+// rolling heatmap at high frame rates, and a console rendering of what it
+// shows.
+//
+// Frames are binned as they arrive; every `sliceMs` of frames completes a
+// column. Per overlay update (60 Hz) the new columns are plotted and the
+// image drawn into a backbuffer, the way Renderer::RenderOverlay does. Two
+// ways to bring the image up to date:
+//
+//   incremental - Update() plots only the new columns (a palette lookup
+//                 per row)
+//   replot      - Invalidate() first, so every column is plotted again
+//
+// Reported: ns per binned frame at 240 to 4000 FPS, and per heatmap width
+// the columns plotted and time per update both ways plus the Draw(). Then a
+// session with 60/30 FPS judder and a hitch every two seconds is printed as
+// text. Before timing, an incremental heatmap is checked against a
+// replotted one through resizes, restyles, range changes and clipping, and
+// per-frame binning against whole-slice histograms (AddSlice); exits with
+// status 1 if any pixel differs, or if updates plot more than the new
+// columns.
+//
+// Usage: bench_frame_time_heatmap [updates]
+//   updates - overlay updates per width and mode (default 20000)
+
+#include "frame_histogram.h"
+#include "frame_time_heatmap.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+const int WIDTHS[] = {128, 512, 2048};
+const int HEATMAP_HEIGHT = 48;
+const float FRAME_RATES[] = {240.0f, 1000.0f, 4000.0f};
+
+uint32_t Noise(uint64_t frame) {
+    uint32_t x = static_cast<uint32_t>(frame) * 2654435761u;
+    x ^= x >> 15;
+    x *= 0x2C1B3C6Du;
+    x ^= x >> 12;
+    return x;
+}
+
+// Around 1000/fps ms, now and then a hitch
+float FrameTimeFor(uint64_t frame, float fps) {
+    uint32_t noise = Noise(frame);
+    if (noise % 499 == 0) return 30.0f + static_cast<float>(noise % 70);
+    return 1000.0f / fps * (0.9f + static_cast<float>(noise % 200) / 1000.0f);
+}
+
+// 60/30 FPS judder (16.7 and 33.3 ms frames) with a 120 ms hitch every 2 s
+float JudderFrameTimeFor(uint64_t frame) {
+    if (frame % 80 == 79) return 120.0f;
+    return Noise(frame) % 3 == 0 ? 33.3f : 16.7f;
+}
+
+struct Target {
+    std::vector<uint32_t> pixels;
+    PixelBuffer buffer;
+
+    Target(int width, int height)
+        : pixels(static_cast<size_t>(width) * height, 0xDEADBEEFu)
+    {
+        buffer.pixels = pixels.data();
+        buffer.width = width;
+        buffer.height = height;
+        buffer.stride = width;
+    }
+};
+
+// Incremental against replotted; returns the step that first differs, or -1
+int CheckAgainstReplot() {
+    FrameTimeHeatmap incremental;
+    FrameTimeHeatmap replot;
+    FrameTimeHeatmapStyle style;
+    style.background = 0xFF101828u;
+    style.color = 0xFFFF8020u;
+    style.sliceMs = 20.0f;
+
+    Target a(300, 80);
+    Target b(300, 80);
+    uint64_t frame = 0;
+    for (int step = 0; step < 4000; ++step) {
+        if (step == 0) {
+            incremental.Resize(211, 37);
+            replot.Resize(211, 37);
+        } else if (step == 1000) {
+            incremental.Resize(97, 37);   // Keeps the newest slices
+            replot.Resize(97, 37);
+        } else if (step == 2000) {
+            incremental.Resize(150, 61);  // Starts over
+            replot.Resize(150, 61);
+        }
+        if (step == 1500) style.color = 0xFF20C0FFu;
+        if (step == 3000) {
+            style.minMs = 1.0f;
+            style.maxMs = 250.0f;
+        }
+        incremental.SetStyle(style);
+        replot.SetStyle(style);
+
+        // Mostly a few frames, now and then none or more than fit
+        uint32_t noise = Noise(static_cast<uint64_t>(step) + 4242);
+        int frames = noise % 60 == 0 ? 3000 : static_cast<int>(noise % 12);
+        for (int i = 0; i < frames; ++i, ++frame) {
+            float frameTimeMs = FrameTimeFor(frame, 300.0f);
+            incremental.AddFrameTime(frameTimeMs);
+            replot.AddFrameTime(frameTimeMs);
+        }
+        incremental.Update();
+        replot.Invalidate();
+        replot.Update();
+
+        int x = step % 11 == 0 ? -41 : (step % 13 == 0 ? 250 : 7);
+        int y = step % 7 == 0 ? -5 : 2;
+        incremental.Draw(a.buffer, x, y);
+        replot.Draw(b.buffer, x, y);
+        if (a.pixels != b.pixels) return step;
+    }
+    return -1;
+}
+
+// Per-frame binning against whole-slice histograms with the same slice
+// boundaries; returns whether the images match
+bool CheckSlices() {
+    FrameTimeHeatmapStyle style;
+    style.sliceMs = 50.0f;
+    FrameTimeHeatmap frames;
+    FrameTimeHeatmap slices;
+    frames.SetStyle(style);
+    slices.SetStyle(style);
+    frames.Resize(120, 40);
+    slices.Resize(120, 40);
+
+    std::vector<uint32_t> buckets(HISTOGRAM_BUCKET_COUNT, 0);
+    float sliceMs = 0.0f;
+    for (uint64_t frame = 0; frame < 50000; ++frame) {
+        float frameTimeMs = FrameTimeFor(frame, 500.0f);
+        frames.AddFrameTime(frameTimeMs);
+        ++buckets[FrameHistogram::BucketForMs(frameTimeMs)];
+        sliceMs += frameTimeMs;
+        if (sliceMs >= style.sliceMs) {
+            slices.AddSlice(buckets.data());
+            std::fill(buckets.begin(), buckets.end(), 0);
+            sliceMs = 0.0f;
+        }
+    }
+    frames.Update();
+    slices.Update();
+
+    Target a(120, 40);
+    Target b(120, 40);
+    frames.Draw(a.buffer, 0, 0);
+    slices.Draw(b.buffer, 0, 0);
+    return a.pixels == b.pixels && frames.GetStats().slices == slices.GetStats().slices;
+}
+
+double NsPerFrame(float fps, int frames) {
+    FrameTimeHeatmap heatmap;
+    heatmap.Resize(512, HEATMAP_HEIGHT);
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        heatmap.AddFrameTime(FrameTimeFor(static_cast<uint64_t>(frame), fps));
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / frames;
+}
+
+struct ModeResult {
+    double usPerUpdate = 0.0;
+    double columnsPerUpdate = 0.0;
+    uint64_t slices = 0;
+};
+
+// One slice per update: 250 ms slices at 60 Hz would mostly add none
+ModeResult RunMode(int width, int updates, bool replot) {
+    FrameTimeHeatmapStyle style;
+    style.sliceMs = 16.0f;
+    FrameTimeHeatmap heatmap;
+    heatmap.SetStyle(style);
+    heatmap.Resize(width, HEATMAP_HEIGHT);
+    for (int i = 0; i < width; ++i) {
+        heatmap.AddFrameTime(16.0f);
+    }
+    heatmap.Update();
+
+    FrameTimeHeatmapStats before = heatmap.GetStats();
+    uint64_t frame = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int update = 0; update < updates; ++update) {
+        for (int i = 0; i < 16; ++i, ++frame) {  // 1000 FPS
+            heatmap.AddFrameTime(FrameTimeFor(frame, 1000.0f));
+        }
+        if (replot) heatmap.Invalidate();
+        heatmap.Update();
+    }
+    auto end = std::chrono::steady_clock::now();
+    FrameTimeHeatmapStats after = heatmap.GetStats();
+
+    ModeResult result;
+    result.usPerUpdate = std::chrono::duration<double, std::micro>(end - start).count() / updates;
+    result.columnsPerUpdate = static_cast<double>(after.plottedColumns - before.plottedColumns) / updates;
+    result.slices = after.slices - before.slices;
+    return result;
+}
+
+double DrawTime(int width, int updates) {
+    FrameTimeHeatmap heatmap;
+    heatmap.Resize(width, HEATMAP_HEIGHT);
+    heatmap.Update();
+    Target target(width + 20, HEATMAP_HEIGHT + 10);
+    auto start = std::chrono::steady_clock::now();
+    for (int update = 0; update < updates; ++update) {
+        heatmap.Draw(target.buffer, update % 3, 5);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / updates;
+}
+
+// Two seconds of judder per eight text columns, brightness as characters
+void PrintJudder() {
+    const int width = 72;
+    const int height = 14;
+    FrameTimeHeatmapStyle style;
+    style.background = 0xFF000000u;
+    style.color = 0xFF808080u;
+    style.minMs = 10.0f;
+    style.maxMs = 150.0f;
+    FrameTimeHeatmap heatmap;
+    heatmap.SetStyle(style);
+    heatmap.Resize(width, height);
+    for (uint64_t frame = 0; frame < 4000; ++frame) {
+        heatmap.AddFrameTime(JudderFrameTimeFor(frame));
+    }
+    heatmap.Update();
+
+    Target target(width, height);
+    heatmap.Draw(target.buffer, 0, 0);
+    const char shades[] = " .:-=+*#%@";
+    std::printf("\n60/30 FPS judder, 120 ms hitch every 2 s; %.0f ms per column, 10 ms (bottom) to 150 ms (top):\n",
+                static_cast<double>(style.sliceMs));
+    for (int y = 0; y < height; ++y) {
+        std::printf("  |");
+        for (int x = 0; x < width; ++x) {
+            uint32_t level = target.pixels[static_cast<size_t>(y) * width + x] & 0xFFu;
+            std::printf("%c", shades[level * 9 / 255]);
+        }
+        std::printf("|\n");
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int updates = argc > 1 ? std::atoi(argv[1]) : 20000;
+    if (updates <= 0) updates = 20000;
+
+    std::printf("Frame-time heatmap: %d updates per width and mode, %dpx high\n\n", updates, HEATMAP_HEIGHT);
+
+    bool ok = true;
+    int mismatch = CheckAgainstReplot();
+    if (mismatch >= 0) {
+        std::printf("FAIL: incremental heatmap differs from a full replot at step %d\n", mismatch);
+        ok = false;
+    }
+    if (!CheckSlices()) {
+        std::printf("FAIL: whole-slice histograms differ from per-frame binning\n");
+        ok = false;
+    }
+
+    std::printf("%-9s %10s\n", "fps", "ns/frame");
+    for (float fps : FRAME_RATES) {
+        std::printf("%-9.0f %10.1f\n", static_cast<double>(fps), NsPerFrame(fps, updates * 50));
+    }
+
+    std::printf("\n%-7s %13s %13s %13s %13s %10s\n", "width", "incr cols", "incr us", "replot cols",
+                "replot us", "draw us");
+    for (int width : WIDTHS) {
+        int replotUpdates = std::max(updates / (width / 128), 100);
+        ModeResult incremental = RunMode(width, updates, false);
+        ModeResult replot = RunMode(width, replotUpdates, true);
+        double drawUs = DrawTime(width, updates);
+
+        std::printf("%-7d %13.2f %13.3f %13.1f %13.3f %10.3f\n", width, incremental.columnsPerUpdate,
+                    incremental.usPerUpdate, replot.columnsPerUpdate, replot.usPerUpdate, drawUs);
+
+        double newColumns = static_cast<double>(incremental.slices) / updates;
+        if (incremental.columnsPerUpdate != newColumns) {
+            std::printf("FAIL: width %d: updates plotted %.2f columns, %.2f were new\n", width,
+                        incremental.columnsPerUpdate, newColumns);
+            ok = false;
+        }
+    }
+
+    PrintJudder();
+    return ok ? 0 : 1;
+}
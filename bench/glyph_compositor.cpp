@@ -0,0 +1,190 @@
+// Glyph atlas and software compositor benchmark: the cost of one overlay
+// text update once glyphs are cached.
+//
+// Builds a GlyphAtlas from the built-in bitmap font (GDI rasterizes it on
+// Windows; the compositing is the same) and then, per update, formats
+// "FPS: xxx.x", fills the backbuffer with the background colour and
+// composites the text into it, the way Renderer::RenderOverlay does. Runs
+// once per compositor kernel the CPU supports (scalar, SSE2, AVX2).
+//
+// Reported: atlas build time, time per update and per glyph for each
+// kernel. Before timing, every kernel draws a set of scenes with clipped,
+// translucent text and a full-range coverage ramp; exits with status 1 if
+// any kernel's pixels differ from the scalar kernel's.
+//
+// Usage: bench_glyph_compositor [updates] [fontSize]
+//   updates  - overlay updates per kernel (default 200000)
+//   fontSize - text height in pixels (default 24)
+
+#include "compositor.h"
+#include "glyph_atlas.h"
+#include "text_format.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cwchar>
+#include <vector>
+
+namespace {
+
+const CompositorKernel KERNELS[] = {
+    CompositorKernel::SCALAR,
+    CompositorKernel::SSE2,
+    CompositorKernel::AVX2,
+};
+
+const uint32_t BACKGROUND = 0xFF000000u;
+const uint32_t TEXT_COLOR = 0xFF00FF00u;
+
+uint64_t Hash(const std::vector<uint32_t>& pixels) {
+    uint64_t hash = 1469598103934665603ull;  // FNV-1a
+    for (uint32_t pixel : pixels) {
+        hash = (hash ^ pixel) * 1099511628211ull;
+    }
+    return hash;
+}
+
+// Deterministic FPS readings, 1 to 4 integer digits
+float FpsFor(int update) {
+    return static_cast<float>((update * 7919) % 20000) / 10.0f + 1.0f;
+}
+
+// Scenes that exercise clipping, translucency, unaligned row lengths and
+// every coverage value; returns a hash of all of them
+uint64_t DrawScenes(const GlyphAtlas& atlas) {
+    const int width = 203;
+    const int height = atlas.LineHeight() + 13;
+    PixelBuffer buffer;
+    std::vector<uint32_t> pixels(static_cast<size_t>(width) * height);
+    buffer.pixels = pixels.data();
+    buffer.width = width;
+    buffer.height = height;
+    buffer.stride = width;
+
+    const int rampWidth = 37;
+    const int rampHeight = 11;
+    std::vector<uint8_t> ramp(static_cast<size_t>(rampWidth) * rampHeight);
+    for (int y = 0; y < rampHeight; ++y) {
+        for (int x = 0; x < rampWidth; ++x) {
+            ramp[static_cast<size_t>(y) * rampWidth + x] = static_cast<uint8_t>(x * 7 + y * 29);
+        }
+    }
+
+    uint64_t hash = 0;
+    wchar_t text[32];
+    for (int scene = 0; scene < 64; ++scene) {
+        for (int y = 0; y < height; ++y) {
+            uint32_t shade = static_cast<uint32_t>((y * 255) / height);
+            uint32_t alpha = 0x80u + static_cast<uint32_t>(scene) * 2;
+            Compositor::Fill(buffer, 0, y, width, 1,
+                             Compositor::Premultiply((alpha << 24) | (shade << 16) | 0x3070u));
+        }
+
+        uint32_t alpha = static_cast<uint32_t>(40 + scene * 3);
+        uint32_t color = Compositor::Premultiply((alpha << 24) | (static_cast<uint32_t>(scene) * 0x040815u & 0xFFFFFFu));
+        int length = std::swprintf(text, 32, L"FPS: %.1f é~", FpsFor(scene));
+        int x = scene % 13 - 6;
+        int y = scene % 5 - 2;
+        Compositor::DrawString(buffer, atlas, x, y, text, length, color);
+        Compositor::BlendMask(buffer, width - rampWidth + scene % 9, scene % 7 - 3, ramp.data(),
+                              rampWidth, rampHeight, rampWidth, color);
+        hash = hash * 31 + Hash(pixels);
+    }
+    return hash;
+}
+
+struct KernelResult {
+    double usPerUpdate = 0.0;
+    double nsPerGlyph = 0.0;
+    uint64_t checksum = 0;
+};
+
+// What the renderer does per update, into a backbuffer sized for the
+// widest reading
+KernelResult RunUpdates(const GlyphAtlas& atlas, int updates) {
+    const wchar_t* widest = L"FPS: 8888.8";
+    int width = atlas.MeasureText(widest, static_cast<int>(std::wcslen(widest))) + 20;
+    int height = atlas.LineHeight() + 10;
+    std::vector<uint32_t> pixels(static_cast<size_t>(width) * height);
+    PixelBuffer buffer;
+    buffer.pixels = pixels.data();
+    buffer.width = width;
+    buffer.height = height;
+    buffer.stride = width;
+
+    KernelResult result;
+    wchar_t text[32];
+    uint64_t glyphs = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int update = 0; update < updates; ++update) {
+        int length = TextFormat::Format<"FPS: {:.1f}">(text, 32, FpsFor(update));
+        Compositor::Fill(buffer, 0, 0, width, height, BACKGROUND);
+        Compositor::DrawString(buffer, atlas, 0, 0, text, length, TEXT_COLOR);
+        result.checksum += pixels[static_cast<size_t>(update % height) * width + update % width];
+        glyphs += length;
+    }
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    result.usPerUpdate = ns / updates / 1000.0;
+    result.nsPerGlyph = glyphs ? ns / glyphs : 0.0;
+    return result;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int updates = argc > 1 ? std::atoi(argv[1]) : 200000;
+    int fontSize = argc > 2 ? std::atoi(argv[2]) : 24;
+    if (updates <= 0) updates = 200000;
+    if (fontSize <= 0) fontSize = 24;
+
+    GlyphAtlas atlas;
+    BitmapFontRasterizer rasterizer(fontSize);
+    auto buildStart = std::chrono::steady_clock::now();
+    bool built = atlas.Build(rasterizer);
+    auto buildEnd = std::chrono::steady_clock::now();
+    if (!built) {
+        std::printf("FAIL: glyph atlas build failed\n");
+        return 1;
+    }
+
+    std::printf("Glyph compositor: %d updates per kernel, %dpx font (line %d), default kernel %s\n",
+                updates, fontSize, atlas.LineHeight(), Compositor::KernelName(Compositor::GetKernel()));
+    std::printf("atlas: %d glyphs, %zu coverage bytes, built in %.1f us\n\n",
+                GLYPH_ATLAS_LAST - GLYPH_ATLAS_FIRST + 1, atlas.CoverageBytes(),
+                std::chrono::duration<double, std::micro>(buildEnd - buildStart).count());
+
+    CompositorKernel defaultKernel = Compositor::GetKernel();
+    bool ok = true;
+    uint64_t reference = 0;
+    uint64_t referenceChecksum = 0;
+
+    std::printf("%-8s %12s %12s %10s\n", "kernel", "us/update", "ns/glyph", "scenes");
+    for (CompositorKernel kernel : KERNELS) {
+        if (!Compositor::IsKernelSupported(kernel)) {
+            std::printf("%-8s %12s %12s %10s\n", Compositor::KernelName(kernel), "-", "-", "n/a");
+            continue;
+        }
+        Compositor::SetKernel(kernel);
+
+        uint64_t scenes = DrawScenes(atlas);
+        KernelResult result = RunUpdates(atlas, updates);
+        bool matches = true;
+        if (kernel == CompositorKernel::SCALAR) {
+            reference = scenes;
+            referenceChecksum = result.checksum;
+        } else {
+            matches = scenes == reference && result.checksum == referenceChecksum;
+        }
+
+        std::printf("%-8s %12.3f %12.1f %10s\n", Compositor::KernelName(kernel),
+                    result.usPerUpdate, result.nsPerGlyph, matches ? "match" : "DIFFER");
+        if (!matches) {
+            std::printf("FAIL: %s output differs from scalar\n", Compositor::KernelName(kernel));
+            ok = false;
+        }
+    }
+    Compositor::SetKernel(defaultKernel);
+    return ok ? 0 : 1;
+}
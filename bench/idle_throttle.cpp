@@ -0,0 +1,213 @@
+// Idle throttling benchmark and check.
+//
+// Runs the overlay's sampler loop (frame pipeline + ActivityGovernor +
+// FramePacer, as in FPSOverlay::UpdateWorker) against a synthetic frame
+// source that starts and stops:
+//
+//   idle   - no frames yet
+//   active - synthetic source presenting at 144 fps
+//   drain  - source stopped, governor cooling down
+//   idle   - source stopped for longer than idleAfterMs
+//
+// Each phase reports sampler wakeups, process context switches and CPU time,
+// first with throttling disabled (the old always-60 Hz loop) and then with
+// it enabled. Finally the source restarts and the time until the governor
+// goes ACTIVE again is measured.
+//
+// Usage: bench_idle_throttle [phaseSeconds]
+// Exits with status 1 if the throttled idle phases wake more than twice per
+// poll period or ramp-up takes longer than 50 ms.
+
+#include "activity_governor.h"
+#include "frame_pipeline.h"
+#include "precise_timer.h"
+#include "synthetic_source.h"
+
+#include <sys/resource.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+namespace {
+
+const uint32_t IDLE_AFTER_MS = 1000;
+const uint32_t IDLE_POLL_MS = 1000;
+const uint32_t MAX_RAMP_UP_MS = 50;
+
+struct Usage {
+    uint64_t contextSwitches = 0;
+    double cpuSeconds = 0.0;
+};
+
+Usage ProcessUsage() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    Usage result;
+    result.contextSwitches = static_cast<uint64_t>(usage.ru_nvcsw + usage.ru_nivcsw);
+    result.cpuSeconds = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 +
+                        usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+    return result;
+}
+
+// The sampler side of FPSOverlay, minus Win32
+class Monitor {
+public:
+    explicit Monitor(bool throttle)
+        : m_pipeline(PipelineConfig())
+        , m_governor(MakeConfig())
+        , m_pacer(16000000ull, PacingMode::HYBRID, PACING_DEFAULT_SPIN_US)
+        , m_throttle(throttle)
+        , m_running(false)
+        , m_loops(0)
+        , m_activeAtNs(0)
+    {
+        m_governor.SetStateCallback([this](ActivityState state) {
+            if (state == ActivityState::ACTIVE) {
+                m_activeAtNs.store(MonotonicNowNs(), std::memory_order_relaxed);
+                m_pipeline.ResetSource(FRAME_SOURCE_SAMPLER, MonotonicNowNs());
+                m_pacer.Reset();
+            }
+        });
+    }
+
+    ~Monitor() { Stop(); }
+
+    void Start() {
+        m_pipeline.Start();
+        m_running.store(true);
+        m_thread = std::thread([this]() { SamplerLoop(); });
+    }
+
+    void Stop() {
+        if (!m_running.exchange(false)) return;
+        m_governor.Wake();
+        m_thread.join();
+        m_pipeline.Stop();
+    }
+
+    // What the hooks do for every present
+    void OnPresent(uint64_t timestampNs) {
+        m_pipeline.PushPresent(timestampNs, FRAME_SOURCE_HOOK);
+        m_governor.NotifyActivity(timestampNs);
+    }
+
+    uint64_t Loops() const { return m_loops.load(std::memory_order_relaxed); }
+    uint64_t ActiveAtNs() const { return m_activeAtNs.load(std::memory_order_relaxed); }
+    ActivityState State() const { return m_governor.GetState(); }
+
+private:
+    FramePipeline m_pipeline;
+    ActivityGovernor m_governor;
+    FramePacer m_pacer;
+    bool m_throttle;
+    std::atomic<bool> m_running;
+    std::atomic<uint64_t> m_loops;
+    std::atomic<uint64_t> m_activeAtNs;
+    std::thread m_thread;
+
+    static ActivityConfig MakeConfig() {
+        ActivityConfig config;
+        config.coolingAfterMs = 250;
+        config.idleAfterMs = IDLE_AFTER_MS;
+        config.idlePollMs = IDLE_POLL_MS;
+        return config;
+    }
+
+    void SamplerLoop() {
+        m_pacer.Reset();
+        while (m_running.load(std::memory_order_relaxed)) {
+            m_loops.fetch_add(1, std::memory_order_relaxed);
+            ActivityState state = m_governor.Update(MonotonicNowNs());
+            if (m_throttle && state != ActivityState::ACTIVE) {
+                m_governor.WaitForActivity();
+                continue;
+            }
+            m_pipeline.PushPresent(MonotonicNowNs(), FRAME_SOURCE_SAMPLER);
+            m_pacer.Wait();
+        }
+    }
+};
+
+const char* StateName(ActivityState state) {
+    switch (state) {
+        case ActivityState::ACTIVE:  return "active";
+        case ActivityState::COOLING: return "cooling";
+        default:                     return "idle";
+    }
+}
+
+struct PhaseResult {
+    double loopsPerSec = 0.0;
+};
+
+PhaseResult RunPhase(const char* name, Monitor& monitor, double seconds) {
+    Usage before = ProcessUsage();
+    uint64_t loopsBefore = monitor.Loops();
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+
+    Usage after = ProcessUsage();
+    PhaseResult result;
+    result.loopsPerSec = (monitor.Loops() - loopsBefore) / seconds;
+    std::printf("  %-8s %-8s %10.1f %12.1f %9.2f%%\n", name, StateName(monitor.State()),
+                result.loopsPerSec,
+                (after.contextSwitches - before.contextSwitches) / seconds,
+                100.0 * (after.cpuSeconds - before.cpuSeconds) / seconds);
+    return result;
+}
+
+bool Run(bool throttle, double phaseSeconds) {
+    std::printf("%s\n", throttle ? "throttling enabled" : "throttling disabled (always 60 Hz)");
+    std::printf("  %-8s %-8s %10s %12s %10s\n", "phase", "state", "wakeups/s", "ctx switch/s", "cpu");
+
+    Monitor monitor(throttle);
+    SyntheticFrameSource source([&monitor](uint64_t ts) { monitor.OnPresent(ts); });
+    monitor.Start();
+
+    PhaseResult idleBefore = RunPhase("idle", monitor, phaseSeconds);
+
+    source.Start(144.0);
+    RunPhase("active", monitor, phaseSeconds);
+    source.Stop();
+
+    RunPhase("drain", monitor, IDLE_AFTER_MS / 1000.0);
+    PhaseResult idleAfter = RunPhase("idle", monitor, phaseSeconds);
+
+    // Ramp-up: first present after idling until the sampler is ACTIVE
+    uint64_t restartNs = MonotonicNowNs();
+    source.Start(144.0);
+    uint64_t deadline = restartNs + 1000000000ull;
+    while (monitor.ActiveAtNs() < restartNs && MonotonicNowNs() < deadline) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    source.Stop();
+    uint64_t activeAt = monitor.ActiveAtNs();
+    double rampUpMs = activeAt >= restartNs ? (activeAt - restartNs) / 1e6 : -1.0;
+    std::printf("  ramp-up  %.2f ms\n\n", rampUpMs);
+
+    monitor.Stop();
+    if (!throttle) return true;
+
+    // Allow two wakeups per poll period for timing noise
+    double maxIdleRate = 2.0 * 1000.0 / IDLE_POLL_MS;
+    bool ok = idleBefore.loopsPerSec <= maxIdleRate && idleAfter.loopsPerSec <= maxIdleRate &&
+              rampUpMs >= 0.0 && rampUpMs <= MAX_RAMP_UP_MS;
+    if (!ok) {
+        std::printf("FAIL: idle wakeups must stay <= %.1f/s and ramp-up <= %u ms\n",
+                    maxIdleRate, MAX_RAMP_UP_MS);
+    }
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    double phaseSeconds = argc > 1 ? std::atof(argv[1]) : 3.0;
+    if (phaseSeconds <= 0.0) phaseSeconds = 3.0;
+
+    Run(false, phaseSeconds);
+    return Run(true, phaseSeconds) ? 0 : 1;
+}
@@ -0,0 +1,173 @@
+// Sampler tail latency under heavy file writes.
+//
+// A paced loop (the fallback sampler's shape) records how late each wakeup
+// is. Every writeIntervalMs it "saves" writeMB of data, the way the periodic
+// config/export flush does, in one of three ways:
+//   none  - no writes (baseline)
+//   sync  - write, fsync and rename on the sampler thread itself
+//   async - hand the buffer to the IoExecutor and keep going
+// Lateness is reported at p50/p99/p99.9/max for each mode.
+//
+// Usage: bench_io_tail_latency [seconds] [writeMB] [writeIntervalMs] [dir]
+//   seconds         - run time per mode (default 5)
+//   writeMB         - size of each write (default 8)
+//   writeIntervalMs - time between writes (default 250)
+//   dir             - where the scratch file goes (default: current directory)
+
+#include "io_executor.h"
+#include "io_task.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const auto SAMPLE_PERIOD = std::chrono::microseconds(2000);
+
+enum class WriteMode {
+    NONE,
+    SYNC,
+    ASYNC
+};
+
+struct LatencySummary {
+    size_t samples = 0;
+    size_t writes = 0;
+    double p50Us = 0.0;
+    double p99Us = 0.0;
+    double p999Us = 0.0;
+    double maxUs = 0.0;
+};
+
+// The same write the executor does for IoWriteMode::REPLACE, done inline
+bool WriteBlocking(const std::filesystem::path& path, const std::vector<char>& data) {
+    std::filesystem::path temp = path;
+    temp += ".tmp";
+    FILE* file = std::fopen(temp.string().c_str(), "wb");
+    if (!file) return false;
+    bool ok = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    ok = std::fflush(file) == 0 && ok;
+#ifndef _WIN32
+    ok = fsync(fileno(file)) == 0 && ok;
+#endif
+    std::fclose(file);
+    std::error_code error;
+    std::filesystem::rename(temp, path, error);
+    return ok && !error;
+}
+
+Task<void> WriteAsync(IoExecutor& io, std::filesystem::path path, std::vector<char> data,
+                      std::atomic<bool>& inFlight) {
+    co_await io.WriteFile(path, std::move(data), IoWriteMode::REPLACE);
+    inFlight = false;
+}
+
+double Percentile(const std::vector<double>& sorted, double fraction) {
+    if (sorted.empty()) return 0.0;
+    size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+LatencySummary RunSampler(WriteMode mode, double seconds, size_t writeBytes, int writeIntervalMs,
+                          const std::filesystem::path& path) {
+    std::shared_ptr<IoExecutor> io = IoExecutor::Shared();
+    std::atomic<bool> inFlight(false);
+    std::vector<char> payload(writeBytes, 'x');
+
+    std::vector<double> lateness;
+    lateness.reserve(static_cast<size_t>(seconds * 1e6 / SAMPLE_PERIOD.count()) + 16);
+    LatencySummary summary;
+
+    auto start = Clock::now();
+    auto end = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+    auto deadline = start + SAMPLE_PERIOD;
+    auto nextWrite = start + std::chrono::milliseconds(writeIntervalMs);
+
+    while (deadline < end) {
+        std::this_thread::sleep_until(deadline);
+        auto now = Clock::now();
+        lateness.push_back(std::chrono::duration<double, std::micro>(now - deadline).count());
+        deadline += SAMPLE_PERIOD;
+
+        if (mode == WriteMode::NONE || now < nextWrite) continue;
+        nextWrite += std::chrono::milliseconds(writeIntervalMs);
+
+        if (mode == WriteMode::SYNC) {
+            WriteBlocking(path, payload);
+            summary.writes++;
+        } else if (!inFlight.exchange(true)) {
+            // Skip a flush while the previous one is still running, like
+            // ConfigManager::SaveIfDirty
+            Spawn(WriteAsync(*io, path, payload, inFlight));
+            summary.writes++;
+        }
+    }
+    io->Drain();
+
+    std::sort(lateness.begin(), lateness.end());
+    summary.samples = lateness.size();
+    summary.p50Us = Percentile(lateness, 0.50);
+    summary.p99Us = Percentile(lateness, 0.99);
+    summary.p999Us = Percentile(lateness, 0.999);
+    summary.maxUs = lateness.empty() ? 0.0 : lateness.back();
+    return summary;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? std::atof(argv[1]) : 5.0;
+    double writeMB = argc > 2 ? std::atof(argv[2]) : 8.0;
+    int writeIntervalMs = argc > 3 ? std::atoi(argv[3]) : 250;
+    std::filesystem::path dir = argc > 4 ? argv[4] : ".";
+    if (seconds <= 0.0) seconds = 5.0;
+    if (writeMB <= 0.0) writeMB = 8.0;
+    if (writeIntervalMs <= 0) writeIntervalMs = 250;
+
+    // Shared by all modes, so the totals at the end cover every run
+    std::shared_ptr<IoExecutor> io = IoExecutor::Shared();
+    std::filesystem::path path = dir / "bench_io_tail_latency.bin";
+    size_t writeBytes = static_cast<size_t>(writeMB * (1 << 20));
+
+    std::printf("sampler period %lld us, %.1f MB write every %d ms, %.1f s per mode\n\n",
+                static_cast<long long>(SAMPLE_PERIOD.count()), writeMB, writeIntervalMs, seconds);
+    std::printf("%-6s %8s %7s %10s %10s %10s %10s\n", "mode", "samples", "writes",
+                "p50 us", "p99 us", "p99.9 us", "max us");
+
+    const struct {
+        const char* name;
+        WriteMode mode;
+    } modes[] = {
+        {"none", WriteMode::NONE},
+        {"sync", WriteMode::SYNC},
+        {"async", WriteMode::ASYNC},
+    };
+
+    for (const auto& mode : modes) {
+        LatencySummary summary = RunSampler(mode.mode, seconds, writeBytes, writeIntervalMs, path);
+        std::printf("%-6s %8zu %7zu %10.1f %10.1f %10.1f %10.1f\n", mode.name, summary.samples, summary.writes,
+                    summary.p50Us, summary.p99Us, summary.p999Us, summary.maxUs);
+    }
+
+    std::error_code error;
+    std::filesystem::remove(path, error);
+
+    IoExecutorStats stats = io->GetStats();
+    std::printf("\nexecutor: %llu completed, %llu failed, %.1f MB written\n",
+                static_cast<unsigned long long>(stats.completed), static_cast<unsigned long long>(stats.failed),
+                stats.bytesWritten / double(1 << 20));
+    return 0;
+}
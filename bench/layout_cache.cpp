@@ -0,0 +1,275 @@
+// Layout cache benchmark: the per-frame cost of measuring the overlay text
+// and placing the window, done every frame vs looked up in LayoutCache.
+//
+// Replays FPS readings from 30.0 to 999.9, one line ("FPS: 59.9") and three
+// ("FPS: 59.9\n1%: 41\n0.1%: 25"), measured with a bitmap-font GlyphAtlas
+// at 12 to 32 pixels and placed bottom-right on a 2560x1440 monitor, with
+// the overlay's padding (Renderer now keys the position by the widget
+// layout instead, which only ever has one width class):
+//
+//   measured - measure every line and compute the position every frame
+//   cached   - key the frame by monitor, DPI, font, placement and width
+//              class; measure and place only on a miss
+//
+// Reported per font size and layout: the distinct width classes, ns per
+// frame both ways, and the misses in a first pass, a second pass (steady
+// state) and a pass after a display change. Before timing, every cached
+// layout is checked against a measured one, also with a font whose digits
+// differ in width (no digit folding then); exits with status 1 if any
+// differs, if the steady state misses at all, or if a display change
+// misses more than once per width class.
+//
+// Usage: bench_layout_cache [passes]
+//   passes - timed passes over the readings per font and layout (default 200)
+
+#include "glyph_atlas.h"
+#include "layout_cache.h"
+#include "text_format.h"
+#include "widget_layout.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <vector>
+
+namespace {
+
+const int FONT_SIZES[] = {12, 16, 24, 32};
+const int READINGS = 4096;
+const int TEXT_CAPACITY = 48;
+const int MONITOR_WIDTH = 2560;
+const int MONITOR_HEIGHT = 1440;
+const int OFFSET = 10;
+const int MAX_LINES = 8;
+
+uint32_t Noise(uint64_t value) {
+    uint32_t x = static_cast<uint32_t>(value) * 2654435761u;
+    x ^= x >> 15;
+    x *= 0x2C1B3C6Du;
+    x ^= x >> 12;
+    return x;
+}
+
+struct Reading {
+    wchar_t text[TEXT_CAPACITY];
+    int length = 0;
+};
+
+std::vector<Reading> MakeReadings(bool multiLine) {
+    std::vector<Reading> readings(READINGS);
+    for (int i = 0; i < READINGS; ++i) {
+        uint32_t noise = Noise(static_cast<uint64_t>(i));
+        float fps = 30.0f + static_cast<float>(noise % 9700) / 10.0f;
+        Reading& reading = readings[static_cast<size_t>(i)];
+        if (multiLine) {
+            float low = fps * (0.5f + static_cast<float>((noise >> 16) % 40) / 100.0f);
+            reading.length = TextFormat::Format<"FPS: {:.1f}\n1%: {:.0f}\n0.1%: {:.0f}">(
+                reading.text, TEXT_CAPACITY, fps, low, low * 0.6f);
+        } else {
+            reading.length = TextFormat::Format<"FPS: {:.1f}">(reading.text, TEXT_CAPACITY, fps);
+        }
+    }
+    return readings;
+}
+
+// '1' narrower than the other digits, like proportional UI fonts
+class ProportionalRasterizer : public BitmapFontRasterizer {
+public:
+    explicit ProportionalRasterizer(int pixelHeight) : BitmapFontRasterizer(pixelHeight) {}
+
+    bool Rasterize(wchar_t ch, GlyphBitmap& glyph) override {
+        if (!BitmapFontRasterizer::Rasterize(ch, glyph)) return false;
+        if (ch == L'1') glyph.advance = std::max(glyph.advance / 2, 1);
+        return true;
+    }
+};
+
+// Widest of the '\n'-separated lines
+int MeasureLines(const GlyphAtlas& atlas, const wchar_t* text, int length, int& lines) {
+    int width = 0;
+    int start = 0;
+    lines = 0;
+    while (lines < MAX_LINES) {
+        int end = start;
+        while (end < length && text[end] != L'\n') ++end;
+        width = std::max(width, atlas.MeasureText(text + start, end - start));
+        ++lines;
+        start = end + 1;
+        if (start > length) break;
+    }
+    return width;
+}
+
+// Bottom-right with the renderer's padding, clamped to the monitor
+LayoutEntry MeasureAndPlace(const GlyphAtlas& atlas, const Reading& reading) {
+    LayoutEntry entry;
+    entry.textWidth = MeasureLines(atlas, reading.text, reading.length, entry.lines);
+    entry.lineHeight = atlas.LineHeight();
+    int width = entry.textWidth + OVERLAY_PADDING_X;
+    int height = entry.lines * entry.lineHeight + OVERLAY_PADDING_Y;
+    entry.x = std::max(0, std::min(MONITOR_WIDTH - width - OFFSET, MONITOR_WIDTH - width));
+    entry.y = std::max(0, std::min(MONITOR_HEIGHT - height - OFFSET, MONITOR_HEIGHT - height));
+    return entry;
+}
+
+LayoutKey KeyFor(const GlyphAtlas& atlas, int fontSize, const Reading& reading) {
+    LayoutKey key;
+    key.monitor = 1;
+    key.dpi = 96;
+    key.font = static_cast<uint64_t>(fontSize);
+    key.placement = LayoutCache::Mix(0, 3);  // Bottom-right
+    key.widthClass = LayoutCache::WidthClass(reading.text, reading.length, atlas.HasTabularDigits());
+    return key;
+}
+
+LayoutEntry Cached(LayoutCache& cache, const GlyphAtlas& atlas, int fontSize, const Reading& reading) {
+    LayoutKey key = KeyFor(atlas, fontSize, reading);
+    if (const LayoutEntry* entry = cache.Find(key)) return *entry;
+    LayoutEntry entry = MeasureAndPlace(atlas, reading);
+    cache.Store(key, entry);
+    return entry;
+}
+
+bool SameEntry(const LayoutEntry& a, const LayoutEntry& b) {
+    return a.textWidth == b.textWidth && a.lineHeight == b.lineHeight && a.lines == b.lines && a.x == b.x &&
+           a.y == b.y;
+}
+
+// Every cached layout against a measured one; returns the mismatches
+int CheckAgainstMeasured(const GlyphAtlas& atlas, int fontSize, const std::vector<Reading>& readings) {
+    LayoutCache cache;
+    int mismatches = 0;
+    for (int pass = 0; pass < 2; ++pass) {
+        for (const Reading& reading : readings) {
+            if (!SameEntry(Cached(cache, atlas, fontSize, reading), MeasureAndPlace(atlas, reading))) {
+                ++mismatches;
+            }
+        }
+    }
+    return mismatches;
+}
+
+struct Result {
+    size_t classes = 0;
+    double nsMeasured = 0.0;
+    double nsCached = 0.0;
+    uint64_t firstMisses = 0;
+    uint64_t steadyMisses = 0;
+    uint64_t displayChangeMisses = 0;
+    int64_t checksum = 0;  // Keeps the timed loops' results alive
+};
+
+uint64_t MissesForPass(LayoutCache& cache, const GlyphAtlas& atlas, int fontSize,
+                       const std::vector<Reading>& readings, int64_t& checksum) {
+    uint64_t before = cache.GetStats().misses;
+    for (const Reading& reading : readings) {
+        checksum += Cached(cache, atlas, fontSize, reading).x;
+    }
+    return cache.GetStats().misses - before;
+}
+
+Result Run(const GlyphAtlas& atlas, int fontSize, const std::vector<Reading>& readings, int passes) {
+    Result result;
+    std::set<uint64_t> classes;
+    for (const Reading& reading : readings) {
+        classes.insert(LayoutCache::WidthClass(reading.text, reading.length, atlas.HasTabularDigits()));
+    }
+    result.classes = classes.size();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; ++pass) {
+        for (const Reading& reading : readings) {
+            result.checksum += MeasureAndPlace(atlas, reading).x;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    double frames = static_cast<double>(passes) * readings.size();
+    result.nsMeasured = std::chrono::duration<double, std::nano>(end - start).count() / frames;
+
+    LayoutCache cache;
+    result.firstMisses = MissesForPass(cache, atlas, fontSize, readings, result.checksum);
+    result.steadyMisses = MissesForPass(cache, atlas, fontSize, readings, result.checksum);
+    cache.Invalidate();
+    result.displayChangeMisses = MissesForPass(cache, atlas, fontSize, readings, result.checksum);
+
+    start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; ++pass) {
+        for (const Reading& reading : readings) {
+            result.checksum += Cached(cache, atlas, fontSize, reading).x;
+        }
+    }
+    end = std::chrono::steady_clock::now();
+    result.nsCached = std::chrono::duration<double, std::nano>(end - start).count() / frames;
+    return result;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int passes = argc > 1 ? std::atoi(argv[1]) : 200;
+    if (passes <= 0) passes = 200;
+
+    std::printf("Layout cache: %d readings, %d timed passes per font and layout\n\n", READINGS, passes);
+
+    bool ok = true;
+    std::vector<Reading> layouts[2] = {MakeReadings(false), MakeReadings(true)};
+    const char* layoutNames[2] = {"1 line", "3 lines"};
+
+    for (int fontSize : FONT_SIZES) {
+        GlyphAtlas proportional;
+        ProportionalRasterizer rasterizer(fontSize);
+        proportional.Build(rasterizer);
+        for (const std::vector<Reading>& readings : layouts) {
+            int mismatches = CheckAgainstMeasured(proportional, fontSize, readings);
+            if (proportional.HasTabularDigits() || mismatches > 0) {
+                std::printf("FAIL: %dpx proportional digits: %d cached layouts differ from measured\n", fontSize,
+                            mismatches);
+                ok = false;
+            }
+        }
+    }
+
+    std::printf("%-6s %-8s %8s %12s %10s %12s %13s %15s\n", "font", "layout", "classes", "measured ns",
+                "cached ns", "first misses", "steady misses", "display misses");
+    int64_t checksum = 0;
+    for (int fontSize : FONT_SIZES) {
+        GlyphAtlas atlas;
+        BitmapFontRasterizer rasterizer(fontSize);
+        atlas.Build(rasterizer);
+        for (int layout = 0; layout < 2; ++layout) {
+            const std::vector<Reading>& readings = layouts[layout];
+            int mismatches = CheckAgainstMeasured(atlas, fontSize, readings);
+            if (mismatches > 0) {
+                std::printf("FAIL: %dpx %s: %d cached layouts differ from measured\n", fontSize, layoutNames[layout],
+                            mismatches);
+                ok = false;
+            }
+
+            Result result = Run(atlas, fontSize, readings, passes);
+            checksum += result.checksum;
+            std::printf("%-6d %-8s %8zu %12.1f %10.1f %12llu %13llu %15llu\n", fontSize, layoutNames[layout],
+                        result.classes, result.nsMeasured, result.nsCached,
+                        static_cast<unsigned long long>(result.firstMisses),
+                        static_cast<unsigned long long>(result.steadyMisses),
+                        static_cast<unsigned long long>(result.displayChangeMisses));
+            if (result.steadyMisses > 0) {
+                std::printf("FAIL: %dpx %s: steady state missed %llu times\n", fontSize, layoutNames[layout],
+                            static_cast<unsigned long long>(result.steadyMisses));
+                ok = false;
+            }
+            if (result.displayChangeMisses > result.classes) {
+                std::printf("FAIL: %dpx %s: a display change missed %llu times for %zu classes\n", fontSize,
+                            layoutNames[layout], static_cast<unsigned long long>(result.displayChangeMisses),
+                            result.classes);
+                ok = false;
+            }
+        }
+    }
+    if (checksum == 0) {
+        std::printf("FAIL: no layouts were placed\n");
+        ok = false;
+    }
+    return ok ? 0 : 1;
+}
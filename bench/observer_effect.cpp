@@ -0,0 +1,546 @@
+// Observer-effect benchmark: what the monitor costs the game it watches.
+//
+// A deterministic synthetic "game loop" runs a fixed number of frames. Each
+// frame does a fixed amount of integer work plus a fixed-seed random walk
+// over a large buffer, so it is both CPU- and memory-bound and every run
+// does exactly the same work. It runs alone and then next to the monitor in
+// each of its modes:
+//
+//   baseline - the game alone
+//   idle     - monitor running, nothing presenting (throttled sampler,
+//              stats task at the idle interval, render thread asleep)
+//   overlay  - every game frame is a hooked present; stats task at 60 Hz
+//              feeding the render thread
+//   capture  - overlay plus a capture sink appending frames to disk
+//              through the IoExecutor about once a second
+//   all      - capture plus a histogram sink and a stats log sink
+//
+// Reported per mode: game frame time distribution and its shift against the
+// baseline, the game thread's cache misses (perf_event_open; "n/a" where
+// unavailable) and the CPU time the monitor itself used. The run exits with
+// status 1 if the game's checksum differs between modes, i.e. the workload
+// was not deterministic and the comparison is meaningless.
+//
+// Usage: bench_observer_effect [frames] [bufferMB] [frameKiloOps]
+//   frames       - game frames per mode (default 2000)
+//   bufferMB     - size of the buffer the game walks (default 64)
+//   frameKiloOps - thousands of integer ops and memory reads per frame
+//                  (default 25)
+
+#include "activity_governor.h"
+#include "frame_histogram.h"
+#include "frame_pipeline.h"
+#include "io_executor.h"
+#include "io_task.h"
+#include "lockfree_queue.h"
+#include "precise_timer.h"
+#include "scheduler.h"
+#include "thread_affinity.h"
+#include "triple_buffer.h"
+
+#include <sys/resource.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+enum class MonitorMode { NONE, IDLE, OVERLAY, CAPTURE, ALL };
+
+const uint32_t STATS_ACTIVE_MS = 16;
+const uint32_t STATS_IDLE_MS = 1000;
+const uint32_t CAPTURE_FLUSH_MS = 1000;
+
+double ProcessCpuSeconds() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 +
+           usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+}
+
+double ThreadCpuSeconds() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Hardware counters for the calling thread only
+class ThreadCounters {
+public:
+    ThreadCounters() : m_fds{-1, -1} {
+#ifdef __linux__
+        m_fds[0] = Open(PERF_COUNT_HW_CACHE_MISSES);
+        m_fds[1] = Open(PERF_COUNT_HW_INSTRUCTIONS);
+#endif
+    }
+
+    ~ThreadCounters() {
+#ifdef __linux__
+        for (int fd : m_fds) {
+            if (fd >= 0) close(fd);
+        }
+#endif
+    }
+
+    bool Available() const { return m_fds[0] >= 0; }
+
+    void Start() {
+#ifdef __linux__
+        for (int fd : m_fds) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    void Stop(uint64_t& cacheMisses, uint64_t& instructions) {
+        cacheMisses = Read(m_fds[0]);
+        instructions = Read(m_fds[1]);
+    }
+
+private:
+    int m_fds[2];
+
+#ifdef __linux__
+    static int Open(uint64_t config) {
+        perf_event_attr attr = {};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+
+    static uint64_t Read(int fd) {
+#ifdef __linux__
+        if (fd < 0) return 0;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        uint64_t value = 0;
+        if (read(fd, &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value))) return 0;
+        return value;
+#else
+        (void)fd;
+        return 0;
+#endif
+    }
+};
+
+// The game: integer work plus a dependent random walk over `buffer`
+class SyntheticGame {
+public:
+    SyntheticGame(size_t bufferBytes, uint64_t opsPerFrame)
+        : m_buffer(bufferBytes / sizeof(uint64_t)), m_opsPerFrame(opsPerFrame) {
+        uint64_t x = 0x2545F4914F6CDD1Dull;
+        for (uint64_t& word : m_buffer) {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            word = x;
+        }
+    }
+
+    // Same seed every run, so every run does identical work
+    void Reset() { m_state = 0x9E3779B97F4A7C15ull; m_index = 0; }
+
+    uint64_t Frame() {
+        uint64_t x = m_state;
+        uint64_t index = m_index;
+        size_t mask = m_buffer.size() - 1;
+        for (uint64_t i = 0; i < m_opsPerFrame; ++i) {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            // The next address depends on the loaded value: no prefetching
+            index = (index ^ m_buffer[index & mask] ^ x) & mask;
+        }
+        m_state = x;
+        m_index = index;
+        return x ^ index;
+    }
+
+private:
+    std::vector<uint64_t> m_buffer;  // Power-of-two words
+    uint64_t m_opsPerFrame;
+    uint64_t m_state = 0;
+    uint64_t m_index = 0;
+};
+
+Task<void> AppendAsync(IoExecutor& io, std::filesystem::path path, std::vector<char> data) {
+    co_await io.WriteFile(path, std::move(data), IoWriteMode::APPEND);
+}
+
+// Frame capture: buffers every frame as CSV and appends it once a second
+class CaptureSink : public IFrameSink {
+public:
+    CaptureSink(std::shared_ptr<IoExecutor> io, std::filesystem::path path)
+        : m_io(std::move(io)), m_path(std::move(path)), m_lastFlushNs(MonotonicNowNs()) {}
+
+    void Consume(const FrameStats&) override {}
+
+    void ConsumeBatch(const FrameBatchRef& batch) override {
+        char line[64];
+        for (size_t i = 0; i < batch->Count(); ++i) {
+            const NormalizedFrame& frame = (*batch)[i];
+            int length = std::snprintf(line, sizeof(line), "%llu,%.4f\n",
+                                       static_cast<unsigned long long>(frame.timestampNs),
+                                       frame.frameTime * 1000.0f);
+            m_pending.insert(m_pending.end(), line, line + length);
+        }
+        uint64_t now = MonotonicNowNs();
+        if (now - m_lastFlushNs >= CAPTURE_FLUSH_MS * 1000000ull) {
+            Flush();
+            m_lastFlushNs = now;
+        }
+    }
+
+    // Sink thread, or any thread once the pipeline has stopped
+    void Flush() {
+        if (m_pending.empty()) return;
+        Spawn(AppendAsync(*m_io, m_path, std::move(m_pending)));
+        m_pending = std::vector<char>();
+    }
+
+private:
+    std::shared_ptr<IoExecutor> m_io;
+    std::filesystem::path m_path;
+    std::vector<char> m_pending;
+    uint64_t m_lastFlushNs;
+};
+
+// Rolling frame time histogram, queried for the 1% low on every stats update
+class HistogramSink : public IFrameSink {
+public:
+    HistogramSink() : m_histogram(1000), m_p99Ms(0.0f) {}
+
+    void Consume(const FrameStats&) override {
+        m_p99Ms.store(m_histogram.Percentile(99.0f), std::memory_order_relaxed);
+    }
+
+    void ConsumeBatch(const FrameBatchRef& batch) override {
+        for (size_t i = 0; i < batch->Count(); ++i) {
+            m_histogram.Add((*batch)[i].frameTime * 1000.0f);
+        }
+    }
+
+private:
+    FrameHistogram m_histogram;
+    std::atomic<float> m_p99Ms;
+};
+
+// Stats log: one formatted line per stats update into a bounded buffer
+class LogSink : public IFrameSink {
+public:
+    LogSink() { m_log.reserve(LOG_CAPACITY); }
+
+    void Consume(const FrameStats& stats) override {
+        char line[128];
+        int length = std::snprintf(line, sizeof(line), "%llu fps=%.1f ft=%.3f low1=%.1f hitches=%llu\n",
+                                   static_cast<unsigned long long>(stats.sequence), stats.fps,
+                                   stats.frameTimeMs, stats.low1Fps,
+                                   static_cast<unsigned long long>(stats.hitchCount));
+        if (m_log.size() + length > LOG_CAPACITY) m_log.clear();
+        m_log.append(line, length);
+    }
+
+private:
+    static const size_t LOG_CAPACITY = 64 * 1024;
+    std::string m_log;
+};
+
+// The monitor minus Win32: pipeline, governed sampler, scheduler stats task
+// and a render thread drawing into an offscreen ARGB buffer
+class Monitor {
+public:
+    Monitor(MonitorMode mode, const std::filesystem::path& capturePath)
+        : m_governor(MakeActivityConfig())
+        , m_running(false)
+        , m_statsTaskId(0)
+        , m_lastSequence(0)
+        , m_pixels(200 * 50) {
+        if (mode >= MonitorMode::CAPTURE) {
+            m_io = IoExecutor::Shared();
+            m_capture = std::make_unique<CaptureSink>(m_io, capturePath);
+            m_pipeline.AddSink(m_capture.get());
+        }
+        if (mode >= MonitorMode::ALL) {
+            m_histogram = std::make_unique<HistogramSink>();
+            m_log = std::make_unique<LogSink>();
+            m_pipeline.AddSink(m_histogram.get());
+            m_pipeline.AddSink(m_log.get());
+        }
+    }
+
+    void Start() {
+        m_running = true;
+        m_pipeline.Start();
+        m_renderThread = std::thread([this]() { RenderLoop(); });
+
+        m_statsTaskId = m_scheduler.AddPeriodic("stats", STATS_IDLE_MS, 0, [this]() { PublishStats(); });
+        m_governor.SetStateCallback([this](ActivityState state) {
+            m_scheduler.SetInterval(m_statsTaskId, state == ActivityState::ACTIVE ? STATS_ACTIVE_MS : STATS_IDLE_MS);
+        });
+        m_scheduler.Start();
+        m_samplerThread = std::thread([this]() { SamplerLoop(); });
+    }
+
+    void Stop() {
+        if (!m_running.exchange(false)) return;
+        m_governor.Wake();
+        m_samplerThread.join();
+        m_scheduler.Stop();
+        m_doorbell.Ring();
+        m_renderThread.join();
+        m_pipeline.Stop();
+        if (m_capture) {
+            m_capture->Flush();
+            m_io->Drain();
+        }
+    }
+
+    // What the present hook does for every game frame
+    void OnPresent(uint64_t timestampNs) {
+        m_pipeline.PushPresent(timestampNs, FRAME_SOURCE_HOOK);
+        m_governor.NotifyActivity(timestampNs);
+    }
+
+    uint64_t Renders() const { return m_renders.load(std::memory_order_relaxed); }
+
+private:
+    FramePipeline m_pipeline;
+    ActivityGovernor m_governor;
+    Scheduler m_scheduler;
+    std::atomic<bool> m_running;
+    uint32_t m_statsTaskId;
+    uint64_t m_lastSequence;  // Scheduler thread
+
+    TripleBuffer<FrameStats> m_snapshot;
+    Doorbell m_doorbell;
+    std::vector<uint32_t> m_pixels;  // Render thread
+    std::atomic<uint64_t> m_renders{0};
+
+    std::shared_ptr<IoExecutor> m_io;
+    std::unique_ptr<CaptureSink> m_capture;
+    std::unique_ptr<HistogramSink> m_histogram;
+    std::unique_ptr<LogSink> m_log;
+
+    std::thread m_samplerThread;
+    std::thread m_renderThread;
+
+    static ActivityConfig MakeActivityConfig() {
+        ActivityConfig config;
+        config.coolingAfterMs = 250;
+        config.idleAfterMs = 1000;
+        return config;
+    }
+
+    // FPSOverlay::UpdateWorker with the config.ini thread settings
+    void SamplerLoop() {
+        ThreadAffinity::ApplyToCurrentThread(THREAD_AFFINITY_AUTO, ThreadPriority::NORMAL);
+        FramePacer pacer(16000000ull, PacingMode::HYBRID, PACING_DEFAULT_SPIN_US);
+        pacer.Reset();
+        while (m_running.load(std::memory_order_relaxed)) {
+            ActivityState state = m_governor.Update(MonotonicNowNs());
+            if (state != ActivityState::ACTIVE) {
+                m_governor.WaitForActivity();
+                continue;
+            }
+            m_pipeline.PushPresent(MonotonicNowNs(), FRAME_SOURCE_SAMPLER);
+            pacer.Wait();
+        }
+    }
+
+    void PublishStats() {
+        FrameStats stats = m_pipeline.GetLatestStats();
+        if (stats.sequence == m_lastSequence) return;
+        m_lastSequence = stats.sequence;
+        m_snapshot.Publish(stats);
+        m_doorbell.Ring();
+    }
+
+    void RenderLoop() {
+        ThreadAffinity::ApplyToCurrentThread(THREAD_AFFINITY_AUTO, ThreadPriority::BELOW_NORMAL);
+        while (true) {
+            m_doorbell.Wait(std::chrono::milliseconds(100));
+            bool running = m_running.load();
+            if (m_snapshot.Acquire()) {
+                Draw(m_snapshot.Front());
+            } else if (!running) {
+                break;
+            }
+        }
+    }
+
+    // Stand-in for the GDI pass: format the text and fill the bitmap
+    void Draw(const FrameStats& stats) {
+        char text[64];
+        int length = std::snprintf(text, sizeof(text), "FPS: %.0f  %.2f ms", stats.fps, stats.frameTimeMs);
+        std::fill(m_pixels.begin(), m_pixels.end(), 0x80000000u);
+        for (int c = 0; c < length; ++c) {
+            uint32_t ink = 0xFF000000u | (static_cast<uint8_t>(text[c]) * 0x010101u);
+            for (size_t y = 10; y < 40; ++y) {
+                for (size_t x = 0; x < 6; ++x) {
+                    size_t column = 4 + c * 7 + x;
+                    if (column < 200) m_pixels[y * 200 + column] = ink;
+                }
+            }
+        }
+        m_renders.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+struct RunResult {
+    std::vector<uint64_t> frameNs;  // Sorted
+    uint64_t checksum = 0;
+    double wallSeconds = 0.0;
+    double gameCpuSeconds = 0.0;
+    double monitorCpuSeconds = 0.0;
+    uint64_t cacheMisses = 0;
+    uint64_t instructions = 0;
+    uint64_t renders = 0;
+};
+
+void RunGame(SyntheticGame& game, size_t frames, Monitor* monitor, bool presents, RunResult& result) {
+    ThreadCounters counters;
+    result.frameNs.resize(frames);
+    game.Reset();
+
+    double processStart = ProcessCpuSeconds();
+    double threadStart = ThreadCpuSeconds();
+    uint64_t wallStart = MonotonicNowNs();
+    counters.Start();
+
+    uint64_t checksum = 0;
+    for (size_t i = 0; i < frames; ++i) {
+        uint64_t start = MonotonicNowNs();
+        checksum += game.Frame();
+        uint64_t end = MonotonicNowNs();
+        if (presents) monitor->OnPresent(end);
+        result.frameNs[i] = end - start;
+    }
+
+    counters.Stop(result.cacheMisses, result.instructions);
+    result.wallSeconds = (MonotonicNowNs() - wallStart) / 1e9;
+    result.gameCpuSeconds = ThreadCpuSeconds() - threadStart;
+    result.monitorCpuSeconds = std::max(0.0, ProcessCpuSeconds() - processStart - result.gameCpuSeconds);
+    result.checksum = checksum;
+    std::sort(result.frameNs.begin(), result.frameNs.end());
+}
+
+double PercentileUs(const std::vector<uint64_t>& sorted, double percentile) {
+    size_t index = static_cast<size_t>(percentile / 100.0 * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)] / 1000.0;
+}
+
+double MeanUs(const std::vector<uint64_t>& values) {
+    double sum = 0.0;
+    for (uint64_t value : values) sum += value;
+    return values.empty() ? 0.0 : sum / values.size() / 1000.0;
+}
+
+double Shift(double value, double baseline) {
+    return baseline > 0.0 ? (value / baseline - 1.0) * 100.0 : 0.0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t frames = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 2000;
+    size_t bufferMB = argc > 2 ? static_cast<size_t>(std::strtoull(argv[2], nullptr, 10)) : 64;
+    uint64_t kiloOps = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 25;
+    if (frames == 0) frames = 2000;
+    if (bufferMB == 0) bufferMB = 64;
+    if (kiloOps == 0) kiloOps = 25;
+
+    // Round the buffer down to a power of two for the index mask
+    size_t bufferBytes = 1;
+    while (bufferBytes * 2 <= bufferMB * 1024 * 1024) bufferBytes *= 2;
+
+    SyntheticGame game(bufferBytes, kiloOps * 1000);
+    std::filesystem::path capturePath = std::filesystem::temp_directory_path() / "bench_observer_capture.csv";
+    std::error_code ignored;
+
+    // Warm-up: fault the buffer in and settle the CPU clock
+    RunResult warmup;
+    RunGame(game, std::min<size_t>(frames, 200), nullptr, false, warmup);
+
+    std::printf("game: %zu frames, %zu MB buffer, %llu k ops per frame, %s\n\n", frames, bufferBytes >> 20,
+                static_cast<unsigned long long>(kiloOps),
+                ThreadCounters().Available() ? "hardware counters on" : "hardware counters unavailable");
+
+    const struct {
+        const char* name;
+        MonitorMode mode;
+    } runs[] = {
+        {"baseline", MonitorMode::NONE},
+        {"idle", MonitorMode::IDLE},
+        {"overlay", MonitorMode::OVERLAY},
+        {"capture", MonitorMode::CAPTURE},
+        {"all", MonitorMode::ALL},
+    };
+
+    std::printf("%-9s %9s %9s %9s %9s %9s %8s %8s %12s %7s %11s %8s\n", "mode", "mean us", "p50 us", "p99 us",
+                "p99.9 us", "max us", "p50 +%", "p99 +%", "cache miss", "miss +%", "monitor cpu", "renders");
+
+    bool ok = true;
+    RunResult baseline;
+    for (const auto& run : runs) {
+        std::filesystem::remove(capturePath, ignored);
+
+        RunResult result;
+        if (run.mode == MonitorMode::NONE) {
+            RunGame(game, frames, nullptr, false, result);
+        } else {
+            Monitor monitor(run.mode, capturePath);
+            monitor.Start();
+            RunGame(game, frames, &monitor, run.mode >= MonitorMode::OVERLAY, result);
+            monitor.Stop();
+            result.renders = monitor.Renders();
+        }
+        if (run.mode == MonitorMode::NONE) baseline = result;
+
+        double p50 = PercentileUs(result.frameNs, 50.0);
+        double p99 = PercentileUs(result.frameNs, 99.0);
+        double baseP50 = PercentileUs(baseline.frameNs, 50.0);
+        double baseP99 = PercentileUs(baseline.frameNs, 99.0);
+        bool same = result.checksum == baseline.checksum;
+        ok &= same;
+
+        char misses[32] = "n/a";
+        char missShift[32] = "n/a";
+        if (result.instructions > 0) {
+            std::snprintf(misses, sizeof(misses), "%llu", static_cast<unsigned long long>(result.cacheMisses));
+            std::snprintf(missShift, sizeof(missShift), "%.1f",
+                          Shift(static_cast<double>(result.cacheMisses), static_cast<double>(baseline.cacheMisses)));
+        }
+        char monitorCpu[32];
+        std::snprintf(monitorCpu, sizeof(monitorCpu), "%.1f ms", result.monitorCpuSeconds * 1000.0);
+
+        std::printf("%-9s %9.0f %9.0f %9.0f %9.0f %9.0f %8.1f %8.1f %12s %7s %11s %8llu%s\n", run.name,
+                    MeanUs(result.frameNs), p50, p99, PercentileUs(result.frameNs, 99.9),
+                    result.frameNs.back() / 1000.0, Shift(p50, baseP50), Shift(p99, baseP99), misses, missShift,
+                    monitorCpu, static_cast<unsigned long long>(result.renders),
+                    same ? "" : "  CHECKSUM MISMATCH");
+    }
+
+    std::filesystem::remove(capturePath, ignored);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,289 @@
+// Overlay render benchmark and golden-image check: the whole overlay (text
+// widgets, translucent rounded panel, frame-time graph and heatmap,
+// premultiplied with per-pixel alpha) drawn by HeadlessRenderer into
+// memory, with the same widget layout, painter and damage tracking as the
+// layered window.
+//
+// Each case replays a scripted session: frames at about 240 FPS with now
+// and then a hitch, and per overlay update a set of readings (FPS, frame
+// time, lows, hitches, frame-time range) that changes every third update,
+// as a capped game's quantized reading does, shown by the case's widget
+// list. Font sizes run from 12 to 32 at 96 to 192 DPI; the bitmap font
+// makes the pixels the same on every machine.
+//
+// Checked against the golden table below, per case: the final frame's size
+// and pixel hash, and the work the session took (pixels repainted, graph
+// and heatmap columns plotted), so a render-cost regression fails like a
+// wrong pixel does. Every final frame is also compared with a full repaint
+// of itself. Reported per case: the golden values, then time per tracked
+// update and per full repaint. Exits with status 1 on any mismatch, or if
+// a session repaints more pixels or plots more columns than the golden
+// table allows; fewer is reported, for the table to be updated.
+//
+// Usage: bench_overlay_render [--update] [--dump dir] [updates]
+//   --update - print a new golden table (after an intended change)
+//   --dump   - write each case's final frame to dir/<case>.ppm
+//   updates  - timed overlay updates per case and mode (default 2000)
+
+#include "headless_renderer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int SESSION_UPDATES = 240;
+const int FRAMES_PER_UPDATE = 4;   // 240 FPS against a 60 Hz overlay
+
+struct RenderCase {
+    const char* name;
+    int fontSize;
+    int dpi;
+    const wchar_t* widgets;  // As config.ini's [Layout] Widgets
+    uint32_t textColor;
+    uint32_t backgroundColor;
+    bool showBackground;
+};
+
+const RenderCase CASES[] = {
+    {"text-12-96",        12,  96, L"fps",                    0xFF00FF00u, 0xFF000000u, true},
+    {"text-16-120",       16, 120, L"fps",                    0xFF00FF00u, 0xFF000000u, true},
+    {"text-24-144",       24, 144, L"fps",                    0xFF00FF00u, 0xFF000000u, true},
+    {"text-32-192",       32, 192, L"fps",                    0xFF00FF00u, 0xFF000000u, true},
+    {"background",        16,  96, L"fps",                    0xFFFFFFFFu, 0xFF203060u, true},
+    {"translucent",       16,  96, L"fps",                    0xFFFFFFFFu, 0x80000000u, true},
+    {"translucent-text",  16, 144, L"fps",                    0xC0FFFF00u, 0x60102040u, true},
+    {"no-background",     16,  96, L"fps",                    0xFF00FF00u, 0xFF000000u, false},
+    {"graph-16-96",       16,  96, L"fps | graph",            0xFF00FF00u, 0xFF000000u, true},
+    {"heatmap-16-144",    16, 144, L"fps | heatmap",          0xFFFF8020u, 0xFF101828u, true},
+    {"multiline-16-96",   16,  96, L"fps | low1 | low01",     0xFF00FF00u, 0xFF000000u, true},
+    {"multiline-12-192",  12, 192, L"fps | low1 | low01",     0xFFFFFF00u, 0xFF000000u, true},
+    {"row-16-120",        16, 120, L"fps frametime hitches",  0xFF00FF00u, 0x80000000u, true},
+    {"everything-20-144", 20, 144, L"fps frametime | low1 low01 | hitches range | graph | heatmap",
+                                                              0xFF00FF00u, 0x80000000u, true},
+};
+
+struct Golden {
+    const char* name;
+    int width;
+    int height;
+    uint64_t hash;
+    uint64_t dirtyPixels;
+    uint64_t plottedColumns;
+};
+
+// Regenerate with --update after an intended change to what is drawn
+const Golden GOLDEN[] = {
+    {"text-12-96", 86, 19, 0x02820bfa912eee05ull, 17618, 0},
+    {"text-16-120", 152, 28, 0x9cdcf794ed981481ull, 68192, 0},
+    {"text-24-144", 284, 46, 0x85866822e019f790ull, 268808, 0},
+    {"text-32-192", 482, 73, 0x92a9ec1174c25a80ull, 818402, 0},
+    {"background", 152, 28, 0x8051f346bb95f9a1ull, 68192, 0},
+    {"translucent", 152, 28, 0xd937d00783caa8d1ull, 68192, 0},
+    {"translucent-text", 218, 37, 0x9144ecd92ca67d36ull, 151922, 0},
+    {"no-background", 152, 28, 0x8bbbe6b699e3c701ull, 68192, 0},
+    {"graph-16-96", 180, 72, 0x8c6d5b1fa6065359ull, 1606496, 1116},
+    {"heatmap-16-144", 220, 89, 0xa707d99508aca41eull, 931436, 280},
+    {"multiline-16-96", 152, 64, 0x3e775a7e7e42b0fdull, 131984, 0},
+    {"multiline-12-192", 218, 91, 0xf5ab071be08ec1b6ull, 294914, 0},
+    {"row-16-120", 488, 28, 0x86e01b608ae5582eull, 177176, 0},
+    {"everything-20-144", 578, 187, 0x9b30bf424df25f07ull, 3150724, 1396},
+};
+
+uint32_t Noise(uint64_t value) {
+    uint32_t x = static_cast<uint32_t>(value) * 2654435761u;
+    x ^= x >> 15;
+    x *= 0x2C1B3C6Du;
+    x ^= x >> 12;
+    return x;
+}
+
+// Around 4.2 ms, now and then a hitch
+float FrameTimeFor(uint64_t frame) {
+    uint32_t noise = Noise(frame);
+    if (noise % 211 == 0) return 25.0f + static_cast<float>(noise % 40);
+    return 3.8f + static_cast<float>(noise % 80) / 100.0f;
+}
+
+// The readings the overlay shows after `update`; they move every third one
+FrameStats StatsFor(int update) {
+    uint32_t noise = Noise(static_cast<uint64_t>(update / 3) + 77);
+    FrameStats stats;
+    stats.fps = 200.0f + static_cast<float>(noise % 800) / 10.0f;
+    stats.frameTimeMs = 1000.0f / stats.fps;
+    stats.minFrameTimeMs = 3.8f;
+    stats.maxFrameTimeMs = 4.6f + static_cast<float>((noise >> 4) % 300) / 10.0f;
+    stats.low1Fps = stats.fps * 0.5f + static_cast<float>((noise >> 10) % 20);
+    stats.low01Fps = stats.low1Fps * 0.6f;
+    stats.hitchCount = static_cast<uint64_t>(update / 50);
+    return stats;
+}
+
+HeadlessRenderConfig ConfigFor(const RenderCase& renderCase) {
+    HeadlessRenderConfig config;
+    config.fontSize = renderCase.fontSize;
+    config.dpi = renderCase.dpi;
+    WidgetList::Parse(renderCase.widgets, config.widgets);
+    config.heatmapWidth = 200;
+    config.heatmapHeight = 48;
+    config.style.textColor = renderCase.textColor;
+    config.style.backgroundColor = renderCase.backgroundColor;
+    config.style.showBackground = renderCase.showBackground;
+    config.style.heatmap.sliceMs = 50.0f;
+    return config;
+}
+
+uint64_t PlottedColumns(const HeadlessRenderer& renderer) {
+    return renderer.GetPainter().GetGraphStats().plottedColumns +
+           renderer.GetPainter().GetHeatmapStats().plottedColumns;
+}
+
+struct CaseResult {
+    Golden measured;
+    bool repaintMatches = false;  // Final frame equals a full repaint of it
+    double usPerUpdate = 0.0;
+    double usPerRepaint = 0.0;
+};
+
+// Frames and readings for one update
+void Step(HeadlessRenderer& renderer, const HeadlessRenderConfig& config, int update, bool repaint) {
+    for (int i = 0; i < FRAMES_PER_UPDATE; ++i) {
+        renderer.AddFrameTime(FrameTimeFor(static_cast<uint64_t>(update) * FRAMES_PER_UPDATE + i));
+    }
+    if (repaint) renderer.Invalidate();
+    renderer.Render(StatsFor(update), config);
+}
+
+CaseResult RunCase(const RenderCase& renderCase, int updates, const char* dumpDir) {
+    HeadlessRenderConfig config = ConfigFor(renderCase);
+    HeadlessRenderer renderer;
+    CaseResult result;
+
+    // The scripted session the golden values describe
+    for (int update = 0; update < SESSION_UPDATES; ++update) {
+        Step(renderer, config, update, false);
+    }
+    result.measured.name = renderCase.name;
+    result.measured.width = renderer.GetFramebuffer().width;
+    result.measured.height = renderer.GetFramebuffer().height;
+    result.measured.hash = renderer.Hash();
+    result.measured.dirtyPixels = renderer.GetPainter().GetDamageStats().dirtyPixels;
+    result.measured.plottedColumns = PlottedColumns(renderer);
+
+    if (dumpDir) {
+        std::string path = std::string(dumpDir) + "/" + renderCase.name + ".ppm";
+        if (!renderer.WritePpm(path)) {
+            std::printf("warning: couldn't write %s\n", path.c_str());
+        }
+    }
+
+    // Same readings and columns again, every pixel repainted
+    renderer.Invalidate();
+    renderer.Render(StatsFor(SESSION_UPDATES - 1), config);
+    result.repaintMatches = renderer.Hash() == result.measured.hash;
+
+    // Timed: carry on with the session, tracked and then repainting everything
+    for (int mode = 0; mode < 2; ++mode) {
+        int first = SESSION_UPDATES + mode * updates;
+        auto start = std::chrono::steady_clock::now();
+        for (int update = first; update < first + updates; ++update) {
+            Step(renderer, config, update, mode == 1);
+        }
+        auto end = std::chrono::steady_clock::now();
+        double us = std::chrono::duration<double, std::micro>(end - start).count() / updates;
+        (mode == 0 ? result.usPerUpdate : result.usPerRepaint) = us;
+    }
+    return result;
+}
+
+const Golden* FindGolden(const char* name) {
+    for (const Golden& golden : GOLDEN) {
+        if (std::strcmp(golden.name, name) == 0) return &golden;
+    }
+    return nullptr;
+}
+
+bool Check(const Golden& measured) {
+    const Golden* golden = FindGolden(measured.name);
+    if (!golden) {
+        std::printf("FAIL: %s: no golden values\n", measured.name);
+        return false;
+    }
+
+    bool ok = true;
+    if (measured.width != golden->width || measured.height != golden->height) {
+        std::printf("FAIL: %s: %dx%d, golden %dx%d\n", measured.name, measured.width, measured.height,
+                    golden->width, golden->height);
+        ok = false;
+    } else if (measured.hash != golden->hash) {
+        std::printf("FAIL: %s: pixels differ from the golden image\n", measured.name);
+        ok = false;
+    }
+    if (measured.dirtyPixels > golden->dirtyPixels || measured.plottedColumns > golden->plottedColumns) {
+        std::printf("FAIL: %s: repainted %llu pixels and plotted %llu columns, golden %llu and %llu\n",
+                    measured.name, static_cast<unsigned long long>(measured.dirtyPixels),
+                    static_cast<unsigned long long>(measured.plottedColumns),
+                    static_cast<unsigned long long>(golden->dirtyPixels),
+                    static_cast<unsigned long long>(golden->plottedColumns));
+        ok = false;
+    } else if (measured.dirtyPixels < golden->dirtyPixels || measured.plottedColumns < golden->plottedColumns) {
+        std::printf("note: %s: cheaper than the golden table; update it with --update\n", measured.name);
+    }
+    return ok;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bool update = false;
+    const char* dumpDir = nullptr;
+    int updates = 2000;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--update") == 0) {
+            update = true;
+        } else if (std::strcmp(argv[i], "--dump") == 0 && i + 1 < argc) {
+            dumpDir = argv[++i];
+        } else {
+            updates = std::atoi(argv[i]);
+        }
+    }
+    if (updates <= 0) updates = 2000;
+
+    std::printf("Overlay render: %d scripted updates per case, then %d timed per mode\n\n", SESSION_UPDATES, updates);
+    std::printf("%-18s %9s %16s %11s %9s %10s %11s\n", "case", "size", "hash", "dirty px", "columns",
+                "update us", "repaint us");
+
+    bool ok = true;
+    std::vector<Golden> measured;
+    for (const RenderCase& renderCase : CASES) {
+        CaseResult result = RunCase(renderCase, updates, dumpDir);
+        const Golden& m = result.measured;
+        char size[24];
+        std::snprintf(size, sizeof(size), "%dx%d", m.width, m.height);
+        std::printf("%-18s %9s %016llx %11llu %9llu %10.2f %11.2f\n", m.name, size,
+                    static_cast<unsigned long long>(m.hash), static_cast<unsigned long long>(m.dirtyPixels),
+                    static_cast<unsigned long long>(m.plottedColumns), result.usPerUpdate, result.usPerRepaint);
+        measured.push_back(m);
+
+        if (!result.repaintMatches) {
+            std::printf("FAIL: %s: the tracked frame differs from a full repaint\n", m.name);
+            ok = false;
+        }
+        if (!update && !Check(m)) ok = false;
+    }
+
+    if (update) {
+        std::printf("\nconst Golden GOLDEN[] = {\n");
+        for (const Golden& m : measured) {
+            std::printf("    {\"%s\", %d, %d, 0x%016llxull, %llu, %llu},\n", m.name, m.width, m.height,
+                        static_cast<unsigned long long>(m.hash), static_cast<unsigned long long>(m.dirtyPixels),
+                        static_cast<unsigned long long>(m.plottedColumns));
+        }
+        std::printf("};\n");
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+// Sampler pacing benchmark.
+//
+// Runs a fixed-rate loop with each pacing strategy and reports wakeup
+// lateness (wake time minus deadline) and the CPU time the loop burned:
+//
+//   sleep_for - std::this_thread::sleep_for(period), the old sampler loop
+//   coarse    - PreciseTimer COARSE (absolute-deadline OS sleep)
+//   hybrid    - PreciseTimer HYBRID (OS sleep, then spin the last stretch)
+//   spin      - PreciseTimer SPIN
+//
+// The fps column is what the fallback sampler would report from those
+// wakeups; the closer to 1e9 / period, the less pacing error leaks into it.
+//
+// Exits with status 1 if the hybrid pacer, which the sampler uses by
+// default, misses a deadline or its p99 lateness reaches maxP99Us (default
+// 1000 us, about 6% of the default 62.5 Hz period). Run it on an otherwise
+// idle machine; a loaded or virtualized one can fail on scheduler noise alone.
+//
+// Usage: bench_pacing_jitter [periodUs] [iterations] [spinThresholdUs] [maxP99Us]
+
+#include "frame_types.h"
+#include "precise_timer.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <thread>
+
+namespace {
+
+struct Strategy {
+    const char* name;
+    bool useSleepFor;
+    PacingMode mode;
+};
+
+double ThreadCpuSeconds() {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+#else
+    return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+}
+
+JitterStats Run(const Strategy& strategy, uint64_t periodNs, int iterations, uint32_t spinUs) {
+    JitterMeter meter;
+    FramePacer pacer(periodNs, strategy.mode, spinUs);
+
+    double cpuStart = ThreadCpuSeconds();
+    uint64_t start = MonotonicNowNs();
+    uint64_t previous = start;
+
+    if (strategy.useSleepFor) {
+        // Relative sleeps: lateness is measured against the ideal schedule
+        // and each overshoot pushes every later deadline back
+        for (int i = 0; i < iterations; ++i) {
+            std::this_thread::sleep_for(std::chrono::nanoseconds(periodNs));
+            uint64_t now = MonotonicNowNs();
+            meter.Record(now - previous > periodNs ? now - previous - periodNs : 0);
+            previous = now;
+        }
+    } else {
+        pacer.Reset();
+        for (int i = 0; i < iterations; ++i) {
+            previous = pacer.Wait();
+        }
+    }
+
+    uint64_t elapsed = previous - start;
+    double cpu = ThreadCpuSeconds() - cpuStart;
+    JitterStats jitter = strategy.useSleepFor ? meter.GetStats() : pacer.GetJitter();
+    double fps = elapsed ? iterations * 1e9 / elapsed : 0.0;
+
+    std::printf("%-10s %9.1f %9.1f %9.1f %9.1f %7llu %9.2f %6.1f%%\n",
+                strategy.name, jitter.meanUs, jitter.p50Us, jitter.p99Us, jitter.maxUs,
+                static_cast<unsigned long long>(jitter.missedDeadlines), fps,
+                elapsed ? 100.0 * cpu / (elapsed / 1e9) : 0.0);
+    return jitter;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint64_t periodUs = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 16000;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 250;
+    uint32_t spinUs = argc > 3 ? static_cast<uint32_t>(std::atoi(argv[3])) : PACING_DEFAULT_SPIN_US;
+    double maxP99Us = argc > 4 ? std::atof(argv[4]) : 1000.0;
+    if (periodUs == 0) periodUs = 1;
+    if (iterations <= 0) iterations = 1;
+
+    std::printf("period %llu us, %d iterations, spin threshold %u us, target %.2f fps\n\n",
+                static_cast<unsigned long long>(periodUs), iterations, spinUs, 1e6 / periodUs);
+    std::printf("%-10s %9s %9s %9s %9s %7s %9s %7s\n",
+                "strategy", "mean us", "p50 us", "p99 us", "max us", "missed", "fps", "cpu");
+
+    const Strategy strategies[] = {
+        {"sleep_for", true, PacingMode::COARSE},
+        {"coarse", false, PacingMode::COARSE},
+        {"hybrid", false, PacingMode::HYBRID},
+        {"spin", false, PacingMode::SPIN},
+    };
+    bool ok = true;
+    for (const Strategy& strategy : strategies) {
+        JitterStats jitter = Run(strategy, periodUs * 1000, iterations, spinUs);
+        if (strategy.useSleepFor || strategy.mode != PacingMode::HYBRID) continue;
+
+        if (jitter.p99Us >= maxP99Us) {
+            std::printf("FAIL: hybrid p99 lateness %.1f us, limit %.1f us\n", jitter.p99Us, maxP99Us);
+            ok = false;
+        }
+        if (jitter.missedDeadlines > 0) {
+            std::printf("FAIL: hybrid missed %llu deadlines\n",
+                        static_cast<unsigned long long>(jitter.missedDeadlines));
+            ok = false;
+        }
+    }
+    return ok ? 0 : 1;
+}
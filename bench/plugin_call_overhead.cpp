@@ -0,0 +1,166 @@
+// Plugin call overhead benchmark.
+//
+// Loads the sample plugin through PluginHost, exactly as the overlay does,
+// and measures what crossing the C ABI costs:
+//
+//   sink   - the plugin's frame-summary sink against an in-process IFrameSink
+//            doing the same work, called with batches of 1, 16 and 128
+//            frames (128 = a full pipeline batch)
+//   source - presents handed to a running pipeline through
+//            FpsHostApiV1::submit_presents in groups of 1 and 64, against
+//            calling FramePipeline::PushPresent directly
+//
+// Reported: nanoseconds per call and per frame, and the per-frame overhead
+// against the in-process path. Exits with status 1 if the plugin fails to
+// load.
+//
+// Usage: bench_plugin_call_overhead [millionFrames] [pluginPath]
+//   millionFrames - frames pushed through each sink case (default 20)
+//   pluginPath    - plugin to load (default: the sample plugin built
+//                   alongside this benchmark)
+
+#include "frame_batch.h"
+#include "frame_pipeline.h"
+#include "plugin_host.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// Same work as the sample plugin's frame-summary sink
+class NativeSummary : public IFrameSink {
+public:
+    void Consume(const FrameStats&) override {}
+
+    void ConsumeBatch(const FrameBatchRef& batch) override {
+        for (size_t i = 0; i < batch->Count(); ++i) {
+            double ms = (*batch)[i].frameTime * 1000.0;
+            m_totalMs += ms;
+            if (ms > m_worstMs) m_worstMs = ms;
+        }
+        m_frames += batch->Count();
+    }
+
+    uint64_t Frames() const { return m_frames; }
+
+private:
+    uint64_t m_frames = 0;
+    double m_totalMs = 0.0;
+    double m_worstMs = 0.0;
+};
+
+FrameBatchRef MakeBatch(FrameBatchPool& pool, size_t frames) {
+    FrameBatchWriter writer(pool);
+    for (size_t i = 0; i < frames; ++i) {
+        NormalizedFrame frame;
+        frame.timestampNs = (i + 1) * 16666667ull;
+        frame.frameTime = 0.016f + (i % 7) * 0.0005f;
+        frame.sourceId = FRAME_SOURCE_HOOK;
+        writer.Append(frame);
+    }
+    return writer.Publish();
+}
+
+// Read through an atomic so the compiler can't devirtualize and fold the
+// in-process sink into the timing loop
+std::atomic<IFrameSink*> g_timedSink(nullptr);
+
+// Nanoseconds per call
+double TimeSink(IFrameSink& sink, const FrameBatchRef& batch, uint64_t calls) {
+    g_timedSink.store(&sink);
+    IFrameSink* timed = g_timedSink.load();
+    uint64_t start = MonotonicNowNs();
+    for (uint64_t i = 0; i < calls; ++i) {
+        timed->ConsumeBatch(batch);
+    }
+    return static_cast<double>(MonotonicNowNs() - start) / calls;
+}
+
+void PrintRow(const char* path, size_t batch, double nsPerCall, double baselineNsPerFrame) {
+    double nsPerFrame = nsPerCall / batch;
+    std::printf("  %-10s %6zu %12.1f %12.2f %+14.2f\n", path, batch, nsPerCall, nsPerFrame,
+                baselineNsPerFrame >= 0.0 ? nsPerFrame - baselineNsPerFrame : 0.0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint64_t millionFrames = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20;
+    const char* pluginPath = argc > 2 ? argv[2] : FPS_SAMPLE_PLUGIN_PATH;
+    if (millionFrames == 0) millionFrames = 20;
+
+    // Ask the sample for its source too, so there is a source id to submit on
+#ifdef _WIN32
+    _putenv_s("FPS_SAMPLE_PLUGIN_SOURCE_HZ", "60");
+#else
+    setenv("FPS_SAMPLE_PLUGIN_SOURCE_HZ", "60", 0);
+#endif
+
+    FramePipeline pipeline;
+    PluginHost host(pipeline);
+    host.SetLogCallback([](int level, const std::string& message) {
+        std::printf("[plugin %d] %s\n", level, message.c_str());
+    });
+    if (!host.Load(pluginPath) || host.GetSinks().empty()) {
+        std::printf("FAIL: could not load a sink from %s\n", pluginPath);
+        return 1;
+    }
+    IFrameSink* pluginSink = host.GetSinks().front();
+
+    // Sinks
+    FrameBatchPool pool(4);
+    NativeSummary native;
+    const size_t batchSizes[] = {1, 16, FRAME_BATCH_CAPACITY};
+
+    std::printf("\nsink: %llu M frames per case\n", static_cast<unsigned long long>(millionFrames));
+    std::printf("  %-10s %6s %12s %12s %14s\n", "path", "batch", "ns/call", "ns/frame", "overhead ns/fr");
+    for (size_t batchSize : batchSizes) {
+        FrameBatchRef batch = MakeBatch(pool, batchSize);
+        uint64_t calls = millionFrames * 1000000 / batchSize;
+
+        // Warm both paths before timing
+        TimeSink(native, batch, calls / 10 + 1);
+        TimeSink(*pluginSink, batch, calls / 10 + 1);
+
+        double nativeNs = TimeSink(native, batch, calls);
+        double pluginNs = TimeSink(*pluginSink, batch, calls);
+        PrintRow("in-process", batchSize, nativeNs, -1.0);
+        PrintRow("plugin", batchSize, pluginNs, nativeNs / batchSize);
+    }
+
+    // Sources: into a running pipeline, drops included (ingest is DROP)
+    const FpsHostApiV1& api = host.GetHostApi();
+    const uint64_t presents = 1000000;
+    const uint32_t groupSizes[] = {1, 64};
+    std::vector<uint64_t> timestamps(64);
+    pipeline.Start();
+
+    std::printf("\nsource: %llu presents per case\n", static_cast<unsigned long long>(presents));
+    std::printf("  %-10s %6s %12s %12s %14s\n", "path", "group", "ns/call", "ns/frame", "overhead ns/fr");
+
+    uint64_t start = MonotonicNowNs();
+    for (uint64_t i = 0; i < presents; ++i) {
+        pipeline.PushPresent(MonotonicNowNs(), FRAME_SOURCE_PLUGIN_FIRST);
+    }
+    double directNs = static_cast<double>(MonotonicNowNs() - start) / presents;
+    PrintRow("in-process", 1, directNs, -1.0);
+
+    for (uint32_t group : groupSizes) {
+        start = MonotonicNowNs();
+        for (uint64_t i = 0; i < presents; i += group) {
+            for (uint32_t j = 0; j < group; ++j) timestamps[j] = MonotonicNowNs();
+            api.submit_presents(api.host, FRAME_SOURCE_PLUGIN_FIRST, timestamps.data(), group);
+        }
+        double ns = static_cast<double>(MonotonicNowNs() - start) / (presents / group);
+        PrintRow("plugin", group, ns, directNs);
+    }
+
+    pipeline.Stop();
+    std::printf("\n");
+    host.Unload();
+    return 0;
+}
@@ -0,0 +1,211 @@
+// Render handoff benchmark.
+//
+// A producer ticks at a fixed rate (the scheduler's stats task) and each
+// snapshot has to be drawn by a renderer that occasionally stalls, the way
+// GDI does when the compositor is busy. Two arrangements:
+//
+//   inline   - the producer draws each snapshot itself (the old redraw task)
+//   threaded - the producer publishes into a TripleBuffer and a render
+//              thread draws the newest snapshot whenever it wakes
+//
+// Reported: producer tick lateness, render time and snapshot age (publish to
+// start of draw), plus how many snapshots were drawn or superseded. Every
+// drawn snapshot is checked for tearing and for going backwards; the
+// benchmark exits with status 1 if either happens.
+//
+// Usage: bench_render_handoff [seconds] [periodUs] [renderUs] [stallUs] [stallEvery]
+//   seconds    - run time per arrangement (default 3)
+//   periodUs   - producer tick period (default 4000)
+//   renderUs   - normal draw cost (default 1000)
+//   stallUs    - cost of a stalled draw (default 25000)
+//   stallEvery - every Nth draw stalls (default 50)
+
+#include "frame_types.h"
+#include "lockfree_queue.h"
+#include "precise_timer.h"
+#include "triple_buffer.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+namespace {
+
+struct Snapshot {
+    FrameStats stats;
+    uint64_t publishedNs = 0;
+};
+
+struct Options {
+    double seconds = 3.0;
+    uint64_t periodNs = 4000000;
+    uint64_t renderNs = 1000000;
+    uint64_t stallNs = 25000000;
+    uint64_t stallEvery = 50;
+};
+
+struct Result {
+    JitterStats producerLateness;  // From the producer's FramePacer
+    JitterMeter renderTime;
+    JitterMeter snapshotAge;
+    uint64_t published = 0;
+    uint64_t rendered = 0;
+    uint64_t superseded = 0;
+    bool corrupt = false;
+};
+
+// Draw stand-in: burns the configured time and validates the snapshot
+class FakeRenderer {
+public:
+    explicit FakeRenderer(const Options& options) : m_options(options), m_draws(0), m_lastSequence(0) {}
+
+    bool Draw(const Snapshot& snapshot) {
+        uint64_t cost = ++m_draws % m_options.stallEvery == 0 ? m_options.stallNs : m_options.renderNs;
+        uint64_t until = MonotonicNowNs() + cost;
+        while (MonotonicNowNs() < until) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+
+        // Producer writes the same value into every field; a mix is a tear
+        const FrameStats& stats = snapshot.stats;
+        bool consistent = stats.frameCount == stats.sequence && stats.hitchCount == stats.sequence &&
+                          stats.timestampNs == stats.sequence;
+        bool forward = stats.sequence > m_lastSequence;
+        m_lastSequence = stats.sequence;
+        return consistent && forward;
+    }
+
+private:
+    const Options& m_options;
+    uint64_t m_draws;
+    uint64_t m_lastSequence;
+};
+
+Snapshot MakeSnapshot(uint64_t sequence) {
+    Snapshot snapshot;
+    snapshot.stats.fps = 60.0f;
+    snapshot.stats.sequence = sequence;
+    snapshot.stats.frameCount = sequence;
+    snapshot.stats.hitchCount = sequence;
+    snapshot.stats.timestampNs = sequence;
+    snapshot.publishedNs = MonotonicNowNs();
+    return snapshot;
+}
+
+void RunInline(const Options& options, Result& result) {
+    FakeRenderer renderer(options);
+    FramePacer pacer(options.periodNs, PacingMode::HYBRID, PACING_DEFAULT_SPIN_US);
+    uint64_t end = MonotonicNowNs() + static_cast<uint64_t>(options.seconds * 1e9);
+
+    pacer.Reset();
+    for (uint64_t sequence = 1; MonotonicNowNs() < end; ++sequence) {
+        Snapshot snapshot = MakeSnapshot(sequence);
+        result.published++;
+
+        uint64_t start = MonotonicNowNs();
+        result.snapshotAge.Record(start - snapshot.publishedNs);
+        result.corrupt |= !renderer.Draw(snapshot);
+        result.renderTime.Record(MonotonicNowNs() - start);
+        result.rendered++;
+
+        pacer.Wait();
+    }
+
+    result.producerLateness = pacer.GetJitter();
+}
+
+void RunThreaded(const Options& options, Result& result) {
+    TripleBuffer<Snapshot> buffer;
+    Doorbell doorbell;
+    std::atomic<bool> stopping(false);
+
+    std::thread renderThread([&]() {
+        FakeRenderer renderer(options);
+        while (true) {
+            doorbell.Wait(std::chrono::microseconds(100000));
+            bool stop = stopping.load();
+            if (buffer.Acquire()) {
+                const Snapshot& snapshot = buffer.Front();
+                uint64_t start = MonotonicNowNs();
+                result.snapshotAge.Record(start - snapshot.publishedNs);
+                result.corrupt |= !renderer.Draw(snapshot);
+                result.renderTime.Record(MonotonicNowNs() - start);
+                result.rendered++;
+            } else if (stop) {
+                break;
+            }
+        }
+    });
+
+    FramePacer pacer(options.periodNs, PacingMode::HYBRID, PACING_DEFAULT_SPIN_US);
+    uint64_t end = MonotonicNowNs() + static_cast<uint64_t>(options.seconds * 1e9);
+
+    pacer.Reset();
+    for (uint64_t sequence = 1; MonotonicNowNs() < end; ++sequence) {
+        buffer.Back() = MakeSnapshot(sequence);
+        if (buffer.Publish()) {
+            result.superseded++;
+        }
+        result.published++;
+        doorbell.Ring();
+
+        pacer.Wait();
+    }
+
+    result.producerLateness = pacer.GetJitter();
+
+    stopping = true;
+    doorbell.Ring();
+    renderThread.join();
+}
+
+void PrintRow(const char* name, const JitterStats& stats) {
+    std::printf("  %-18s %10.0f %10.0f %10.0f %10.0f\n", name, stats.meanUs, stats.p50Us, stats.p99Us, stats.maxUs);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (argc > 1) options.seconds = std::atof(argv[1]);
+    if (argc > 2) options.periodNs = std::strtoull(argv[2], nullptr, 10) * 1000;
+    if (argc > 3) options.renderNs = std::strtoull(argv[3], nullptr, 10) * 1000;
+    if (argc > 4) options.stallNs = std::strtoull(argv[4], nullptr, 10) * 1000;
+    if (argc > 5) options.stallEvery = std::strtoull(argv[5], nullptr, 10);
+    if (options.seconds <= 0.0) options.seconds = 3.0;
+    if (options.periodNs == 0) options.periodNs = 4000000;
+    if (options.stallEvery == 0) options.stallEvery = 50;
+
+    std::printf("tick %.1f ms, draw %.1f ms (%.1f ms stall every %llu draws), %.1f s per arrangement\n",
+                options.periodNs / 1e6, options.renderNs / 1e6, options.stallNs / 1e6,
+                static_cast<unsigned long long>(options.stallEvery), options.seconds);
+
+    bool ok = true;
+    const struct {
+        const char* name;
+        void (*run)(const Options&, Result&);
+    } arrangements[] = {
+        {"inline", RunInline},
+        {"threaded", RunThreaded},
+    };
+
+    for (const auto& arrangement : arrangements) {
+        Result result;
+        arrangement.run(options, result);
+        ok &= !result.corrupt;
+
+        std::printf("\n%s: %llu published, %llu drawn, %llu superseded, %llu producer ticks missed%s\n",
+                    arrangement.name, static_cast<unsigned long long>(result.published),
+                    static_cast<unsigned long long>(result.rendered),
+                    static_cast<unsigned long long>(result.superseded),
+                    static_cast<unsigned long long>(result.producerLateness.missedDeadlines),
+                    result.corrupt ? ", TORN OR STALE SNAPSHOT" : "");
+        std::printf("  %-18s %10s %10s %10s %10s\n", "", "mean us", "p50 us", "p99 us", "max us");
+        PrintRow("producer lateness", result.producerLateness);
+        PrintRow("render time", result.renderTime.GetStats());
+        PrintRow("snapshot age", result.snapshotAge.GetStats());
+    }
+    return ok ? 0 : 1;
+}
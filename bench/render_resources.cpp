@@ -0,0 +1,181 @@
+// Render resource cache benchmark: what keeping the backbuffer, font and
+// brush between frames saves over building them for every draw.
+//
+// Replays an overlay session against the headless backend: the FPS text
+// changes width every frame, the config (font size, background colour)
+// changes every `configEvery` frames and the DPI changes once halfway
+// through. Each frame fetches a backbuffer of the text's size, a font and
+// a brush and writes the text area's corners (drawing itself costs the same
+// either way, so it is left out of the timing). Two ways:
+//
+//   recreate - create everything, draw, destroy everything (the old
+//              Renderer::RenderOverlay)
+//   cached   - RenderResourceCache
+//
+// Reported: time per frame, backend creations and the cache hit rate. The
+// headless backend's objects are only heap blocks, so the recreate cost
+// here is a floor for what GDI object creation costs per frame. Exits
+// with status 1 if the cache hands out a surface smaller than asked for,
+// misses more often than config/DPI changes explain, or leaks objects.
+//
+// Usage: bench_render_resources [frames] [configEvery]
+//   frames      - frames per mode (default 200000)
+//   configEvery - frames between config changes (default 20000)
+
+#include "render_resources.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace {
+
+const int BASE_FONT_SIZE = 24;
+
+struct FrameSpec {
+    int width;
+    int height;
+    int fontSize;
+    uint32_t background;
+    int dpi;
+};
+
+// Deterministic session: "FPS: 59.9" .. "FPS: 1234.5" widths, periodic
+// config changes and one DPI change
+FrameSpec SpecFor(int frame, int frames, int configEvery) {
+    FrameSpec spec;
+    int config = frame / configEvery;
+    spec.fontSize = BASE_FONT_SIZE + (config % 2) * 4;
+    spec.background = (config % 3 == 2) ? 0x202020u : 0x000000u;
+    spec.dpi = frame < frames / 2 ? 96 : 144;
+
+    int characters = 9 + (frame % 7 == 0 ? 1 : 0) + (frame % 97 == 0 ? 1 : 0);
+    int glyphWidth = spec.fontSize * spec.dpi / 96 / 2;
+    spec.width = characters * glyphWidth + 20;
+    spec.height = spec.fontSize * spec.dpi / 96 + 10;
+    return spec;
+}
+
+// Stand-in for drawing: touch the first and last pixel of the text area
+uint64_t Touch(const RenderSurface& surface, int width, int height, uint32_t color) {
+    size_t last = static_cast<size_t>(height - 1) * surface.width + width - 1;
+    surface.pixels[0] = color;
+    surface.pixels[last] = color;
+    return surface.pixels[0] + surface.pixels[last] + static_cast<uint64_t>(width) * height;
+}
+
+struct ModeResult {
+    double nsPerFrame = 0.0;
+    uint64_t creates = 0;
+    uint64_t checksum = 0;
+    bool ok = true;
+};
+
+ModeResult RunRecreate(int frames, int configEvery) {
+    HeadlessRenderBackend backend;
+    ModeResult result;
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        FrameSpec spec = SpecFor(frame, frames, configEvery);
+        RenderSurface surface;
+        backend.CreateSurface(spec.width, spec.height, surface);
+        RenderHandle font = backend.CreateFontFace(L"Consolas", spec.fontSize * spec.dpi / 96);
+        RenderHandle brush = backend.CreateBrush(spec.background);
+
+        result.checksum += Touch(surface, spec.width, spec.height, 0xFF000000u | spec.background);
+
+        backend.DestroyBrush(brush);
+        backend.DestroyFontFace(font);
+        backend.DestroySurface(surface);
+    }
+    auto end = std::chrono::steady_clock::now();
+    result.nsPerFrame = std::chrono::duration<double, std::nano>(end - start).count() / frames;
+    result.creates = backend.Creates();
+    result.ok = backend.Live() == 0;
+    return result;
+}
+
+ModeResult RunCached(int frames, int configEvery, RenderResourceStats& stats) {
+    HeadlessRenderBackend backend;
+    ModeResult result;
+    {
+        RenderResourceCache cache(backend);
+        const std::wstring fontName = L"Consolas";
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            FrameSpec spec = SpecFor(frame, frames, configEvery);
+            cache.SetDpi(spec.dpi);
+            const RenderSurface* surface = cache.Surface(spec.width, spec.height);
+            RenderHandle font = cache.Font(fontName, spec.fontSize);
+            RenderHandle brush = cache.Brush(spec.background);
+            if (!surface || !font || !brush ||
+                surface->width < spec.width || surface->height < spec.height) {
+                std::printf("FAIL: frame %d got a missing or undersized resource\n", frame);
+                result.ok = false;
+                break;
+            }
+            result.checksum += Touch(*surface, spec.width, spec.height, 0xFF000000u | spec.background);
+        }
+        auto end = std::chrono::steady_clock::now();
+        result.nsPerFrame = std::chrono::duration<double, std::nano>(end - start).count() / frames;
+        stats = cache.GetStats();
+    }
+    result.creates = backend.Creates();
+    if (backend.Live() != 0) {
+        std::printf("FAIL: %lld objects leaked by the cache\n", static_cast<long long>(backend.Live()));
+        result.ok = false;
+    }
+    return result;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int frames = argc > 1 ? std::atoi(argv[1]) : 200000;
+    int configEvery = argc > 2 ? std::atoi(argv[2]) : 20000;
+    if (frames <= 0) frames = 200000;
+    if (configEvery <= 0) configEvery = 20000;
+
+    std::printf("Render resources: %d frames, config change every %d frames, one DPI change\n\n",
+                frames, configEvery);
+
+    ModeResult recreate = RunRecreate(frames, configEvery);
+    RenderResourceStats stats;
+    ModeResult cached = RunCached(frames, configEvery, stats);
+
+    std::printf("%-10s %12s %12s\n", "mode", "ns/frame", "creates");
+    std::printf("%-10s %12.1f %12llu\n", "recreate", recreate.nsPerFrame,
+                static_cast<unsigned long long>(recreate.creates));
+    std::printf("%-10s %12.1f %12llu\n", "cached", cached.nsPerFrame,
+                static_cast<unsigned long long>(cached.creates));
+
+    double hitRate = stats.Lookups() ? static_cast<double>(stats.Hits()) / stats.Lookups() : 0.0;
+    std::printf("\ncache: %.4f%% hit rate; surface %llu/%llu, font %llu/%llu, brush %llu/%llu (hits/creates), "
+                "%llu invalidations\n",
+                hitRate * 100.0,
+                static_cast<unsigned long long>(stats.surfaceHits), static_cast<unsigned long long>(stats.surfaceCreates),
+                static_cast<unsigned long long>(stats.fontHits), static_cast<unsigned long long>(stats.fontCreates),
+                static_cast<unsigned long long>(stats.brushHits), static_cast<unsigned long long>(stats.brushCreates),
+                static_cast<unsigned long long>(stats.invalidations));
+    std::printf("speedup: %.1fx\n", cached.nsPerFrame > 0.0 ? recreate.nsPerFrame / cached.nsPerFrame : 0.0);
+
+    bool ok = recreate.ok && cached.ok;
+    if (cached.checksum != recreate.checksum) {
+        // Both touch the same pixels with the same colour every frame
+        std::printf("FAIL: cached drawing differs from the recreate path\n");
+        ok = false;
+    }
+
+    // Every config change may rebuild the font and the brush, the DPI change
+    // the font and the (taller) surface; beyond that everything must hit
+    uint64_t configChanges = static_cast<uint64_t>((frames - 1) / configEvery);
+    uint64_t allowedCreates = 3 + configChanges * 2 + 2 + 4;  // + a few surface growths
+    if (cached.creates > allowedCreates) {
+        std::printf("FAIL: %llu backend creations, expected at most %llu\n",
+                    static_cast<unsigned long long>(cached.creates),
+                    static_cast<unsigned long long>(allowedCreates));
+        ok = false;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,238 @@
+// Startup phase benchmark and config parser check.
+//
+// Times the platform-independent part of FPSOverlay::Initialize, phase by
+// phase, the old way and the new way:
+//
+//   serial   - config read one key at a time, each lookup opening and
+//              scanning the file again (what GetPrivateProfileString does),
+//              then pipeline, then plugins, one after another
+//   parallel - config parsed once into an IniFile, while a second thread
+//              builds and starts the pipeline; plugins load once the
+//              pipeline exists, as in Initialize()
+//
+// Every run is recorded on a StartupTimeline; the last run of each mode is
+// printed as a timeline and all runs are summarized as the median per phase.
+// The Win32-only phases (API probe, font catalog, window creation) are in
+// the real timeline printed by `FPSOverlay.exe --startup-bench`.
+//
+// Exits with status 1 if any key the overlay reads parses differently in
+// IniFile than in the per-key scanner.
+//
+// Usage: bench_startup_phases [runs] [configPath] [pluginDir]
+//   defaults: 50 runs, the repo's config.ini, the built sample plugin's dir
+
+#include "frame_pipeline.h"
+#include "ini_file.h"
+#include "plugin_host.h"
+#include "startup_timeline.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct IniKey {
+    const char* section;
+    const char* key;
+};
+
+// Every key ConfigManager::LoadConfig() reads, in order
+const IniKey CONFIG_KEYS[] = {
+    {"General", "Enabled"}, {"General", "UpdateInterval"},
+    {"Appearance", "Position"}, {"Appearance", "FontSize"}, {"Appearance", "FontName"},
+    {"Appearance", "OffsetX"}, {"Appearance", "OffsetY"}, {"Appearance", "ShowBackground"},
+    {"Colors", "TextColor"}, {"Colors", "BackgroundColor"},
+    {"Advanced", "MinFrameTime"},
+    {"Pipeline", "IngestPolicy"}, {"Pipeline", "NormalizePolicy"}, {"Pipeline", "SinkPolicy"},
+    {"Pipeline", "QueueCapacity"},
+    {"Pacing", "Mode"}, {"Pacing", "SpinThresholdUs"},
+    {"Activity", "IdleThrottling"}, {"Activity", "IdleAfterMs"}, {"Activity", "IdlePollMs"},
+    {"Threads", "WorkerThreads"}, {"Threads", "WorkerAffinityMask"}, {"Threads", "WorkerPriority"},
+    {"Threads", "SamplerAffinityMask"}, {"Threads", "SamplerPriority"},
+    {"Threads", "RenderAffinityMask"}, {"Threads", "RenderPriority"},
+    {"Plugins", "Enabled"}, {"Plugins", "Directory"},
+};
+
+bool EqualsNoCase(const std::string& a, const char* b) {
+    size_t i = 0;
+    for (; i < a.size() && b[i]; ++i) {
+        if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) {
+            return false;
+        }
+    }
+    return i == a.size() && !b[i];
+}
+
+std::string Trim(const std::string& str) {
+    size_t first = str.find_first_not_of(" \t\r");
+    if (first == std::string::npos) return std::string();
+    return str.substr(first, str.find_last_not_of(" \t\r") - first + 1);
+}
+
+// One GetPrivateProfileString call: open, scan to the key, close
+bool ScanForKey(const char* path, const char* section, const char* key, std::string& value) {
+    std::ifstream file(path);
+    std::string line;
+    bool inSection = false;
+    while (std::getline(file, line)) {
+        line = Trim(line);
+        if (line.empty() || line[0] == ';' || line[0] == '#') continue;
+        if (line[0] == '[') {
+            inSection = EqualsNoCase(Trim(line.substr(1, line.find(']') - 1)), section);
+            continue;
+        }
+        size_t equals = line.find('=');
+        if (inSection && equals != std::string::npos && EqualsNoCase(Trim(line.substr(0, equals)), key)) {
+            value = Trim(line.substr(equals + 1));
+            if (value.size() >= 2 && (value[0] == '"' || value[0] == '\'') && value.back() == value[0]) {
+                value = value.substr(1, value.size() - 2);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t ReadConfigPerKey(const char* path) {
+    size_t found = 0;
+    std::string value;
+    for (const IniKey& key : CONFIG_KEYS) {
+        if (ScanForKey(path, key.section, key.key, value)) ++found;
+    }
+    return found;
+}
+
+size_t ReadConfigOnce(const char* path) {
+    IniFile ini;
+    if (!ini.Load(path)) return 0;
+    size_t found = 0;
+    for (const IniKey& key : CONFIG_KEYS) {
+        if (ini.Find(key.section, key.key)) ++found;
+    }
+    return found;
+}
+
+struct Startup {
+    std::unique_ptr<FramePipeline> pipeline;
+    std::unique_ptr<PluginHost> plugins;
+
+    ~Startup() {
+        if (plugins) plugins->Unload();
+        if (pipeline) pipeline->Stop();
+    }
+};
+
+void BuildPipeline(Startup& startup) {
+    startup.pipeline = std::make_unique<FramePipeline>(PipelineConfig());
+}
+
+void LoadPlugins(Startup& startup, const char* pluginDir) {
+    startup.plugins = std::make_unique<PluginHost>(*startup.pipeline);
+    if (pluginDir && *pluginDir) startup.plugins->LoadDirectory(pluginDir);
+    startup.pipeline->Start();
+}
+
+void RunSerial(StartupTimeline& timeline, const char* configPath, const char* pluginDir) {
+    Startup startup;
+    {
+        auto phase = timeline.Phase("config");
+        ReadConfigPerKey(configPath);
+    }
+    {
+        auto phase = timeline.Phase("pipeline");
+        BuildPipeline(startup);
+    }
+    {
+        auto phase = timeline.Phase("plugins");
+        LoadPlugins(startup, pluginDir);
+    }
+}
+
+void RunParallel(StartupTimeline& timeline, const char* configPath, const char* pluginDir) {
+    Startup startup;
+    std::future<void> pipeline = std::async(std::launch::async, [&]() {
+        auto phase = timeline.Phase("pipeline");
+        BuildPipeline(startup);
+    });
+    {
+        auto phase = timeline.Phase("config");
+        ReadConfigOnce(configPath);
+    }
+    pipeline.get();
+    {
+        auto phase = timeline.Phase("plugins");
+        LoadPlugins(startup, pluginDir);
+    }
+}
+
+template <typename Run>
+void Measure(const char* mode, int runs, Run run) {
+    std::map<std::string, std::vector<double>> phaseMs;
+    std::vector<double> totalMs;
+    std::string lastTimeline;
+
+    for (int i = 0; i < runs; ++i) {
+        StartupTimeline timeline;
+        run(timeline);
+        for (const StartupPhase& phase : timeline.GetPhases()) {
+            phaseMs[phase.name].push_back((phase.endNs - phase.startNs) / 1e6);
+        }
+        totalMs.push_back(timeline.TotalNs() / 1e6);
+        if (i == runs - 1) lastTimeline = timeline.Format();
+    }
+
+    auto median = [](std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        return values[values.size() / 2];
+    };
+
+    std::printf("\n%s, last run:\n%s", mode, lastTimeline.c_str());
+    std::printf("%s, median of %d runs:\n", mode, runs);
+    for (const auto& [name, values] : phaseMs) {
+        std::printf("  %-20s %10.3f ms\n", name.c_str(), median(values));
+    }
+    std::printf("  %-20s %10.3f ms\n", "total", median(totalMs));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int runs = argc > 1 ? std::atoi(argv[1]) : 50;
+    const char* configPath = argc > 2 ? argv[2] : FPS_CONFIG_PATH;
+    const char* pluginDir = argc > 3 ? argv[3] : FPS_PLUGIN_DIR;
+    if (runs < 1) runs = 50;
+
+    // Parser check: same answer as the per-key scanner for every key
+    IniFile ini;
+    if (!ini.Load(configPath)) {
+        std::printf("FAIL: cannot read %s\n", configPath);
+        return 1;
+    }
+    int mismatches = 0;
+    for (const IniKey& key : CONFIG_KEYS) {
+        std::string scanned;
+        bool found = ScanForKey(configPath, key.section, key.key, scanned);
+        const std::string* parsed = ini.Find(key.section, key.key);
+        if (found != (parsed != nullptr) || (found && scanned != *parsed)) {
+            std::printf("FAIL: [%s] %s: scanned '%s', parsed '%s'\n", key.section, key.key,
+                        found ? scanned.c_str() : "(missing)", parsed ? parsed->c_str() : "(missing)");
+            ++mismatches;
+        }
+    }
+    std::printf("config: %zu of %zu keys present, %d mismatches (%s)\n", ReadConfigOnce(configPath),
+                sizeof(CONFIG_KEYS) / sizeof(CONFIG_KEYS[0]), mismatches, configPath);
+
+    Measure("serial", runs, [&](StartupTimeline& timeline) { RunSerial(timeline, configPath, pluginDir); });
+    Measure("parallel", runs, [&](StartupTimeline& timeline) { RunParallel(timeline, configPath, pluginDir); });
+    std::printf("\n");
+
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,136 @@
+// Stats snapshot publishing benchmark and stress check.
+//
+// One writer publishes FrameStats snapshots whose fields are all derived from
+// the same counter while N readers read continuously. Every read is checked
+// for tearing (fields from two different publishes). The same workload is then
+// run against a mutex-protected snapshot to show the writer-side contention
+// the seqlock removes.
+//
+// Usage: bench_stats_seqlock [readers] [milliseconds]
+// Exits with status 1 if any torn snapshot was observed.
+
+#include "frame_types.h"
+#include "seqlock.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+FrameStats MakeStats(uint64_t k) {
+    FrameStats stats;
+    stats.fps = static_cast<float>(k % 100000);
+    stats.frameTimeMs = static_cast<float>((k % 100000) * 2);
+    stats.minFrameTimeMs = static_cast<float>(k % 1000);
+    stats.maxFrameTimeMs = static_cast<float>(k % 1000) + 1.0f;
+    stats.low1Fps = static_cast<float>(k % 777);
+    stats.low01Fps = static_cast<float>(k % 555);
+    stats.frameCount = k;
+    stats.hitchCount = k * 3;
+    stats.sequence = k;
+    stats.timestampNs = k * 7;
+    return stats;
+}
+
+bool IsConsistent(const FrameStats& stats) {
+    uint64_t k = stats.sequence;
+    FrameStats expected = MakeStats(k);
+    return stats.fps == expected.fps &&
+           stats.frameTimeMs == expected.frameTimeMs &&
+           stats.minFrameTimeMs == expected.minFrameTimeMs &&
+           stats.maxFrameTimeMs == expected.maxFrameTimeMs &&
+           stats.low1Fps == expected.low1Fps &&
+           stats.low01Fps == expected.low01Fps &&
+           stats.frameCount == expected.frameCount &&
+           stats.hitchCount == expected.hitchCount &&
+           stats.timestampNs == expected.timestampNs;
+}
+
+struct RunResult {
+    uint64_t publishes = 0;
+    uint64_t reads = 0;
+    uint64_t torn = 0;
+    uint64_t maxPublishNs = 0;
+};
+
+template <typename Publish, typename Read>
+RunResult Run(size_t readerCount, int milliseconds, Publish publish, Read read) {
+    std::atomic<bool> running(true);
+    std::atomic<uint64_t> reads(0);
+    std::atomic<uint64_t> torn(0);
+
+    std::vector<std::thread> readers;
+    for (size_t i = 0; i < readerCount; ++i) {
+        readers.emplace_back([&]() {
+            uint64_t localReads = 0;
+            uint64_t localTorn = 0;
+            while (running.load(std::memory_order_relaxed)) {
+                FrameStats stats = read();
+                if (!IsConsistent(stats)) localTorn++;
+                localReads++;
+            }
+            reads.fetch_add(localReads);
+            torn.fetch_add(localTorn);
+        });
+    }
+
+    RunResult result;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(milliseconds);
+    uint64_t k = 1;
+    while (std::chrono::steady_clock::now() < deadline) {
+        auto start = std::chrono::steady_clock::now();
+        publish(MakeStats(k++));
+        uint64_t ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+        if (ns > result.maxPublishNs) result.maxPublishNs = ns;
+    }
+    running = false;
+    for (auto& reader : readers) reader.join();
+
+    result.publishes = k - 1;
+    result.reads = reads.load();
+    result.torn = torn.load();
+    return result;
+}
+
+void Print(const char* name, const RunResult& r, int milliseconds) {
+    double seconds = milliseconds / 1000.0;
+    std::printf("%-8s publishes/s %12.0f  reads/s %12.0f  max publish %8.2f us  torn %llu\n",
+                name, r.publishes / seconds, r.reads / seconds, r.maxPublishNs / 1000.0,
+                static_cast<unsigned long long>(r.torn));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t readerCount = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 4;
+    int milliseconds = argc > 2 ? std::atoi(argv[2]) : 1000;
+
+    std::printf("stats snapshot: 1 writer, %zu readers, %d ms per run\n\n", readerCount, milliseconds);
+
+    Seqlock<FrameStats> seqlock;
+    seqlock.Publish(MakeStats(0));
+    RunResult seq = Run(readerCount, milliseconds,
+        [&](const FrameStats& stats) { seqlock.Publish(stats); },
+        [&]() { return seqlock.Read(); });
+    Print("seqlock", seq, milliseconds);
+
+    std::mutex mutex;
+    FrameStats guarded = MakeStats(0);
+    RunResult locked = Run(readerCount, milliseconds,
+        [&](const FrameStats& stats) { std::lock_guard<std::mutex> lock(mutex); guarded = stats; },
+        [&]() { std::lock_guard<std::mutex> lock(mutex); return guarded; });
+    Print("mutex", locked, milliseconds);
+
+    if (seq.torn != 0) {
+        std::printf("\nFAILED: seqlock returned %llu torn snapshots\n",
+                    static_cast<unsigned long long>(seq.torn));
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,290 @@
+// Steady-state allocation benchmark: once Start() has returned and the
+// first frames are through, the monitor must not touch the heap.
+//
+// Runs the monitor minus Win32 (pipeline with a histogram sink, governed
+// sampler, scheduler stats/hooks/memory tasks and a render thread that
+// brings a WidgetLayout of every reading up to date like
+// Renderer::RenderOverlay) against a synthetic 240 fps present source.
+// After a warm-up it counts every global operator new on every thread
+// (AllocCounter) for the measured window and reports allocations per frame
+// and per tick. Exits with status 1 if anything allocated, or if the widgets
+// were placed more than once.
+//
+// Usage: bench_steady_alloc [seconds] [fps]
+//   seconds - measured window (default 3)
+//   fps     - synthetic present rate (default 240)
+
+#include "activity_governor.h"
+#include "alloc_counter.h"
+#include "frame_histogram.h"
+#include "frame_pipeline.h"
+#include "lockfree_queue.h"
+#include "scheduler.h"
+#include "synthetic_source.h"
+#include "triple_buffer.h"
+#include "widget_layout.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const uint32_t STATS_INTERVAL_MS = 16;
+const uint32_t HOOKS_INTERVAL_MS = 100;
+const uint32_t MEMORY_INTERVAL_MS = 250;
+const double WARMUP_SECONDS = 1.0;
+
+// Rolling frame time histogram, queried on every stats update
+class HistogramSink : public IFrameSink {
+public:
+    HistogramSink() : m_histogram(1000), m_p99Ms(0.0f) {}
+
+    void Consume(const FrameStats&) override {
+        m_p99Ms.store(m_histogram.Percentile(99.0f), std::memory_order_relaxed);
+    }
+
+    void ConsumeBatch(const FrameBatchRef& batch) override {
+        for (size_t i = 0; i < batch->Count(); ++i) {
+            m_histogram.Add((*batch)[i].frameTime * 1000.0f);
+        }
+    }
+
+    float P99Ms() const { return m_p99Ms.load(std::memory_order_relaxed); }
+
+private:
+    FrameHistogram m_histogram;
+    std::atomic<float> m_p99Ms;
+};
+
+class Monitor {
+public:
+    Monitor()
+        : m_running(false)
+        , m_lastSequence(0)
+        , m_pixels(200 * 50)
+        , m_hooksChecksum(0) {
+        m_pipeline.AddSink(&m_histogram);
+        WidgetList::Parse(L"fps frametime | low1 low01 | hitches range", m_widgetList);
+    }
+
+    bool Start() {
+        m_running = true;
+        if (!m_pipeline.Start()) return false;
+        m_renderThread = std::thread([this]() { RenderLoop(); });
+
+        // Same shape as FPSOverlay::RegisterPeriodicTasks
+        m_scheduler.AddPeriodic("stats", STATS_INTERVAL_MS, 1, [this]() { PublishStats(); });
+        m_scheduler.AddPeriodic("hooks", HOOKS_INTERVAL_MS, 5, [this]() { RefreshHooks(); });
+        m_scheduler.AddPeriodic("memory", MEMORY_INTERVAL_MS, 10, [this]() { CheckMemory(); });
+        if (!m_scheduler.Start()) return false;
+        m_samplerThread = std::thread([this]() { SamplerLoop(); });
+        return true;
+    }
+
+    void Stop() {
+        if (!m_running.exchange(false)) return;
+        m_governor.Wake();
+        m_samplerThread.join();
+        m_scheduler.Stop();
+        m_doorbell.Ring();
+        m_renderThread.join();
+        m_pipeline.Stop();
+    }
+
+    // What the present hook does for every game frame
+    void OnPresent(uint64_t timestampNs) {
+        m_pipeline.PushPresent(timestampNs, FRAME_SOURCE_HOOK);
+        m_governor.NotifyActivity(timestampNs);
+    }
+
+    uint64_t Renders() const { return m_renders.load(std::memory_order_relaxed); }
+    uint64_t SchedulerWakeups() const { return m_scheduler.GetWakeupCount(); }
+    uint64_t SamplerTicks() const { return m_samplerTicks.load(std::memory_order_relaxed); }
+    const FramePipeline& Pipeline() const { return m_pipeline; }
+    WidgetLayoutStats WidgetStats() const { return m_widgets.GetStats(); }  // Once stopped
+
+private:
+    FramePipeline m_pipeline;
+    HistogramSink m_histogram;
+    ActivityGovernor m_governor;
+    Scheduler m_scheduler;
+    std::atomic<bool> m_running;
+    uint64_t m_lastSequence;  // Scheduler thread
+
+    TripleBuffer<FrameStats> m_snapshot;
+    Doorbell m_doorbell;
+    WidgetList m_widgetList;
+    WidgetLayout m_widgets;          // Render thread
+    std::vector<uint32_t> m_pixels;  // Render thread
+    std::atomic<uint64_t> m_renders{0};
+    std::atomic<uint64_t> m_samplerTicks{0};
+    uint64_t m_hooksChecksum;        // Scheduler thread
+
+    std::thread m_samplerThread;
+    std::thread m_renderThread;
+
+    // FPSOverlay::UpdateWorker
+    void SamplerLoop() {
+        FramePacer pacer(16000000ull, PacingMode::HYBRID, PACING_DEFAULT_SPIN_US);
+        pacer.Reset();
+        while (m_running.load(std::memory_order_relaxed)) {
+            if (m_governor.Update(MonotonicNowNs()) != ActivityState::ACTIVE) {
+                m_governor.WaitForActivity();
+                continue;
+            }
+            m_pipeline.PushPresent(MonotonicNowNs(), FRAME_SOURCE_SAMPLER);
+            m_samplerTicks.fetch_add(1, std::memory_order_relaxed);
+            pacer.Wait();
+        }
+    }
+
+    // FPSOverlay::PublishDisplayStats
+    void PublishStats() {
+        FrameStats stats = m_pipeline.GetLatestStats();
+        if (stats.sequence == m_lastSequence) return;
+        m_lastSequence = stats.sequence;
+        m_snapshot.Publish(stats);
+        m_doorbell.Ring();
+    }
+
+    // HookManager::DetectGraphicsAPI: lowercase module names in place and
+    // search them, as it now does for the toolhelp snapshot
+    void RefreshHooks() {
+        static const char* const modules[] = {"KERNEL32.DLL", "USER32.dll", "D3D11.dll", "dxgi.dll"};
+        char name[32];
+        for (const char* module : modules) {
+            size_t length = std::min(std::strlen(module), sizeof(name) - 1);
+            for (size_t i = 0; i < length; ++i) {
+                name[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(module[i])));
+            }
+            name[length] = '\0';
+            m_hooksChecksum += std::strstr(name, "d3d11") ? 1 : 0;
+        }
+    }
+
+    // FPSOverlay::MonitorMemoryUsage reads a counter and compares it
+    void CheckMemory() {
+        m_hooksChecksum += m_governor.GetMetrics().doorbellWakeups & 1;
+    }
+
+    void RenderLoop() {
+        while (true) {
+            m_doorbell.Wait(std::chrono::milliseconds(100));
+            bool running = m_running.load();
+            if (m_snapshot.Acquire()) {
+                Draw(m_snapshot.Front());
+            } else if (!running) {
+                break;
+            }
+        }
+    }
+
+    // Renderer::RenderOverlay: the widgets placed once and brought up to
+    // date, then the fill
+    void Draw(const FrameStats& stats) {
+        WidgetMetrics metrics;
+        metrics.lineHeight = 20;
+        m_widgets.Configure(m_widgetList, metrics, [](const wchar_t*, int length) { return length * 7; });
+        m_widgets.Update(stats);
+
+        std::fill(m_pixels.begin(), m_pixels.end(), 0x80000000u);
+        for (int i = 0; i < m_widgets.Count(); ++i) {
+            const WidgetCell& cell = m_widgets.Cell(i);
+            for (int c = 0; c < cell.length; ++c) {
+                uint32_t ink = 0xFF000000u | (static_cast<uint8_t>(cell.text[c]) * 0x010101u);
+                size_t row = static_cast<size_t>(std::min(cell.bounds.y, 49));
+                size_t column = static_cast<size_t>(cell.bounds.x + c * 7) % 200;
+                m_pixels[row * 200 + column] = ink;
+            }
+        }
+        m_renders.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? std::atof(argv[1]) : 3.0;
+    double fps = argc > 2 ? std::atof(argv[2]) : 240.0;
+    if (seconds <= 0.0) seconds = 3.0;
+    if (fps <= 0.0) fps = 240.0;
+
+    Monitor monitor;
+    SyntheticFrameSource source([&monitor](uint64_t timestampNs) { monitor.OnPresent(timestampNs); });
+    if (!monitor.Start()) {
+        std::printf("FAIL: monitor did not start\n");
+        return 1;
+    }
+    source.Start(fps);
+
+    // Warm-up: first batches, the first stats publish and first-use statics
+    // (stdio buffers, thread-locals) all allocate once. Print before
+    // measuring so stdout's buffer exists already.
+    std::printf("Steady-state allocations: %.1f s at %.0f fps after %.1f s warm-up\n",
+                seconds, fps, WARMUP_SECONDS);
+    std::fflush(stdout);
+    std::this_thread::sleep_for(std::chrono::duration<double>(WARMUP_SECONDS));
+
+    uint64_t presentsBefore = source.Presents();
+    uint64_t rendersBefore = monitor.Renders();
+    uint64_t wakeupsBefore = monitor.SchedulerWakeups();
+    uint64_t samplerBefore = monitor.SamplerTicks();
+    AllocCounts before = AllocCounter::Get();
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+
+    AllocCounts after = AllocCounter::Get();
+    uint64_t presents = source.Presents() - presentsBefore;
+    uint64_t renders = monitor.Renders() - rendersBefore;
+    uint64_t wakeups = monitor.SchedulerWakeups() - wakeupsBefore;
+    uint64_t samplerTicks = monitor.SamplerTicks() - samplerBefore;
+
+    source.Stop();
+    monitor.Stop();
+
+    uint64_t allocations = after.allocations - before.allocations;
+    uint64_t bytes = after.bytes - before.bytes;
+    uint64_t ticks = renders + wakeups + samplerTicks;
+    PipelineMetrics metrics = monitor.Pipeline().GetMetrics();
+
+    std::printf("%-22s %12s\n", "", "count");
+    std::printf("%-22s %12llu\n", "frames presented", static_cast<unsigned long long>(presents));
+    std::printf("%-22s %12llu\n", "sampler ticks", static_cast<unsigned long long>(samplerTicks));
+    std::printf("%-22s %12llu\n", "scheduler wakeups", static_cast<unsigned long long>(wakeups));
+    std::printf("%-22s %12llu\n", "renders", static_cast<unsigned long long>(renders));
+    std::printf("%-22s %12llu\n", "allocations", static_cast<unsigned long long>(allocations));
+    std::printf("%-22s %12llu\n", "bytes allocated", static_cast<unsigned long long>(bytes));
+    std::printf("\nallocations/frame %.4f, allocations/tick %.4f\n",
+                presents ? static_cast<double>(allocations) / presents : 0.0,
+                ticks ? static_cast<double>(allocations) / ticks : 0.0);
+    WidgetLayoutStats widgets = monitor.WidgetStats();
+    std::printf("widgets: %llu placements, %llu formatted over %llu updates\n",
+                static_cast<unsigned long long>(widgets.layouts), static_cast<unsigned long long>(widgets.formats),
+                static_cast<unsigned long long>(widgets.updates));
+    std::printf("pipeline: %llu pushed, %llu dropped\n",
+                static_cast<unsigned long long>(metrics.ingest.pushed),
+                static_cast<unsigned long long>(metrics.ingest.dropped));
+
+    bool ok = true;
+    if (presents == 0 || renders == 0) {
+        std::printf("FAIL: nothing was presented or drawn during the window\n");
+        ok = false;
+    }
+    if (allocations != 0) {
+        std::printf("FAIL: %llu allocations in steady state\n", static_cast<unsigned long long>(allocations));
+        ok = false;
+    }
+    if (widgets.layouts > 1) {
+        std::printf("FAIL: widgets placed %llu times with an unchanged list\n",
+                    static_cast<unsigned long long>(widgets.layouts));
+        ok = false;
+    }
+    return ok ? 0 : 1;
+}
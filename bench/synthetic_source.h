@@ -0,0 +1,60 @@
+#pragma once
+
+// Synthetic frame source for benchmarks: a thread that "presents" at a fixed
+// rate and hands each timestamp to a callback, standing in for the D3D/GL
+// hooks on platforms where they don't exist.
+
+#include "frame_types.h"
+#include "precise_timer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+class SyntheticFrameSource {
+public:
+    using PresentFn = std::function<void(uint64_t timestampNs)>;
+
+    explicit SyntheticFrameSource(PresentFn onPresent)
+        : m_onPresent(std::move(onPresent))
+        , m_running(false)
+        , m_presents(0)
+    {
+    }
+
+    ~SyntheticFrameSource() { Stop(); }
+
+    SyntheticFrameSource(const SyntheticFrameSource&) = delete;
+    SyntheticFrameSource& operator=(const SyntheticFrameSource&) = delete;
+
+    void Start(double fps) {
+        Stop();
+        uint64_t periodNs = static_cast<uint64_t>(1e9 / (fps > 0.0 ? fps : 60.0));
+        m_running.store(true, std::memory_order_release);
+        m_thread = std::thread([this, periodNs]() {
+            FramePacer pacer(periodNs, PacingMode::HYBRID, PACING_DEFAULT_SPIN_US);
+            while (m_running.load(std::memory_order_acquire)) {
+                m_onPresent(MonotonicNowNs());
+                m_presents.fetch_add(1, std::memory_order_relaxed);
+                pacer.Wait();
+            }
+        });
+    }
+
+    void Stop() {
+        m_running.store(false, std::memory_order_release);
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    bool IsRunning() const { return m_running.load(std::memory_order_acquire); }
+    uint64_t Presents() const { return m_presents.load(std::memory_order_relaxed); }
+
+private:
+    PresentFn m_onPresent;
+    std::atomic<bool> m_running;
+    std::atomic<uint64_t> m_presents;
+    std::thread m_thread;
+};
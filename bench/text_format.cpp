@@ -0,0 +1,165 @@
+// Overlay text formatting benchmark: "FPS: xxx.x" and "1%: xxx" three ways.
+//
+//   ostream  - std::wostringstream with std::fixed/std::setprecision into a
+//              std::wstring (Renderer::FormatFPS before the running
+//              monitor went allocation-free)
+//   swprintf - swprintf into a stack buffer (Renderer::FormatFPS since)
+//   to_chars - TextFormat::Format with the layout parsed at compile time
+//              (Renderer::FormatFPS now)
+//
+// Reported: time and heap allocations per string. Before timing, the
+// to_chars output is compared with swprintf's for a sweep of readings from
+// 0 to 10000 (plus values that sit on rounding boundaries); exits with
+// status 1 if any string differs or TextFormat allocates.
+//
+// Usage: bench_text_format [iterations]
+//   iterations - strings per mode and layout (default 1000000)
+
+#include "alloc_counter.h"
+#include "text_format.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cwchar>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+namespace {
+
+const int TEXT_CAPACITY = 32;
+
+enum class Layout {
+    FPS,        // "FPS: {:.1f}"
+    PERCENTILE  // "1%: {:.0f}"
+};
+
+const char* LayoutName(Layout layout) {
+    return layout == Layout::FPS ? "FPS: {:.1f}" : "1%: {:.0f}";
+}
+
+float ReadingFor(int i) {
+    return static_cast<float>((i * 7919) % 30000) / 10.0f + 0.05f;
+}
+
+int FormatOstream(Layout layout, float value, wchar_t* out) {
+    std::wostringstream oss;
+    if (layout == Layout::FPS) {
+        oss << L"FPS: " << std::fixed << std::setprecision(1) << value;
+    } else {
+        oss << L"1%: " << std::fixed << std::setprecision(0) << value;
+    }
+    std::wstring text = oss.str();
+    size_t length = text.size() < TEXT_CAPACITY - 1 ? text.size() : TEXT_CAPACITY - 1;
+    text.copy(out, length);
+    out[length] = L'\0';
+    return static_cast<int>(length);
+}
+
+int FormatSwprintf(Layout layout, float value, wchar_t* out) {
+    if (layout == Layout::FPS) {
+        return std::swprintf(out, TEXT_CAPACITY, L"FPS: %.1f", value);
+    }
+    return std::swprintf(out, TEXT_CAPACITY, L"1%%: %.0f", value);
+}
+
+int FormatToChars(Layout layout, float value, wchar_t* out) {
+    if (layout == Layout::FPS) {
+        return TextFormat::Format<"FPS: {:.1f}">(out, TEXT_CAPACITY, value);
+    }
+    return TextFormat::Format<"1%: {:.0f}">(out, TEXT_CAPACITY, value);
+}
+
+struct ModeResult {
+    double nsPerString = 0.0;
+    double allocsPerString = 0.0;
+    uint64_t checksum = 0;
+};
+
+template <typename FormatFn>
+ModeResult Run(FormatFn format, Layout layout, int iterations) {
+    ModeResult result;
+    wchar_t text[TEXT_CAPACITY];
+    AllocCounts before = AllocCounter::Get();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        int length = format(layout, ReadingFor(i), text);
+        result.checksum += static_cast<uint64_t>(length) + static_cast<uint64_t>(text[length > 0 ? length - 1 : 0]);
+    }
+    auto end = std::chrono::steady_clock::now();
+    AllocCounts after = AllocCounter::Get();
+    result.nsPerString = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+    result.allocsPerString = static_cast<double>(after.allocations - before.allocations) / iterations;
+    return result;
+}
+
+// to_chars against swprintf; returns the number of differing strings
+int CompareOutputs(Layout layout) {
+    int mismatches = 0;
+    wchar_t expected[TEXT_CAPACITY];
+    wchar_t actual[TEXT_CAPACITY];
+    auto check = [&](float value) {
+        int expectedLength = FormatSwprintf(layout, value, expected);
+        int actualLength = FormatToChars(layout, value, actual);
+        if (expectedLength != actualLength || std::wcscmp(expected, actual) != 0) {
+            if (mismatches < 5) {
+                std::printf("  %s: %.9g -> swprintf \"%ls\", to_chars \"%ls\"\n", LayoutName(layout),
+                            static_cast<double>(value), expected, actual);
+            }
+            ++mismatches;
+        }
+    };
+
+    for (int i = 0; i <= 200000; ++i) {
+        check(static_cast<float>(i) / 20.0f);            // Steps of 0.05: halfway cases
+        check(static_cast<float>(i) * 0.05f + 0.0001f);
+    }
+    const float edges[] = {0.0f, -0.0f, 0.04999f, 0.05f, 0.95f, 9.95f, 59.95f, 99.95f, 144.05f, 999.95f,
+                           0.5f, 1.5f, 2.5f, -1.25f, 1e6f, 123456.7f};
+    for (float value : edges) {
+        check(value);
+    }
+    return mismatches;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    if (iterations <= 0) iterations = 1000000;
+
+    std::printf("Text formatting: %d strings per mode and layout\n\n", iterations);
+
+    bool ok = true;
+    const Layout layouts[] = {Layout::FPS, Layout::PERCENTILE};
+    for (Layout layout : layouts) {
+        int mismatches = CompareOutputs(layout);
+        if (mismatches > 0) {
+            std::printf("FAIL: %s: %d strings differ from swprintf\n", LayoutName(layout), mismatches);
+            ok = false;
+        }
+    }
+
+    std::printf("%-13s %-9s %12s %14s\n", "layout", "mode", "ns/string", "allocs/string");
+    for (Layout layout : layouts) {
+        ModeResult ostream = Run(FormatOstream, layout, iterations);
+        ModeResult formatted = Run(FormatSwprintf, layout, iterations);
+        ModeResult toChars = Run(FormatToChars, layout, iterations);
+
+        std::printf("%-13s %-9s %12.1f %14.2f\n", LayoutName(layout), "ostream", ostream.nsPerString,
+                    ostream.allocsPerString);
+        std::printf("%-13s %-9s %12.1f %14.2f\n", "", "swprintf", formatted.nsPerString, formatted.allocsPerString);
+        std::printf("%-13s %-9s %12.1f %14.2f\n", "", "to_chars", toChars.nsPerString, toChars.allocsPerString);
+
+        if (toChars.allocsPerString != 0.0) {
+            std::printf("FAIL: %s: TextFormat allocated\n", LayoutName(layout));
+            ok = false;
+        }
+        if (toChars.checksum != formatted.checksum || ostream.checksum != formatted.checksum) {
+            std::printf("FAIL: %s: modes formatted the benchmark readings differently\n", LayoutName(layout));
+            ok = false;
+        }
+    }
+    return ok ? 0 : 1;
+}
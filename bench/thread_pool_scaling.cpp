@@ -0,0 +1,153 @@
+// Work-stealing pool scaling benchmark.
+//
+// Builds an in-memory capture of normalized frames (16 bytes each) and runs
+// the kind of offline analysis the pool is meant for over it with
+// ParallelFor: frame-time histogram, min/max/mean and hitch count. The pass
+// is timed with 1..N workers and checked against a single-threaded pass.
+//
+// Usage: bench_thread_pool_scaling [captureGB] [maxWorkers] [passes]
+//   captureGB  - size of the synthetic capture (default 2)
+//   maxWorkers - highest worker count to try (default: hardware threads)
+//   passes     - timed passes per worker count, best is reported (default 3)
+// Exits with status 1 if any parallel result differs from the serial one.
+
+#include "frame_histogram.h"
+#include "frame_types.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct CaptureSummary {
+    std::vector<uint64_t> buckets;
+    uint64_t frames = 0;
+    uint64_t hitches = 0;
+    double totalMs = 0.0;
+    float minMs = 1e9f;
+    float maxMs = 0.0f;
+
+    CaptureSummary() : buckets(HISTOGRAM_BUCKET_COUNT, 0) {}
+
+    void Merge(const CaptureSummary& other) {
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            buckets[i] += other.buckets[i];
+        }
+        frames += other.frames;
+        hitches += other.hitches;
+        totalMs += other.totalMs;
+        minMs = std::min(minMs, other.minMs);
+        maxMs = std::max(maxMs, other.maxMs);
+    }
+
+    bool operator==(const CaptureSummary& other) const {
+        // totalMs is summed in a different order; compare it loosely
+        double tolerance = 1e-6 * std::max(1.0, totalMs);
+        return buckets == other.buckets && frames == other.frames && hitches == other.hitches &&
+               minMs == other.minMs && maxMs == other.maxMs &&
+               (totalMs - other.totalMs <= tolerance && other.totalMs - totalMs <= tolerance);
+    }
+};
+
+// Frame times around 60 fps with periodic hitches and some jitter
+std::vector<NormalizedFrame> BuildCapture(size_t frameCount) {
+    std::vector<NormalizedFrame> capture(frameCount);
+    uint64_t timestamp = 0;
+    uint32_t rng = 12345;
+    for (size_t i = 0; i < frameCount; ++i) {
+        rng = rng * 1664525u + 1013904223u;
+        float ms = 16.0f + static_cast<float>(rng >> 24) / 64.0f;
+        if (i % 997 == 0) ms *= 4.0f;
+
+        timestamp += static_cast<uint64_t>(ms * 1e6f);
+        capture[i].timestampNs = timestamp;
+        capture[i].frameTime = ms / 1000.0f;
+        capture[i].sourceId = FRAME_SOURCE_HOOK;
+    }
+    return capture;
+}
+
+void Analyze(const NormalizedFrame* frames, size_t count, CaptureSummary& summary) {
+    for (size_t i = 0; i < count; ++i) {
+        float ms = frames[i].frameTime * 1000.0f;
+        summary.buckets[FrameHistogram::BucketForMs(ms)]++;
+        summary.totalMs += ms;
+        summary.minMs = std::min(summary.minMs, ms);
+        summary.maxMs = std::max(summary.maxMs, ms);
+        if (ms > 40.0f) summary.hitches++;
+    }
+    summary.frames += count;
+}
+
+CaptureSummary AnalyzeParallel(WorkStealingPool& pool, const std::vector<NormalizedFrame>& capture) {
+    CaptureSummary total;
+    std::mutex mutex;
+    pool.ParallelFor(0, capture.size(), 1 << 16, [&](size_t begin, size_t end) {
+        CaptureSummary partial;
+        Analyze(capture.data() + begin, end - begin, partial);
+        std::lock_guard<std::mutex> lock(mutex);
+        total.Merge(partial);
+    });
+    return total;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    double captureGB = argc > 1 ? std::atof(argv[1]) : 2.0;
+    size_t maxWorkers = argc > 2 ? static_cast<size_t>(std::atoi(argv[2])) : 0;
+    int passes = argc > 3 ? std::atoi(argv[3]) : 3;
+    if (captureGB <= 0.0) captureGB = 2.0;
+    if (maxWorkers == 0) maxWorkers = std::max(1u, std::thread::hardware_concurrency());
+    if (passes <= 0) passes = 1;
+
+    size_t frameCount = static_cast<size_t>(captureGB * (1ull << 30) / sizeof(NormalizedFrame));
+    std::printf("capture: %zu frames, %.2f GB\n", frameCount,
+                frameCount * sizeof(NormalizedFrame) / double(1ull << 30));
+    std::vector<NormalizedFrame> capture = BuildCapture(frameCount);
+
+    // Serial reference
+    auto serialStart = std::chrono::steady_clock::now();
+    CaptureSummary reference;
+    Analyze(capture.data(), capture.size(), reference);
+    double serialSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - serialStart).count();
+    std::printf("serial: %.3f s, %.2f GB/s, %llu hitches\n\n", serialSec,
+                frameCount * sizeof(NormalizedFrame) / serialSec / 1e9,
+                static_cast<unsigned long long>(reference.hitches));
+
+    std::printf("%8s %10s %10s %9s %10s\n", "workers", "seconds", "GB/s", "speedup", "stolen");
+    bool ok = true;
+    // Powers of two up to the maximum, plus the maximum itself
+    std::vector<size_t> workerCounts;
+    for (size_t workers = 1; workers < maxWorkers; workers *= 2) {
+        workerCounts.push_back(workers);
+    }
+    workerCounts.push_back(maxWorkers);
+
+    for (size_t workers : workerCounts) {
+        WorkStealingPool pool(workers);
+
+        double best = 1e30;
+        for (int pass = 0; pass < passes; ++pass) {
+            auto start = std::chrono::steady_clock::now();
+            CaptureSummary summary = AnalyzeParallel(pool, capture);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            best = std::min(best, seconds);
+            if (!(summary == reference)) {
+                std::printf("MISMATCH with %zu workers\n", workers);
+                ok = false;
+            }
+        }
+
+        std::printf("%8zu %10.3f %10.2f %8.2fx %10llu\n", workers, best,
+                    frameCount * sizeof(NormalizedFrame) / best / 1e9, serialSec / best,
+                    static_cast<unsigned long long>(pool.GetStats().stolen));
+    }
+    return ok ? 0 : 1;
+}
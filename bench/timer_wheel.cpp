@@ -0,0 +1,334 @@
+// Timer wheel and scheduler check.
+//
+// Drives a TimerWheel and a Scheduler on a fake clock, so every result is
+// exact and the same on every run:
+//
+//   wheel     - timers spread over all four levels and past the wheel's
+//               range, inserted as time moves and advanced in steps of every
+//               size: each fires exactly once, in the Advance() that passes
+//               its expiry, in expiry order, and NextExpiry() always names
+//               the earliest pending one
+//   overdue   - expiries at or before the current tick fire on the next
+//               Advance() without time moving
+//   coalesce  - tasks run on their deadlines, in registration order within a
+//               tick, and tasks whose slack windows overlap share wakeups
+//   lateness  - a clock jump runs a task once, late by exactly the jump, and
+//               skips the periods it missed instead of replaying them
+//   cancel    - cancelled and re-timed entries never fire, including when an
+//               earlier task cancels or re-times one due in the same tick;
+//               re-timing to the same period leaves the schedule alone
+//   far       - 5 and 90 minute tasks, which cascade down from levels 2 and
+//               3, fire on the exact tick
+//
+// Exits with status 1 if any check fails.
+//
+// Usage: bench_timer_wheel [timers] [seed]
+
+#include "scheduler.h"
+#include "timer_wheel.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+// One task run: fake clock tick and task id
+struct Run {
+    uint64_t tick;
+    uint32_t id;
+
+    bool operator==(const Run& other) const { return tick == other.tick && id == other.id; }
+};
+
+// Step the fake clock a tick at a time, running what's due at each
+void RunUntil(Scheduler& scheduler, uint64_t& clockMs, uint64_t untilMs) {
+    while (clockMs < untilMs) {
+        clockMs++;
+        scheduler.RunDue();
+    }
+}
+
+bool ExpectRuns(const char* check, const std::vector<Run>& runs, const std::vector<Run>& expected) {
+    for (size_t i = 0; i < runs.size() || i < expected.size(); ++i) {
+        if (i < runs.size() && i < expected.size() && runs[i] == expected[i]) continue;
+        std::printf("FAIL: %s: run %zu is ", check, i);
+        if (i < runs.size()) {
+            std::printf("task %u at %llu", runs[i].id, static_cast<unsigned long long>(runs[i].tick));
+        } else {
+            std::printf("missing");
+        }
+        if (i < expected.size()) {
+            std::printf(", expected task %u at %llu\n", expected[i].id,
+                        static_cast<unsigned long long>(expected[i].tick));
+        } else {
+            std::printf(", expected none\n");
+        }
+        return false;
+    }
+    return true;
+}
+
+bool CheckWheel(size_t timers, uint32_t seed) {
+    // Delta bands: level 0, 1, 2, 3 and past the wheel's range
+    static const uint64_t bands[] = {1, 1ull << 8, 1ull << 14, 1ull << 20, 1ull << 26, 1ull << 27};
+
+    std::mt19937_64 rng(seed);
+    uint64_t now = 12345;  // Off every level's slot boundary
+    TimerWheel wheel(now);
+
+    std::vector<uint64_t> expiries;
+    std::vector<bool> fired;
+    std::multiset<uint64_t> pending;
+    auto insert = [&]() {
+        size_t band = rng() % 5;
+        TimerEntry entry;
+        entry.id = static_cast<uint32_t>(expiries.size());
+        entry.expiry = now + bands[band] + rng() % (bands[band + 1] - bands[band]);
+        wheel.Insert(entry);
+        expiries.push_back(entry.expiry);
+        fired.push_back(false);
+        pending.insert(entry.expiry);
+    };
+    for (size_t i = 0; i < timers / 2; ++i) insert();
+
+    std::vector<TimerEntry> expired;
+    size_t advances = 0;
+    while (!pending.empty() || expiries.size() < timers) {
+        if (expiries.size() < timers && rng() % 2 == 0) insert();
+
+        uint64_t earliest = pending.empty() ? UINT64_MAX : *pending.begin();
+        if (wheel.NextExpiry() != earliest || wheel.Size() != pending.size()) {
+            std::printf("FAIL: wheel: at tick %llu NextExpiry() %llu and Size() %zu, expected %llu and %zu\n",
+                        static_cast<unsigned long long>(now),
+                        static_cast<unsigned long long>(wheel.NextExpiry()), wheel.Size(),
+                        static_cast<unsigned long long>(earliest), pending.size());
+            return false;
+        }
+        if (pending.empty()) continue;
+
+        // Land on, just before and just past the next expiry, or anywhere
+        uint64_t target;
+        switch (rng() % 4) {
+        case 0: target = earliest; break;
+        case 1: target = earliest > now + 1 ? earliest - 1 : earliest; break;
+        case 2: target = now + 1 + rng() % 300; break;
+        default: target = now + 1 + rng() % (1ull << 16); break;
+        }
+
+        expired.clear();
+        wheel.Advance(target, expired);
+        advances++;
+
+        uint64_t previous = 0;
+        for (const TimerEntry& entry : expired) {
+            if (entry.expiry != expiries[entry.id] || fired[entry.id] ||
+                entry.expiry <= now || entry.expiry > target || entry.expiry < previous) {
+                std::printf("FAIL: wheel: timer %u (expiry %llu) fired by Advance(%llu -> %llu)%s\n",
+                            entry.id, static_cast<unsigned long long>(expiries[entry.id]),
+                            static_cast<unsigned long long>(now), static_cast<unsigned long long>(target),
+                            fired[entry.id] ? " a second time" : entry.expiry < previous ? " out of order" : "");
+                return false;
+            }
+            fired[entry.id] = true;
+            pending.erase(pending.find(entry.expiry));
+            previous = entry.expiry;
+        }
+        if (!pending.empty() && *pending.begin() <= target) {
+            std::printf("FAIL: wheel: a timer expiring at %llu did not fire by Advance(%llu)\n",
+                        static_cast<unsigned long long>(*pending.begin()),
+                        static_cast<unsigned long long>(target));
+            return false;
+        }
+        now = target;
+    }
+
+    std::printf("%-10s ok: %zu timers over %zu advances\n", "wheel", timers, advances);
+    return true;
+}
+
+bool CheckOverdue() {
+    TimerWheel wheel(1000);
+    std::vector<TimerEntry> expired;
+    wheel.Advance(1500, expired);  // Empty: just moves time
+
+    TimerEntry late;
+    late.id = 1;
+    late.expiry = 1200;
+    TimerEntry current;
+    current.id = 2;
+    current.expiry = 1500;
+    wheel.Insert(late);
+    wheel.Insert(current);
+
+    if (wheel.NextExpiry() != 1500) {
+        std::printf("FAIL: overdue: NextExpiry() %llu, expected the current tick 1500\n",
+                    static_cast<unsigned long long>(wheel.NextExpiry()));
+        return false;
+    }
+    wheel.Advance(1500, expired);
+    if (expired.size() != 2 || wheel.Size() != 0 || wheel.NextExpiry() != UINT64_MAX) {
+        std::printf("FAIL: overdue: %zu of 2 overdue timers fired\n", expired.size());
+        return false;
+    }
+
+    std::printf("%-10s ok\n", "overdue");
+    return true;
+}
+
+bool CheckCoalescing() {
+    uint64_t clockMs = 0;
+    Scheduler scheduler([&clockMs]() { return clockMs * 1000000ull; });
+    if (scheduler.Start()) {
+        std::printf("FAIL: coalesce: Start() accepted a fake clock\n");
+        scheduler.Stop();
+        return false;
+    }
+
+    std::vector<Run> runs;
+    auto record = [&](uint32_t id) { return [&runs, &clockMs, id]() { runs.push_back({clockMs, id}); }; };
+    scheduler.AddPeriodic("stats", 100, 1, record(0));
+    scheduler.AddPeriodic("flush", 1000, 50, record(1));
+    scheduler.AddPeriodic("probe", 5000, 50, record(2));
+    // Nominally every 970 ms, but flush's booking is within its slack
+    scheduler.AddPeriodic("tick", 970, 50, record(3));
+    RunUntil(scheduler, clockMs, 5000);
+
+    std::vector<Run> expected;
+    for (uint64_t tick = 100; tick <= 5000; tick += 100) {
+        expected.push_back({tick, 0});
+        if (tick % 1000 == 0) expected.push_back({tick, 1});
+        if (tick == 5000) expected.push_back({tick, 2});
+        if (tick % 1000 == 0) expected.push_back({tick, 3});
+    }
+    if (!ExpectRuns("coalesce", runs, expected)) return false;
+
+    for (const ScheduledTaskStats& stats : scheduler.GetTaskStats()) {
+        if (stats.name != "tick" && stats.maxLatenessNs != 0) {
+            std::printf("FAIL: coalesce: %s ran %llu ns late on a stepped clock\n", stats.name.c_str(),
+                        static_cast<unsigned long long>(stats.maxLatenessNs));
+            return false;
+        }
+    }
+
+    std::printf("%-10s ok: %zu runs on 50 wakeup ticks\n", "coalesce", runs.size());
+    return true;
+}
+
+bool CheckLateness() {
+    uint64_t clockMs = 0;
+    Scheduler scheduler([&clockMs]() { return clockMs * 1000000ull; });
+
+    std::vector<Run> runs;
+    scheduler.AddPeriodic("sample", 10, 1, [&]() { runs.push_back({clockMs, 0}); });
+    RunUntil(scheduler, clockMs, 30);
+
+    // Stall: the tick due at 40 runs once at 75; 50, 60 and 70 are skipped
+    clockMs = 75;
+    scheduler.RunDue();
+    RunUntil(scheduler, clockMs, 100);
+
+    std::vector<Run> expected = {{10, 0}, {20, 0}, {30, 0}, {75, 0}, {80, 0}, {90, 0}, {100, 0}};
+    if (!ExpectRuns("lateness", runs, expected)) return false;
+
+    ScheduledTaskStats stats = scheduler.GetTaskStats().at(0);
+    if (stats.runs != expected.size() || stats.maxLatenessNs != 35000000ull ||
+        stats.totalLatenessNs != 35000000ull) {
+        std::printf("FAIL: lateness: %llu runs, max %llu ns, total %llu ns; expected %zu runs, 35 ms both\n",
+                    static_cast<unsigned long long>(stats.runs),
+                    static_cast<unsigned long long>(stats.maxLatenessNs),
+                    static_cast<unsigned long long>(stats.totalLatenessNs), expected.size());
+        return false;
+    }
+
+    std::printf("%-10s ok: one run 35 ms late, 3 periods skipped\n", "lateness");
+    return true;
+}
+
+bool CheckCancel() {
+    uint64_t clockMs = 0;
+    Scheduler scheduler([&clockMs]() { return clockMs * 1000000ull; });
+
+    std::vector<Run> runs;
+    uint32_t b = 0;
+    uint32_t c = 0;
+    // A cancels B and re-times C from inside its own run, in ticks where
+    // both are due after it
+    uint32_t a = scheduler.AddPeriodic("a", 10, 1, [&]() {
+        runs.push_back({clockMs, 0});
+        if (clockMs == 50) scheduler.Cancel(b);
+        if (clockMs == 100) scheduler.SetInterval(c, 40);
+    });
+    b = scheduler.AddPeriodic("b", 10, 1, [&]() { runs.push_back({clockMs, 1}); });
+    c = scheduler.AddPeriodic("c", 100, 1, [&]() { runs.push_back({clockMs, 2}); });
+
+    RunUntil(scheduler, clockMs, 130);
+    scheduler.SetInterval(a, 25);  // Entry for 140 goes stale; next at 155
+    RunUntil(scheduler, clockMs, 160);
+    scheduler.SetInterval(a, 25);  // Unchanged: must not move 180
+    RunUntil(scheduler, clockMs, 200);
+    scheduler.Cancel(c);           // Entry for 220 must not fire
+    RunUntil(scheduler, clockMs, 300);
+
+    std::vector<Run> expected;
+    for (uint64_t tick = 10; tick <= 130; tick += 10) {
+        expected.push_back({tick, 0});
+        if (tick < 50) expected.push_back({tick, 1});
+    }
+    expected.push_back({140, 2});
+    expected.push_back({155, 0});
+    expected.push_back({180, 0});
+    expected.push_back({180, 2});
+    for (uint64_t tick = 205; tick <= 300; tick += 25) expected.push_back({tick, 0});
+    if (!ExpectRuns("cancel", runs, expected)) return false;
+
+    if (scheduler.GetTaskStats().size() != 1) {
+        std::printf("FAIL: cancel: %zu tasks still listed, expected 1\n", scheduler.GetTaskStats().size());
+        return false;
+    }
+
+    std::printf("%-10s ok: %zu runs, no cancelled or stale entry fired\n", "cancel", runs.size());
+    return true;
+}
+
+bool CheckFar() {
+    const uint64_t start = 123457;  // Off every level's slot boundary
+    uint64_t clockMs = start;
+    Scheduler scheduler([&clockMs]() { return clockMs * 1000000ull; });
+
+    std::vector<Run> runs;
+    scheduler.AddPeriodic("5 min", 300000, 1, [&]() { runs.push_back({clockMs, 0}); });
+    scheduler.AddPeriodic("90 min", 5400000, 1, [&]() { runs.push_back({clockMs, 1}); });
+    RunUntil(scheduler, clockMs, start + 5400000);
+
+    std::vector<Run> expected;
+    for (uint64_t tick = start + 300000; tick <= start + 5400000; tick += 300000) {
+        expected.push_back({tick, 0});
+    }
+    expected.push_back({start + 5400000, 1});
+    if (!ExpectRuns("far", runs, expected)) return false;
+
+    std::printf("%-10s ok: %zu runs over 90 minutes of ticks\n", "far", runs.size());
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t timers = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 4000;
+    uint32_t seed = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 1;
+    if (timers == 0) timers = 4000;
+
+    std::printf("timer wheel check: %zu timers, seed %u\n\n", timers, seed);
+
+    bool ok = true;
+    ok = CheckWheel(timers, seed) && ok;
+    ok = CheckOverdue() && ok;
+    ok = CheckCoalescing() && ok;
+    ok = CheckLateness() && ok;
+    ok = CheckCancel() && ok;
+    ok = CheckFar() && ok;
+    return ok ? 0 : 1;
+}
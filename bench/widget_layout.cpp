@@ -0,0 +1,210 @@
+// Widget layout benchmark: the per-frame cost of the retained overlay
+// layout with one widget vs ten, drawn by HeadlessRenderer with the same
+// WidgetLayout, painter and damage tracking as the layered window.
+//
+// Per widget list (the FPS alone, five readings, ten widgets with the graph
+// and heatmap) at 16 and 24 pixels, times a frame where
+//
+//   steady  - no reading changed (a capped game between quantized values)
+//   one     - only the FPS changed
+//   all     - every reading changed
+//   repaint - every reading changed and everything is repainted and
+//             formatted again, as a draw without retained state does
+//
+// and reports the pixels repainted per "one" frame. The graph and heatmap
+// get no new frame times here, so only the widgets' own cost is timed.
+//
+// Exits with status 1 if a widget list doesn't survive Parse() and
+// ToString(), a bad one is accepted, the widgets are placed more than once
+// while the readings change, a steady frame formats or repaints anything,
+// a "one" frame formats more than the FPS or repaints more pixels than the
+// single widget's does, the overlay's size moves with a reading, or a
+// tracked frame differs from a full repaint of it.
+//
+// Usage: bench_widget_layout [frames]
+//   frames - timed frames per list, size and mode (default 20000)
+
+#include "headless_renderer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace {
+
+struct LayoutCase {
+    const char* name;
+    const wchar_t* widgets;  // As config.ini's [Layout] Widgets
+};
+
+const LayoutCase CASES[] = {
+    {"fps",   L"fps"},
+    {"five",  L"fps frametime | low1 low01 | hitches"},
+    {"ten",   L"fps frametime | low1 low01 | hitches range | low1 low01 | graph | heatmap"},
+};
+
+const int FONT_SIZES[] = {16, 24};
+
+// Round trip: what ToString() gives back for each
+const wchar_t* const GOOD_LISTS[][2] = {
+    {L"fps", L"fps"},
+    {L"FPS, FrameTime|graph", L"fps frametime | graph"},
+    {L"  fps  low1 low01 |hitches range|| heatmap ", L"fps low1 low01 | hitches range | heatmap"},
+};
+
+const wchar_t* const BAD_LISTS[] = {
+    L"",
+    L" | ",
+    L"fps bogus",
+    L"fps fps fps fps fps fps fps fps fps fps fps fps fps fps fps fps fps",
+};
+
+// The FPS and the other readings each move by a step their widgets show,
+// or stay put
+FrameStats StatsFor(int frame, bool fpsMoves, bool othersMove) {
+    FrameStats stats;
+    float fpsStep = fpsMoves ? static_cast<float>(frame % 500) / 10.0f : 0.0f;
+    float step = othersMove ? static_cast<float>(frame % 97) : 0.0f;
+    stats.fps = 120.0f + fpsStep;
+    stats.frameTimeMs = 8.0f + step / 100.0f;
+    stats.minFrameTimeMs = 4.0f + step / 10.0f;
+    stats.maxFrameTimeMs = 20.0f + step / 10.0f;
+    stats.low1Fps = 90.0f + step;
+    stats.low01Fps = 60.0f + step;
+    stats.hitchCount = static_cast<uint64_t>(step);
+    return stats;
+}
+
+enum class Mode { STEADY, ONE, ALL, REPAINT };
+
+struct ModeResult {
+    double us = 0.0;
+    uint64_t formats = 0;
+    uint64_t dirtyPixels = 0;
+    bool sizeMoved = false;
+};
+
+ModeResult RunMode(HeadlessRenderer& renderer, const HeadlessRenderConfig& config, Mode mode, int frames) {
+    // First frame of the mode sets its baseline
+    renderer.Render(StatsFor(0, mode != Mode::STEADY, mode == Mode::ALL || mode == Mode::REPAINT), config);
+    int width = renderer.GetFramebuffer().width;
+    int height = renderer.GetFramebuffer().height;
+    WidgetLayoutStats widgetsBefore = renderer.GetLayout().GetStats();
+    DamageStats damageBefore = renderer.GetPainter().GetDamageStats();
+
+    ModeResult result;
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 1; frame <= frames; ++frame) {
+        bool fpsMoves = mode != Mode::STEADY;
+        bool othersMove = mode == Mode::ALL || mode == Mode::REPAINT;
+        if (mode == Mode::REPAINT) renderer.Invalidate();
+        renderer.Render(StatsFor(frame, fpsMoves, othersMove), config);
+        result.sizeMoved |= renderer.GetFramebuffer().width != width || renderer.GetFramebuffer().height != height;
+    }
+    auto end = std::chrono::steady_clock::now();
+    result.us = std::chrono::duration<double, std::micro>(end - start).count() / frames;
+
+    WidgetLayoutStats widgets = renderer.GetLayout().GetStats();
+    result.formats = widgets.formats - widgetsBefore.formats;
+    result.dirtyPixels = renderer.GetPainter().GetDamageStats().dirtyPixels - damageBefore.dirtyPixels;
+    return result;
+}
+
+bool ListsOk() {
+    bool ok = true;
+    for (const auto& list : GOOD_LISTS) {
+        WidgetList parsed;
+        std::wstring text = WidgetList::Parse(list[0], parsed) ? parsed.ToString() : L"(rejected)";
+        WidgetList again;
+        if (text != list[1] || !WidgetList::Parse(text, again) || !(again == parsed)) {
+            std::printf("FAIL: widget list \"%ls\" came back as \"%ls\"\n", list[0], text.c_str());
+            ok = false;
+        }
+    }
+    for (const wchar_t* list : BAD_LISTS) {
+        WidgetList parsed;
+        if (WidgetList::Parse(list, parsed) || !(parsed == WidgetList())) {
+            std::printf("FAIL: widget list \"%ls\" was accepted\n", list);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int frames = argc > 1 ? std::atoi(argv[1]) : 20000;
+    if (frames <= 0) frames = 20000;
+
+    std::printf("Widget layout: %d frames per list, size and mode\n\n", frames);
+    bool ok = ListsOk();
+
+    std::printf("%-6s %4s %8s %9s %9s %9s %10s %11s\n", "list", "font", "size", "steady us", "one us", "all us",
+                "repaint us", "one px/frm");
+    for (int fontSize : FONT_SIZES) {
+        double singleOnePixels = 0.0;
+        for (const LayoutCase& layoutCase : CASES) {
+            HeadlessRenderConfig config;
+            config.fontSize = fontSize;
+            WidgetList::Parse(layoutCase.widgets, config.widgets);
+            HeadlessRenderer renderer;
+
+            ModeResult steady = RunMode(renderer, config, Mode::STEADY, frames);
+            ModeResult one = RunMode(renderer, config, Mode::ONE, frames);
+            ModeResult all = RunMode(renderer, config, Mode::ALL, frames);
+
+            // Every reading the tracked frames changed, as a full repaint
+            // leaves them
+            uint64_t tracked = renderer.Hash();
+            renderer.Invalidate();
+            renderer.Render(StatsFor(frames, true, true), config);
+            bool repaintMatches = renderer.Hash() == tracked;
+
+            ModeResult repaint = RunMode(renderer, config, Mode::REPAINT, frames);
+            double onePixels = static_cast<double>(one.dirtyPixels) / frames;
+
+            char size[24];
+            std::snprintf(size, sizeof(size), "%dx%d", renderer.GetFramebuffer().width,
+                          renderer.GetFramebuffer().height);
+            std::printf("%-6s %4d %8s %9.3f %9.3f %9.3f %10.3f %11.0f\n", layoutCase.name, fontSize, size, steady.us,
+                        one.us, all.us, repaint.us, onePixels);
+
+            if (!repaintMatches) {
+                std::printf("FAIL: %s-%d: the tracked frame differs from a full repaint\n", layoutCase.name,
+                            fontSize);
+                ok = false;
+            }
+            if (renderer.GetLayout().GetStats().layouts != 1) {
+                std::printf("FAIL: %s-%d: widgets placed %llu times\n", layoutCase.name, fontSize,
+                            static_cast<unsigned long long>(renderer.GetLayout().GetStats().layouts));
+                ok = false;
+            }
+            if (steady.formats != 0 || steady.dirtyPixels != 0) {
+                std::printf("FAIL: %s-%d: steady frames formatted %llu widgets and repainted %llu pixels\n",
+                            layoutCase.name, fontSize, static_cast<unsigned long long>(steady.formats),
+                            static_cast<unsigned long long>(steady.dirtyPixels));
+                ok = false;
+            }
+            if (one.formats > static_cast<uint64_t>(frames)) {
+                std::printf("FAIL: %s-%d: %llu widgets formatted for %d FPS changes\n", layoutCase.name,
+                            fontSize, static_cast<unsigned long long>(one.formats), frames);
+                ok = false;
+            }
+            if (steady.sizeMoved || one.sizeMoved || all.sizeMoved || repaint.sizeMoved) {
+                std::printf("FAIL: %s-%d: the overlay changed size with a reading\n", layoutCase.name, fontSize);
+                ok = false;
+            }
+
+            if (&layoutCase == &CASES[0]) {
+                singleOnePixels = onePixels;
+            } else if (onePixels > singleOnePixels) {
+                std::printf("FAIL: %s-%d: an FPS change repaints %.0f pixels, %.0f with the FPS alone\n",
+                            layoutCase.name, fontSize, onePixels, singleOnePixels);
+                ok = false;
+            }
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "lockfree_queue.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+// Activity-aware throttling for the overlay's own threads.
+//
+// Frame sources call NotifyActivity() for every real present; the owner
+// thread (the sampler) calls Update() and, while not ACTIVE, WaitForActivity()
+// instead of running its fast loop:
+//
+//   ACTIVE  - frames seen within `coolingAfterMs`: full-rate sampling
+//   COOLING - no frames for a moment: poll every `coolingPollMs`
+//   IDLE    - no frames for `idleAfterMs`: poll every `idlePollMs`
+//
+// NotifyActivity() rings a doorbell when the governor is not ACTIVE, so a
+// sleeping owner wakes on the first new frame rather than at its next poll.
+// While ACTIVE it is a single relaxed store.
+
+enum class ActivityState {
+    ACTIVE = 0,
+    COOLING = 1,
+    IDLE = 2
+};
+
+struct ActivityConfig {
+    uint32_t coolingAfterMs = 1000;
+    uint32_t idleAfterMs = 5000;
+    uint32_t coolingPollMs = 100;
+    uint32_t idlePollMs = 1000;
+    uint32_t probeIntervalMs = 250;  // How often the probe runs while ACTIVE
+};
+
+struct ActivityMetrics {
+    ActivityState state = ActivityState::IDLE;
+    uint64_t transitions = 0;
+    uint64_t activeWakeups = 0;    // Owner loop iterations per state
+    uint64_t coolingWakeups = 0;
+    uint64_t idleWakeups = 0;
+    uint64_t doorbellWakeups = 0;  // Waits cut short by NotifyActivity()
+    uint64_t idleForMs = 0;        // Time since the last activity
+};
+
+class ActivityGovernor {
+public:
+    explicit ActivityGovernor(const ActivityConfig& config = ActivityConfig());
+
+    // Any thread, lock-free: a frame (or other activity) was observed
+    void NotifyActivity(uint64_t nowNs);
+
+    // Owner thread: optional fallback activity check (e.g. "a game window
+    // is in the foreground"), run at most every probeIntervalMs while
+    // ACTIVE and once per poll otherwise
+    void SetProbe(std::function<bool()> probe);
+
+    // Owner thread: called with the new state on every transition
+    void SetStateCallback(std::function<void(ActivityState)> callback);
+
+    // Owner thread: run the probe if due, re-evaluate the state, count one
+    // wakeup for it and return it
+    ActivityState Update(uint64_t nowNs);
+
+    // Owner thread: sleep for the current state's poll period, or until
+    // NotifyActivity() rings. Returns immediately when ACTIVE.
+    void WaitForActivity();
+
+    // Wake a waiting owner without counting activity (used on shutdown)
+    void Wake() { m_doorbell.Ring(); }
+
+    ActivityState GetState() const { return m_state.load(std::memory_order_relaxed); }
+    ActivityMetrics GetMetrics() const;
+
+private:
+    ActivityConfig m_config;
+    Doorbell m_doorbell;
+
+    std::atomic<uint64_t> m_lastActivityNs;
+    std::atomic<ActivityState> m_state;
+    std::atomic<uint64_t> m_transitions;
+    std::atomic<uint64_t> m_wakeups[3];
+    std::atomic<uint64_t> m_doorbellWakeups;
+
+    // Owner thread only
+    std::function<bool()> m_probe;
+    std::function<void(ActivityState)> m_callback;
+    uint64_t m_lastProbeNs;
+
+    ActivityState Classify(uint64_t nowNs) const;
+};
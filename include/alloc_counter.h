@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+// Process-wide heap allocation counter.
+//
+// alloc_counter.cpp replaces the global operator new/delete (every form) with
+// versions that count calls and bytes before forwarding to malloc/free, so
+// anything that allocates through new - containers, strings, streams,
+// std::function - is counted, on every thread. Use it to check that a
+// steady-state path doesn't allocate:
+//
+//   AllocCounts before = AllocCounter::Get();
+//   ... run ticks ...
+//   uint64_t allocated = AllocCounter::Get().allocations - before.allocations;
+//
+// Direct malloc calls (C code, OS libraries) are not counted. This is not
+// part of fps_core: only programs that link the fps_alloc_counter target
+// (bench/CMakeLists.txt) get the replacement; everything else keeps the
+// default allocator.
+
+struct AllocCounts {
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+    uint64_t bytes = 0;  // Requested, not released
+};
+
+namespace AllocCounter {
+    // Relaxed reads; exact once the threads of interest are quiet
+    AllocCounts Get();
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "frame_pipeline.h"
+#include "io_executor.h"
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Frame capture files: a 32-byte header followed by one 16-byte record per
+// normalized frame, little-endian, exactly as NormalizedFrame lays them out.
+//
+//   offset  size  field
+//        0     4  magic "FPSC"
+//        4     4  version (CAPTURE_FILE_VERSION)
+//        8     4  record size (16)
+//       12     4  flags (0)
+//       16     8  MonotonicNowNs() when the capture started
+//       24     8  reserved (0)
+//
+// Readers must accept larger record sizes from newer versions and read only
+// the fields they know.
+
+#define CAPTURE_FILE_MAGIC   0x43535046u  // "FPSC"
+#define CAPTURE_FILE_VERSION 1
+
+struct CaptureFileHeader {
+    uint32_t magic = CAPTURE_FILE_MAGIC;
+    uint32_t version = CAPTURE_FILE_VERSION;
+    uint32_t recordSize = sizeof(NormalizedFrame);
+    uint32_t flags = 0;
+    uint64_t startNs = 0;
+    uint64_t reserved = 0;
+};
+
+struct CaptureStats {
+    uint64_t framesWritten = 0;
+    uint64_t bytesWritten = 0;
+    uint64_t failedWrites = 0;
+};
+
+// Pipeline sink that records every frame. Batches are buffered on the sink
+// thread and appended through the IoExecutor about every `flushMs`, one write
+// in flight at a time so the records stay in order.
+class CaptureSink : public IFrameSink {
+public:
+    CaptureSink(std::filesystem::path path, uint32_t flushMs = 1000,
+                std::shared_ptr<IoExecutor> io = IoExecutor::Shared());
+    ~CaptureSink() override;
+
+    void Consume(const FrameStats&) override {}
+    void ConsumeBatch(const FrameBatchRef& batch) override;
+
+    // After the pipeline has stopped: write what is buffered and wait
+    void Close();
+
+    CaptureStats GetStats() const;
+
+private:
+    std::filesystem::path m_path;
+    uint32_t m_flushMs;
+    std::shared_ptr<IoExecutor> m_io;
+
+    std::vector<char> m_pending;  // Sink thread
+    uint64_t m_pendingFrames;
+    uint64_t m_lastFlushNs;
+
+    // Set by the write in flight, read by the sink thread only once it has
+    // claimed m_writeInFlight: whether the header (the first REPLACE) is on
+    // disk, and what a failed REPLACE gave back to be written again
+    bool m_headerWritten;
+    std::vector<char> m_unwritten;
+    uint64_t m_unwrittenFrames;
+
+    std::atomic<bool> m_writeInFlight;
+    std::atomic<uint64_t> m_framesWritten;
+    std::atomic<uint64_t> m_bytesWritten;
+    std::atomic<uint64_t> m_failedWrites;
+
+    void Flush();
+};
+
+// Read a whole capture. Returns false (with a reason) if the file is missing,
+// not a capture, or its records are too small to hold a NormalizedFrame. The
+// version is not checked: newer versions only append fields, which are
+// skipped. A trailing partial record is dropped.
+bool ReadCaptureFile(const std::filesystem::path& path, std::vector<NormalizedFrame>& frames,
+                     std::string* error = nullptr);
@@ -21,6 +21,12 @@ struct ID3DXFont;
 #include <mutex>
 #include <vector>
 
+#include "lockfree_queue.h"
+#include "precise_timer.h"
+#include "activity_governor.h"
+#include "thread_affinity.h"
+#include "widget_layout.h"
+
 // Application constants
 #define APP_NAME L"FPS Overlay"
 #define CONFIG_FILE L"config.ini"
@@ -31,6 +37,8 @@ struct ID3DXFont;
 // FPS calculation
 #define FPS_SAMPLE_COUNT 60
 #define MIN_FRAME_TIME 0.001f  // 1ms minimum
+#define SAMPLER_INTERVAL_US 16000  // Fallback sampler period (~60 Hz)
+#define IDLE_DISPLAY_INTERVAL 5000  // Stats/redraw period while idle (ms)
 
 // Overlay positioning
 enum class OverlayPosition {
@@ -40,6 +48,12 @@ enum class OverlayPosition {
     BOTTOM_RIGHT = 3
 };
 
+// Monitor the overlay is placed on
+enum class OverlayMonitor {
+    PRIMARY = 0,
+    TARGET = 1    // The one showing the foreground (game) window
+};
+
 // Graphics API types
 enum class GraphicsAPI {
     UNKNOWN = 0,
@@ -61,6 +75,7 @@ struct Color {
 struct OverlayConfig {
     bool enabled = true;
     OverlayPosition position = OverlayPosition::TOP_LEFT;
+    OverlayMonitor monitor = OverlayMonitor::PRIMARY;
     int fontSize = DEFAULT_FONT_SIZE;
     Color textColor = Color(0.0f, 1.0f, 0.0f, 1.0f);  // Green
     Color backgroundColor = Color(0.0f, 0.0f, 0.0f, 0.5f);  // Semi-transparent black
@@ -69,6 +84,59 @@ struct OverlayConfig {
     int offsetY = 10;
     bool showBackground = true;
     std::wstring fontName = L"Consolas";
+    
+    // What the overlay shows, row by row (see widget_layout.h); holds the
+    // graph and heatmap whenever showGraph and showHeatmap are set
+    WidgetList widgets;
+    
+    // Frame-time graph under the text (see frame_time_graph.h)
+    bool showGraph = false;
+    int graphWidth = 160;        // Pixels; one column each
+    int graphHeight = 40;
+    int graphScaleMs = 50;       // Frame time at the top of the graph
+    int graphFramesPerColumn = 1;
+    
+    // Frame-time heatmap under the text and graph (see frame_time_heatmap.h)
+    bool showHeatmap = false;
+    int heatmapWidth = 160;      // Pixels; one slice each
+    int heatmapHeight = 40;
+    int heatmapSliceMs = 250;    // Frame time per column
+    int heatmapMinMs = 2;        // Log scale from the bottom row...
+    int heatmapMaxMs = 100;      // ...to the top row
+    int minFrameTimeMs = 1;
+    
+    // Frame pipeline backpressure
+    BackpressurePolicy ingestPolicy = BackpressurePolicy::DROP;
+    BackpressurePolicy normalizePolicy = BackpressurePolicy::BLOCK;
+    BackpressurePolicy sinkPolicy = BackpressurePolicy::DROP;
+    int queueCapacity = 1024;
+    
+    // Sampler pacing (see precise_timer.h)
+    PacingMode pacingMode = PacingMode::HYBRID;
+    int spinThresholdUs = PACING_DEFAULT_SPIN_US;
+    
+    // Idle throttling (see activity_governor.h)
+    bool idleThrottling = true;
+    int idleAfterMs = 5000;
+    int idlePollMs = 1000;
+    std::wstring gameProcesses;  // ';'-separated executables that count as active windowed
+    
+    // Background worker pool for bulk/offline work (0 = auto)
+    int workerThreads = 0;
+    uint64_t workerAffinityMask = 0;  // 0 = no pinning
+    ThreadPriority workerPriority = ThreadPriority::LOWEST;
+    
+    // Pinning and priority of the monitor's own threads (see thread_affinity.h)
+    uint64_t samplerAffinityMask = THREAD_AFFINITY_AUTO;
+    ThreadPriority samplerPriority = ThreadPriority::NORMAL;
+    uint64_t renderAffinityMask = THREAD_AFFINITY_AUTO;
+    ThreadPriority renderPriority = ThreadPriority::BELOW_NORMAL;
+    uint64_t backgroundAffinityMask = THREAD_AFFINITY_AUTO;  // Pipeline stages, scheduler, file I/O
+    ThreadPriority backgroundPriority = ThreadPriority::BELOW_NORMAL;
+    
+    // Frame source/sink plugins (see plugin_host.h)
+    bool pluginsEnabled = true;
+    std::wstring pluginDirectory = L"plugins";  // Relative to the executable
 };
 
 // Utility macros
@@ -83,5 +151,4 @@ typedef BOOL(WINAPI* SwapBuffers_t)(HDC);
 
 // Global state
 extern std::atomic<bool> g_running;
-extern std::atomic<float> g_currentFPS;
 extern std::mutex g_configMutex;
\ No newline at end of file
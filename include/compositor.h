@@ -0,0 +1,71 @@
+#pragma once
+
+#include "glyph_atlas.h"
+
+#include <cstdint>
+
+// Software compositor for the overlay: fills, translucent panels and
+// glyph-coverage blends into a 32-bit premultiplied-alpha buffer
+// (0xAARRGGBB, i.e. BGRA in memory, the layout of a 32-bit DIB section).
+// Platform-independent; the blend kernels have SSE2 and AVX2 versions
+// picked at run time, and every version gives bit-identical results to the
+// scalar one.
+//
+// Blending is premultiplied source-over with 8-bit coverage:
+//
+//   src' = color * coverage / 255                (every channel)
+//   dst  = src' + dst * (255 - src'.alpha) / 255
+//
+// with exact rounding division by 255.
+
+#define ROUNDED_RECT_MAX_RADIUS 32
+
+struct PixelBuffer {
+    uint32_t* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    int stride = 0;  // In pixels
+};
+
+enum class CompositorKernel {
+    SCALAR,
+    SSE2,
+    AVX2
+};
+
+namespace Compositor {
+    // Straight 0xAARRGGBB to premultiplied
+    uint32_t Premultiply(uint32_t argb);
+
+    // Best kernel this CPU supports, unless overridden
+    CompositorKernel GetKernel();
+
+    // For benchmarks and comparisons; an unsupported kernel falls back to
+    // the best supported one. Not thread-safe against concurrent drawing.
+    void SetKernel(CompositorKernel kernel);
+    bool IsKernelSupported(CompositorKernel kernel);
+    const char* KernelName(CompositorKernel kernel);
+
+    // Overwrite a rectangle (clipped to the buffer) with `color`
+    void Fill(PixelBuffer& buffer, int x, int y, int width, int height, uint32_t color);
+
+    // Source-over a premultiplied `color` across a rectangle (clipped to
+    // the buffer); translucent panels over whatever is already there
+    void BlendRect(PixelBuffer& buffer, int x, int y, int width, int height, uint32_t color);
+
+    // Source-over a premultiplied `color` through a rectangle with round
+    // corners of `radius` pixels (at most ROUNDED_RECT_MAX_RADIUS and half
+    // the shorter side), antialiased; clipped to the buffer
+    void FillRoundedRect(PixelBuffer& buffer, int x, int y, int width, int height, int radius, uint32_t color);
+
+    // Source-over `color` through a width x height coverage mask whose
+    // top-left lands at (x, y); clipped to the buffer
+    void BlendMask(PixelBuffer& buffer, int x, int y, const uint8_t* mask, int width, int height,
+                   int maskStride, uint32_t color);
+
+    // Draw `text` with its line top at (x, y); returns the pen position
+    // after the last glyph. Characters outside the atlas draw as '?'. (Not
+    // DrawText: windows.h defines that as a macro.)
+    int DrawString(PixelBuffer& buffer, const GlyphAtlas& atlas, int x, int y,
+                   const wchar_t* text, int length, uint32_t color);
+}
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "common.h"
+#include "io_executor.h"
+#include "io_task.h"
+#include "ini_file.h"
 
 class ConfigManager {
 public:
@@ -10,15 +13,24 @@ public:
     // Load configuration from file
     bool LoadConfig(const std::wstring& configPath = CONFIG_FILE);
     
-    // Save configuration to file
+    // Save configuration to file, waiting for the write to finish
     bool SaveConfig(const std::wstring& configPath = CONFIG_FILE);
     
+    // Save without blocking the caller: the file is read, merged and
+    // replaced on the I/O executor, and the task finishes on its thread
+    Task<bool> SaveConfigAsync(std::wstring configPath = CONFIG_FILE);
+    
     // Get current configuration
     const OverlayConfig& GetConfig() const { return m_config; }
     
     // Update configuration
     void UpdateConfig(const OverlayConfig& config);
     
+    // Start an async save only if UpdateConfig changed the configuration
+    // since the last save (periodic flush). Returns false if a previous save
+    // is still running; the change is picked up by the next flush.
+    bool SaveIfDirty(const std::wstring& configPath = CONFIG_FILE);
+    
     // Auto-scale font size based on screen resolution
     int GetScaledFontSize() const;
     
@@ -26,26 +38,39 @@ public:
     void GetScreenResolution(int& width, int& height) const;
 
 private:
+    struct IniValue {
+        std::wstring section;
+        std::wstring key;
+        std::wstring value;
+    };
+    
     OverlayConfig m_config;
+    std::atomic<bool> m_dirty;
+    std::atomic<bool> m_saveInFlight;
+    std::shared_ptr<IoExecutor> m_io;
+    
+    Task<void> FlushAsync(std::wstring configPath);
     
-    // Helper functions for INI file parsing
+    // Lookups in the parsed file
     std::wstring ReadIniString(const std::wstring& section, const std::wstring& key, 
-                              const std::wstring& defaultValue, const std::wstring& filePath);
+                              const std::wstring& defaultValue, const IniFile& ini);
     int ReadIniInt(const std::wstring& section, const std::wstring& key, 
-                   int defaultValue, const std::wstring& filePath);
+                   int defaultValue, const IniFile& ini);
     bool ReadIniBool(const std::wstring& section, const std::wstring& key, 
-                     bool defaultValue, const std::wstring& filePath);
+                     bool defaultValue, const IniFile& ini);
     float ReadIniFloat(const std::wstring& section, const std::wstring& key, 
-                       float defaultValue, const std::wstring& filePath);
-    
-    bool WriteIniString(const std::wstring& section, const std::wstring& key, 
-                       const std::wstring& value, const std::wstring& filePath);
-    bool WriteIniInt(const std::wstring& section, const std::wstring& key, 
-                     int value, const std::wstring& filePath);
-    bool WriteIniBool(const std::wstring& section, const std::wstring& key, 
-                      bool value, const std::wstring& filePath);
-    bool WriteIniFloat(const std::wstring& section, const std::wstring& key, 
-                       float value, const std::wstring& filePath);
+                       float defaultValue, const IniFile& ini);
+    
+    // Key/value pairs written by a save, in file order
+    std::vector<IniValue> CollectIniValues(const OverlayConfig& config);
+    
+    // Replace the values in an existing INI text, keeping comments, unknown
+    // keys and layout; missing keys and sections are appended
+    static std::string MergeIniText(const std::string& existing, const std::vector<IniValue>& values);
+    
+    // Affinity masks are hex, or "auto" for THREAD_AFFINITY_AUTO
+    static uint64_t ParseAffinityMask(const std::wstring& maskStr);
+    static std::wstring AffinityMaskToString(uint64_t mask);
     
     // Parse color from string (e.g., "255,255,255,255" or "1.0,1.0,1.0,1.0")
     Color ParseColor(const std::wstring& colorStr, const Color& defaultColor);
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "glyph_atlas.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Retained-mode damage tracking for the overlay's backbuffer. Each frame
+// every widget reports what it would draw (its content, a style key and
+// its bounds); the tracker compares that with the previous frame and
+// collects the rectangles that need repainting. A frame-capped game shows
+// the same quantized FPS text for many updates in a row, and those frames
+// come out with no damage at all, so the renderer can skip them entirely.
+
+struct DamageRect {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+
+    bool IsEmpty() const { return width <= 0 || height <= 0; }
+    int64_t Area() const { return IsEmpty() ? 0 : static_cast<int64_t>(width) * height; }
+    bool operator==(const DamageRect&) const = default;
+
+    static DamageRect Union(const DamageRect& a, const DamageRect& b);
+    static DamageRect Intersect(const DamageRect& a, const DamageRect& b);
+};
+
+enum class DamageKind {
+    NONE,     // Nothing changed; skip drawing and the window update
+    PARTIAL,  // Repaint DirtyRects() only
+    FULL      // Repaint everything
+};
+
+struct DamageStats {
+    uint64_t frames = 0;
+    uint64_t skipped = 0;       // DamageKind::NONE
+    uint64_t partial = 0;
+    uint64_t full = 0;
+    uint64_t dirtyPixels = 0;   // Repainted
+    uint64_t surfacePixels = 0; // Would have been repainted without tracking
+};
+
+#define DAMAGE_MAX_RECTS 8  // More than this get merged into their bounds
+
+// Not thread-safe: owned and used by the render thread. Steady state is
+// allocation-free once every widget has reported its largest content.
+class DamageTracker {
+public:
+    DamageTracker();
+
+    // Start a frame over a width x height surface; a new size, or an
+    // Invalidate() since the last frame, makes the whole frame dirty
+    void BeginFrame(int width, int height);
+
+    // Everything is dirty next frame (new font, lost backbuffer contents)
+    void Invalidate();
+
+    // Widgets are reported every frame by index; call Invalidate() when the
+    // set of widgets changes, since one that stops reporting isn't erased.
+    //
+    // Report a widget. `content` is compared byte for byte and `style`
+    // stands for everything else that changes its pixels (colours, font,
+    // window position). Any change damages the old and new bounds. Returns
+    // whether the widget is dirty.
+    bool Update(size_t widget, const void* content, size_t size, uint64_t style, const DamageRect& bounds);
+
+    // Report a line of text drawn from `atlas` with its pen starting at
+    // `textX`. When only the tail of the text changed ("59.9" -> "60.0")
+    // the damage starts at the first changed glyph rather than covering
+    // the whole widget. `style` must change with the atlas (or Invalidate()).
+    bool UpdateText(size_t widget, const GlyphAtlas& atlas, const wchar_t* text, int length, uint64_t style,
+                    const DamageRect& bounds, int textX);
+
+    // Classify the frame and add it to the stats
+    DamageKind EndFrame();
+
+    // Valid between EndFrame() and the next BeginFrame(); clipped to the
+    // surface and non-overlapping
+    const std::vector<DamageRect>& DirtyRects() const { return m_dirty; }
+    DamageRect DirtyBounds() const;
+
+    DamageStats GetStats() const { return m_stats; }
+
+private:
+    struct WidgetState {
+        bool valid = false;
+        uint64_t style = 0;
+        DamageRect bounds;
+        int textX = 0;
+        std::vector<uint8_t> content;
+        std::vector<wchar_t> text;
+    };
+
+    std::vector<WidgetState> m_widgets;
+    std::vector<DamageRect> m_dirty;
+    DamageRect m_surface;
+    bool m_fullFrame;
+    bool m_invalidated;
+    DamageStats m_stats;
+
+    // Private methods
+    WidgetState& Widget(size_t widget);
+    void AddDirty(const DamageRect& rect);
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "fps_plugin_abi.h"
+
+/*
+ * C API for embedding the measurement engine (the fps_core library) in
+ * another process: a game engine, a test harness, an automation runner.
+ *
+ * One FpsCore owns a frame pipeline. Feed it present timestamps from any
+ * number of threads; read the latest statistics and frame-time percentiles
+ * from any thread without taking a lock (both are seqlock snapshots, so a
+ * reader never blocks the engine and never sees a half-written value).
+ * Optionally every frame is recorded to a capture file (capture_file.h).
+ *
+ * Lifecycle, from one owning thread: create -> add_sink* -> start -> stop ->
+ * destroy. Frame, stats and sink types are shared with the plugin ABI, and
+ * every struct passed in or out starts with its `size` (set it to sizeof
+ * before the call).
+ */
+
+#ifdef __cplusplus
+#define FPS_CORE_API extern "C"
+extern "C" {
+#else
+#define FPS_CORE_API
+#endif
+
+typedef struct FpsCore FpsCore;
+
+typedef struct FpsCoreConfig {
+    uint32_t size;
+    uint32_t queueCapacity;    /* Ingest queue, rounded up to a power of two */
+    uint32_t averageWindow;    /* Frames in the rolling FPS average */
+    uint32_t percentileWindow; /* Frames behind lows and percentiles */
+    float minFrameTimeMs;      /* Shorter frames are clamped to this */
+    float rejectFrameTimeMs;   /* Shorter frames are dropped (0 = keep all) */
+    float hitchFactor;         /* Hitch = frame longer than this x average */
+    const char* capturePath;   /* UTF-8; NULL = no capture */
+} FpsCoreConfig;
+
+/* Frame-time percentiles over the last percentileWindow frames */
+typedef struct FpsPercentiles {
+    uint32_t size;
+    uint32_t frames; /* Frames currently in the window */
+    float p50Ms;
+    float p90Ms;
+    float p99Ms;
+    float p999Ms;
+    uint64_t sequence; /* Increments with every update */
+} FpsPercentiles;
+
+typedef struct FpsCoreCounters {
+    uint32_t size;
+    uint64_t presentsAccepted;
+    uint64_t presentsDropped; /* Ingest queue full */
+    uint64_t framesRejected;  /* Filtered as polling artifacts */
+    uint64_t captureFramesWritten;
+    uint64_t captureFailedWrites;
+} FpsCoreCounters;
+
+/* Fill `config` with the defaults */
+FPS_CORE_API void fps_core_default_config(FpsCoreConfig* config);
+
+/* NULL config = defaults. Returns NULL on failure. */
+FPS_CORE_API FpsCore* fps_core_create(const FpsCoreConfig* config);
+
+/* Stops the core if running */
+FPS_CORE_API void fps_core_destroy(FpsCore* core);
+
+/* Before fps_core_start(): receive every frame batch and stats update on a
+ * thread of its own. The struct is copied. */
+FPS_CORE_API int fps_core_add_sink(FpsCore* core, const FpsSinkV1* sink);
+
+FPS_CORE_API int fps_core_start(FpsCore* core);
+
+/* Drains the pipeline and finishes the capture file */
+FPS_CORE_API void fps_core_stop(FpsCore* core);
+
+/* The clock present timestamps must be taken on */
+FPS_CORE_API uint64_t fps_core_now_ns(void);
+
+/* Any thread. `sourceId` below MAX_FRAME_SOURCES (8), e.g. one per swap
+ * chain: each source's frame times are computed on their own. Stats and
+ * percentiles follow one source at a time (FpsStats.sourceId) and switch
+ * once it has been quiet for 500 ms; the capture and sinks get every
+ * source's frames. Returns how many presents were accepted. */
+FPS_CORE_API uint32_t fps_core_push_presents(FpsCore* core, uint32_t sourceId, const uint64_t* timestampsNs,
+                                             uint32_t count);
+
+/* Any thread, lock-free. Return FPS_PLUGIN_OK or FPS_PLUGIN_ERROR. */
+FPS_CORE_API int fps_core_read_stats(const FpsCore* core, FpsStats* stats);
+FPS_CORE_API int fps_core_read_percentiles(const FpsCore* core, FpsPercentiles* percentiles);
+FPS_CORE_API int fps_core_read_counters(const FpsCore* core, FpsCoreCounters* counters);
+
+/* Read a capture file: copies up to `capacity` frames and returns how many
+ * the file holds, or -1 if it can't be read */
+FPS_CORE_API int64_t fps_core_read_capture(const char* path, FpsFrame* frames, uint64_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
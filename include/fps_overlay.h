@@ -3,7 +3,12 @@
 #include "common.h"
 #include "config_manager.h"
 #include "hook_manager.h"
-#include "renderer.h"
+#include "render_thread.h"
+#include "frame_pipeline.h"
+#include "scheduler.h"
+#include "thread_pool.h"
+#include "plugin_host.h"
+#include "startup_timeline.h"
 
 class FPSOverlay {
 public:
@@ -16,50 +21,103 @@ public:
     // Start the overlay
     bool Start();
     
-    // Stop the overlay
+    // Stop the overlay; callers on other threads (the console handler and
+    // main) return only once the teardown is done
     void Stop();
     
     // Check if overlay is running
     bool IsRunning() const { return m_running; }
     
-    // Update FPS calculation
+    // Block the calling thread until Stop() has finished tearing down
+    void WaitForStop();
+    
+    // Feed a sampler frame into the pipeline
     void UpdateFPS();
     
-    // Get current FPS
+    // Get current FPS (lock-free read of the newest stats snapshot)
     float GetCurrentFPS() const;
     
+    // Get the complete newest stats snapshot
+    FrameStats GetCurrentStats() const;
+    
     // Process command line arguments
     bool ProcessCommandLine(int argc, wchar_t* argv[]);
     
-    // Main update loop (called from worker thread)
-    void Update();
+    // Queue depths and drop counters of the frame pipeline
+    PipelineMetrics GetPipelineMetrics() const;
+    
+    // Background pool for bulk work (export, analysis); created on first use
+    WorkStealingPool& GetWorkerPool();
+    
+    // Idle throttling state and per-state sampler wakeups
+    ActivityMetrics GetActivityMetrics() const;
+    
+    // Wakeup lateness of the fallback sampler loop
+    JitterStats GetSamplerJitter() const;
+    
+    // Render time and snapshot age on the render thread
+    RenderThreadStats GetRenderStats() const;
+    
+    // Run-time/lateness of the periodic tasks and scheduler wakeups
+    std::vector<ScheduledTaskStats> GetSchedulerStats() const;
+    uint64_t GetSchedulerWakeups() const;
+    
+    // Per-phase timings of Initialize() and Start()
+    const StartupTimeline& GetStartupTimeline() const { return m_startup; }
 
 private:
-    bool m_running;
+    std::atomic<bool> m_running;  // Read by the sampler and scheduler threads
+    bool m_stopped;               // Stop() finished; guarded by m_stopMutex
     bool m_initialized;
-    float m_currentFPS;
     
     // Component managers
     std::unique_ptr<ConfigManager> m_configManager;
     std::unique_ptr<HookManager> m_hookManager;
-    std::unique_ptr<Renderer> m_renderer;
+    std::unique_ptr<RenderThread> m_renderThread;  // Owns the window and renderer
+    
+    // Frame pipeline (source -> normalize -> aggregate -> sinks)
+    std::unique_ptr<FramePipeline> m_pipeline;
+    
+    // Periodic maintenance (stats publish, hooks, memory, flush)
+    std::unique_ptr<Scheduler> m_scheduler;
+    uint64_t m_publishedSequence;  // Sequence of the last snapshot sent to the render thread
+    uint32_t m_statsTaskId;
+    
+    // Idle throttling; the sampler thread owns its state machine
+    std::unique_ptr<ActivityGovernor> m_activity;
+    
+    // Windowed games named in [Activity] GameProcesses (lower case), and
+    // whether the last foreground window the probe saw belongs to one
+    std::vector<std::wstring> m_gameProcesses;
+    mutable HWND m_probeWindow;
+    mutable bool m_probeWindowIsGame;
+    
+    // Out-of-tree frame sources and sinks; declared after the pipeline so
+    // the libraries unload before it goes away
+    std::unique_ptr<PluginHost> m_plugins;
     
     // Threading
     std::thread m_updateThread;
-    mutable std::mutex m_fpsMutex;
-    
-    // FPS calculation
-    std::vector<float> m_frameTimes;
-    std::chrono::high_resolution_clock::time_point m_lastFrameTime;
-    size_t m_frameTimeIndex;
+    std::unique_ptr<WorkStealingPool> m_workerPool;
+    std::mutex m_workerPoolMutex;
+    std::unique_ptr<FramePacer> m_samplerPacer;
+    std::mutex m_teardownMutex;  // Held for the whole of Stop()
+    std::mutex m_stopMutex;
+    std::condition_variable m_stopCv;
     
     // Performance monitoring
-    std::chrono::high_resolution_clock::time_point m_lastUpdateTime;
     size_t m_memoryUsage;
+    StartupTimeline m_startup;
     
     // Private methods
     void UpdateWorker();
-    void CalculateFPS(float deltaTime);
+    void RegisterPeriodicTasks(const OverlayConfig& config);
+    void OnActivityChanged(ActivityState state);
+    bool ProbeForegroundActivity() const;
+    void PublishDisplayStats();
+    void RefreshHooks();
+    PipelineConfig BuildPipelineConfig(const OverlayConfig& config) const;
+    void LoadPlugins(const OverlayConfig& config);
     void MonitorMemoryUsage();
     bool CheckSystemCompatibility();
     void SetupExceptionHandling();
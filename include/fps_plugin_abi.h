@@ -0,0 +1,142 @@
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * Stable C ABI for out-of-tree frame sources and sinks.
+ *
+ * A plugin is a shared library (.dll / .so) in the plugins directory that
+ * exports the three entry points below. At load time the host checks
+ * fps_plugin_abi_version() and then calls fps_plugin_init() with its
+ * FpsHostApiV1 table; from there the plugin registers any number of sinks
+ * and sources. Everything crossing the boundary is plain C: no exceptions,
+ * no C++ types, no allocations freed on the other side.
+ *
+ * Data moves a batch at a time. Sinks receive the pipeline's frame batches
+ * by pointer (no copy); sources hand the host an array of present
+ * timestamps per call. One indirect call per batch keeps the per-frame cost
+ * of the boundary negligible.
+ *
+ * Versioning: FPS_PLUGIN_ABI_VERSION only changes on breaking changes, and a
+ * plugin built for a different version is not loaded. Every struct starts
+ * with its `size`; new fields are only ever appended, so a reader must
+ * ignore (host) or zero-fill (plugin) anything past the size it was given.
+ */
+
+#define FPS_PLUGIN_ABI_VERSION 1
+
+#if defined(_WIN32)
+#define FPS_PLUGIN_EXPORT __declspec(dllexport)
+#else
+#define FPS_PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+#define FPS_PLUGIN_API extern "C" FPS_PLUGIN_EXPORT
+extern "C" {
+#else
+#define FPS_PLUGIN_API FPS_PLUGIN_EXPORT
+#endif
+
+/* Return codes */
+#define FPS_PLUGIN_OK 0
+#define FPS_PLUGIN_ERROR -1
+#define FPS_PLUGIN_UNSUPPORTED -2
+
+/* Log levels for FpsHostApiV1::log */
+#define FPS_PLUGIN_LOG_INFO 0
+#define FPS_PLUGIN_LOG_WARNING 1
+#define FPS_PLUGIN_LOG_ERROR 2
+
+/* One normalized frame; the same layout as the pipeline's NormalizedFrame */
+typedef struct FpsFrame {
+    uint64_t timestampNs; /* Monotonic clock of the present */
+    float frameTime;      /* Seconds since the previous present */
+    uint32_t sourceId;
+} FpsFrame;
+
+/* A published batch. `frames` points into the host's pooled batch and is
+ * only valid for the duration of the call; copy what you keep. */
+typedef struct FpsFrameBatch {
+    uint32_t size;
+    uint32_t count;
+    uint64_t sequence; /* Increments per published batch */
+    const FpsFrame* frames;
+} FpsFrameBatch;
+
+/* Aggregated statistics snapshot */
+typedef struct FpsStats {
+    uint32_t size;
+    float fps;
+    float frameTimeMs;
+    float minFrameTimeMs;
+    float maxFrameTimeMs;
+    float low1Fps;
+    float low01Fps;
+    uint64_t frameCount;
+    uint64_t hitchCount;
+    uint64_t sequence;
+    uint64_t timestampNs;
+    uint32_t sourceId; /* Source the stats follow (one at a time, never mixed) */
+} FpsStats;
+
+/* A consumer of frame batches. Each sink gets its own host thread and is
+ * called in order, never concurrently with itself. */
+typedef struct FpsSinkV1 {
+    uint32_t size;
+    const char* name; /* Copied by the host */
+    void* context;    /* Passed back on every call */
+    void (*consume_batch)(void* context, const FpsFrameBatch* batch);
+    void (*consume_stats)(void* context, const FpsStats* stats); /* Optional */
+} FpsSinkV1;
+
+/* A producer of presents, e.g. engine telemetry. Between start and stop the
+ * source calls FpsHostApiV1::submit_presents from any thread it likes. */
+typedef struct FpsSourceV1 {
+    uint32_t size;
+    const char* name; /* Copied by the host */
+    void* context;
+    int (*start)(void* context, uint32_t sourceId);
+    /* No submit_presents call may be running or made once this returns */
+    void (*stop)(void* context);
+} FpsSourceV1;
+
+/* Services the host offers. `host` is an opaque handle to pass back. */
+typedef struct FpsHostApiV1 {
+    uint32_t size;
+    uint32_t abiVersion;
+    void* host;
+
+    /* Only valid inside fps_plugin_init(); the structs are copied */
+    int (*register_sink)(void* host, const FpsSinkV1* sink);
+    int (*register_source)(void* host, const FpsSourceV1* source);
+
+    /* Push `count` present timestamps (monotonic ns, see now_ns) for a
+     * started source. Returns how many were accepted. */
+    uint32_t (*submit_presents)(void* host, uint32_t sourceId, const uint64_t* timestampsNs, uint32_t count);
+
+    /* The clock frame timestamps are taken on */
+    uint64_t (*now_ns)(void* host);
+
+    void (*log)(void* host, int level, const char* message);
+} FpsHostApiV1;
+
+/* Required exports */
+#define FPS_PLUGIN_ABI_VERSION_SYMBOL "fps_plugin_abi_version"
+#define FPS_PLUGIN_INIT_SYMBOL "fps_plugin_init"
+#define FPS_PLUGIN_SHUTDOWN_SYMBOL "fps_plugin_shutdown"
+
+/* uint32_t fps_plugin_abi_version(void): return FPS_PLUGIN_ABI_VERSION */
+typedef uint32_t (*FpsPluginAbiVersionFn)(void);
+
+/* int fps_plugin_init(const FpsHostApiV1* host): register sinks and
+ * sources; the table stays valid until shutdown. Non-zero = don't load. */
+typedef int (*FpsPluginInitFn)(const FpsHostApiV1* host);
+
+/* void fps_plugin_shutdown(void): after every source has stopped and the
+ * last sink call has returned */
+typedef void (*FpsPluginShutdownFn)(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "frame_types.h"
+#include "lockfree_queue.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Immutable, reference-counted batches of normalized frames.
+//
+// One producer (the aggregate stage) fills a batch through FrameBatchWriter
+// and publishes it once. Every sink then receives a FrameBatchRef to the same
+// memory; nothing is copied per sink. When the last reference is released the
+// batch goes back to its FrameBatchPool.
+
+#define FRAME_BATCH_CAPACITY 128
+
+class FrameBatchPool;
+
+class FrameBatch {
+public:
+    uint64_t Sequence() const { return m_sequence; }
+    size_t Count() const { return m_count; }
+    const NormalizedFrame* Frames() const { return m_frames; }
+    const NormalizedFrame& operator[](size_t index) const { return m_frames[index]; }
+    uint64_t FirstTimestampNs() const { return m_count ? m_frames[0].timestampNs : 0; }
+    uint64_t LastTimestampNs() const { return m_count ? m_frames[m_count - 1].timestampNs : 0; }
+
+private:
+    friend class FrameBatchPool;
+    friend class FrameBatchRef;
+    friend class FrameBatchWriter;
+
+    FrameBatch() : m_refCount(0), m_pool(nullptr), m_sequence(0), m_count(0) {}
+
+    std::atomic<uint32_t> m_refCount;
+    FrameBatchPool* m_pool;
+    uint64_t m_sequence;
+    size_t m_count;
+    NormalizedFrame m_frames[FRAME_BATCH_CAPACITY];
+};
+
+// Shared handle to a published batch. Copying adds a reference.
+class FrameBatchRef {
+public:
+    FrameBatchRef() : m_batch(nullptr) {}
+    FrameBatchRef(const FrameBatchRef& other);
+    FrameBatchRef(FrameBatchRef&& other) noexcept : m_batch(other.m_batch) { other.m_batch = nullptr; }
+    ~FrameBatchRef() { Reset(); }
+
+    FrameBatchRef& operator=(const FrameBatchRef& other);
+    FrameBatchRef& operator=(FrameBatchRef&& other) noexcept;
+
+    const FrameBatch* Get() const { return m_batch; }
+    const FrameBatch* operator->() const { return m_batch; }
+    const FrameBatch& operator*() const { return *m_batch; }
+    explicit operator bool() const { return m_batch != nullptr; }
+
+    // Drop this reference; the batch returns to the pool on the last one
+    void Reset();
+
+    uint32_t UseCount() const;
+
+private:
+    friend class FrameBatchWriter;
+    explicit FrameBatchRef(FrameBatch* adopted) : m_batch(adopted) {}
+
+    FrameBatch* m_batch;
+};
+
+// Fixed pool of batches allocated once up front. Acquire() is called by the
+// single producer; Recycle() may run on any sink thread.
+class FrameBatchPool {
+public:
+    explicit FrameBatchPool(size_t batchCount);
+    ~FrameBatchPool();
+
+    size_t Capacity() const { return m_capacity; }
+    size_t Available() const { return m_freeList.Depth(); }
+    uint64_t ExhaustedCount() const { return m_exhausted.load(std::memory_order_relaxed); }
+
+private:
+    friend class FrameBatchRef;
+    friend class FrameBatchWriter;
+
+    FrameBatch* Acquire();
+    void Recycle(FrameBatch* batch);
+
+    std::unique_ptr<FrameBatch[]> m_storage;
+    size_t m_capacity;
+    MpscQueue<FrameBatch*> m_freeList;
+    std::atomic<uint64_t> m_exhausted;
+};
+
+// Producer-side builder. Frames are appended into a pooled batch that no one
+// else can see until Publish() hands out the first reference.
+class FrameBatchWriter {
+public:
+    explicit FrameBatchWriter(FrameBatchPool& pool);
+    ~FrameBatchWriter();
+
+    // Append a frame; returns false if no pooled batch was available
+    bool Append(const NormalizedFrame& frame);
+
+    bool Empty() const { return !m_batch || m_batch->m_count == 0; }
+    bool Full() const { return m_batch && m_batch->m_count == FRAME_BATCH_CAPACITY; }
+    uint64_t FirstTimestampNs() const { return m_batch ? m_batch->FirstTimestampNs() : 0; }
+
+    // Freeze the current batch and return the first reference to it
+    FrameBatchRef Publish();
+
+private:
+    FrameBatchPool& m_pool;
+    FrameBatch* m_batch;
+    uint64_t m_nextSequence;
+};
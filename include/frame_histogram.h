@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Log-spaced frame-time histogram over a rolling window of frames.
+//
+// Used for percentile metrics (1% / 0.1% lows). Add() evicts the oldest frame
+// once the window is full, so both updates and percentile queries are O(1)
+// and O(buckets) respectively, independent of the window length.
+
+#define HISTOGRAM_BUCKET_COUNT 512
+#define HISTOGRAM_MIN_MS 0.1f
+#define HISTOGRAM_MAX_MS 10000.0f
+
+class FrameHistogram {
+public:
+    explicit FrameHistogram(size_t windowFrames = 1000);
+
+    // Add a frame time in milliseconds
+    void Add(float frameTimeMs);
+
+    // Remove everything
+    void Clear();
+
+    // Frame time (ms) at or below which `percentile` (0-100) of frames fall
+    float Percentile(float percentile) const;
+
+    size_t Count() const { return m_count; }
+    uint32_t BucketCount(size_t bucket) const { return m_buckets[bucket]; }
+
+    // Bucket mapping, shared with the histogram-based widgets
+    static size_t BucketForMs(float frameTimeMs);
+    static float BucketUpperMs(size_t bucket);
+
+private:
+    std::vector<uint32_t> m_buckets;
+    std::vector<uint16_t> m_window;  // Bucket index per frame, ring buffer
+    size_t m_windowIndex;
+    size_t m_count;
+};
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "frame_types.h"
+#include "frame_batch.h"
+#include "frame_histogram.h"
+#include "lockfree_queue.h"
+#include "seqlock.h"
+#include "thread_affinity.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Staged frame pipeline:
+//
+//   sources --MPSC--> normalize --SPSC--> aggregate --SPSC--> sink (one thread each)
+//
+// Every edge is a bounded lock-free queue with its own backpressure policy.
+// Ingestion defaults to DROP so a slow downstream stage can never stall the
+// thread that reports a frame (the sampler or a Present hook).
+//
+// The aggregate stage also packs frames into pooled FrameBatches; all sinks
+// share the same batch by reference instead of receiving their own copy.
+//
+// Stats follow one source at a time (FrameStats::sourceId), so sampler polls,
+// hooked presents and separate swap chains are never averaged together. A
+// present source takes over from the sampler at once; any source takes over
+// once the current one has been quiet for sourceTimeoutMs. Batches carry the
+// frames of every source.
+
+// Consumer of aggregated statistics and frame batches. Both callbacks run on
+// the sink's own thread.
+class IFrameSink {
+public:
+    virtual ~IFrameSink() = default;
+    virtual void Consume(const FrameStats& stats) = 0;
+    
+    // Called for every published batch; hold on to the ref to keep it alive
+    virtual void ConsumeBatch(const FrameBatchRef& batch) {}
+};
+
+// Pipeline tuning, normally filled from OverlayConfig
+struct PipelineConfig {
+    size_t ingestCapacity = 1024;
+    size_t normalizeCapacity = 1024;
+    size_t sinkCapacity = 64;
+    BackpressurePolicy ingestPolicy = BackpressurePolicy::DROP;
+    BackpressurePolicy normalizePolicy = BackpressurePolicy::BLOCK;
+
+    float minFrameTime = 0.001f;      // Clamp below this (seconds)
+    float rejectFrameTime = 0.008f;   // Drop polling artifacts below this (seconds)
+    size_t averageWindow = 60;        // Rolling average window (frames)
+    size_t percentileWindow = 1000;   // Window for 1% / 0.1% lows (frames)
+    float hitchFactor = 2.0f;         // Hitch = frame longer than this x average
+    uint32_t sourceTimeoutMs = 500;   // Stats switch source once theirs is quiet this long
+
+    size_t batchPoolSize = 64;        // Batches shared by all sinks
+    uint32_t batchFlushMs = 250;      // Publish partial batches after this long
+
+    // Normalize, aggregate and sink threads (see thread_affinity.h)
+    uint64_t threadAffinityMask = THREAD_AFFINITY_NONE;
+    ThreadPriority threadPriority = ThreadPriority::NORMAL;
+};
+
+// Depth metrics for every edge of the pipeline
+struct PipelineMetrics {
+    QueueStats ingest;
+    QueueStats normalize;
+    std::vector<QueueStats> sinks;
+    uint64_t rejectedFrames = 0;
+
+    // Frame batch pool
+    size_t batchPoolCapacity = 0;
+    size_t batchPoolAvailable = 0;
+    uint64_t batchesPublished = 0;
+    uint64_t unbatchedFrames = 0;  // Frames lost because the pool was exhausted
+
+    uint32_t threadSettingFailures = 0;  // Stage threads whose affinity/priority didn't apply
+};
+
+class FramePipeline {
+public:
+    explicit FramePipeline(const PipelineConfig& config = PipelineConfig());
+    ~FramePipeline();
+
+    // Register a sink before Start(). The sink must outlive the pipeline run.
+    void AddSink(IFrameSink* sink, BackpressurePolicy policy = BackpressurePolicy::DROP);
+
+    // Start stage threads
+    bool Start();
+
+    // Stop stage threads. Presents not yet normalized are dropped; the last
+    // partial batch is published and every sink drains what is queued for it
+    // before its thread exits.
+    void Stop();
+
+    bool IsRunning() const { return m_running.load(std::memory_order_acquire); }
+
+    // Report a present from any thread (lock-free, never blocks with DROP)
+    bool PushPresent(uint64_t timestampNs, uint32_t sourceId = FRAME_SOURCE_SAMPLER);
+
+    // The source's next present at or after `timestampNs` starts afresh
+    // instead of making a frame of the gap before it (a sampler that was
+    // parked while idle). Any thread; presents already queued are unaffected.
+    void ResetSource(uint32_t sourceId, uint64_t timestampNs);
+
+    // Snapshot of queue depths and counters
+    PipelineMetrics GetMetrics() const;
+
+    // Newest published stats. Lock-free and wait-free for the aggregate
+    // stage; readers retry only while a publish is in flight.
+    FrameStats GetLatestStats() const { return m_publishedStats.Read(); }
+
+private:
+    // Message handed to each sink: newest stats plus an optional shared batch
+    struct SinkEvent {
+        FrameStats stats;
+        FrameBatchRef batch;
+    };
+
+    struct SinkSlot {
+        IFrameSink* sink;
+        std::unique_ptr<StageQueue<SinkEvent, SpscQueue>> queue;
+        std::thread thread;
+    };
+
+    PipelineConfig m_config;
+    std::atomic<bool> m_running;
+    std::atomic<bool> m_sinksActive;
+
+    // Declared first so it outlives every FrameBatchRef still sitting in a queue
+    FrameBatchPool m_batchPool;
+
+    StageQueue<FrameSample, MpscQueue> m_ingestQueue;
+    StageQueue<NormalizedFrame, SpscQueue> m_normalizeQueue;
+    std::vector<std::unique_ptr<SinkSlot>> m_sinks;
+
+    std::thread m_normalizeThread;
+    std::thread m_aggregateThread;
+
+    // Normalize stage state (normalize thread only)
+    uint64_t m_lastTimestamp[MAX_FRAME_SOURCES];
+    std::atomic<uint64_t> m_resetTimestamp[MAX_FRAME_SOURCES];  // ResetSource(); any thread
+    std::atomic<uint64_t> m_rejectedFrames;
+
+    // Aggregate stage state (aggregate thread only)
+    uint32_t m_statsSource;
+    uint64_t m_sourceSeenNs[MAX_FRAME_SOURCES];  // Newest frame per source
+    std::vector<float> m_frameTimes;
+    size_t m_frameTimeIndex;
+    float m_smoothedFPS;
+    uint64_t m_frameCount;
+    uint64_t m_hitchCount;
+    uint64_t m_publishSequence;
+    FrameHistogram m_histogram;
+    FrameBatchWriter m_batchWriter;
+    std::atomic<uint64_t> m_batchesPublished;
+    std::atomic<uint64_t> m_unbatchedFrames;
+    std::atomic<uint32_t> m_threadSettingFailures;
+
+    // Stats snapshot shared with every reader
+    Seqlock<FrameStats> m_publishedStats;
+
+    // Stage workers
+    void ApplyThreadSettings();
+    void NormalizeWorker();
+    void AggregateWorker();
+    void SinkWorker(SinkSlot* slot);
+    bool DrainSink(SinkSlot* slot);
+
+    // Stage bodies
+    bool Normalize(const FrameSample& sample, NormalizedFrame& frame);
+    bool FollowSource(const NormalizedFrame& frame);
+    bool Aggregate(const NormalizedFrame& frame, FrameStats& stats);  // False: not the stats' source
+    void PublishStats(FrameStats& stats);
+    void FanOut(SinkEvent& event);
+    FrameBatchRef TakeBatchIfReady(uint64_t nowNs, bool force);
+};
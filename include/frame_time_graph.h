@@ -0,0 +1,100 @@
+#pragma once
+
+#include "compositor.h"
+#include "scrolling_image.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Scrolling frame-time graph for the overlay. Every pixel column stands for
+// `framesPerColumn` frames and is drawn as a bar from the shortest to the
+// longest of them, so a hitch stays visible however many frames share its
+// column. Columns live in a ring buffer one graph wide, and so does the
+// rendered image (a ScrollingImage): a new column is plotted once, over the
+// oldest one, and never touched again. Update() costs O(new columns)
+// whatever the history length; Draw() presents the ring as a scrolled
+// image straight into the renderer's backbuffer.
+//
+// Platform-independent; not thread-safe (the render thread owns it).
+// Steady state is allocation-free: only Resize() allocates.
+
+struct FrameTimeGraphStyle {
+    uint32_t background = 0xFF000000u;  // Premultiplied 0xAARRGGBB, as the compositor draws
+    uint32_t line = 0xFF00FF00u;        // Min..max bars
+    float scaleMs = 50.0f;              // Frame time at the top row; longer frames clip there
+    float guideMs = 1000.0f / 60.0f;    // Faint horizontal line (0 = none)
+    int framesPerColumn = 1;
+
+    bool operator==(const FrameTimeGraphStyle&) const = default;
+};
+
+struct FrameTimeGraphStats {
+    uint64_t frames = 0;          // AddFrameTime() calls
+    uint64_t columns = 0;         // Columns completed
+    uint64_t plottedColumns = 0;  // Columns drawn into the image, full redraws included
+    uint64_t fullRedraws = 0;     // Resize, restyle or Invalidate()
+};
+
+class FrameTimeGraph {
+public:
+    FrameTimeGraph();
+
+    // Graph size in pixels; one column per pixel. Keeps the newest columns
+    // that still fit. Allocates when the size changes.
+    void Resize(int width, int height);
+    int Width() const { return m_width; }
+    int Height() const { return m_height; }
+
+    // A different style redraws every column on the next Update()
+    void SetStyle(const FrameTimeGraphStyle& style);
+    const FrameTimeGraphStyle& GetStyle() const { return m_style; }
+
+    // Add one frame; completes a column every `framesPerColumn` frames
+    void AddFrameTime(float frameTimeMs);
+
+    // Redraw every column on the next Update()
+    void Invalidate();
+
+    // Plot the columns completed since the last call into the image.
+    // Returns whether the image changed; Version() counts the changes.
+    bool Update();
+    uint64_t Version() const { return m_version; }
+
+    // Copy the image, oldest column on the left, with its top-left at
+    // (x, y); clipped to `target`. Call once per dirty rectangle.
+    void Draw(PixelBuffer& target, int x, int y) const;
+
+    FrameTimeGraphStats GetStats() const { return m_stats; }
+
+private:
+    struct Column {
+        float minMs = 0.0f;
+        float maxMs = -1.0f;  // Below minMs: no frames yet
+
+        bool IsEmpty() const { return maxMs < minMs; }
+    };
+
+    FrameTimeGraphStyle m_style;
+    int m_width;
+    int m_height;
+    std::vector<Column> m_columns;  // Ring, m_width long
+    ScrollingImage m_image;         // Ring column i is pixel column i
+    int m_head;                     // Next column to write: the oldest one
+    int m_pending;                  // Completed but not yet plotted, at most m_width
+    bool m_fullRedraw;
+    uint64_t m_version;
+
+    Column m_current;               // Column being filled
+    int m_currentFrames;
+
+    uint32_t m_guideColor;          // Line colour at a quarter over the background
+    int m_guideRow;                 // -1: no guide
+
+    FrameTimeGraphStats m_stats;
+
+    // Private methods
+    void UpdateStyleCache();
+    int RowFor(float frameTimeMs) const;
+    void PlotColumn(int index);
+};
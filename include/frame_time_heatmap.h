@@ -0,0 +1,106 @@
+#pragma once
+
+#include "compositor.h"
+#include "scrolling_image.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Rolling frame-time heatmap for the overlay: x is time (one column per
+// `sliceMs` of frames), y is frame time on a log scale, and the colour of a
+// cell is the share of the slice's frames that fell into it. Pacing that
+// alternates between two frame times shows up as two bands and a periodic
+// hitch as a dotted line, where a min/max graph only shows one thick bar.
+//
+// Frames are binned into the slice being filled as they arrive (the
+// FrameHistogram bucket mapping, then a bucket-to-row table). Closing a
+// slice turns its row counts into palette indices once; plotting a column
+// is then one palette lookup per row, and only new columns are plotted.
+// The image scrolls like the frame-time graph's (a ScrollingImage).
+//
+// Platform-independent; not thread-safe (the render thread owns it).
+// Steady state is allocation-free: only Resize() and a new height or
+// frame-time range allocate.
+
+#define HEATMAP_PALETTE_SIZE 256  // Index 0 is an empty cell
+
+struct FrameTimeHeatmapStyle {
+    uint32_t background = 0xFF000000u;  // Premultiplied 0xAARRGGBB, as the compositor draws
+    uint32_t color = 0xFF00FF00u;       // Ramp: background, then colour, then towards white
+    float minMs = 2.0f;                 // Bottom row; shorter frames land there
+    float maxMs = 100.0f;               // Top row; longer frames land there
+    float sliceMs = 250.0f;             // Frame time per column
+
+    bool operator==(const FrameTimeHeatmapStyle&) const = default;
+};
+
+struct FrameTimeHeatmapStats {
+    uint64_t frames = 0;          // Frames binned
+    uint64_t slices = 0;          // Columns completed
+    uint64_t plottedColumns = 0;  // Columns drawn into the image, full redraws included
+    uint64_t fullRedraws = 0;     // Resize, restyle or Invalidate()
+};
+
+class FrameTimeHeatmap {
+public:
+    FrameTimeHeatmap();
+
+    // Heatmap size in pixels; one slice per column, one row per pixel. A
+    // new width keeps the newest slices, a new height starts over.
+    void Resize(int width, int height);
+    int Width() const { return m_width; }
+    int Height() const { return m_height; }
+
+    // New colours redraw every column on the next Update(); a new
+    // frame-time range starts over
+    void SetStyle(const FrameTimeHeatmapStyle& style);
+    const FrameTimeHeatmapStyle& GetStyle() const { return m_style; }
+
+    // Bin one frame; completes a slice once `sliceMs` of frames are in it
+    void AddFrameTime(float frameTimeMs);
+
+    // Bin a whole histogram of frames (HISTOGRAM_BUCKET_COUNT counts,
+    // indexed by FrameHistogram::BucketForMs) and complete the slice
+    void AddSlice(const uint32_t* bucketCounts);
+
+    // Redraw every column on the next Update()
+    void Invalidate();
+
+    // Plot the slices completed since the last call into the image.
+    // Returns whether the image changed; Version() counts the changes.
+    bool Update();
+    uint64_t Version() const { return m_version; }
+
+    // Copy the image, oldest slice on the left, with its top-left at
+    // (x, y); clipped to `target`. Call once per dirty rectangle.
+    void Draw(PixelBuffer& target, int x, int y) const;
+
+    FrameTimeHeatmapStats GetStats() const { return m_stats; }
+
+private:
+    FrameTimeHeatmapStyle m_style;
+    int m_width;
+    int m_height;
+    std::vector<uint8_t> m_levels;    // Ring of palette indices, one column of m_height after another
+    ScrollingImage m_image;           // Ring column i is pixel column i
+    int m_head;                       // Next column to write: the oldest one
+    int m_pending;                    // Completed but not yet plotted, at most m_width
+    bool m_fullRedraw;
+    uint64_t m_version;
+
+    std::vector<uint32_t> m_current;  // Frames per row in the slice being filled
+    uint32_t m_currentFrames;
+    float m_currentMs;
+
+    std::vector<uint16_t> m_bucketRow;  // FrameHistogram bucket -> row
+    uint32_t m_palette[HEATMAP_PALETTE_SIZE];
+
+    FrameTimeHeatmapStats m_stats;
+
+    // Private methods
+    void Restart();
+    void UpdatePalette();
+    void CloseSlice();
+    void PlotColumn(int index);
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+
+// Platform-independent frame data shared by the pipeline stages.
+// Nothing in here may include <windows.h>; see common.h for the Win32 side.
+
+// Frame sources feeding the pipeline
+#define FRAME_SOURCE_SAMPLER      0  // Fallback polling loop
+#define FRAME_SOURCE_HOOK         1  // Present/SwapBuffers hooks
+#define FRAME_SOURCE_PLUGIN_FIRST 2  // Plugin sources (see plugin_host.h) take the rest
+#define MAX_FRAME_SOURCES         8
+
+// Raw present event as produced by a frame source
+struct FrameSample {
+    uint64_t timestampNs = 0;  // Monotonic clock, nanoseconds
+    uint32_t sourceId = FRAME_SOURCE_SAMPLER;
+};
+
+// Frame after normalization (delta computed, clamped, filtered)
+struct NormalizedFrame {
+    uint64_t timestampNs = 0;
+    float frameTime = 0.0f;    // Seconds
+    uint32_t sourceId = FRAME_SOURCE_SAMPLER;
+};
+
+// Aggregated statistics produced by the aggregate stage. This is also the
+// snapshot published through the pipeline's seqlock, so keep it trivially
+// copyable and small.
+struct FrameStats {
+    float fps = 0.0f;            // Smoothed average FPS
+    float frameTimeMs = 0.0f;    // Frame time matching `fps`
+    float minFrameTimeMs = 0.0f; // Over the averaging window
+    float maxFrameTimeMs = 0.0f; // Over the averaging window
+    float low1Fps = 0.0f;        // 1% low (99th percentile frame time)
+    float low01Fps = 0.0f;       // 0.1% low (99.9th percentile frame time)
+    uint64_t frameCount = 0;     // Frames aggregated since start (stats sources only)
+    uint64_t hitchCount = 0;     // Frames longer than hitchFactor x average
+    uint64_t sequence = 0;       // Increments with every published snapshot
+    uint64_t timestampNs = 0;    // Timestamp of the newest frame included
+    uint32_t sourceId = FRAME_SOURCE_SAMPLER;  // Source these stats follow
+};
+
+// Monotonic timestamp used by every frame source
+inline uint64_t MonotonicNowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "common.h"
+#include "glyph_atlas.h"
+#include "render_resources.h"
+
+// GDI objects for the layered overlay window: 32-bit top-down DIB sections,
+// CreateFontW fonts and solid brushes. Also owns the one memory DC that
+// draws into the backbuffer and measures text, for the renderer's lifetime.
+class GdiRenderBackend : public IRenderResourceBackend {
+public:
+    GdiRenderBackend();
+    ~GdiRenderBackend() override;
+
+    GdiRenderBackend(const GdiRenderBackend&) = delete;
+    GdiRenderBackend& operator=(const GdiRenderBackend&) = delete;
+
+    bool CreateSurface(int width, int height, RenderSurface& surface) override;
+    void DestroySurface(RenderSurface& surface) override;
+    RenderHandle CreateFontFace(const std::wstring& name, int pixelHeight) override;
+    void DestroyFontFace(RenderHandle font) override;
+    RenderHandle CreateBrush(uint32_t rgb) override;
+    void DestroyBrush(RenderHandle brush) override;
+
+    // Memory DC compatible with the screen; nullptr if it couldn't be made
+    HDC GetMemoryDC() const { return m_memDC; }
+
+    // Vertical DPI of the screen the DC is compatible with
+    int QueryDpi() const;
+
+private:
+    HDC m_memDC;
+    HGDIOBJ m_originalBitmap;  // Selected back before a surface is destroyed
+};
+
+// Rasterizes a GDI font into glyph atlas coverage (GetGlyphOutlineW,
+// 65-level grayscale). Selects `font` into `dc` for its own lifetime, so
+// keep it to the scope of one GlyphAtlas::Build().
+class GdiGlyphRasterizer : public IGlyphRasterizer {
+public:
+    GdiGlyphRasterizer(HDC dc, HFONT font);
+    ~GdiGlyphRasterizer() override;
+
+    GdiGlyphRasterizer(const GdiGlyphRasterizer&) = delete;
+    GdiGlyphRasterizer& operator=(const GdiGlyphRasterizer&) = delete;
+
+    bool GetLineMetrics(int& ascent, int& lineHeight) override;
+    bool Rasterize(wchar_t ch, GlyphBitmap& glyph) override;
+
+private:
+    HDC m_dc;
+    HGDIOBJ m_oldFont;
+    TEXTMETRICW m_metrics;
+    bool m_hasMetrics;
+    std::vector<uint8_t> m_outline;  // GGO_GRAY8_BITMAP rows, DWORD-aligned
+};
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Pre-rasterized glyph coverage for one font at one size. The overlay only
+// ever draws short strings of printable ASCII, so the whole range is
+// rasterized once when the font, size or DPI changes; drawing text is then
+// a table lookup and a coverage blit per character (see compositor.h).
+
+#define GLYPH_ATLAS_FIRST 0x20  // ' '
+#define GLYPH_ATLAS_LAST  0x7E  // '~'
+
+// One rasterized glyph as a rasterizer hands it over
+struct GlyphBitmap {
+    int width = 0;              // Coverage box; 0 for blank glyphs (space)
+    int height = 0;
+    int left = 0;               // Pen position to the box's left edge
+    int top = 0;                // Line top to the box's top edge
+    int advance = 0;            // Pen movement after this glyph
+    std::vector<uint8_t> coverage;  // width * height, 0..255, row-major
+};
+
+// Turns characters into coverage bitmaps; one per font backend (GDI, the
+// built-in bitmap font)
+class IGlyphRasterizer {
+public:
+    virtual ~IGlyphRasterizer() = default;
+
+    // Distance from line top to baseline, and from one line top to the next
+    virtual bool GetLineMetrics(int& ascent, int& lineHeight) = 0;
+
+    virtual bool Rasterize(wchar_t ch, GlyphBitmap& glyph) = 0;
+};
+
+// Where a glyph's coverage sits in the atlas
+struct GlyphInfo {
+    int16_t width = 0;
+    int16_t height = 0;
+    int16_t left = 0;
+    int16_t top = 0;
+    int16_t advance = 0;
+    uint32_t offset = 0;  // Into the atlas's coverage storage
+};
+
+class GlyphAtlas {
+public:
+    GlyphAtlas();
+
+    // Rasterize GLYPH_ATLAS_FIRST..GLYPH_ATLAS_LAST; false (and empty) if
+    // the rasterizer fails
+    bool Build(IGlyphRasterizer& rasterizer);
+
+    bool IsEmpty() const { return m_lineHeight == 0; }
+
+    // nullptr outside the atlas's range; such characters draw as '?'
+    const GlyphInfo* Find(wchar_t ch) const {
+        if (ch < GLYPH_ATLAS_FIRST || ch > GLYPH_ATLAS_LAST) return nullptr;
+        return &m_glyphs[ch - GLYPH_ATLAS_FIRST];
+    }
+
+    const uint8_t* Coverage(const GlyphInfo& glyph) const { return m_coverage.data() + glyph.offset; }
+
+    int Ascent() const { return m_ascent; }
+    int LineHeight() const { return m_lineHeight; }
+
+    // Sum of advances; what Compositor::DrawString() will cover horizontally
+    int MeasureText(const wchar_t* text, int length) const;
+
+    size_t CoverageBytes() const { return m_coverage.size(); }
+
+    // Furthest any glyph's coverage reaches left of its pen position or
+    // right of its advance; what a partial text repaint must add either side
+    int Overhang() const { return m_overhang; }
+
+    // '0'-'9' all advance the same, so a reading's width doesn't depend on
+    // its digits (true of the bitmap font and most UI fonts)
+    bool HasTabularDigits() const { return m_tabularDigits; }
+
+private:
+    GlyphInfo m_glyphs[GLYPH_ATLAS_LAST - GLYPH_ATLAS_FIRST + 1];
+    std::vector<uint8_t> m_coverage;  // Every glyph back to back
+    int m_ascent;
+    int m_lineHeight;
+    int m_overhang;
+    bool m_tabularDigits;
+};
+
+// Rasterizer for the built-in 5x7 bitmap font, scaled by whole pixels to
+// the requested line height. Needs no OS font support, so headless builds,
+// benchmarks and golden images get identical glyphs everywhere.
+class BitmapFontRasterizer : public IGlyphRasterizer {
+public:
+    explicit BitmapFontRasterizer(int pixelHeight);
+
+    bool GetLineMetrics(int& ascent, int& lineHeight) override;
+    bool Rasterize(wchar_t ch, GlyphBitmap& glyph) override;
+
+private:
+    int m_scale;  // Font pixels per cell pixel
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "frame_types.h"
+#include "glyph_atlas.h"
+#include "overlay_painter.h"
+#include "render_resources.h"
+#include "widget_layout.h"
+
+#include <cstdint>
+#include <string>
+
+// The overlay drawn into memory instead of a layered window: the same
+// WidgetLayout and OverlayPainter as Renderer, a backbuffer from the
+// headless resource backend and glyphs from the built-in bitmap font, so
+// the result is the same on every machine. Golden-image checks and render
+// benchmarks run on it without a display.
+//
+// Platform-independent; not thread-safe.
+
+struct HeadlessRenderConfig {
+    int fontSize = 16;                // Logical pixels, as OverlayConfig::fontSize
+    int dpi = RENDER_DEFAULT_DPI;
+    WidgetList widgets;               // As OverlayConfig::widgets
+    int graphWidth = 160;
+    int graphHeight = 40;
+    int heatmapWidth = 160;
+    int heatmapHeight = 40;
+    OverlayPaintStyle style;
+};
+
+class HeadlessRenderer {
+public:
+    HeadlessRenderer();
+
+    HeadlessRenderer(const HeadlessRenderer&) = delete;
+    HeadlessRenderer& operator=(const HeadlessRenderer&) = delete;
+
+    // One frame for the graph and the heatmap; shows up on the next Render()
+    void AddFrameTime(float frameTimeMs);
+
+    // Draw the widgets showing `stats` the way the window would. Returns
+    // how much was repainted, as Renderer::RenderOverlay().
+    DamageKind Render(const FrameStats& stats, const HeadlessRenderConfig& config);
+
+    // Everything is repainted by the next Render()
+    void Invalidate();
+
+    // The last frame: what the window would show, 0xAARRGGBB (BGRA in
+    // memory) with `stride` at least `width`. Valid until the next Render().
+    PixelBuffer GetFramebuffer() const { return m_framebuffer; }
+
+    // The last frame as tightly packed R, G, B, A bytes, width * height * 4
+    void CopyRgba(uint8_t* rgba) const;
+
+    // FNV-1a over the last frame's size and visible pixels; stride and
+    // backbuffer slack don't count
+    uint64_t Hash() const;
+
+    // Binary PPM of the premultiplied colour, i.e. the overlay over black
+    // (alpha dropped). False if the file can't be written.
+    bool WritePpm(const std::string& path) const;
+
+    const WidgetLayout& GetLayout() const { return m_layout; }
+    const OverlayPainter& GetPainter() const { return m_painter; }
+    RenderResourceStats GetResourceStats() const { return m_resources.GetStats(); }
+
+private:
+    HeadlessRenderBackend m_backend;
+    RenderResourceCache m_resources;  // Uses m_backend
+    GlyphAtlas m_atlas;
+    int m_atlasPixelHeight;           // 0: not built yet
+    WidgetLayout m_layout;
+    OverlayPainter m_painter;
+    PixelBuffer m_framebuffer;
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common.h"
+#include "frame_pipeline.h"
 
 class HookManager {
 public:
@@ -24,10 +25,18 @@ public:
     
     // Force refresh hooks (useful when switching applications)
     void RefreshHooks();
+    
+    // Route hooked presents into the frame pipeline (nullptr to detach)
+    void SetFramePipeline(FramePipeline* pipeline) { m_framePipeline = pipeline; }
+    
+    // Report hooked presents as activity so an idle overlay wakes up
+    void SetActivityGovernor(ActivityGovernor* governor) { m_activityGovernor = governor; }
 
 private:
     bool m_active;
     GraphicsAPI m_detectedAPI;
+    std::atomic<FramePipeline*> m_framePipeline;
+    std::atomic<ActivityGovernor*> m_activityGovernor;
     
     // Hook addresses
     void* m_d3d9PresentAddr;
@@ -59,6 +68,7 @@ private:
     static BOOL WINAPI SwapBuffersHook(HDC hdc);
     
     // Helper functions
+    void ReportPresent();
     void* GetProcAddressFromModule(const wchar_t* moduleName, const char* procName);
     bool GetD3D9PresentAddress(void** address);
     bool GetD3D11PresentAddress(void** address);
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// INI text parsed once into memory, answering lookups the way
+// GetPrivateProfileString does: section and key names are case-insensitive,
+// the first occurrence of a key wins, values are trimmed and one pair of
+// surrounding quotes is removed, and lines starting with ';' or '#' are
+// comments. Text is UTF-8 (a leading BOM is skipped).
+class IniFile {
+public:
+    IniFile() = default;
+
+    static IniFile Parse(std::string_view text);
+
+    // Read and parse the whole file; false if it can't be read
+    bool Load(const std::filesystem::path& path);
+
+    // nullptr if the key is missing
+    const std::string* Find(std::string_view section, std::string_view key) const;
+
+    std::string GetString(std::string_view section, std::string_view key, std::string_view defaultValue) const;
+
+    // Leading decimal integer, 0 if there is none (GetPrivateProfileInt)
+    int GetInt(std::string_view section, std::string_view key, int defaultValue) const;
+
+    bool GetBool(std::string_view section, std::string_view key, bool defaultValue) const;
+    float GetFloat(std::string_view section, std::string_view key, float defaultValue) const;
+
+    size_t Size() const { return m_values.size(); }
+
+private:
+    std::unordered_map<std::string, std::string> m_values;  // "section\nkey", lowercase
+
+    static std::string MakeKey(std::string_view section, std::string_view key);
+};
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "io_task.h"
+#include "thread_affinity.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Asynchronous file I/O for coroutines.
+//
+//   IoResult result = co_await executor.WriteFile(path, std::move(bytes), IoWriteMode::REPLACE);
+//
+// Windows: files are opened with FILE_FLAG_OVERLAPPED and bound to an I/O
+// completion port; one completion thread resumes the awaiting coroutines.
+// Elsewhere: one I/O thread performs the (blocking) calls and resumes the
+// coroutines itself. Either way the thread that issued the request only
+// suspends; it never waits on the disk.
+
+enum class IoWriteMode {
+    REPLACE = 0,  // Write to "<path>.tmp", then rename over <path> (atomic)
+    APPEND = 1    // Append to <path>, creating it if needed
+};
+
+struct IoResult {
+    bool ok = false;
+    uint32_t error = 0;       // errno / GetLastError() of the failing call
+    size_t bytes = 0;         // Bytes written or read
+    std::vector<char> data;   // ReadFile only
+};
+
+struct IoExecutorStats {
+    uint64_t submitted = 0;
+    uint64_t completed = 0;
+    uint64_t failed = 0;
+    uint64_t bytesWritten = 0;
+    uint64_t bytesRead = 0;
+    size_t inFlight = 0;
+};
+
+class IoExecutor {
+public:
+    struct Request;
+
+    // Awaitable for one request; resumes on the executor's I/O thread
+    class Operation {
+    public:
+        Operation(IoExecutor* executor, std::unique_ptr<Request> request);
+        Operation(Operation&&) noexcept;
+        ~Operation();
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> awaiting);
+        IoResult await_resume();
+
+    private:
+        IoExecutor* m_executor;
+        std::unique_ptr<Request> m_request;
+    };
+
+    IoExecutor();
+    ~IoExecutor();
+
+    IoExecutor(const IoExecutor&) = delete;
+    IoExecutor& operator=(const IoExecutor&) = delete;
+
+    // Process-wide executor. Holders keep it alive, so objects destroyed
+    // during static teardown can still finish their writes.
+    static std::shared_ptr<IoExecutor> Shared();
+
+    Operation WriteFile(const std::filesystem::path& path, std::vector<char> data,
+                        IoWriteMode mode = IoWriteMode::REPLACE);
+    Operation ReadFile(const std::filesystem::path& path);
+
+    // Block until every submitted request has completed (not from the I/O
+    // thread itself)
+    void Drain();
+
+    // Pinning and priority of the I/O thread; it picks them up before
+    // starting its next request
+    void SetThreadSettings(uint64_t affinityMask, ThreadPriority priority);
+
+    IoExecutorStats GetStats() const;
+
+private:
+    void* m_port;  // I/O completion port (Windows only)
+    std::thread m_thread;
+    std::atomic<bool> m_stopping;
+    std::atomic<uint64_t> m_affinityMask;
+    std::atomic<ThreadPriority> m_priority;
+    std::atomic<bool> m_threadSettingsChanged;
+
+    // Submission queue (thread backend) and drain bookkeeping
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::condition_variable m_drainCv;
+    std::deque<Request*> m_pending;
+    size_t m_inFlight;
+
+    std::atomic<uint64_t> m_submitted;
+    std::atomic<uint64_t> m_completed;
+    std::atomic<uint64_t> m_failed;
+    std::atomic<uint64_t> m_bytesWritten;
+    std::atomic<uint64_t> m_bytesRead;
+
+    void Submit(Request* request);
+    void Complete(Request* request);
+    void IoWorker();
+    void ApplyThreadSettings();  // I/O thread
+
+    // Platform backend
+    void Start(Request* request);
+    static void RunBlocking(Request* request);
+};
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+// Minimal C++20 coroutine task for I/O work.
+//
+//   Task<bool> Save() { IoResult r = co_await io.WriteFile(...); co_return r.ok; }
+//
+// Tasks are lazy: nothing runs until the task is awaited, handed to Spawn()
+// (fire and forget) or to SyncWait() (block the calling thread). After an
+// I/O await the coroutine continues on the IoExecutor's completion thread,
+// so callers on the sampler or render threads never wait for the disk.
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+// Resumes whoever awaited the task once it finishes (symmetric transfer,
+// so long await chains don't grow the stack)
+struct TaskFinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+        std::coroutine_handle<> continuation = handle.promise().continuation;
+        return continuation ? continuation : std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+};
+
+struct TaskPromiseBase {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr error;
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    TaskFinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+};
+
+template <typename T>
+struct TaskPromise : TaskPromiseBase {
+    std::optional<T> value;
+
+    Task<T> get_return_object() noexcept;
+    void return_value(T result) { value = std::move(result); }
+
+    T Result() {
+        if (error) std::rethrow_exception(error);
+        return std::move(*value);
+    }
+};
+
+template <>
+struct TaskPromise<void> : TaskPromiseBase {
+    Task<void> get_return_object() noexcept;
+    void return_void() const noexcept {}
+
+    void Result() {
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+} // namespace detail
+
+template <typename T>
+class Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task() noexcept = default;
+    explicit Task(Handle handle) noexcept : m_handle(handle) {}
+    Task(Task&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (m_handle) m_handle.destroy();
+            m_handle = std::exchange(other.m_handle, nullptr);
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+        if (m_handle) m_handle.destroy();
+    }
+
+    bool Valid() const noexcept { return static_cast<bool>(m_handle); }
+
+    // co_await starts the task and resumes the awaiter when it completes
+    auto operator co_await() noexcept {
+        struct Awaiter {
+            Handle handle;
+            bool await_ready() const noexcept { return !handle || handle.done(); }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+            T await_resume() { return handle.promise().Result(); }
+        };
+        return Awaiter{m_handle};
+    }
+
+private:
+    Handle m_handle;
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+// Eagerly started, self-destroying coroutine used by Spawn()
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept {}  // Spawned work reports its own errors
+    };
+};
+
+template <typename T>
+DetachedTask RunDetached(Task<T> task) {
+    co_await task;
+}
+
+// Signals a waiting thread when the awaited task finishes
+struct SyncLatch {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+
+    void Set() {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        cv.notify_all();
+    }
+
+    void Wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this]() { return done; });
+    }
+};
+
+template <typename T>
+DetachedTask RunAndSignal(Task<T>& task, SyncLatch& latch, std::optional<T>& result,
+                          std::exception_ptr& error) {
+    try {
+        result.emplace(co_await task);
+    } catch (...) {
+        error = std::current_exception();
+    }
+    latch.Set();
+}
+
+inline DetachedTask RunAndSignal(Task<void>& task, SyncLatch& latch, std::exception_ptr& error) {
+    try {
+        co_await task;
+    } catch (...) {
+        error = std::current_exception();
+    }
+    latch.Set();
+}
+
+} // namespace detail
+
+// Start a task without waiting for it; its frame frees itself when done
+template <typename T>
+void Spawn(Task<T> task) {
+    detail::RunDetached(std::move(task));
+}
+
+// Run a task to completion, blocking the calling thread. Must not be called
+// from the IoExecutor's completion thread (it would wait on itself).
+template <typename T>
+T SyncWait(Task<T> task) {
+    detail::SyncLatch latch;
+    std::optional<T> result;
+    std::exception_ptr error;
+    detail::RunAndSignal(task, latch, result, error);
+    latch.Wait();
+    if (error) std::rethrow_exception(error);
+    return std::move(*result);
+}
+
+inline void SyncWait(Task<void> task) {
+    detail::SyncLatch latch;
+    std::exception_ptr error;
+    detail::RunAndSignal(task, latch, error);
+    latch.Wait();
+    if (error) std::rethrow_exception(error);
+}
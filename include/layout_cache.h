@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Remembers where the overlay went for a given set of inputs, so a frame
+// whose text has the same shape as one drawn before skips measuring the
+// text and placing the window. The key is everything those depend on: the
+// monitor, DPI, font, placement settings and the text's width class, i.e.
+// the text with its digits folded together when the font's digits all
+// advance the same. "FPS: 59.9" and "FPS: 61.2" then share an entry, and a
+// steady overlay hits the cache on every frame.
+//
+// Entries describe the display they were measured on; Invalidate() on
+// display changes (mode, DPI, monitors coming and going). Platform-
+// independent; not thread-safe (the render thread owns it).
+
+#define LAYOUT_CACHE_ENTRIES 16  // Least recently used goes first
+
+struct LayoutKey {
+    uint64_t monitor = 0;     // Native monitor handle; 0 for the primary/headless screen
+    int dpi = 0;
+    uint64_t font = 0;        // Face, size and how text is measured (atlas or native)
+    uint64_t placement = 0;   // Position, offsets, widget sizes
+    uint64_t widthClass = 0;  // LayoutCache::WidthClass() of the text
+
+    bool operator==(const LayoutKey&) const = default;
+};
+
+// What measuring and placing produced
+struct LayoutEntry {
+    int textWidth = 0;   // Widest line
+    int lineHeight = 0;
+    int lines = 0;
+    int x = 0;           // Window position on the virtual screen
+    int y = 0;
+};
+
+struct LayoutCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;         // Measured and placed
+    uint64_t invalidations = 0;
+};
+
+class LayoutCache {
+public:
+    LayoutCache();
+
+    // nullptr on a miss; valid until the next Store() or Invalidate()
+    const LayoutEntry* Find(const LayoutKey& key);
+
+    void Store(const LayoutKey& key, const LayoutEntry& entry);
+
+    // Drop every entry (display change)
+    void Invalidate();
+
+    LayoutCacheStats GetStats() const { return m_stats; }
+
+    // FNV-1a over the text with '0'-'9' counted as one character when
+    // `foldDigits` (the font's digits advance the same): texts of one
+    // class measure the same
+    static uint64_t WidthClass(const wchar_t* text, int length, bool foldDigits);
+
+    // FNV-1a step, for building keys
+    static uint64_t Mix(uint64_t hash, uint64_t value) { return (hash ^ value) * 1099511628211ull; }
+
+private:
+    struct Slot {
+        LayoutKey key;
+        LayoutEntry entry;
+        uint64_t lastUse = 0;
+    };
+
+    std::vector<Slot> m_slots;  // At most LAYOUT_CACHE_ENTRIES
+    uint64_t m_useClock;
+    LayoutCacheStats m_stats;
+};
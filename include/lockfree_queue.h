@@ -0,0 +1,289 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Bounded lock-free queues used to connect the frame pipeline stages.
+// Capacities are rounded up to a power of two. The push/pop paths never
+// take a lock; the Doorbell below is only touched when a side has to sleep.
+
+#define QUEUE_CACHE_LINE 64
+
+// What a producer does when the downstream queue is full
+enum class BackpressurePolicy {
+    DROP = 0,   // Discard the new item and count it
+    BLOCK = 1   // Wait until the consumer makes room
+};
+
+// Depth and throughput counters reported by every stage queue
+struct QueueStats {
+    size_t depth = 0;
+    size_t capacity = 0;
+    size_t highWatermark = 0;
+    uint64_t pushed = 0;
+    uint64_t popped = 0;
+    uint64_t dropped = 0;
+    uint64_t blocked = 0;
+};
+
+inline size_t RoundUpPowerOfTwo(size_t value) {
+    size_t result = 2;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+// Single-producer single-consumer ring buffer
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity)
+        : m_buffer(RoundUpPowerOfTwo(capacity))
+        , m_mask(m_buffer.size() - 1)
+        , m_head(0)
+        , m_tail(0)
+    {
+    }
+
+    bool TryPush(const T& item) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_headCache >= m_buffer.size()) {
+            m_headCache = m_head.load(std::memory_order_acquire);
+            if (tail - m_headCache >= m_buffer.size()) return false;
+        }
+        m_buffer[tail & m_mask] = item;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPop(T& item) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tailCache) {
+            m_tailCache = m_tail.load(std::memory_order_acquire);
+            if (head == m_tailCache) return false;
+        }
+        item = std::move(m_buffer[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t Depth() const {
+        size_t tail = m_tail.load(std::memory_order_acquire);
+        size_t head = m_head.load(std::memory_order_acquire);
+        return tail >= head ? tail - head : 0;
+    }
+
+    size_t Capacity() const { return m_buffer.size(); }
+
+private:
+    std::vector<T> m_buffer;
+    size_t m_mask;
+
+    alignas(QUEUE_CACHE_LINE) std::atomic<size_t> m_head;  // Written by consumer
+    size_t m_tailCache = 0;                                  // Consumer-local
+    alignas(QUEUE_CACHE_LINE) std::atomic<size_t> m_tail;  // Written by producer
+    size_t m_headCache = 0;                                  // Producer-local
+};
+
+// Multi-producer single-consumer bounded queue (per-cell sequence numbers)
+template <typename T>
+class MpscQueue {
+public:
+    explicit MpscQueue(size_t capacity)
+        : m_cells(RoundUpPowerOfTwo(capacity))
+        , m_mask(m_cells.size() - 1)
+        , m_head(0)
+        , m_tail(0)
+    {
+        for (size_t i = 0; i < m_cells.size(); ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool TryPush(const T& item) {
+        size_t pos = m_tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = m_cells[pos & m_mask];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = item;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // Full
+            } else {
+                pos = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool TryPop(T& item) {
+        size_t pos = m_head.load(std::memory_order_relaxed);
+        Cell& cell = m_cells[pos & m_mask];
+        size_t seq = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0) {
+            return false;  // Empty
+        }
+        item = std::move(cell.value);
+        cell.sequence.store(pos + m_cells.size(), std::memory_order_release);
+        m_head.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t Depth() const {
+        size_t tail = m_tail.load(std::memory_order_acquire);
+        size_t head = m_head.load(std::memory_order_acquire);
+        return tail >= head ? tail - head : 0;
+    }
+
+    size_t Capacity() const { return m_cells.size(); }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+
+        Cell() : sequence(0), value() {}
+        Cell(const Cell& other) : sequence(other.sequence.load()), value(other.value) {}
+    };
+
+    std::vector<Cell> m_cells;
+    size_t m_mask;
+
+    alignas(QUEUE_CACHE_LINE) std::atomic<size_t> m_head;
+    alignas(QUEUE_CACHE_LINE) std::atomic<size_t> m_tail;
+};
+
+// Sleep/wake helper for stage threads. Ring() only takes the mutex when
+// somebody is actually waiting, so the hot path stays lock-free.
+class Doorbell {
+public:
+    Doorbell() : m_waiters(0), m_pending(false) {}
+
+    void Ring() {
+        m_pending.store(true);
+        if (m_waiters.load() > 0) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_cv.notify_all();
+        }
+    }
+
+    // Returns early if Ring() was called since the last wait
+    void Wait(std::chrono::microseconds timeout) {
+        if (m_pending.exchange(false)) return;
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_waiters.fetch_add(1);
+        m_cv.wait_for(lock, timeout, [this]() { return m_pending.load(); });
+        m_waiters.fetch_sub(1);
+        m_pending.store(false);
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::atomic<int> m_waiters;
+    std::atomic<bool> m_pending;
+};
+
+// Queue plus backpressure policy, doorbells and metrics for one pipeline edge
+template <typename T, template <typename> class Queue>
+class StageQueue {
+public:
+    StageQueue(size_t capacity, BackpressurePolicy policy)
+        : m_queue(capacity)
+        , m_policy(policy)
+        , m_highWatermark(0)
+        , m_pushed(0)
+        , m_popped(0)
+        , m_dropped(0)
+        , m_blocked(0)
+    {
+    }
+
+    // Push according to the backpressure policy. `running` lets a blocked
+    // producer bail out when the pipeline shuts down.
+    bool Push(const T& item, const std::atomic<bool>& running) {
+        if (!m_queue.TryPush(item)) {
+            if (m_policy == BackpressurePolicy::DROP) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            m_blocked.fetch_add(1, std::memory_order_relaxed);
+            while (!m_queue.TryPush(item)) {
+                if (!running.load(std::memory_order_acquire)) {
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                m_notFull.Wait(std::chrono::microseconds(1000));
+            }
+        }
+
+        m_pushed.fetch_add(1, std::memory_order_relaxed);
+        UpdateWatermark();
+        m_notEmpty.Ring();
+        return true;
+    }
+
+    bool TryPop(T& item) {
+        if (!m_queue.TryPop(item)) return false;
+        m_popped.fetch_add(1, std::memory_order_relaxed);
+        if (m_policy == BackpressurePolicy::BLOCK) {
+            m_notFull.Ring();
+        }
+        return true;
+    }
+
+    // Wait for work on the consumer side
+    void WaitForItems(std::chrono::microseconds timeout) {
+        if (m_queue.Depth() == 0) {
+            m_notEmpty.Wait(timeout);
+        }
+    }
+
+    // Wake a consumer without pushing (used on shutdown)
+    void Wake() { m_notEmpty.Ring(); m_notFull.Ring(); }
+
+    BackpressurePolicy GetPolicy() const { return m_policy; }
+
+    QueueStats GetStats() const {
+        QueueStats stats;
+        stats.depth = m_queue.Depth();
+        stats.capacity = m_queue.Capacity();
+        stats.highWatermark = m_highWatermark.load(std::memory_order_relaxed);
+        stats.pushed = m_pushed.load(std::memory_order_relaxed);
+        stats.popped = m_popped.load(std::memory_order_relaxed);
+        stats.dropped = m_dropped.load(std::memory_order_relaxed);
+        stats.blocked = m_blocked.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    Queue<T> m_queue;
+    BackpressurePolicy m_policy;
+    Doorbell m_notEmpty;
+    Doorbell m_notFull;
+
+    std::atomic<size_t> m_highWatermark;
+    std::atomic<uint64_t> m_pushed;
+    std::atomic<uint64_t> m_popped;
+    std::atomic<uint64_t> m_dropped;
+    std::atomic<uint64_t> m_blocked;
+
+    void UpdateWatermark() {
+        size_t depth = m_queue.Depth();
+        size_t current = m_highWatermark.load(std::memory_order_relaxed);
+        while (depth > current &&
+               !m_highWatermark.compare_exchange_weak(current, depth, std::memory_order_relaxed)) {
+        }
+    }
+};
@@ -81,6 +81,7 @@ private:
     std::map<int, MenuOption> m_options;
     bool m_running;
     bool m_initialized;
+    std::wstring m_headerInfo;  // System info lines, filled on the first draw
     
     // Menu display helpers
     void DisplayHeader();
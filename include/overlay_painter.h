@@ -0,0 +1,80 @@
+#pragma once
+
+#include "compositor.h"
+#include "damage_tracker.h"
+#include "frame_time_graph.h"
+#include "frame_time_heatmap.h"
+#include "glyph_atlas.h"
+#include "widget_layout.h"
+
+#include <cstdint>
+
+// What the overlay's pixels look like, independent of where they end up:
+// paints a WidgetLayout's text widgets, frame-time graph and heatmap, tracks
+// damage against the previous frame and repaints only the dirty rectangles
+// of a 32-bit backbuffer with per-pixel alpha: a translucent rounded panel,
+// then the widgets over it. Only widgets whose text version moved are
+// compared at all, so a frame where one of ten readings changed costs about
+// what a single one would. Renderer hands it a layered window's DIB
+// section; HeadlessRenderer a block of memory, so the exact pixels the
+// window would show can be checked and timed without a display.
+//
+// Platform-independent; not thread-safe (the render thread owns it).
+
+#define OVERLAY_CORNER_RADIUS 6    // Panel corners; within the padding, so content is never cut
+
+struct OverlayPaintStyle {
+    uint32_t textColor = 0xFF00FF00u;        // Straight 0xAARRGGBB; premultiplied for drawing
+    uint32_t backgroundColor = 0x80000000u;  // The panel behind everything
+    bool showBackground = true;              // Else the panel is transparent
+    int cornerRadius = OVERLAY_CORNER_RADIUS;
+
+    FrameTimeGraphStyle graph;               // Colours are taken from the text and panel;
+    FrameTimeHeatmapStyle heatmap;           // sizes from the layout's cells
+};
+
+class OverlayPainter {
+public:
+    OverlayPainter();
+
+    // One frame for the graph and the heatmap; shows up on the next Prepare()
+    void AddFrameTime(float frameTimeMs);
+
+    // Bring the graph and heatmap up to `style` and their cells in `layout`,
+    // plotting only the columns completed since the last call
+    void Prepare(const WidgetLayout& layout, const OverlayPaintStyle& style);
+
+    // Compare the frame with the previous one and repaint what changed into
+    // `surface` (at least layout.Width() x layout.Height()). `styleKey`
+    // stands for anything outside the style that changes what the window
+    // shows, such as its position; a new style, layout or surface repaints
+    // everything. Without an atlas the text isn't drawn: any change comes
+    // back FULL, with a square panel and the graphs painted, for the caller
+    // to draw the text widgets over (see Renderer's GDI fallback).
+    DamageKind Paint(PixelBuffer& surface, const GlyphAtlas* atlas, const WidgetLayout& layout, uint64_t styleKey);
+
+    // Everything is repainted next time (new font, display change)
+    void Invalidate();
+
+    // Valid after Paint(), as DamageTracker's
+    const DamageTracker& GetDamage() const { return m_damage; }
+    DamageStats GetDamageStats() const { return m_damage.GetStats(); }
+    FrameTimeGraphStats GetGraphStats() const { return m_graph.GetStats(); }
+    FrameTimeHeatmapStats GetHeatmapStats() const { return m_heatmap.GetStats(); }
+
+private:
+    OverlayPaintStyle m_style;
+    uint32_t m_textColor;              // Premultiplied
+    uint32_t m_panelColor;             // Premultiplied; 0 without a background
+    DamageTracker m_damage;
+    FrameTimeGraph m_graph;
+    FrameTimeHeatmap m_heatmap;
+    const uint32_t* m_damagedSurface;  // Backbuffer the retained pixels live in; nullptr: none
+    uint64_t m_damagedLayout;          // WidgetLayout::Key() they were painted for
+    uint64_t m_damagedStyle;           // StyleKey() they were painted with
+    uint64_t m_paintedVersions[WIDGET_LAYOUT_MAX_WIDGETS];  // Text versions the tracker holds
+
+    // Private methods
+    uint64_t StyleKey(uint64_t styleKey) const;
+    static DamageRect InkBounds(const WidgetCell& cell, const GlyphAtlas& atlas);
+};
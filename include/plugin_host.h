@@ -0,0 +1,127 @@
+#pragma once
+
+#include "fps_plugin_abi.h"
+#include "frame_pipeline.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+class ActivityGovernor;
+
+// Loads frame source/sink plugins (see fps_plugin_abi.h) and connects them
+// to a FramePipeline.
+//
+// Lifecycle, all from the owning thread:
+//
+//   LoadDirectory() / Load()   before pipeline.Start(); sinks are added here
+//   StartSources()             after pipeline.Start()
+//   StopSources()              before pipeline.Stop()
+//   Unload()                   after pipeline.Stop(); also run by the destructor
+//
+// Sink calls arrive on the pipeline's sink threads. A plugin that fails to
+// load (wrong ABI version, missing exports, init error) is skipped and
+// reported through the log callback; it never stops the others.
+
+// Wraps a C sink (from a plugin or an fps_core_c.h embedder) as an
+// IFrameSink; batches are passed through in place
+class PluginSink : public IFrameSink {
+public:
+    explicit PluginSink(const FpsSinkV1& sink);
+
+    void Consume(const FrameStats& stats) override;
+    void ConsumeBatch(const FrameBatchRef& batch) override;
+
+    const std::string& Name() const { return m_name; }
+
+private:
+    FpsSinkV1 m_sink;
+    std::string m_name;
+};
+
+// FrameStats as the C ABI sees it
+FpsStats ToPluginStats(const FrameStats& stats);
+
+// Copy a size-prefixed ABI struct coming in from C: fields the caller didn't
+// know about stay zero, fields we don't know about are ignored
+template <typename T>
+T CopyVersioned(const T* from) {
+    T to;
+    std::memset(&to, 0, sizeof(to));
+    std::memcpy(&to, from, std::min<size_t>(from->size, sizeof(T)));
+    to.size = sizeof(T);
+    return to;
+}
+
+// Write a struct out to a C caller, no further than the size it declared
+template <typename T>
+void CopyVersionedOut(const T& from, T* to) {
+    uint32_t size = to->size;
+    std::memcpy(to, &from, std::min<size_t>(size, sizeof(T)));
+    to->size = static_cast<uint32_t>(std::min<size_t>(size, sizeof(T)));
+}
+
+struct PluginInfo {
+    std::filesystem::path path;
+    std::vector<std::string> sinks;
+    std::vector<std::string> sources;
+};
+
+class PluginHost {
+public:
+    using LogCallback = std::function<void(int level, const std::string& message)>;
+
+    explicit PluginHost(FramePipeline& pipeline, ActivityGovernor* activity = nullptr);
+    ~PluginHost();
+
+    PluginHost(const PluginHost&) = delete;
+    PluginHost& operator=(const PluginHost&) = delete;
+
+    // Load failures and the plugins' own log calls (FPS_PLUGIN_LOG_* levels).
+    // Plugins may log from their own threads.
+    void SetLogCallback(LogCallback callback) { m_log = std::move(callback); }
+
+    // Every shared library directly in `directory`, in name order. Returns
+    // how many loaded; a missing directory is not an error.
+    size_t LoadDirectory(const std::filesystem::path& directory,
+                         BackpressurePolicy sinkPolicy = BackpressurePolicy::DROP);
+    bool Load(const std::filesystem::path& file, BackpressurePolicy sinkPolicy = BackpressurePolicy::DROP);
+
+    void StartSources();
+    void StopSources();
+    void Unload();
+
+    std::vector<PluginInfo> GetPlugins() const;
+
+    // The table handed to plugins and the adapters wrapping their sinks;
+    // exposed for benchmarks
+    const FpsHostApiV1& GetHostApi() const { return m_api; }
+    std::vector<IFrameSink*> GetSinks() const;
+
+private:
+    struct Plugin;
+    struct Source;
+
+    FramePipeline& m_pipeline;
+    ActivityGovernor* m_activity;
+    FpsHostApiV1 m_api;
+    LogCallback m_log;
+
+    std::vector<std::unique_ptr<Plugin>> m_plugins;
+    Plugin* m_loading;  // Plugin inside fps_plugin_init(), if any
+    uint32_t m_nextSourceId;
+    bool m_sourcesStarted;
+
+    void Log(int level, const std::string& message) const;
+
+    // FpsHostApiV1 entry points; `host` is the PluginHost
+    static int RegisterSink(void* host, const FpsSinkV1* sink);
+    static int RegisterSource(void* host, const FpsSourceV1* source);
+    static uint32_t SubmitPresents(void* host, uint32_t sourceId, const uint64_t* timestampsNs, uint32_t count);
+    static uint64_t NowNs(void* host);
+    static void PluginLog(void* host, int level, const char* message);
+};
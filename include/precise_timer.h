@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Precise sleeping and fixed-rate pacing on the MonotonicNowNs() clock.
+//
+// OS sleeps overshoot by up to a scheduler quantum (about 1-16 ms on Windows
+// depending on timer resolution, 50-100 us on Linux). Sampler timestamps
+// inherit that overshoot, so the fallback FPS reading does too. PreciseTimer
+// sleeps coarsely until shortly before the deadline and spins for the rest:
+//
+//   COARSE - OS sleep only (lowest CPU, least precise)
+//   HYBRID - OS sleep until `spinThreshold` before the deadline, then spin
+//   SPIN   - spin (yielding) the whole time (highest CPU, most precise)
+//
+// The coarse sleep uses clock_nanosleep(TIMER_ABSTIME) on POSIX and a
+// high-resolution waitable timer on Windows 10 1803+. Before that only a
+// regular waitable timer (about 15.6 ms granularity) is available, and
+// HYBRID falls back to COARSE rather than spin most of every period.
+
+#define PACING_DEFAULT_SPIN_US 1500
+#define PACING_MAX_SPIN_US 20000
+
+enum class PacingMode {
+    COARSE = 0,
+    HYBRID = 1,
+    SPIN = 2
+};
+
+// Summary of measured wakeup lateness (wake time minus deadline)
+struct JitterStats {
+    uint64_t samples = 0;
+    uint64_t missedDeadlines = 0;  // Whole periods skipped by a FramePacer
+    float meanUs = 0.0f;
+    float p50Us = 0.0f;
+    float p99Us = 0.0f;
+    float maxUs = 0.0f;
+};
+
+// Lock-free lateness histogram: one writer (the paced thread), any number
+// of readers. Buckets are log-spaced with 4 sub-buckets per power of two,
+// so percentiles are accurate to about 19%.
+class JitterMeter {
+public:
+    JitterMeter();
+
+    void Record(uint64_t latenessNs);
+    void RecordMissed(uint64_t periods);
+    void Reset();
+
+    JitterStats GetStats() const;
+
+private:
+    static constexpr size_t SUB_BUCKET_BITS = 2;
+    static constexpr size_t BUCKET_COUNT = 64 << SUB_BUCKET_BITS;
+
+    std::atomic<uint64_t> m_buckets[BUCKET_COUNT];
+    std::atomic<uint64_t> m_samples;
+    std::atomic<uint64_t> m_totalNs;
+    std::atomic<uint64_t> m_maxNs;
+    std::atomic<uint64_t> m_missed;
+
+    static size_t BucketFor(uint64_t ns);
+    static uint64_t BucketUpperNs(size_t bucket);
+};
+
+class PreciseTimer {
+public:
+    // `periodNs` is how often SleepUntil() is called, if it is (FramePacer);
+    // HYBRID then never spins for more than half of it
+    explicit PreciseTimer(PacingMode mode = PacingMode::HYBRID,
+                          uint32_t spinThresholdUs = PACING_DEFAULT_SPIN_US, uint64_t periodNs = 0);
+    ~PreciseTimer();
+
+    PreciseTimer(const PreciseTimer&) = delete;
+    PreciseTimer& operator=(const PreciseTimer&) = delete;
+
+    // Block until MonotonicNowNs() >= deadlineNs; returns the wake time
+    uint64_t SleepUntil(uint64_t deadlineNs);
+
+    // As constructed, or COARSE for HYBRID without a high-resolution timer
+    PacingMode GetMode() const { return m_mode; }
+    uint32_t GetSpinThresholdUs() const { return m_spinThresholdUs; }
+
+    // True when the OS timer supports sub-millisecond resolution
+    bool HasHighResolutionTimer() const { return m_highResolution; }
+
+private:
+    PacingMode m_mode;
+    uint32_t m_spinThresholdUs;
+    void* m_timer;          // Waitable timer handle (Windows only)
+    bool m_highResolution;
+
+    // Recent coarse-sleep overshoot (rises fast, decays slowly, also while
+    // no sleep is taken). HYBRID spins for at least this long so a late OS
+    // timer still lands on time, but never for more than m_maxMarginNs:
+    // one bad wake must not leave every later deadline inside the margin.
+    uint64_t m_overshootNs;
+    uint64_t m_maxMarginNs;
+
+    void CoarseSleepUntil(uint64_t deadlineNs);
+    static void SpinUntil(uint64_t deadlineNs, bool yield);
+};
+
+// Fixed-rate loop pacing: Wait() returns once per period, measured from
+// the previous deadline rather than from wakeup so lateness does not
+// accumulate. Missed periods are skipped, not replayed.
+class FramePacer {
+public:
+    FramePacer(uint64_t periodNs, PacingMode mode, uint32_t spinThresholdUs);
+
+    // Sleep until the next deadline; returns the wake time
+    uint64_t Wait();
+
+    // Restart the deadline sequence from now
+    void Reset();
+
+    uint64_t GetPeriodNs() const { return m_periodNs; }
+    PacingMode GetMode() const { return m_timer.GetMode(); }
+    JitterStats GetJitter() const { return m_jitter.GetStats(); }
+
+private:
+    PreciseTimer m_timer;
+    JitterMeter m_jitter;
+    uint64_t m_periodNs;
+    uint64_t m_nextDeadlineNs;
+};
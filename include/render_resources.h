@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Drawing resources the overlay keeps between frames: the backbuffer, fonts
+// and brushes. A backend creates and destroys the native objects (GDI on
+// Windows, plain memory headless); RenderResourceCache decides when.
+//
+// Every draw asks the cache for what it needs. Hits return the existing
+// object; a miss (first use, new config, DPI change) builds a new one. The
+// backbuffer only grows, so text that gets wider or narrower reuses it.
+
+// Opaque native handle (HFONT, HBRUSH on GDI)
+using RenderHandle = void*;
+
+// 32-bit top-down backbuffer; `pixels` is width * height, row-major
+struct RenderSurface {
+    RenderHandle handle = nullptr;  // HBITMAP DIB section on GDI
+    uint32_t* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+};
+
+class IRenderResourceBackend {
+public:
+    virtual ~IRenderResourceBackend() = default;
+
+    virtual bool CreateSurface(int width, int height, RenderSurface& surface) = 0;
+    virtual void DestroySurface(RenderSurface& surface) = 0;
+
+    // `pixelHeight` is already DPI-scaled
+    virtual RenderHandle CreateFontFace(const std::wstring& name, int pixelHeight) = 0;
+    virtual void DestroyFontFace(RenderHandle font) = 0;
+
+    // 0x00RRGGBB
+    virtual RenderHandle CreateBrush(uint32_t rgb) = 0;
+    virtual void DestroyBrush(RenderHandle brush) = 0;
+};
+
+struct RenderResourceStats {
+    uint64_t surfaceHits = 0;
+    uint64_t surfaceCreates = 0;
+    uint64_t fontHits = 0;
+    uint64_t fontCreates = 0;
+    uint64_t brushHits = 0;
+    uint64_t brushCreates = 0;
+    uint64_t invalidations = 0;  // Invalidate() calls and DPI changes
+
+    uint64_t Lookups() const { return surfaceHits + surfaceCreates + fontHits + fontCreates + brushHits + brushCreates; }
+    uint64_t Hits() const { return surfaceHits + fontHits + brushHits; }
+};
+
+#define RENDER_DEFAULT_DPI 96
+#define RENDER_MAX_CACHED_FONTS 4
+#define RENDER_MAX_CACHED_BRUSHES 8
+
+// Not thread-safe: owned and used by the render thread
+class RenderResourceCache {
+public:
+    explicit RenderResourceCache(IRenderResourceBackend& backend);
+    ~RenderResourceCache();
+
+    RenderResourceCache(const RenderResourceCache&) = delete;
+    RenderResourceCache& operator=(const RenderResourceCache&) = delete;
+
+    // A backbuffer at least width x height, or nullptr if it can't be made
+    const RenderSurface* Surface(int width, int height);
+
+    // Font of `size` logical pixels, scaled to the current DPI; nullptr on failure
+    RenderHandle Font(const std::wstring& name, int size);
+
+    // Solid brush for 0x00RRGGBB; nullptr on failure
+    RenderHandle Brush(uint32_t rgb);
+
+    // Fonts are rasterized for one DPI; a change drops them
+    void SetDpi(int dpi);
+    int GetDpi() const { return m_dpi; }
+
+    // Drop everything (display mode change, device loss)
+    void Invalidate();
+
+    RenderResourceStats GetStats() const { return m_stats; }
+
+private:
+    struct FontEntry {
+        std::wstring name;
+        int size = 0;
+        RenderHandle handle = nullptr;
+        uint64_t lastUse = 0;
+    };
+
+    struct BrushEntry {
+        uint32_t rgb = 0;
+        RenderHandle handle = nullptr;
+        uint64_t lastUse = 0;
+    };
+
+    IRenderResourceBackend& m_backend;
+    RenderSurface m_surface;
+    std::vector<FontEntry> m_fonts;     // At most RENDER_MAX_CACHED_FONTS
+    std::vector<BrushEntry> m_brushes;  // At most RENDER_MAX_CACHED_BRUSHES
+    int m_dpi;
+    uint64_t m_useClock;                // Orders entries for eviction
+    RenderResourceStats m_stats;
+
+    void ReleaseFonts();
+    void ReleaseBrushes();
+};
+
+// Backend without a display: surfaces are plain memory, fonts and brushes
+// are tokens. Counts what it creates so benchmarks can see cache misses and
+// leaks.
+class HeadlessRenderBackend : public IRenderResourceBackend {
+public:
+    HeadlessRenderBackend() = default;
+
+    bool CreateSurface(int width, int height, RenderSurface& surface) override;
+    void DestroySurface(RenderSurface& surface) override;
+    RenderHandle CreateFontFace(const std::wstring& name, int pixelHeight) override;
+    void DestroyFontFace(RenderHandle font) override;
+    RenderHandle CreateBrush(uint32_t rgb) override;
+    void DestroyBrush(RenderHandle brush) override;
+
+    uint64_t Creates() const { return m_creates; }
+    int64_t Live() const { return m_live; }  // Created minus destroyed
+
+private:
+    uint64_t m_creates = 0;
+    int64_t m_live = 0;
+};
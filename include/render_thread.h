@@ -0,0 +1,87 @@
+#pragma once
+
+#include "common.h"
+#include "frame_pipeline.h"
+#include "frame_types.h"
+#include "renderer.h"
+#include "triple_buffer.h"
+#include <future>
+
+class ConfigManager;
+
+// Snapshot handed from the scheduler to the render thread
+struct RenderSnapshot {
+    FrameStats stats;
+    uint64_t publishedNs = 0;  // When the producer handed it over
+};
+
+struct RenderThreadStats {
+    uint64_t published = 0;    // Snapshots handed over
+    uint64_t rendered = 0;     // Snapshots drawn
+    uint64_t superseded = 0;   // Replaced before the render thread got to them
+    uint64_t unchanged = 0;    // Drawn as nothing: same text as on screen
+    uint64_t partial = 0;      // Only the changed glyphs repainted
+    uint64_t graphDropped = 0; // Frame times the graph/heatmap queue had no room for
+    JitterStats renderTime;    // Time spent in Renderer::RenderOverlay
+    JitterStats snapshotAge;   // Publish to start of drawing
+};
+
+// Owns the overlay window: creates it, pumps its messages and draws on a
+// thread of its own, so GDI stalls never hold up sampling or the scheduler.
+// Publish() is wait-free; the render thread always draws the newest
+// snapshot and skips any it was too slow for.
+//
+// It is also a pipeline sink when the frame-time graph or heatmap is on:
+// frame times from each batch are queued for the renderer and plotted on
+// the next draw.
+class RenderThread : public IFrameSink {
+public:
+    explicit RenderThread(const ConfigManager& configManager);
+    ~RenderThread();
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    // Start the thread and create the window on it; returns once the
+    // renderer is initialized (false if that failed). The layered window
+    // works over any graphics API, so this needn't wait for API detection.
+    bool Start();
+
+    // Destroy the window and join the thread
+    void Stop();
+
+    // Hand over a new snapshot (single producer: the scheduler thread)
+    void Publish(const FrameStats& stats);
+
+    bool IsRunning() const { return m_running; }
+
+    RenderThreadStats GetStats() const;
+
+    // IFrameSink, on the pipeline's sink thread (single producer)
+    void Consume(const FrameStats& stats) override {}
+    void ConsumeBatch(const FrameBatchRef& batch) override;
+
+private:
+    const ConfigManager& m_configManager;
+    std::unique_ptr<Renderer> m_renderer;  // Render thread only
+    std::thread m_thread;
+    std::atomic<bool> m_running;
+    std::atomic<bool> m_stopping;
+    void* m_wakeEvent;                      // Auto-reset event (HANDLE)
+
+    TripleBuffer<RenderSnapshot> m_snapshots;
+    SpscQueue<float> m_frameTimes;          // Milliseconds, for the graph and heatmap
+
+    std::atomic<uint64_t> m_published;
+    std::atomic<uint64_t> m_rendered;
+    std::atomic<uint64_t> m_superseded;
+    std::atomic<uint64_t> m_unchanged;
+    std::atomic<uint64_t> m_partial;
+    std::atomic<uint64_t> m_graphDropped;
+    JitterMeter m_renderTime;
+    JitterMeter m_snapshotAge;
+
+    void RenderLoop(std::promise<bool>* started);
+    bool PumpMessages();
+    void DrawNewest();
+};
@@ -1,6 +1,13 @@
 #pragma once
 
 #include "common.h"
+#include "compositor.h"
+#include "gdi_render_backend.h"
+#include "glyph_atlas.h"
+#include "layout_cache.h"
+#include "overlay_painter.h"
+#include "render_resources.h"
+#include "widget_layout.h"
 
 class Renderer {
 public:
@@ -13,8 +20,11 @@ public:
     // Cleanup renderer resources
     void Cleanup();
     
-    // Render FPS overlay
-    void RenderOverlay(float fps, const OverlayConfig& config);
+    // Render the overlay's widgets (OverlayConfig::widgets) for `stats`.
+    // Returns how much was repainted: NONE when the overlay already shows
+    // these readings (or nothing could be drawn), and then the window isn't
+    // touched.
+    DamageKind RenderOverlay(const FrameStats& stats, const OverlayConfig& config);
     
     // Check if renderer is ready
     bool IsInitialized() const { return m_initialized; }
@@ -24,6 +34,25 @@ public:
     
     // Update screen dimensions
     void UpdateScreenDimensions(int width, int height);
+    
+    // Display mode or DPI changed: re-read the screen size and DPI
+    void OnDisplayChanged();
+    
+    // Backbuffer/font/brush cache hits and rebuilds so far
+    RenderResourceStats GetResourceStats() const;
+    
+    // Updates skipped or drawn partially by damage tracking
+    DamageStats GetDamageStats() const;
+    
+    // Frames placed from the layout cache vs measured and placed again
+    LayoutCacheStats GetLayoutStats() const;
+    
+    // Widget placements and text widgets reformatted so far
+    WidgetLayoutStats GetWidgetStats() const;
+    
+    // One frame for the frame-time graph and heatmap (OverlayConfig::
+    // showGraph, showHeatmap); it shows up on the next RenderOverlay()
+    void AddFrameTime(float frameTimeMs);
 
 private:
     bool m_initialized;
@@ -45,8 +74,40 @@ private:
     HGLRC m_glContext;
     HFONT m_glFont;
     
-    // Common resources
-    HFONT m_font;
+    // Common resources: one memory DC and backbuffer for the whole run,
+    // fonts and brushes rebuilt only when the config or DPI changes
+    std::unique_ptr<GdiRenderBackend> m_gdi;
+    std::unique_ptr<RenderResourceCache> m_resources;  // Uses m_gdi
+    std::wstring m_requestedFontName;  // As configured
+    std::wstring m_fontName;           // Installed face actually used
+    uint64_t m_fontNameHash;           // Of m_fontName, for layout keys
+    
+    // Glyphs of the current font, rasterized once per face/size/DPI and
+    // composited in software each frame; GDI text is only the fallback
+    std::unique_ptr<GlyphAtlas> m_atlas;
+    std::wstring m_atlasFontName;
+    int m_atlasFontSize;
+    int m_atlasDpi;
+    
+    // Text, frame-time graph and heatmap as the window shows them now, so
+    // unchanged frames are skipped and changed ones only repaint what differs
+    std::unique_ptr<OverlayPainter> m_painter;
+    
+    // Where each widget goes and the text it shows, placed once per widget
+    // list, font, DPI and graph size; readings are formatted when they change
+    std::unique_ptr<WidgetLayout> m_widgets;
+    
+    // Window position per monitor, placement and widget layout, so a steady
+    // overlay does no placement work; dropped on display changes
+    std::unique_ptr<LayoutCache> m_layouts;
+    
+    // Monitor the overlay goes on (OverlayConfig::monitor); nullptr is the
+    // primary one. The target's monitor is asked for when the foreground
+    // window changes, and every MONITOR_RECHECK_DRAWS draws in case it moved.
+    HMONITOR m_monitor;
+    RECT m_monitorRect;
+    HWND m_targetWindow;
+    int m_monitorChecks;
     
     // Initialization functions for different APIs
     bool InitializeD3D9(IDirect3DDevice9* device);
@@ -54,16 +115,21 @@ private:
     bool InitializeOpenGL(HDC hdc);
     
     // Rendering functions for different APIs
-    void RenderD3D9(const std::wstring& text, const OverlayConfig& config);
-    void RenderD3D11(const std::wstring& text, const OverlayConfig& config);
-    void RenderOpenGL(const std::wstring& text, const OverlayConfig& config);
+    void RenderD3D9(const wchar_t* text, const OverlayConfig& config);
+    void RenderD3D11(const wchar_t* text, const OverlayConfig& config);
+    void RenderOpenGL(const wchar_t* text, const OverlayConfig& config);
     
     // Helper functions
-    void CreateFont(const std::wstring& fontName, int fontSize);
-    void GetTextPosition(const OverlayConfig& config, const std::wstring& text, 
-                        int& x, int& y, int& width, int& height);
+    HFONT ResolveFont(const std::wstring& fontName, int fontSize);
+    const GlyphAtlas* ResolveAtlas(HFONT font, int fontSize);  // nullptr: use GDI text
+    void ResolveMonitor(const OverlayConfig& config);
+    LayoutKey LayoutKeyFor(const OverlayConfig& config) const;
+    void GetTextPosition(const OverlayConfig& config, int width, int height, int& x, int& y);
     DWORD ColorToD3DColor(const Color& color);
-    std::wstring FormatFPS(float fps);
+    static uint32_t ColorToRGB(const Color& color);   // 0x00RRGGBB
+    static uint32_t ColorToARGB(const Color& color);  // 0xAARRGGBB, straight alpha
+    static uint64_t StyleKey(const OverlayConfig& config, int x, int y);
+    static OverlayPaintStyle PaintStyle(const OverlayConfig& config, bool perPixelAlpha);
     
     // Screen overlay for fallback rendering
     HWND m_overlayWindow;
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "thread_affinity.h"
+#include "timer_wheel.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Single-thread scheduler for periodic maintenance work, backed by a
+// TimerWheel with 1 ms ticks.
+//
+// Deadlines are coalesced: a task's next deadline joins any wakeup already
+// booked within its slack, and is otherwise rounded up to a multiple of its
+// slack so tasks with compatible periods keep landing on the same tick. The
+// thread sleeps until the earliest deadline and never polls. Once the tasks
+// are registered, running and rescheduling them does not allocate.
+
+#define SCHEDULER_TICK_MS 1
+
+// Nanoseconds since an arbitrary fixed point; lets a check drive the
+// scheduler on a fake clock
+using SchedulerClock = std::function<uint64_t()>;
+
+// Run-time and lateness counters for one task
+struct ScheduledTaskStats {
+    std::string name;
+    uint32_t intervalMs = 0;
+    uint64_t runs = 0;
+    uint64_t totalRunNs = 0;
+    uint64_t maxRunNs = 0;
+    uint64_t totalLatenessNs = 0;  // Start time minus (coalesced) deadline
+    uint64_t maxLatenessNs = 0;
+};
+
+class Scheduler {
+public:
+    // Without a clock the scheduler reads std::chrono::steady_clock
+    explicit Scheduler(SchedulerClock clock = SchedulerClock());
+    ~Scheduler();
+
+    // Register a periodic task. `slackMs` is how late the task may run so its
+    // deadline can be shared with others. Returns a task id.
+    uint32_t AddPeriodic(const std::string& name, uint32_t intervalMs, uint32_t slackMs,
+                         std::function<void()> task);
+
+    // Change a task's period (and slack, unless 0); takes effect from now
+    void SetInterval(uint32_t taskId, uint32_t intervalMs, uint32_t slackMs = 0);
+
+    // Remove a task; it will not run again once this returns (unless it is
+    // running right now on the scheduler thread)
+    void Cancel(uint32_t taskId);
+
+    // Pinning and priority of the scheduler thread; before Start()
+    void SetThreadSettings(uint64_t affinityMask, ThreadPriority priority);
+
+    // Start/stop the scheduler thread. Fails with a custom clock, which the
+    // thread could not sleep on; drive such a scheduler with RunDue().
+    bool Start();
+    void Stop();
+    bool IsRunning() const { return m_running; }
+
+    // Run every task due by the clock's current time on the calling thread,
+    // as the scheduler thread does when it wakes. Only without Start().
+    void RunDue();
+
+    // Counters
+    std::vector<ScheduledTaskStats> GetTaskStats() const;
+    uint64_t GetWakeupCount() const { return m_wakeups.load(std::memory_order_relaxed); }
+
+private:
+    struct Task {
+        ScheduledTaskStats stats;
+        uint32_t slackMs = 1;
+        uint32_t generation = 0;
+        bool active = false;
+        // Shared so the worker can hold it while unlocked without copying
+        // the callable (and whatever it captured)
+        std::shared_ptr<const std::function<void()>> fn;
+    };
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::vector<Task> m_tasks;
+    TimerWheel m_wheel;
+    // Booked wakeup tick -> entries, sorted by tick; at most one per task,
+    // so reserving the task count keeps booking allocation-free
+    std::vector<std::pair<uint64_t, uint32_t>> m_deadlines;
+    std::chrono::steady_clock::time_point m_epoch;
+    SchedulerClock m_clock;
+    std::vector<TimerEntry> m_expired;
+    std::vector<TimerEntry> m_due;
+
+    std::thread m_thread;
+    bool m_running;
+    std::atomic<uint64_t> m_wakeups;
+    uint64_t m_affinityMask;
+    ThreadPriority m_priority;
+
+    void SchedulerWorker();
+    void RunDueLocked(std::unique_lock<std::mutex>& lock);
+    uint64_t NowNs() const;
+    uint64_t NowTick() const;
+    uint64_t AlignedDeadline(uint64_t fromTick, const Task& task) const;
+    void ScheduleLocked(uint32_t taskId, uint64_t fromTick);
+    void ReleaseDeadline(uint64_t tick);
+    size_t FindDeadline(uint64_t tick) const;  // First booking at or after `tick`
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "compositor.h"
+
+#include <cstdint>
+#include <vector>
+
+// Pixel image for the scrolling overlay widgets (frame-time graph, heatmap),
+// kept as a ring of columns: the widget paints a new column over the oldest
+// one and never moves the others. Draw() presents the ring scrolled, oldest
+// column on the left, with one copy per row (two where the ring wraps), so
+// scrolling costs no more than drawing the image would.
+
+class ScrollingImage {
+public:
+    ScrollingImage();
+
+    // Allocates; every pixel becomes `fill`
+    void Resize(int width, int height, uint32_t fill);
+    int Width() const { return m_width; }
+    int Height() const { return m_height; }
+
+    // Top pixel of ring column `index`; rows are Width() pixels apart
+    uint32_t* Column(int index) { return m_pixels.data() + index; }
+
+    // Copy with its top-left at (x, y), clipped to `target`; `oldest` is
+    // the ring column that goes on the left
+    void Draw(PixelBuffer& target, int x, int y, int oldest) const;
+
+private:
+    std::vector<uint32_t> m_pixels;
+    int m_width;
+    int m_height;
+
+    // Private methods
+    void CopyColumns(PixelBuffer& target, int x, int y, int firstColumn, int count) const;
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+// Single-writer seqlock for publishing small trivially-copyable snapshots.
+//
+// The writer never waits for readers. Readers copy the payload and retry if
+// the sequence changed underneath them, so they can never observe a torn
+// value. The payload is stored as relaxed atomic words, which keeps the racy
+// copy well-defined.
+template <typename T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable<T>::value, "Seqlock payload must be trivially copyable");
+
+public:
+    Seqlock() : m_sequence(0) {
+        T empty{};
+        StoreWords(empty);
+    }
+
+    // Publish a new value (one writer thread only)
+    void Publish(const T& value) {
+        uint64_t seq = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        StoreWords(value);
+        m_sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    // Single read attempt; fails if a publish was in progress
+    bool TryRead(T& out) const {
+        uint64_t before = m_sequence.load(std::memory_order_acquire);
+        if (before & 1) return false;
+        LoadWords(out);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return m_sequence.load(std::memory_order_relaxed) == before;
+    }
+
+    // Read a consistent value, retrying while a publish is in flight
+    T Read() const {
+        T value;
+        for (int attempt = 0; !TryRead(value); ++attempt) {
+            if (attempt > 64) std::this_thread::yield();
+        }
+        return value;
+    }
+
+    // Number of completed publishes
+    uint64_t Version() const { return m_sequence.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr size_t WORD_COUNT = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint64_t> m_sequence;
+    std::atomic<uint64_t> m_words[WORD_COUNT];
+
+    void StoreWords(const T& value) {
+        uint64_t words[WORD_COUNT] = {};
+        std::memcpy(words, &value, sizeof(T));
+        for (size_t i = 0; i < WORD_COUNT; ++i) {
+            m_words[i].store(words[i], std::memory_order_relaxed);
+        }
+    }
+
+    void LoadWords(T& value) const {
+        uint64_t words[WORD_COUNT];
+        for (size_t i = 0; i < WORD_COUNT; ++i) {
+            words[i] = m_words[i].load(std::memory_order_relaxed);
+        }
+        std::memcpy(&value, words, sizeof(T));
+    }
+};
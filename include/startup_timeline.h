@@ -0,0 +1,64 @@
+#pragma once
+
+#include "frame_types.h"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct StartupPhase {
+    std::string name;
+    uint64_t startNs = 0;  // Since the timeline was created
+    uint64_t endNs = 0;
+    uint32_t thread = 0;   // 0 = the thread that recorded first, then in order of appearance
+};
+
+// Per-phase timings of startup. Phases may run on any thread and overlap;
+// the report shows which ran concurrently and how long the whole took.
+class StartupTimeline {
+public:
+    StartupTimeline();
+
+    StartupTimeline(const StartupTimeline&) = delete;
+    StartupTimeline& operator=(const StartupTimeline&) = delete;
+
+    // Records the phase from construction to destruction
+    class Scope {
+    public:
+        Scope(StartupTimeline& timeline, const char* name);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        StartupTimeline& m_timeline;
+        const char* m_name;
+        uint64_t m_startNs;
+    };
+
+    Scope Phase(const char* name) { return Scope(*this, name); }
+
+    // Absolute MonotonicNowNs() timestamps
+    void Record(const char* name, uint64_t startNs, uint64_t endNs);
+
+    // In start order
+    std::vector<StartupPhase> GetPhases() const;
+
+    // Creation to the end of the last phase
+    uint64_t TotalNs() const;
+
+    // Sum of the phase durations: what a serial startup would have taken
+    uint64_t SerialNs() const;
+
+    // One line per phase plus totals, for logs and --startup-bench
+    std::string Format() const;
+
+private:
+    uint64_t m_originNs;
+    mutable std::mutex m_mutex;
+    std::vector<StartupPhase> m_phases;
+    std::vector<std::thread::id> m_threads;
+};
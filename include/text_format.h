@@ -0,0 +1,241 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// Allocation- and locale-free formatting of overlay strings into a caller's
+// buffer, with the layout parsed and checked at compile time:
+//
+//   wchar_t text[32];
+//   int length = TextFormat::Format<"FPS: {:.1f}">(text, 32, fps);
+//
+// Placeholders: {} (shortest form of any number), {:d} (integers),
+// {:f} (fixed, 6 decimals) and {:.Nf} (fixed, N decimals, N <= 9); {{ and
+// }} are literal braces. A layout that doesn't parse, or whose placeholders
+// don't match the arguments in number or type, fails to compile. Numbers
+// go through std::to_chars, so they match printf's "%.Nf" digit for digit
+// without its locale lookups.
+
+#define TEXT_FORMAT_MAX_FIELDS 8
+#define TEXT_FORMAT_MAX_PRECISION 9
+
+namespace TextFormat {
+    enum class LayoutError {
+        NONE,
+        UNMATCHED_BRACE,
+        BAD_SPEC,
+        TOO_MANY_FIELDS
+    };
+
+    enum class FieldKind {
+        SHORTEST,  // {}
+        INTEGER,   // {:d}
+        FIXED      // {:f}, {:.Nf}
+    };
+
+    struct Field {
+        size_t literalBegin = 0;  // Literal text before the field, in TextLayout::literals
+        size_t literalLength = 0;
+        FieldKind kind = FieldKind::SHORTEST;
+        int precision = 0;
+    };
+
+    // A format string parsed at compile time; used as a template argument
+    template <size_t N>
+    struct TextLayout {
+        char literals[N] = {};  // Every literal run, braces unescaped, back to back
+        Field fields[TEXT_FORMAT_MAX_FIELDS] = {};
+        size_t fieldCount = 0;
+        size_t tailBegin = 0;   // Literal text after the last field
+        size_t tailLength = 0;
+        LayoutError error = LayoutError::NONE;
+
+        consteval TextLayout(const char (&layout)[N]) {
+            size_t out = 0;
+            size_t runBegin = 0;
+            size_t i = 0;
+            const size_t length = N - 1;  // Without the terminator
+            while (i < length && error == LayoutError::NONE) {
+                char c = layout[i];
+                if (c == '{' && i + 1 < length && layout[i + 1] == '{') {
+                    literals[out++] = '{';
+                    i += 2;
+                } else if (c == '}' && i + 1 < length && layout[i + 1] == '}') {
+                    literals[out++] = '}';
+                    i += 2;
+                } else if (c == '}') {
+                    error = LayoutError::UNMATCHED_BRACE;
+                } else if (c == '{') {
+                    size_t close = i + 1;
+                    while (close < length && layout[close] != '}' && layout[close] != '{') ++close;
+                    if (close >= length || layout[close] != '}') {
+                        error = LayoutError::UNMATCHED_BRACE;
+                    } else if (fieldCount == TEXT_FORMAT_MAX_FIELDS) {
+                        error = LayoutError::TOO_MANY_FIELDS;
+                    } else {
+                        Field field;
+                        field.literalBegin = runBegin;
+                        field.literalLength = out - runBegin;
+                        if (!ParseSpec(layout, i + 1, close, field)) {
+                            error = LayoutError::BAD_SPEC;
+                        }
+                        fields[fieldCount++] = field;
+                        runBegin = out;
+                        i = close + 1;
+                    }
+                } else {
+                    literals[out++] = c;
+                    ++i;
+                }
+            }
+            tailBegin = runBegin;
+            tailLength = out - runBegin;
+        }
+
+    private:
+        // Between the braces: "", ":d", ":f" or ":.Nf"
+        static consteval bool ParseSpec(const char (&layout)[N], size_t begin, size_t end, Field& field) {
+            size_t length = end - begin;
+            if (length == 0) {
+                field.kind = FieldKind::SHORTEST;
+                return true;
+            }
+            if (layout[begin] != ':') return false;
+            if (length == 2 && layout[begin + 1] == 'd') {
+                field.kind = FieldKind::INTEGER;
+                return true;
+            }
+            if (length == 2 && layout[begin + 1] == 'f') {
+                field.kind = FieldKind::FIXED;
+                field.precision = 6;
+                return true;
+            }
+            if (length == 4 && layout[begin + 1] == '.' && layout[begin + 2] >= '0' &&
+                layout[begin + 2] - '0' <= TEXT_FORMAT_MAX_PRECISION && layout[begin + 3] == 'f') {
+                field.kind = FieldKind::FIXED;
+                field.precision = layout[begin + 2] - '0';
+                return true;
+            }
+            return false;
+        }
+    };
+
+    namespace Detail {
+        template <typename CharT>
+        struct Writer {
+            CharT* pos;
+            CharT* end;  // One before the terminator's slot
+            bool overflow = false;
+
+            void Literal(const char* text, size_t length) {
+                if (overflow) return;
+                if (static_cast<size_t>(end - pos) < length) {
+                    overflow = true;
+                    return;
+                }
+                for (size_t i = 0; i < length; ++i) {
+                    *pos++ = static_cast<CharT>(text[i]);
+                }
+            }
+
+            template <typename... ConvertArgs>
+            void Number(ConvertArgs... convert) {
+                if (overflow) return;
+                if constexpr (std::is_same_v<CharT, char>) {
+                    std::to_chars_result result = std::to_chars(pos, end, convert...);
+                    if (result.ec != std::errc()) {
+                        overflow = true;
+                        return;
+                    }
+                    pos = result.ptr;
+                } else {
+                    // Digits are ASCII: convert narrow, then widen
+                    char digits[64];
+                    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), convert...);
+                    if (result.ec != std::errc()) {
+                        overflow = true;
+                        return;
+                    }
+                    Literal(digits, static_cast<size_t>(result.ptr - digits));
+                }
+            }
+        };
+
+        template <typename T>
+        constexpr bool FitsField(FieldKind kind) {
+            using Value = std::remove_cv_t<T>;
+            if constexpr (std::is_same_v<Value, bool>) {
+                return false;
+            } else if (kind == FieldKind::INTEGER) {
+                return std::is_integral_v<Value>;
+            } else if (kind == FieldKind::FIXED) {
+                return std::is_floating_point_v<Value>;
+            } else {
+                return std::is_arithmetic_v<Value>;
+            }
+        }
+
+        template <auto Layout, typename... Args, size_t... I>
+        constexpr bool FieldsFit(std::index_sequence<I...>) {
+            return (FitsField<Args>(Layout.fields[I].kind) && ...);
+        }
+
+        template <auto Layout, size_t I, typename CharT, typename T>
+        void WriteField(Writer<CharT>& writer, T value) {
+            constexpr Field field = Layout.fields[I];
+            writer.Literal(Layout.literals + field.literalBegin, field.literalLength);
+            if constexpr (field.kind == FieldKind::FIXED) {
+                writer.Number(value, std::chars_format::fixed, field.precision);
+            } else {
+                writer.Number(value);
+            }
+        }
+
+        template <auto Layout, typename CharT, typename... Args, size_t... I>
+        void WriteFields(Writer<CharT>& writer, std::index_sequence<I...>, Args... args) {
+            (WriteField<Layout, I>(writer, args), ...);
+        }
+    }
+
+    // Write the formatted text and a terminator into `out`. Returns the
+    // length, or -1 (and an empty string) if it doesn't fit in `capacity`
+    // characters including the terminator.
+    template <TextLayout Layout, typename CharT, typename... Args>
+    int Format(CharT* out, size_t capacity, Args... args) {
+        static_assert(Layout.error != LayoutError::UNMATCHED_BRACE, "format layout: unmatched '{' or '}'");
+        static_assert(Layout.error != LayoutError::BAD_SPEC,
+                      "format layout: only {}, {:d}, {:f} and {:.Nf} (N <= 9) are supported");
+        static_assert(Layout.error != LayoutError::TOO_MANY_FIELDS, "format layout: too many placeholders");
+        static_assert(Layout.fieldCount == sizeof...(Args),
+                      "format layout: placeholder count differs from the argument count");
+        static_assert(Detail::FieldsFit<Layout, Args...>(std::index_sequence_for<Args...>()),
+                      "format layout: {:d} needs an integer, {:f} a floating-point value");
+
+        if (capacity == 0) return -1;
+        Detail::Writer<CharT> writer{out, out + capacity - 1};
+        Detail::WriteFields<Layout>(writer, std::index_sequence_for<Args...>(), args...);
+        writer.Literal(Layout.literals + Layout.tailBegin, Layout.tailLength);
+        if (writer.overflow) {
+            out[0] = CharT();
+            return -1;
+        }
+        *writer.pos = CharT();
+        return static_cast<int>(writer.pos - out);
+    }
+
+    // Fixed-capacity stack buffer to format into
+    template <size_t Capacity, typename CharT = wchar_t>
+    struct FixedText {
+        CharT data[Capacity] = {};
+        int length = 0;  // -1 after a format that didn't fit
+
+        template <TextLayout Layout, typename... Args>
+        int Format(Args... args) {
+            length = TextFormat::Format<Layout>(data, Capacity, args...);
+            return length;
+        }
+    };
+}
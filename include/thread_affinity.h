@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+
+// CPU pinning and scheduling priority for the monitor's own threads, so they
+// stay off the cores the game runs on.
+//
+// Masks use bit n = logical CPU n (the first 64 CPUs; processor group 0 on
+// Windows). THREAD_AFFINITY_AUTO resolves at run time to the efficiency
+// cores on hybrid CPUs (Intel P/E, ARM big.LITTLE) and to the last logical
+// CPU otherwise, which games tend to load last.
+//
+// Windows: SetThreadAffinityMask/SetThreadPriority, E-cores from
+// GetSystemCpuSetInformation. Linux: pthread_setaffinity_np, SCHED_IDLE or
+// per-thread nice values, E-cores from /sys/devices/cpu_atom or
+// cpu_capacity. Elsewhere the calls report failure and change nothing.
+
+#define THREAD_AFFINITY_NONE 0ull
+#define THREAD_AFFINITY_AUTO (~0ull)
+
+enum class ThreadPriority {
+    LOWEST = -2,        // Windows THREAD_PRIORITY_LOWEST; Linux SCHED_IDLE
+    BELOW_NORMAL = -1,  // Linux nice +5
+    NORMAL = 0,
+    ABOVE_NORMAL = 1,   // Linux nice -5 (needs CAP_SYS_NICE)
+    HIGHEST = 2         // Linux nice -10 (needs CAP_SYS_NICE)
+};
+
+struct CpuTopology {
+    unsigned logicalCpus = 1;
+    uint64_t allMask = 1;          // Every CPU this process may use
+    uint64_t efficiencyMask = 0;   // E-cores; 0 unless the CPU is hybrid
+    bool hybrid = false;
+};
+
+namespace ThreadAffinity {
+    // Detected once and cached
+    const CpuTopology& GetTopology();
+
+    // CPUs THREAD_AFFINITY_AUTO stands for on this machine
+    uint64_t AutoMask(const CpuTopology& topology);
+
+    // Turn a configured mask into a usable one: AUTO is resolved, CPUs that
+    // don't exist are dropped, and NONE stays NONE (no pinning)
+    uint64_t ResolveMask(uint64_t mask);
+
+    // Restrict the calling thread to `mask` (must be resolved, non-zero)
+    bool PinCurrentThread(uint64_t mask);
+
+    // CPUs the calling thread may run on (0 if unknown)
+    uint64_t GetCurrentAffinity();
+
+    bool SetCurrentPriority(ThreadPriority priority);
+    ThreadPriority GetCurrentPriority();
+
+    // Resolve and pin (if the mask isn't NONE), then set the priority
+    // (if not NORMAL). Logs nothing; returns false if either call failed.
+    bool ApplyToCurrentThread(uint64_t mask, ThreadPriority priority);
+
+    // Clamp a configured integer to a ThreadPriority
+    ThreadPriority PriorityFromInt(int value);
+}
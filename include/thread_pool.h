@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "thread_affinity.h"
+
+// Work-stealing thread pool for offline and bulk work (capture compression,
+// export, percentile recomputation, file analysis). Never used on the frame
+// path.
+//
+// Each worker owns a deque: it pushes and pops its own tasks at the back
+// (LIFO, cache-warm) and idle workers steal from the front of the others'
+// (FIFO, oldest and usually largest pieces first). Tasks submitted from
+// outside the pool are spread round-robin over the worker deques.
+//
+// ParallelFor splits a range recursively: each task halves its range, pushes
+// one half for others to steal and keeps going with the other, so load
+// balances itself without a central queue. The calling thread helps run
+// tasks while it waits, so ParallelFor may be nested or called from a task.
+
+#define THREAD_POOL_MAX_WORKERS 64
+
+struct ThreadPoolStats {
+    size_t workers = 0;
+    uint64_t executed = 0;  // Tasks run (by workers and helping callers)
+    uint64_t stolen = 0;    // Tasks taken from another worker's deque
+    uint64_t failed = 0;    // Submitted tasks that threw
+};
+
+class WorkStealingPool {
+public:
+    // `workerCount` 0 = one less than the hardware threads (at least one).
+    // `affinityMask` non-zero pins every worker to those CPUs (bit n = CPU n,
+    // or THREAD_AFFINITY_AUTO), e.g. to keep bulk work off the cores the
+    // game is using. `priority` applies to every worker.
+    explicit WorkStealingPool(size_t workerCount = 0, uint64_t affinityMask = 0,
+                              ThreadPriority priority = ThreadPriority::NORMAL);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Fire-and-forget task; exceptions are counted in `failed` and dropped
+    void Submit(std::function<void()> task);
+
+    // Run body(rangeBegin, rangeEnd) over [begin, end) in pieces of at most
+    // `grain` items (0 = pick one). Blocks until done; the first exception
+    // thrown by the body is rethrown here.
+    void ParallelFor(size_t begin, size_t end, size_t grain,
+                     const std::function<void(size_t, size_t)>& body);
+
+    // Block until every queued task has finished
+    void WaitIdle();
+
+    size_t WorkerCount() const { return m_workers.size(); }
+    ThreadPoolStats GetStats() const;
+
+private:
+    struct alignas(64) WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    std::vector<std::thread> m_workers;
+
+    // Sleep/wake for idle workers; m_queued counts tasks sitting in deques
+    std::mutex m_sleepMutex;
+    std::condition_variable m_sleepCv;
+    std::condition_variable m_idleCv;
+    std::atomic<size_t> m_queued;
+    std::atomic<size_t> m_inFlight;  // Queued + running
+    std::atomic<int> m_sleepers;
+    std::atomic<bool> m_stopping;
+    std::atomic<size_t> m_nextQueue;
+
+    std::atomic<uint64_t> m_executed;
+    std::atomic<uint64_t> m_stolen;
+    std::atomic<uint64_t> m_failed;
+
+    struct ForJob;
+
+    void WorkerLoop(size_t index, uint64_t affinityMask, ThreadPriority priority);
+    void RunRange(const std::shared_ptr<ForJob>& job, size_t begin, size_t end);
+    void Push(std::function<void()> task);
+    bool TryRunOne(size_t home);
+    bool TryPop(size_t home, std::function<void()>& task);
+    void Notify();
+    static size_t CurrentWorker(const WorkStealingPool* pool);
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+// Bump allocator for one thread's per-tick temporaries (formatted text,
+// layout scratch). The buffer is allocated once, up front; Allocate() only
+// moves a pointer and Reset() at the start of each tick frees everything.
+// When a tick asks for more than fits, Allocate() returns nullptr and counts
+// an overflow instead of falling back to the heap, so callers must handle
+// running out (e.g. by drawing less) and the capacity can be sized from
+// HighWater().
+class TickArena {
+public:
+    explicit TickArena(size_t capacityBytes);
+
+    TickArena(const TickArena&) = delete;
+    TickArena& operator=(const TickArena&) = delete;
+
+    void* Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+    // Uninitialized storage for `count` trivially destructible objects
+    template <typename T>
+    T* AllocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "Arena memory is never destroyed");
+        return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void Reset() { m_used = 0; }
+
+    size_t Capacity() const { return m_capacity; }
+    size_t Used() const { return m_used; }
+    size_t HighWater() const { return m_highWater; }
+    uint64_t Overflows() const { return m_overflows; }
+
+private:
+    std::unique_ptr<unsigned char[]> m_buffer;
+    size_t m_capacity;
+    size_t m_used;
+    size_t m_highWater;
+    uint64_t m_overflows;
+};
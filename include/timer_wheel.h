@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Hierarchical timer wheel with 1 tick resolution at the bottom level.
+//
+//   level 0: 256 slots x 1 tick
+//   level 1:  64 slots x 256 ticks
+//   level 2:  64 slots x 16384 ticks
+//   level 3:  64 slots x 1048576 ticks
+//
+// Timers further out than level 3 covers are parked in its last reachable
+// slot and re-cascaded. Insert and expiry are O(1); Advance() costs O(1) per
+// elapsed tick plus the cascades it triggers.
+
+#define TIMER_WHEEL_LEVELS 4
+#define TIMER_WHEEL_L0_BITS 8
+#define TIMER_WHEEL_LN_BITS 6
+
+struct TimerEntry {
+    uint32_t id = 0;          // Owner-defined identifier
+    uint32_t generation = 0;  // Lets the owner ignore cancelled entries lazily
+    uint64_t expiry = 0;      // Absolute tick
+};
+
+class TimerWheel {
+public:
+    explicit TimerWheel(uint64_t startTick = 0);
+
+    // Schedule an entry; expiries in the past fire on the next Advance()
+    void Insert(const TimerEntry& entry);
+
+    // Move time forward to `nowTick`, appending every expired entry to `expired`
+    void Advance(uint64_t nowTick, std::vector<TimerEntry>& expired);
+
+    // Give every slot room for `entriesPerSlot` entries up front, so Insert()
+    // and Advance() don't allocate while the timer count stays below that
+    void Reserve(size_t entriesPerSlot);
+
+    // Earliest scheduled expiry, or UINT64_MAX when empty
+    uint64_t NextExpiry() const;
+
+    uint64_t CurrentTick() const { return m_currentTick; }
+    size_t Size() const { return m_size; }
+
+private:
+    std::vector<TimerEntry> m_levels[TIMER_WHEEL_LEVELS][1 << TIMER_WHEEL_L0_BITS];
+    std::vector<TimerEntry> m_overdue;
+    std::vector<TimerEntry> m_cascade;  // Swapped with the slot being cascaded
+    uint64_t m_currentTick;
+    size_t m_size;
+
+    static unsigned Shift(int level);
+    static unsigned SlotCount(int level);
+    void Place(const TimerEntry& entry);
+    void Cascade(int level);
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Wait-free single-producer/single-consumer handoff of the newest value.
+//
+// Three slots: the producer owns the back slot, the consumer owns the front
+// slot, and the middle slot is exchanged atomically between them. Neither
+// side ever waits for the other, and the consumer always gets the newest
+// complete value; values it was too slow to pick up are simply replaced.
+// Unlike Seqlock the payload may be any copyable type, and a reader holding
+// the front slot keeps it stable for as long as it likes (e.g. a whole draw).
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : m_middle(1), m_back(2), m_front(0) {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Producer: slot to fill before Publish()
+    T& Back() { return m_slots[m_back].value; }
+
+    // Producer: hand the back slot to the consumer. Returns true if it
+    // replaced a value the consumer never picked up.
+    bool Publish() {
+        uint8_t previous = m_middle.exchange(m_back | FRESH, std::memory_order_acq_rel);
+        m_back = previous & INDEX_MASK;
+        return (previous & FRESH) != 0;
+    }
+
+    bool Publish(const T& value) {
+        Back() = value;
+        return Publish();
+    }
+
+    // Consumer: take the newest published value, if there is one since the
+    // last call. Front() holds it afterwards.
+    bool Acquire() {
+        if (!(m_middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        uint8_t previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+        m_front = previous & INDEX_MASK;
+        return true;
+    }
+
+    // Consumer: value taken by the last successful Acquire()
+    const T& Front() const { return m_slots[m_front].value; }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH = 0x4;  // Middle slot not yet acquired
+
+    // Keep producer and consumer writes off each other's cache lines
+    struct alignas(64) Slot {
+        T value{};
+    };
+
+    Slot m_slots[3];
+    alignas(64) std::atomic<uint8_t> m_middle;
+    alignas(64) uint8_t m_back;   // Producer only
+    alignas(64) uint8_t m_front;  // Consumer only
+};
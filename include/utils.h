@@ -26,14 +26,16 @@ namespace Utils {
     bool IsDirectX9Available();
     bool IsDirectX11Available();
     bool IsOpenGLAvailable();
-    std::vector<GraphicsAPI> GetAvailableGraphicsAPIs();
+    const std::vector<GraphicsAPI>& GetAvailableGraphicsAPIs();  // Probed once
     
     // Window utilities
     HWND GetForegroundGameWindow();
     std::wstring GetWindowClassName(HWND hwnd);
     std::wstring GetWindowTitle(HWND hwnd);
     DWORD GetWindowProcessId(HWND hwnd);
-    bool IsFullscreenWindow(HWND hwnd);
+    bool IsFullscreenWindow(HWND hwnd);  // Covers its monitor (fullscreen or borderless)
+    bool IsShellWindow(HWND hwnd);       // Desktop, taskbars
+    std::wstring GetWindowProcessName(HWND hwnd);  // Executable name, lower case; empty if unknown
     
     // Performance utilities
     class PerformanceTimer {
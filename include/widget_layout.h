@@ -0,0 +1,131 @@
+#pragma once
+
+#include "damage_tracker.h"
+#include "frame_types.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// Retained layout for the overlay's widgets. config.ini's [Layout] Widgets
+// lists them in rows ("fps frametime | low1 low01 | graph"); they are placed
+// once per widget list, font, DPI and graph size, each text widget in a
+// cell wide enough for its widest value, so a changing reading never moves
+// or resizes anything. Every frame each text widget rounds its value the way
+// it is shown and is formatted again only when that changed; OverlayPainter
+// then repaints just the cells whose version moved. A steady frame costs a
+// comparison per widget, however many there are.
+//
+// Platform-independent; not thread-safe (the render thread owns it).
+// Allocation-free: the widgets live in fixed arrays.
+
+#define OVERLAY_PADDING_X 20          // Around the content, split evenly between the sides
+#define OVERLAY_PADDING_Y 10
+#define OVERLAY_WIDGET_SPACING 4      // Above and below a row holding a graph or heatmap
+#define WIDGET_LAYOUT_MAX_WIDGETS 16  // Further widgets are rejected by Parse()
+#define WIDGET_TEXT_CAPACITY 24       // Longest text widget, terminator included
+
+enum class OverlayWidget : uint8_t {
+    FPS = 0,       // "FPS: 143.2"
+    FRAME_TIME,    // "6.94 ms"
+    LOW_1,         // "1%: 98", the 1% low FPS
+    LOW_01,        // "0.1%: 71"
+    HITCHES,       // "Hitches: 3"
+    FRAME_RANGE,   // "3.9-25.0 ms", shortest and longest frame in the averaging window
+    GRAPH,         // Frame-time graph (frame_time_graph.h)
+    HEATMAP,       // Frame-time heatmap (frame_time_heatmap.h)
+};
+
+// What the overlay shows, row by row; an OverlayConfig value
+struct WidgetList {
+    OverlayWidget widgets[WIDGET_LAYOUT_MAX_WIDGETS] = {};
+    uint32_t rowStarts = 1;  // Bit i: widgets[i] begins a row
+    int count = 1;           // Just the FPS
+
+    bool Contains(OverlayWidget widget) const;
+
+    // `widget` on a row of its own at the end; ignored when full
+    void AppendRow(OverlayWidget widget);
+
+    bool operator==(const WidgetList&) const = default;
+
+    // Names separated by spaces or commas, rows by '|': fps, frametime,
+    // low1, low01, hitches, range, graph, heatmap (any case). False, with
+    // `list` untouched, for an unknown name, an empty list or more than
+    // WIDGET_LAYOUT_MAX_WIDGETS widgets.
+    static bool Parse(const std::wstring& text, WidgetList& list);
+    std::wstring ToString() const;
+};
+
+// Everything besides the widget list the placement depends on
+struct WidgetMetrics {
+    uint64_t font = 0;       // Changes with the face, size, DPI and how text is measured
+    int lineHeight = 0;
+    int graphWidth = 0;
+    int graphHeight = 0;
+    int heatmapWidth = 0;
+    int heatmapHeight = 0;
+
+    bool operator==(const WidgetMetrics&) const = default;
+};
+
+// Text widths for placing: GlyphAtlas::MeasureText, or GDI's when the text
+// is drawn with it
+typedef std::function<int(const wchar_t* text, int length)> TextMeasure;
+
+struct WidgetCell {
+    OverlayWidget widget = OverlayWidget::FPS;
+    DamageRect bounds;       // Surface coordinates; what repaints when it changes
+    wchar_t text[WIDGET_TEXT_CAPACITY] = {};
+    int length = 0;
+    uint64_t version = 0;    // Bumped whenever `text` changes
+    int64_t shown = -1;      // The value as displayed (rounded); -1: nothing yet
+
+    bool IsText() const { return widget != OverlayWidget::GRAPH && widget != OverlayWidget::HEATMAP; }
+};
+
+struct WidgetLayoutStats {
+    uint64_t layouts = 0;  // Placements (widget list, font, DPI or graph size changed)
+    uint64_t updates = 0;  // Update() calls
+    uint64_t formats = 0;  // Text widgets formatted because their shown value changed
+};
+
+class WidgetLayout {
+public:
+    WidgetLayout();
+
+    // Place `widgets` unless they and `metrics` are what was placed last;
+    // returns whether it did. Placing again shows every text widget anew.
+    bool Configure(const WidgetList& widgets, const WidgetMetrics& metrics, const TextMeasure& measure);
+
+    // Bring the text widgets up to `stats`; only those whose shown value
+    // changed are formatted. Returns how many were.
+    int Update(const FrameStats& stats);
+
+    // Changes with every placement; the cells' bounds are only valid for it
+    uint64_t Key() const { return m_key; }
+
+    // Surface size, padding included
+    int Width() const { return m_width; }
+    int Height() const { return m_height; }
+
+    int Count() const { return m_count; }
+    const WidgetCell& Cell(int index) const { return m_cells[index]; }
+    bool Contains(OverlayWidget widget) const { return m_widgets.Contains(widget); }
+
+    WidgetLayoutStats GetStats() const { return m_stats; }
+
+private:
+    WidgetList m_widgets;
+    WidgetMetrics m_metrics;
+    WidgetCell m_cells[WIDGET_LAYOUT_MAX_WIDGETS];
+    int m_count;
+    int m_width;
+    int m_height;
+    uint64_t m_key;  // 0: nothing placed yet
+    WidgetLayoutStats m_stats;
+
+    // Private methods
+    static int64_t ShownValue(OverlayWidget widget, const FrameStats& stats);
+    static int Format(OverlayWidget widget, int64_t shown, wchar_t* text);
+};
@@ -0,0 +1,181 @@
+/*
+ * Sample frame plugin, written against fps_plugin_abi.h in plain C.
+ *
+ * Sink "frame-summary": keeps a running frame count, mean and worst frame
+ * time from the batches it is handed and logs them at shutdown.
+ *
+ * Source "synthetic": only registered when FPS_SAMPLE_PLUGIN_SOURCE_HZ is
+ * set, so dropping the plugin into a real install never adds fake frames.
+ * A thread produces presents at that rate and hands them to the host four
+ * at a time, the way a telemetry reader would forward what it drained.
+ */
+
+#include "fps_plugin_abi.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#endif
+
+#define SOURCE_BATCH 4
+
+static const FpsHostApiV1* g_host;
+
+/* Sink */
+
+typedef struct Summary {
+    uint64_t frames;
+    double totalMs;
+    double worstMs;
+} Summary;
+
+static Summary g_summary;
+
+static void SummaryConsumeBatch(void* context, const FpsFrameBatch* batch) {
+    Summary* summary = (Summary*)context;
+    uint32_t i;
+    for (i = 0; i < batch->count; ++i) {
+        double ms = batch->frames[i].frameTime * 1000.0;
+        summary->totalMs += ms;
+        if (ms > summary->worstMs) summary->worstMs = ms;
+    }
+    summary->frames += batch->count;
+}
+
+/* Source */
+
+typedef struct Synthetic {
+    uint32_t sourceId;
+    uint64_t periodNs;
+    volatile long stop;
+#ifdef _WIN32
+    HANDLE thread;
+#else
+    pthread_t thread;
+#endif
+} Synthetic;
+
+static Synthetic g_synthetic;
+
+static int StopRequested(Synthetic* synthetic) {
+#ifdef _WIN32
+    return InterlockedCompareExchange(&synthetic->stop, 0, 0) != 0;
+#else
+    return __atomic_load_n(&synthetic->stop, __ATOMIC_ACQUIRE) != 0;
+#endif
+}
+
+static void SleepUntil(uint64_t deadlineNs) {
+    uint64_t now = g_host->now_ns(g_host->host);
+    if (deadlineNs <= now) return;
+#ifdef _WIN32
+    Sleep((DWORD)((deadlineNs - now) / 1000000));
+#else
+    {
+        struct timespec wait;
+        wait.tv_sec = (time_t)((deadlineNs - now) / 1000000000ull);
+        wait.tv_nsec = (long)((deadlineNs - now) % 1000000000ull);
+        nanosleep(&wait, NULL);
+    }
+#endif
+}
+
+static void SyntheticRun(Synthetic* synthetic) {
+    uint64_t pending[SOURCE_BATCH];
+    uint32_t count = 0;
+    uint64_t next = g_host->now_ns(g_host->host);
+
+    while (!StopRequested(synthetic)) {
+        next += synthetic->periodNs;
+        SleepUntil(next);
+        pending[count++] = g_host->now_ns(g_host->host);
+        if (count == SOURCE_BATCH) {
+            g_host->submit_presents(g_host->host, synthetic->sourceId, pending, count);
+            count = 0;
+        }
+    }
+    if (count) g_host->submit_presents(g_host->host, synthetic->sourceId, pending, count);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI SyntheticThread(LPVOID context) {
+    SyntheticRun((Synthetic*)context);
+    return 0;
+}
+#else
+static void* SyntheticThread(void* context) {
+    SyntheticRun((Synthetic*)context);
+    return NULL;
+}
+#endif
+
+static int SyntheticStart(void* context, uint32_t sourceId) {
+    Synthetic* synthetic = (Synthetic*)context;
+    synthetic->sourceId = sourceId;
+    synthetic->stop = 0;
+#ifdef _WIN32
+    synthetic->thread = CreateThread(NULL, 0, SyntheticThread, synthetic, 0, NULL);
+    return synthetic->thread ? FPS_PLUGIN_OK : FPS_PLUGIN_ERROR;
+#else
+    return pthread_create(&synthetic->thread, NULL, SyntheticThread, synthetic) == 0 ? FPS_PLUGIN_OK
+                                                                                    : FPS_PLUGIN_ERROR;
+#endif
+}
+
+static void SyntheticStop(void* context) {
+    Synthetic* synthetic = (Synthetic*)context;
+#ifdef _WIN32
+    InterlockedExchange(&synthetic->stop, 1);
+    WaitForSingleObject(synthetic->thread, INFINITE);
+    CloseHandle(synthetic->thread);
+#else
+    __atomic_store_n(&synthetic->stop, 1, __ATOMIC_RELEASE);
+    pthread_join(synthetic->thread, NULL);
+#endif
+}
+
+/* Entry points */
+
+FPS_PLUGIN_API uint32_t fps_plugin_abi_version(void) {
+    return FPS_PLUGIN_ABI_VERSION;
+}
+
+FPS_PLUGIN_API int fps_plugin_init(const FpsHostApiV1* host) {
+    FpsSinkV1 sink = {0};
+    const char* rate = getenv("FPS_SAMPLE_PLUGIN_SOURCE_HZ");
+
+    g_host = host;
+
+    sink.size = sizeof(sink);
+    sink.name = "frame-summary";
+    sink.context = &g_summary;
+    sink.consume_batch = SummaryConsumeBatch;
+    if (host->register_sink(host->host, &sink) != FPS_PLUGIN_OK) return FPS_PLUGIN_ERROR;
+
+    if (rate && atof(rate) > 0.0) {
+        FpsSourceV1 source = {0};
+        source.size = sizeof(source);
+        source.name = "synthetic";
+        source.context = &g_synthetic;
+        source.start = SyntheticStart;
+        source.stop = SyntheticStop;
+        g_synthetic.periodNs = (uint64_t)(1e9 / atof(rate));
+        if (host->register_source(host->host, &source) != FPS_PLUGIN_OK) {
+            host->log(host->host, FPS_PLUGIN_LOG_WARNING, "sample: no free source id for the synthetic source");
+        }
+    }
+    return FPS_PLUGIN_OK;
+}
+
+FPS_PLUGIN_API void fps_plugin_shutdown(void) {
+    char message[128];
+    snprintf(message, sizeof(message), "sample: %llu frames, mean %.2f ms, worst %.2f ms",
+             (unsigned long long)g_summary.frames,
+             g_summary.frames ? g_summary.totalMs / (double)g_summary.frames : 0.0, g_summary.worstMs);
+    g_host->log(g_host->host, FPS_PLUGIN_LOG_INFO, message);
+}
@@ -0,0 +1,100 @@
+#include "activity_governor.h"
+#include "frame_types.h"
+
+ActivityGovernor::ActivityGovernor(const ActivityConfig& config)
+    : m_config(config)
+    , m_lastActivityNs(0)
+    , m_state(ActivityState::IDLE)
+    , m_transitions(0)
+    , m_doorbellWakeups(0)
+    , m_lastProbeNs(0)
+{
+    for (auto& wakeups : m_wakeups) {
+        wakeups.store(0, std::memory_order_relaxed);
+    }
+}
+
+void ActivityGovernor::NotifyActivity(uint64_t nowNs) {
+    m_lastActivityNs.store(nowNs, std::memory_order_relaxed);
+
+    // Only pay for the doorbell when the owner may be asleep
+    if (m_state.load(std::memory_order_relaxed) != ActivityState::ACTIVE) {
+        m_doorbell.Ring();
+    }
+}
+
+void ActivityGovernor::SetProbe(std::function<bool()> probe) {
+    m_probe = std::move(probe);
+}
+
+void ActivityGovernor::SetStateCallback(std::function<void(ActivityState)> callback) {
+    m_callback = std::move(callback);
+}
+
+ActivityState ActivityGovernor::Update(uint64_t nowNs) {
+    ActivityState current = m_state.load(std::memory_order_relaxed);
+
+    // While ACTIVE the owner wakes at frame rate; rate-limit the probe.
+    // Otherwise every wakeup is already a poll.
+    uint64_t probeIntervalNs = static_cast<uint64_t>(m_config.probeIntervalMs) * 1000000ull;
+    if (m_probe && (current != ActivityState::ACTIVE || nowNs - m_lastProbeNs >= probeIntervalNs)) {
+        m_lastProbeNs = nowNs;
+        if (m_probe()) {
+            m_lastActivityNs.store(nowNs, std::memory_order_relaxed);
+        }
+    }
+
+    ActivityState next = Classify(nowNs);
+    if (next != current) {
+        m_state.store(next, std::memory_order_relaxed);
+        m_transitions.fetch_add(1, std::memory_order_relaxed);
+        if (m_callback) {
+            m_callback(next);
+        }
+    }
+
+    m_wakeups[static_cast<int>(next)].fetch_add(1, std::memory_order_relaxed);
+    return next;
+}
+
+void ActivityGovernor::WaitForActivity() {
+    uint32_t pollMs;
+    switch (m_state.load(std::memory_order_relaxed)) {
+        case ActivityState::COOLING: pollMs = m_config.coolingPollMs; break;
+        case ActivityState::IDLE:    pollMs = m_config.idlePollMs; break;
+        default: return;
+    }
+
+    uint64_t before = m_lastActivityNs.load(std::memory_order_relaxed);
+    m_doorbell.Wait(std::chrono::milliseconds(pollMs));
+    if (m_lastActivityNs.load(std::memory_order_relaxed) != before) {
+        m_doorbellWakeups.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+ActivityMetrics ActivityGovernor::GetMetrics() const {
+    ActivityMetrics metrics;
+    metrics.state = m_state.load(std::memory_order_relaxed);
+    metrics.transitions = m_transitions.load(std::memory_order_relaxed);
+    metrics.activeWakeups = m_wakeups[static_cast<int>(ActivityState::ACTIVE)].load(std::memory_order_relaxed);
+    metrics.coolingWakeups = m_wakeups[static_cast<int>(ActivityState::COOLING)].load(std::memory_order_relaxed);
+    metrics.idleWakeups = m_wakeups[static_cast<int>(ActivityState::IDLE)].load(std::memory_order_relaxed);
+    metrics.doorbellWakeups = m_doorbellWakeups.load(std::memory_order_relaxed);
+
+    uint64_t last = m_lastActivityNs.load(std::memory_order_relaxed);
+    uint64_t now = MonotonicNowNs();
+    metrics.idleForMs = last && now > last ? (now - last) / 1000000ull : 0;
+    return metrics;
+}
+
+// Private methods implementation
+ActivityState ActivityGovernor::Classify(uint64_t nowNs) const {
+    uint64_t last = m_lastActivityNs.load(std::memory_order_relaxed);
+    if (last == 0) return ActivityState::IDLE;
+
+    // Hook threads may stamp a slightly newer time than the owner's `nowNs`
+    uint64_t quietMs = nowNs > last ? (nowNs - last) / 1000000ull : 0;
+    if (quietMs < m_config.coolingAfterMs) return ActivityState::ACTIVE;
+    if (quietMs < m_config.idleAfterMs) return ActivityState::COOLING;
+    return ActivityState::IDLE;
+}
@@ -0,0 +1,138 @@
+#include "alloc_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace {
+    std::atomic<uint64_t> g_allocations(0);
+    std::atomic<uint64_t> g_frees(0);
+    std::atomic<uint64_t> g_bytes(0);
+
+    void* CountedAlloc(std::size_t size, std::size_t alignment) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        g_bytes.fetch_add(size, std::memory_order_relaxed);
+        if (size == 0) size = 1;
+
+        if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) return std::malloc(size);
+#ifdef _WIN32
+        return _aligned_malloc(size, alignment);
+#else
+        void* ptr = nullptr;
+        return posix_memalign(&ptr, alignment, size) == 0 ? ptr : nullptr;
+#endif
+    }
+
+    void CountedFree(void* ptr, std::size_t alignment) {
+        if (!ptr) return;
+        g_frees.fetch_add(1, std::memory_order_relaxed);
+#ifdef _WIN32
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            _aligned_free(ptr);
+            return;
+        }
+#else
+        (void)alignment;
+#endif
+        std::free(ptr);
+    }
+
+    void* CountedNew(std::size_t size, std::size_t alignment) {
+        void* ptr = CountedAlloc(size, alignment);
+        if (!ptr) throw std::bad_alloc();
+        return ptr;
+    }
+}
+
+AllocCounts AllocCounter::Get() {
+    AllocCounts counts;
+    counts.allocations = g_allocations.load(std::memory_order_relaxed);
+    counts.frees = g_frees.load(std::memory_order_relaxed);
+    counts.bytes = g_bytes.load(std::memory_order_relaxed);
+    return counts;
+}
+
+// Replaceable global allocation functions
+void* operator new(std::size_t size) {
+    return CountedNew(size, 0);
+}
+
+void* operator new[](std::size_t size) {
+    return CountedNew(size, 0);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return CountedNew(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return CountedNew(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return CountedAlloc(size, 0);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return CountedAlloc(size, 0);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return CountedAlloc(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return CountedAlloc(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept {
+    CountedFree(ptr, 0);
+}
+
+void operator delete[](void* ptr) noexcept {
+    CountedFree(ptr, 0);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    CountedFree(ptr, 0);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    CountedFree(ptr, 0);
+}
+
+void operator delete(void* ptr, std::align_val_t alignment) noexcept {
+    CountedFree(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept {
+    CountedFree(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t alignment) noexcept {
+    CountedFree(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t alignment) noexcept {
+    CountedFree(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    CountedFree(ptr, 0);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    CountedFree(ptr, 0);
+}
+
+void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    CountedFree(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    CountedFree(ptr, static_cast<std::size_t>(alignment));
+}
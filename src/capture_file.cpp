@@ -0,0 +1,131 @@
+#include "capture_file.h"
+#include "io_task.h"
+
+#include <cstring>
+#include <fstream>
+
+static_assert(sizeof(CaptureFileHeader) == 32, "Capture header layout is part of the file format");
+static_assert(sizeof(NormalizedFrame) == 16, "Capture record layout is part of the file format");
+
+CaptureSink::CaptureSink(std::filesystem::path path, uint32_t flushMs, std::shared_ptr<IoExecutor> io)
+    : m_path(std::move(path))
+    , m_flushMs(flushMs)
+    , m_io(std::move(io))
+    , m_pendingFrames(0)
+    , m_lastFlushNs(MonotonicNowNs())
+    , m_headerWritten(false)
+    , m_unwrittenFrames(0)
+    , m_writeInFlight(false)
+    , m_framesWritten(0)
+    , m_bytesWritten(0)
+    , m_failedWrites(0)
+{
+    // The first write replaces whatever was there and starts with the header
+    CaptureFileHeader header;
+    header.startNs = m_lastFlushNs;
+    const char* bytes = reinterpret_cast<const char*>(&header);
+    m_pending.assign(bytes, bytes + sizeof(header));
+}
+
+CaptureSink::~CaptureSink() {
+    Close();
+}
+
+void CaptureSink::ConsumeBatch(const FrameBatchRef& batch) {
+    const char* bytes = reinterpret_cast<const char*>(batch->Frames());
+    m_pending.insert(m_pending.end(), bytes, bytes + batch->Count() * sizeof(NormalizedFrame));
+    m_pendingFrames += batch->Count();
+
+    uint64_t now = MonotonicNowNs();
+    if (now - m_lastFlushNs >= m_flushMs * 1000000ull) {
+        Flush();
+        m_lastFlushNs = now;
+    }
+}
+
+void CaptureSink::Close() {
+    // Let the write in flight finish so the remainder lands after it
+    m_io->Drain();
+    Flush();
+    m_io->Drain();
+}
+
+CaptureStats CaptureSink::GetStats() const {
+    CaptureStats stats;
+    stats.framesWritten = m_framesWritten.load(std::memory_order_relaxed);
+    stats.bytesWritten = m_bytesWritten.load(std::memory_order_relaxed);
+    stats.failedWrites = m_failedWrites.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void CaptureSink::Flush() {
+    // A slow disk only makes the next write bigger, never out of order
+    if (m_writeInFlight.exchange(true, std::memory_order_acquire)) return;
+    if (m_pending.empty() && m_unwritten.empty()) {
+        m_writeInFlight.store(false, std::memory_order_release);
+        return;
+    }
+
+    // Until the header is on disk every write replaces the file, so a failed
+    // first write is retried whole: header, its frames and the ones since
+    if (!m_unwritten.empty()) {
+        m_unwritten.insert(m_unwritten.end(), m_pending.begin(), m_pending.end());
+        m_pending = std::move(m_unwritten);
+        m_pendingFrames += m_unwrittenFrames;
+        m_unwritten = std::vector<char>();
+        m_unwrittenFrames = 0;
+    }
+    IoWriteMode mode = m_headerWritten ? IoWriteMode::APPEND : IoWriteMode::REPLACE;
+
+    struct Write {
+        static Task<void> Run(CaptureSink* sink, std::vector<char> data, IoWriteMode mode, uint64_t frames) {
+            size_t bytes = data.size();
+            // A replacement keeps a copy in case it has to be written again
+            std::vector<char> retry;
+            if (mode == IoWriteMode::REPLACE) retry = data;
+            IoResult result = co_await sink->m_io->WriteFile(sink->m_path, std::move(data), mode);
+            if (result.ok) {
+                sink->m_framesWritten.fetch_add(frames, std::memory_order_relaxed);
+                sink->m_bytesWritten.fetch_add(bytes, std::memory_order_relaxed);
+                if (mode == IoWriteMode::REPLACE) sink->m_headerWritten = true;
+            } else {
+                sink->m_failedWrites.fetch_add(1, std::memory_order_relaxed);
+                // A failed replacement leaves the old file untouched; a failed
+                // append may have written part of a record, so it isn't retried
+                if (mode == IoWriteMode::REPLACE) {
+                    sink->m_unwritten = std::move(retry);
+                    sink->m_unwrittenFrames = frames;
+                }
+            }
+            sink->m_writeInFlight.store(false, std::memory_order_release);
+        }
+    };
+    Spawn(Write::Run(this, std::move(m_pending), mode, m_pendingFrames));
+    m_pending = std::vector<char>();
+    m_pendingFrames = 0;
+}
+
+bool ReadCaptureFile(const std::filesystem::path& path, std::vector<NormalizedFrame>& frames, std::string* error) {
+    auto fail = [error](const char* reason) {
+        if (error) *error = reason;
+        return false;
+    };
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return fail("cannot open file");
+
+    CaptureFileHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) return fail("truncated header");
+    if (header.magic != CAPTURE_FILE_MAGIC) return fail("not a capture file");
+    if (header.recordSize < sizeof(NormalizedFrame)) return fail("unsupported record size");
+
+    // Newer versions may append fields to each record; skip what we don't know
+    std::vector<char> record(header.recordSize);
+    frames.clear();
+    while (file.read(record.data(), record.size())) {
+        NormalizedFrame frame;
+        std::memcpy(&frame, record.data(), sizeof(frame));
+        frames.push_back(frame);
+    }
+    return true;
+}
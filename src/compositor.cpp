@@ -0,0 +1,395 @@
+#include "compositor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COMPOSITOR_SSE2 1
+#include <emmintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+#endif
+
+namespace Compositor {
+namespace Detail {
+    void BlendMaskScalar(uint32_t* dst, int dstStride, const uint8_t* mask, int maskStride,
+                         int width, int height, uint32_t color);
+    void BlendRectScalar(uint32_t* dst, int dstStride, int width, int height, uint32_t color);
+#ifdef FPS_COMPOSITOR_AVX2
+    // compositor_avx2.cpp, built with AVX2 code generation
+    void BlendMaskAvx2(uint32_t* dst, int dstStride, const uint8_t* mask, int maskStride,
+                       int width, int height, uint32_t color);
+    void BlendRectAvx2(uint32_t* dst, int dstStride, int width, int height, uint32_t color);
+#endif
+}
+}
+
+namespace {
+    // One clipped mask rectangle; a whole glyph per call
+    typedef void (*BlendMaskFn)(uint32_t* dst, int dstStride, const uint8_t* mask, int maskStride,
+                                int width, int height, uint32_t color);
+
+    // One clipped rectangle of a uniform colour
+    typedef void (*BlendRectFn)(uint32_t* dst, int dstStride, int width, int height, uint32_t color);
+
+    // Exact x / 255, rounded, for x <= 255 * 255
+    inline uint32_t Div255(uint32_t x) {
+        x += 128;
+        return (x + (x >> 8)) >> 8;
+    }
+
+#ifdef COMPOSITOR_SSE2
+    inline __m128i Div255Epu16(__m128i x) {
+        x = _mm_add_epi16(x, _mm_set1_epi16(128));
+        return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+    }
+
+    // Two pixels, one channel per 16-bit lane
+    inline __m128i BlendPixelPair(__m128i dst16, __m128i mask16, __m128i color16) {
+        __m128i src = Div255Epu16(_mm_mullo_epi16(color16, mask16));
+        __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src, _MM_SHUFFLE(3, 3, 3, 3)),
+                                            _MM_SHUFFLE(3, 3, 3, 3));
+        __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+        return _mm_add_epi16(src, Div255Epu16(_mm_mullo_epi16(dst16, inverse)));
+    }
+
+    // Four pixels
+    inline void BlendBlockSse2(uint32_t* dst, int32_t coverage, __m128i color16) {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i mask16 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(coverage), zero);
+        __m128i pairs = _mm_unpacklo_epi16(mask16, mask16);
+        __m128i maskLo = _mm_unpacklo_epi32(pairs, pairs);  // m0 x4, m1 x4
+        __m128i maskHi = _mm_unpackhi_epi32(pairs, pairs);  // m2 x4, m3 x4
+
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst));
+        __m128i lo = BlendPixelPair(_mm_unpacklo_epi8(pixels, zero), maskLo, color16);
+        __m128i hi = BlendPixelPair(_mm_unpackhi_epi8(pixels, zero), maskHi, color16);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(lo, hi));
+    }
+
+    void BlendMaskSse2(uint32_t* dst, int dstStride, const uint8_t* mask, int maskStride,
+                       int width, int height, uint32_t color) {
+        const __m128i color16 = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(color)), _mm_setzero_si128());
+        const int blocks = width & ~3;
+        const int rest = width - blocks;
+
+        for (int row = 0; row < height; ++row, dst += dstStride, mask += maskStride) {
+            for (int i = 0; i < blocks; i += 4) {
+                int32_t coverage;
+                std::memcpy(&coverage, mask + i, sizeof(coverage));
+                if (coverage != 0) {  // Gaps between and around glyphs
+                    BlendBlockSse2(dst + i, coverage, color16);
+                }
+            }
+
+            // Glyph rows are short, so blend the tail as a zero-padded
+            // block rather than pixel by pixel
+            if (rest > 0) {
+                uint8_t coverage[4] = {};
+                uint32_t pixels[4] = {};
+                for (int i = 0; i < rest; ++i) {
+                    coverage[i] = mask[blocks + i];
+                    pixels[i] = dst[blocks + i];
+                }
+                int32_t packed;
+                std::memcpy(&packed, coverage, sizeof(packed));
+                if (packed == 0) continue;
+                BlendBlockSse2(pixels, packed, color16);
+                for (int i = 0; i < rest; ++i) {
+                    dst[blocks + i] = pixels[i];
+                }
+            }
+        }
+    }
+
+    void BlendRectSse2(uint32_t* dst, int dstStride, int width, int height, uint32_t color) {
+        // Full coverage: src' is the colour itself, and the inverse alpha
+        // is the same for every pixel
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i color16 = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(color)), zero);
+        const __m128i inverse = _mm_set1_epi16(static_cast<short>(255 - (color >> 24)));
+        const int blocks = width & ~3;
+
+        for (int row = 0; row < height; ++row, dst += dstStride) {
+            for (int i = 0; i < blocks; i += 4) {
+                __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+                __m128i lo = Div255Epu16(_mm_mullo_epi16(_mm_unpacklo_epi8(pixels, zero), inverse));
+                __m128i hi = Div255Epu16(_mm_mullo_epi16(_mm_unpackhi_epi8(pixels, zero), inverse));
+                lo = _mm_add_epi16(color16, lo);
+                hi = _mm_add_epi16(color16, hi);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+            }
+            if (blocks < width) {
+                Compositor::Detail::BlendRectScalar(dst + blocks, dstStride, width - blocks, 1, color);
+            }
+        }
+    }
+
+    void FillRowSse2(uint32_t* dst, int count, uint32_t color) {
+        const __m128i colors = _mm_set1_epi32(static_cast<int>(color));
+        int i = 0;
+        for (; i + 8 <= count; i += 8) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), colors);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4), colors);
+        }
+        for (; i < count; ++i) {
+            dst[i] = color;
+        }
+    }
+#endif
+
+    bool CpuHasAvx2() {
+#if defined(FPS_COMPOSITOR_AVX2) && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;  // OS saves YMM
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#elif defined(FPS_COMPOSITOR_AVX2)
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }
+
+    CompositorKernel BestKernel() {
+        if (CpuHasAvx2()) return CompositorKernel::AVX2;
+#ifdef COMPOSITOR_SSE2
+        return CompositorKernel::SSE2;
+#else
+        return CompositorKernel::SCALAR;
+#endif
+    }
+
+    std::atomic<CompositorKernel> g_kernel(BestKernel());
+
+    BlendMaskFn BlendKernel(CompositorKernel kernel) {
+        switch (kernel) {
+#ifdef FPS_COMPOSITOR_AVX2
+            case CompositorKernel::AVX2: return Compositor::Detail::BlendMaskAvx2;
+#endif
+#ifdef COMPOSITOR_SSE2
+            case CompositorKernel::SSE2: return BlendMaskSse2;
+#endif
+            default: return Compositor::Detail::BlendMaskScalar;
+        }
+    }
+
+    BlendRectFn BlendRectKernel(CompositorKernel kernel) {
+        switch (kernel) {
+#ifdef FPS_COMPOSITOR_AVX2
+            case CompositorKernel::AVX2: return Compositor::Detail::BlendRectAvx2;
+#endif
+#ifdef COMPOSITOR_SSE2
+            case CompositorKernel::SSE2: return BlendRectSse2;
+#endif
+            default: return Compositor::Detail::BlendRectScalar;
+        }
+    }
+
+    // Quarter-circle coverage for the top-left corner of a rounded
+    // rectangle: how much of each pixel lies within `radius` of the point
+    // (radius, radius), from the distance to the pixel centre
+    void CornerCoverage(uint8_t* mask, int radius) {
+        float r = static_cast<float>(radius);
+        for (int row = 0; row < radius; ++row) {
+            for (int col = 0; col < radius; ++col) {
+                float dx = r - (static_cast<float>(col) + 0.5f);
+                float dy = r - (static_cast<float>(row) + 0.5f);
+                float coverage = r + 0.5f - std::sqrt(dx * dx + dy * dy);
+                coverage = std::min(std::max(coverage, 0.0f), 1.0f);
+                mask[row * radius + col] = static_cast<uint8_t>(coverage * 255.0f + 0.5f);
+            }
+        }
+    }
+}
+
+void Compositor::Detail::BlendMaskScalar(uint32_t* dst, int dstStride, const uint8_t* mask, int maskStride,
+                                         int width, int height, uint32_t color) {
+    const uint32_t colorB = color & 0xFF;
+    const uint32_t colorG = (color >> 8) & 0xFF;
+    const uint32_t colorR = (color >> 16) & 0xFF;
+    const uint32_t colorA = color >> 24;
+
+    for (int row = 0; row < height; ++row, dst += dstStride, mask += maskStride) {
+        for (int i = 0; i < width; ++i) {
+            uint32_t coverage = mask[i];
+            if (coverage == 0) continue;
+
+            uint32_t srcA = Div255(colorA * coverage);
+            uint32_t inverse = 255 - srcA;
+            uint32_t pixel = dst[i];
+            // Saturate like the SIMD packs do, for colours that aren't
+            // really premultiplied
+            uint32_t b = std::min(255u, Div255(colorB * coverage) + Div255((pixel & 0xFF) * inverse));
+            uint32_t g = std::min(255u, Div255(colorG * coverage) + Div255(((pixel >> 8) & 0xFF) * inverse));
+            uint32_t r = std::min(255u, Div255(colorR * coverage) + Div255(((pixel >> 16) & 0xFF) * inverse));
+            uint32_t a = std::min(255u, srcA + Div255((pixel >> 24) * inverse));
+            dst[i] = (a << 24) | (r << 16) | (g << 8) | b;
+        }
+    }
+}
+
+void Compositor::Detail::BlendRectScalar(uint32_t* dst, int dstStride, int width, int height, uint32_t color) {
+    const uint32_t colorB = color & 0xFF;
+    const uint32_t colorG = (color >> 8) & 0xFF;
+    const uint32_t colorR = (color >> 16) & 0xFF;
+    const uint32_t colorA = color >> 24;
+    const uint32_t inverse = 255 - colorA;
+
+    for (int row = 0; row < height; ++row, dst += dstStride) {
+        for (int i = 0; i < width; ++i) {
+            uint32_t pixel = dst[i];
+            uint32_t b = std::min(255u, colorB + Div255((pixel & 0xFF) * inverse));
+            uint32_t g = std::min(255u, colorG + Div255(((pixel >> 8) & 0xFF) * inverse));
+            uint32_t r = std::min(255u, colorR + Div255(((pixel >> 16) & 0xFF) * inverse));
+            uint32_t a = std::min(255u, colorA + Div255((pixel >> 24) * inverse));
+            dst[i] = (a << 24) | (r << 16) | (g << 8) | b;
+        }
+    }
+}
+
+uint32_t Compositor::Premultiply(uint32_t argb) {
+    uint32_t a = argb >> 24;
+    uint32_t r = Div255(((argb >> 16) & 0xFF) * a);
+    uint32_t g = Div255(((argb >> 8) & 0xFF) * a);
+    uint32_t b = Div255((argb & 0xFF) * a);
+    return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
+CompositorKernel Compositor::GetKernel() {
+    return g_kernel.load(std::memory_order_relaxed);
+}
+
+void Compositor::SetKernel(CompositorKernel kernel) {
+    g_kernel.store(IsKernelSupported(kernel) ? kernel : BestKernel(), std::memory_order_relaxed);
+}
+
+bool Compositor::IsKernelSupported(CompositorKernel kernel) {
+    switch (kernel) {
+        case CompositorKernel::SCALAR: return true;
+#ifdef COMPOSITOR_SSE2
+        case CompositorKernel::SSE2: return true;
+#endif
+        case CompositorKernel::AVX2: return CpuHasAvx2();
+        default: return false;
+    }
+}
+
+const char* Compositor::KernelName(CompositorKernel kernel) {
+    switch (kernel) {
+        case CompositorKernel::SCALAR: return "scalar";
+        case CompositorKernel::SSE2: return "sse2";
+        case CompositorKernel::AVX2: return "avx2";
+    }
+    return "unknown";
+}
+
+void Compositor::Fill(PixelBuffer& buffer, int x, int y, int width, int height, uint32_t color) {
+    int x0 = std::max(x, 0);
+    int y0 = std::max(y, 0);
+    int x1 = std::min(x + width, buffer.width);
+    int y1 = std::min(y + height, buffer.height);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    for (int row = y0; row < y1; ++row) {
+        uint32_t* line = buffer.pixels + static_cast<size_t>(row) * buffer.stride;
+#ifdef COMPOSITOR_SSE2
+        FillRowSse2(line + x0, x1 - x0, color);
+#else
+        std::fill(line + x0, line + x1, color);
+#endif
+    }
+}
+
+void Compositor::BlendRect(PixelBuffer& buffer, int x, int y, int width, int height, uint32_t color) {
+    if ((color >> 24) == 0xFF) {  // Opaque: the same as overwriting
+        Fill(buffer, x, y, width, height, color);
+        return;
+    }
+    if (color == 0) return;
+
+    int x0 = std::max(x, 0);
+    int y0 = std::max(y, 0);
+    int x1 = std::min(x + width, buffer.width);
+    int y1 = std::min(y + height, buffer.height);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    uint32_t* target = buffer.pixels + static_cast<size_t>(y0) * buffer.stride + x0;
+    BlendRectKernel(GetKernel())(target, buffer.stride, x1 - x0, y1 - y0, color);
+}
+
+void Compositor::FillRoundedRect(PixelBuffer& buffer, int x, int y, int width, int height, int radius,
+                                 uint32_t color) {
+    if (width <= 0 || height <= 0) return;
+    radius = std::min(std::max(radius, 0), std::min(ROUNDED_RECT_MAX_RADIUS, std::min(width, height) / 2));
+    if (radius == 0) {
+        BlendRect(buffer, x, y, width, height, color);
+        return;
+    }
+
+    // Full rows between the corners, then the bands between them
+    BlendRect(buffer, x, y + radius, width, height - 2 * radius, color);
+    BlendRect(buffer, x + radius, y, width - 2 * radius, radius, color);
+    BlendRect(buffer, x + radius, y + height - radius, width - 2 * radius, radius, color);
+
+    // The corners through their coverage, mirrored from the top-left one;
+    // clipping happens in BlendMask()
+    uint8_t topLeft[ROUNDED_RECT_MAX_RADIUS * ROUNDED_RECT_MAX_RADIUS];
+    uint8_t mirrored[ROUNDED_RECT_MAX_RADIUS * ROUNDED_RECT_MAX_RADIUS];
+    CornerCoverage(topLeft, radius);
+    BlendMask(buffer, x, y, topLeft, radius, radius, radius, color);
+    for (int row = 0; row < radius; ++row) {
+        for (int col = 0; col < radius; ++col) {
+            mirrored[row * radius + col] = topLeft[row * radius + (radius - 1 - col)];
+        }
+    }
+    BlendMask(buffer, x + width - radius, y, mirrored, radius, radius, radius, color);
+    // Bottom corners: the top ones read bottom row first
+    const uint8_t* lastRow = topLeft + (radius - 1) * radius;
+    BlendMask(buffer, x, y + height - radius, lastRow, radius, radius, -radius, color);
+    lastRow = mirrored + (radius - 1) * radius;
+    BlendMask(buffer, x + width - radius, y + height - radius, lastRow, radius, radius, -radius, color);
+}
+
+void Compositor::BlendMask(PixelBuffer& buffer, int x, int y, const uint8_t* mask, int width, int height,
+                           int maskStride, uint32_t color) {
+    int x0 = std::max(x, 0);
+    int y0 = std::max(y, 0);
+    int x1 = std::min(x + width, buffer.width);
+    int y1 = std::min(y + height, buffer.height);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    uint32_t* target = buffer.pixels + static_cast<size_t>(y0) * buffer.stride + x0;
+    const uint8_t* coverage = mask + static_cast<ptrdiff_t>(y0 - y) * maskStride + (x0 - x);  // Stride may be negative
+    BlendKernel(GetKernel())(target, buffer.stride, coverage, maskStride, x1 - x0, y1 - y0, color);
+}
+
+int Compositor::DrawString(PixelBuffer& buffer, const GlyphAtlas& atlas, int x, int y,
+                           const wchar_t* text, int length, uint32_t color) {
+    if (atlas.IsEmpty()) return x;
+
+    const GlyphInfo* fallback = atlas.Find(L'?');
+    int pen = x;
+    for (int i = 0; i < length; ++i) {
+        const GlyphInfo* glyph = atlas.Find(text[i]);
+        if (!glyph) glyph = fallback;
+        if (glyph->width > 0) {
+            BlendMask(buffer, pen + glyph->left, y + glyph->top, atlas.Coverage(*glyph),
+                      glyph->width, glyph->height, glyph->width, color);
+        }
+        pen += glyph->advance;
+    }
+    return pen;
+}
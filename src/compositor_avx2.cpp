@@ -0,0 +1,117 @@
+// AVX2 blend kernels; this file alone is compiled with AVX2 code generation
+// and only called after compositor.cpp has checked the CPU supports it.
+
+#include "compositor.h"
+
+#include <cstring>
+#include <immintrin.h>
+
+namespace Compositor {
+namespace Detail {
+    void BlendMaskAvx2(uint32_t* dst, int dstStride, const uint8_t* mask, int maskStride,
+                       int width, int height, uint32_t color);
+    void BlendRectAvx2(uint32_t* dst, int dstStride, int width, int height, uint32_t color);
+}
+}
+
+namespace {
+    inline __m256i Div255Epu16(__m256i x) {
+        x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+        return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+    }
+
+    // Four pixels (two per 128-bit lane), one channel per 16-bit lane
+    inline __m256i BlendPixelQuad(__m256i dst16, __m256i mask16, __m256i color16) {
+        __m256i src = Div255Epu16(_mm256_mullo_epi16(color16, mask16));
+        __m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(src, _MM_SHUFFLE(3, 3, 3, 3)),
+                                               _MM_SHUFFLE(3, 3, 3, 3));
+        __m256i inverse = _mm256_sub_epi16(_mm256_set1_epi16(255), alpha);
+        return _mm256_add_epi16(src, Div255Epu16(_mm256_mullo_epi16(dst16, inverse)));
+    }
+
+    // Eight pixels
+    inline __m256i BlendBlock(__m256i pixels, long long coverage, __m256i color16) {
+        // The byte unpacks work per 128-bit lane, so the low half of the
+        // result holds pixels 0,1 | 4,5 and the high half 2,3 | 6,7; spread
+        // the mask bytes the same way
+        const __m256i spreadLo = _mm256_setr_epi8(
+            0, -1, 0, -1, 0, -1, 0, -1, 1, -1, 1, -1, 1, -1, 1, -1,
+            4, -1, 4, -1, 4, -1, 4, -1, 5, -1, 5, -1, 5, -1, 5, -1);
+        const __m256i spreadHi = _mm256_setr_epi8(
+            2, -1, 2, -1, 2, -1, 2, -1, 3, -1, 3, -1, 3, -1, 3, -1,
+            6, -1, 6, -1, 6, -1, 6, -1, 7, -1, 7, -1, 7, -1, 7, -1);
+        const __m256i zero = _mm256_setzero_si256();
+
+        __m256i masks = _mm256_set1_epi64x(coverage);
+        __m256i maskLo = _mm256_shuffle_epi8(masks, spreadLo);
+        __m256i maskHi = _mm256_shuffle_epi8(masks, spreadHi);
+
+        __m256i lo = BlendPixelQuad(_mm256_unpacklo_epi8(pixels, zero), maskLo, color16);
+        __m256i hi = BlendPixelQuad(_mm256_unpackhi_epi8(pixels, zero), maskHi, color16);
+        return _mm256_packus_epi16(lo, hi);
+    }
+
+    // Eight pixels under a uniform colour at full coverage: src' is the
+    // colour itself and the inverse alpha the same everywhere, so there is
+    // no mask to spread
+    inline __m256i BlendUniform(__m256i pixels, __m256i inverse, __m256i color16) {
+        const __m256i zero = _mm256_setzero_si256();
+        __m256i lo = Div255Epu16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(pixels, zero), inverse));
+        __m256i hi = Div255Epu16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(pixels, zero), inverse));
+        return _mm256_packus_epi16(_mm256_add_epi16(color16, lo), _mm256_add_epi16(color16, hi));
+    }
+}
+
+void Compositor::Detail::BlendMaskAvx2(uint32_t* dst, int dstStride, const uint8_t* mask, int maskStride,
+                                       int width, int height, uint32_t color) {
+    const __m256i color16 = _mm256_unpacklo_epi8(_mm256_set1_epi32(static_cast<int>(color)), _mm256_setzero_si256());
+    const int blocks = width & ~7;
+    const int rest = width - blocks;
+    static const int TAIL_LANES[16] = {-1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0};
+    const __m256i lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(TAIL_LANES + 8 - rest));
+
+    for (int row = 0; row < height; ++row, dst += dstStride, mask += maskStride) {
+        for (int i = 0; i < blocks; i += 8) {
+            long long coverage;
+            std::memcpy(&coverage, mask + i, sizeof(coverage));
+            if (coverage != 0) {  // Gaps between and around glyphs
+                __m256i* pixels = reinterpret_cast<__m256i*>(dst + i);
+                _mm256_storeu_si256(pixels, BlendBlock(_mm256_loadu_si256(pixels), coverage, color16));
+            }
+        }
+
+        // Glyph rows are short, so blend the tail as one block through
+        // masked loads and stores rather than pixel by pixel
+        if (rest > 0) {
+            long long coverage = 0;
+            for (int i = rest - 1; i >= 0; --i) {
+                coverage = (coverage << 8) | mask[blocks + i];
+            }
+            if (coverage == 0) continue;
+            int* pixels = reinterpret_cast<int*>(dst + blocks);
+            __m256i block = BlendBlock(_mm256_maskload_epi32(pixels, lanes), coverage, color16);
+            _mm256_maskstore_epi32(pixels, lanes, block);
+        }
+    }
+}
+
+void Compositor::Detail::BlendRectAvx2(uint32_t* dst, int dstStride, int width, int height, uint32_t color) {
+    const __m256i color16 = _mm256_unpacklo_epi8(_mm256_set1_epi32(static_cast<int>(color)), _mm256_setzero_si256());
+    const __m256i inverse = _mm256_set1_epi16(static_cast<short>(255 - (color >> 24)));
+    const int blocks = width & ~7;
+    const int rest = width - blocks;
+    static const int TAIL_LANES[16] = {-1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0};
+    const __m256i lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(TAIL_LANES + 8 - rest));
+
+    for (int row = 0; row < height; ++row, dst += dstStride) {
+        for (int i = 0; i < blocks; i += 8) {
+            __m256i* pixels = reinterpret_cast<__m256i*>(dst + i);
+            _mm256_storeu_si256(pixels, BlendUniform(_mm256_loadu_si256(pixels), inverse, color16));
+        }
+        if (rest > 0) {
+            int* pixels = reinterpret_cast<int*>(dst + blocks);
+            __m256i block = BlendUniform(_mm256_maskload_epi32(pixels, lanes), inverse, color16);
+            _mm256_maskstore_epi32(pixels, lanes, block);
+        }
+    }
+}
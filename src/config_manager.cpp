@@ -3,14 +3,52 @@
 #include <sstream>
 #include <fstream>
 #include <iomanip>
+#include <algorithm>
+#include <cwchar>
+#include <cctype>
 
-ConfigManager::ConfigManager() {
+namespace {
+    bool EqualsNoCase(const std::string& a, const std::string& b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    std::string TrimAscii(const std::string& str) {
+        size_t first = str.find_first_not_of(" \t\r");
+        if (first == std::string::npos) return std::string();
+        size_t last = str.find_last_not_of(" \t\r");
+        return str.substr(first, last - first + 1);
+    }
+    
+    // Written once at the top of a newly created file
+    const char* const CONFIG_FILE_HEADER[] = {
+        "; FPS Overlay Configuration File",
+        "; Position: 0=Top-Left, 1=Top-Right, 2=Bottom-Left, 3=Bottom-Right",
+        "; Monitor: 0=Primary, 1=The one showing the game window",
+        "; FontSize: 0=Auto-scale based on resolution, or specify custom size",
+        "; Colors: R,G,B,A values (0.0-1.0 range)",
+        "; UpdateInterval: Milliseconds between FPS updates (recommended: 500-1000)",
+        "; Widgets: fps frametime low1 low01 hitches range graph heatmap, rows separated by |",
+    };
+}
+
+ConfigManager::ConfigManager()
+    : m_dirty(false)
+    , m_saveInFlight(false)
+    , m_io(IoExecutor::Shared())
+{
     // Initialize default configuration
     m_config = OverlayConfig();
 }
 
 ConfigManager::~ConfigManager() {
-    // Save configuration on destruction
+    // Let a running flush finish, then save on destruction
+    m_io->Drain();
     SaveConfig();
 }
 
@@ -22,40 +60,122 @@ bool ConfigManager::LoadConfig(const std::wstring& configPath) {
         return SaveConfig(configPath); // Create default config
     }
     
+    // One read; every key below is a lookup in memory instead of a
+    // GetPrivateProfileString call that opens and scans the file again
+    IniFile ini;
+    if (!ini.Load(std::filesystem::path(fullPath))) {
+        Utils::LogError(L"Failed to read configuration from: " + fullPath);
+        return false;
+    }
+    
     try {
         // Load general settings
-        m_config.enabled = ReadIniBool(L"General", L"Enabled", true, fullPath);
-        m_config.updateInterval = ReadIniInt(L"General", L"UpdateInterval", DEFAULT_UPDATE_INTERVAL, fullPath);
+        m_config.enabled = ReadIniBool(L"General", L"Enabled", true, ini);
+        m_config.updateInterval = ReadIniInt(L"General", L"UpdateInterval", DEFAULT_UPDATE_INTERVAL, ini);
         
         // Load appearance settings
-        int position = ReadIniInt(L"Appearance", L"Position", static_cast<int>(OverlayPosition::TOP_LEFT), fullPath);
+        int position = ReadIniInt(L"Appearance", L"Position", static_cast<int>(OverlayPosition::TOP_LEFT), ini);
         m_config.position = static_cast<OverlayPosition>(position);
+        int monitor = ReadIniInt(L"Appearance", L"Monitor", static_cast<int>(OverlayMonitor::PRIMARY), ini);
+        m_config.monitor = monitor == static_cast<int>(OverlayMonitor::TARGET) ? OverlayMonitor::TARGET
+                                                                              : OverlayMonitor::PRIMARY;
+        
+        m_config.fontSize = ReadIniInt(L"Appearance", L"FontSize", 0, ini); // 0 = auto-scale
+        m_config.fontName = ReadIniString(L"Appearance", L"FontName", L"Consolas", ini);
+        m_config.offsetX = ReadIniInt(L"Appearance", L"OffsetX", 10, ini);
+        m_config.offsetY = ReadIniInt(L"Appearance", L"OffsetY", 10, ini);
+        m_config.showBackground = ReadIniBool(L"Appearance", L"ShowBackground", true, ini);
+        
+        // Load frame-time graph settings
+        m_config.showGraph = ReadIniBool(L"Graph", L"Enabled", false, ini);
+        m_config.graphWidth = std::min(std::max(ReadIniInt(L"Graph", L"Width", 160, ini), 16), 4096);
+        m_config.graphHeight = std::min(std::max(ReadIniInt(L"Graph", L"Height", 40, ini), 8), 1024);
+        m_config.graphScaleMs = std::max(ReadIniInt(L"Graph", L"ScaleMs", 50, ini), 1);
+        m_config.graphFramesPerColumn = std::max(ReadIniInt(L"Graph", L"FramesPerColumn", 1, ini), 1);
         
-        m_config.fontSize = ReadIniInt(L"Appearance", L"FontSize", 0, fullPath); // 0 = auto-scale
-        m_config.fontName = ReadIniString(L"Appearance", L"FontName", L"Consolas", fullPath);
-        m_config.offsetX = ReadIniInt(L"Appearance", L"OffsetX", 10, fullPath);
-        m_config.offsetY = ReadIniInt(L"Appearance", L"OffsetY", 10, fullPath);
-        m_config.showBackground = ReadIniBool(L"Appearance", L"ShowBackground", true, fullPath);
+        // Load frame-time heatmap settings
+        m_config.showHeatmap = ReadIniBool(L"Heatmap", L"Enabled", false, ini);
+        m_config.heatmapWidth = std::min(std::max(ReadIniInt(L"Heatmap", L"Width", 160, ini), 16), 4096);
+        m_config.heatmapHeight = std::min(std::max(ReadIniInt(L"Heatmap", L"Height", 40, ini), 8), 1024);
+        m_config.heatmapSliceMs = std::max(ReadIniInt(L"Heatmap", L"SliceMs", 250, ini), 1);
+        m_config.heatmapMinMs = std::max(ReadIniInt(L"Heatmap", L"MinMs", 2, ini), 1);
+        m_config.heatmapMaxMs = std::max(ReadIniInt(L"Heatmap", L"MaxMs", 100, ini), m_config.heatmapMinMs * 2);
+        
+        // Load widget layout; [Graph] and [Heatmap] Enabled still add theirs
+        // on a row of their own, and listing one enables it
+        std::wstring widgetsStr = ReadIniString(L"Layout", L"Widgets", L"fps", ini);
+        m_config.widgets = WidgetList();
+        if (!WidgetList::Parse(widgetsStr, m_config.widgets)) {
+            Utils::LogWarning(L"Failed to parse widget list: " + widgetsStr);
+        }
+        if (m_config.showGraph && !m_config.widgets.Contains(OverlayWidget::GRAPH)) {
+            m_config.widgets.AppendRow(OverlayWidget::GRAPH);
+        }
+        if (m_config.showHeatmap && !m_config.widgets.Contains(OverlayWidget::HEATMAP)) {
+            m_config.widgets.AppendRow(OverlayWidget::HEATMAP);
+        }
+        m_config.showGraph = m_config.widgets.Contains(OverlayWidget::GRAPH);
+        m_config.showHeatmap = m_config.widgets.Contains(OverlayWidget::HEATMAP);
         
         // Load colors
-        std::wstring textColorStr = ReadIniString(L"Colors", L"TextColor", L"0.0,1.0,0.0,1.0", fullPath);
+        std::wstring textColorStr = ReadIniString(L"Colors", L"TextColor", L"0.0,1.0,0.0,1.0", ini);
         m_config.textColor = ParseColor(textColorStr, Color(0.0f, 1.0f, 0.0f, 1.0f));
         
-        std::wstring bgColorStr = ReadIniString(L"Colors", L"BackgroundColor", L"0.0,0.0,0.0,0.5", fullPath);
+        std::wstring bgColorStr = ReadIniString(L"Colors", L"BackgroundColor", L"0.0,0.0,0.0,0.5", ini);
         m_config.backgroundColor = ParseColor(bgColorStr, Color(0.0f, 0.0f, 0.0f, 0.5f));
         
+        // Load advanced settings
+        m_config.minFrameTimeMs = ReadIniInt(L"Advanced", L"MinFrameTime", 1, ini);
+        
+        // Load pipeline settings (0=Drop, 1=Block)
+        m_config.ingestPolicy = ReadIniInt(L"Pipeline", L"IngestPolicy", 0, ini) ?
+            BackpressurePolicy::BLOCK : BackpressurePolicy::DROP;
+        m_config.normalizePolicy = ReadIniInt(L"Pipeline", L"NormalizePolicy", 1, ini) ?
+            BackpressurePolicy::BLOCK : BackpressurePolicy::DROP;
+        m_config.sinkPolicy = ReadIniInt(L"Pipeline", L"SinkPolicy", 0, ini) ?
+            BackpressurePolicy::BLOCK : BackpressurePolicy::DROP;
+        m_config.queueCapacity = ReadIniInt(L"Pipeline", L"QueueCapacity", 1024, ini);
+        
+        // Load pacing settings (0=Coarse, 1=Hybrid, 2=Spin)
+        int pacingMode = ReadIniInt(L"Pacing", L"Mode", 1, ini);
+        m_config.pacingMode = static_cast<PacingMode>(std::min(std::max(pacingMode, 0), 2));
+        m_config.spinThresholdUs = std::min(std::max(
+            ReadIniInt(L"Pacing", L"SpinThresholdUs", PACING_DEFAULT_SPIN_US, ini), 0), PACING_MAX_SPIN_US);
+        
+        // Load idle throttling settings
+        m_config.idleThrottling = ReadIniBool(L"Activity", L"IdleThrottling", true, ini);
+        m_config.idleAfterMs = std::max(ReadIniInt(L"Activity", L"IdleAfterMs", 5000, ini), 1000);
+        m_config.idlePollMs = std::max(ReadIniInt(L"Activity", L"IdlePollMs", 1000, ini), 100);
+        m_config.gameProcesses = ReadIniString(L"Activity", L"GameProcesses", L"", ini);
+        
+        // Load thread settings; masks are hex so all 64 CPUs fit
+        m_config.workerThreads = std::max(ReadIniInt(L"Threads", L"WorkerThreads", 0, ini), 0);
+        m_config.workerAffinityMask = ParseAffinityMask(
+            ReadIniString(L"Threads", L"WorkerAffinityMask", L"0", ini));
+        m_config.workerPriority = ThreadAffinity::PriorityFromInt(
+            ReadIniInt(L"Threads", L"WorkerPriority", -2, ini));
+        m_config.samplerAffinityMask = ParseAffinityMask(
+            ReadIniString(L"Threads", L"SamplerAffinityMask", L"auto", ini));
+        m_config.samplerPriority = ThreadAffinity::PriorityFromInt(
+            ReadIniInt(L"Threads", L"SamplerPriority", 0, ini));
+        m_config.renderAffinityMask = ParseAffinityMask(
+            ReadIniString(L"Threads", L"RenderAffinityMask", L"auto", ini));
+        m_config.renderPriority = ThreadAffinity::PriorityFromInt(
+            ReadIniInt(L"Threads", L"RenderPriority", -1, ini));
+        m_config.backgroundAffinityMask = ParseAffinityMask(
+            ReadIniString(L"Threads", L"BackgroundAffinityMask", L"auto", ini));
+        m_config.backgroundPriority = ThreadAffinity::PriorityFromInt(
+            ReadIniInt(L"Threads", L"BackgroundPriority", -1, ini));
+        
+        // Load plugin settings
+        m_config.pluginsEnabled = ReadIniBool(L"Plugins", L"Enabled", true, ini);
+        m_config.pluginDirectory = ReadIniString(L"Plugins", L"Directory", L"plugins", ini);
+        
         // Auto-scale font size if set to 0
         if (m_config.fontSize <= 0) {
             m_config.fontSize = GetScaledFontSize();
         }
         
-        // Validate font availability
-        if (!Utils::IsFontInstalled(m_config.fontName)) {
-            std::vector<std::wstring> preferredFonts = {L"Consolas", L"Courier New", L"Arial"};
-            m_config.fontName = Utils::GetBestAvailableFont(preferredFonts);
-            Utils::LogWarning(L"Font not found, using fallback: " + m_config.fontName);
-        }
-        
         Utils::LogInfo(L"Configuration loaded successfully from: " + fullPath);
         return true;
         
@@ -66,55 +186,77 @@ bool ConfigManager::LoadConfig(const std::wstring& configPath) {
 }
 
 bool ConfigManager::SaveConfig(const std::wstring& configPath) {
+    return SyncWait(SaveConfigAsync(configPath));
+}
+
+Task<bool> ConfigManager::SaveConfigAsync(std::wstring configPath) {
     std::wstring fullPath = Utils::GetExecutableDirectory() + L"\\" + configPath;
     
+    // Snapshot on the calling thread; everything after the first await runs
+    // on the I/O thread
+    std::vector<IniValue> values;
+    {
+        std::lock_guard<std::mutex> lock(g_configMutex);
+        values = CollectIniValues(m_config);
+    }
+    
     try {
+        // A missing file (or directory) is not an error: it is created below.
+        // Any other read failure keeps the file as it is, since rewriting it
+        // from the defaults alone would drop the user's comments.
+        IoResult existing = co_await m_io->ReadFile(fullPath);
+        if (!existing.ok && existing.error != ERROR_FILE_NOT_FOUND && existing.error != ERROR_PATH_NOT_FOUND) {
+            Utils::LogError(L"Failed to read configuration before saving: " + fullPath +
+                            L" (error " + std::to_wstring(existing.error) + L")");
+            co_return false;
+        }
+        std::string text(existing.data.begin(), existing.data.end());
+        
         // Create directory if it doesn't exist
         size_t lastSlash = fullPath.find_last_of(L"\\/");
         if (lastSlash != std::wstring::npos) {
-            std::wstring dir = fullPath.substr(0, lastSlash);
-            Utils::CreateDirectoryRecursive(dir);
+            Utils::CreateDirectoryRecursive(fullPath.substr(0, lastSlash));
         }
         
-        // Save general settings
-        WriteIniBool(L"General", L"Enabled", m_config.enabled, fullPath);
-        WriteIniInt(L"General", L"UpdateInterval", m_config.updateInterval, fullPath);
-        
-        // Save appearance settings
-        WriteIniInt(L"Appearance", L"Position", static_cast<int>(m_config.position), fullPath);
-        WriteIniInt(L"Appearance", L"FontSize", m_config.fontSize, fullPath);
-        WriteIniString(L"Appearance", L"FontName", m_config.fontName, fullPath);
-        WriteIniInt(L"Appearance", L"OffsetX", m_config.offsetX, fullPath);
-        WriteIniInt(L"Appearance", L"OffsetY", m_config.offsetY, fullPath);
-        WriteIniBool(L"Appearance", L"ShowBackground", m_config.showBackground, fullPath);
-        
-        // Save colors
-        WriteIniString(L"Colors", L"TextColor", ColorToString(m_config.textColor), fullPath);
-        WriteIniString(L"Colors", L"BackgroundColor", ColorToString(m_config.backgroundColor), fullPath);
-        
-        // Write configuration comments
-        std::wofstream file(fullPath, std::ios::app);
-        if (file.is_open()) {
-            file << L"\n; FPS Overlay Configuration File\n";
-            file << L"; Position: 0=Top-Left, 1=Top-Right, 2=Bottom-Left, 3=Bottom-Right\n";
-            file << L"; FontSize: 0=Auto-scale based on resolution, or specify custom size\n";
-            file << L"; Colors: R,G,B,A values (0.0-1.0 range)\n";
-            file << L"; UpdateInterval: Milliseconds between FPS updates (recommended: 500-1000)\n";
-            file.close();
+        std::string merged = MergeIniText(text, values);
+        IoResult written = co_await m_io->WriteFile(fullPath, std::vector<char>(merged.begin(), merged.end()),
+                                                    IoWriteMode::REPLACE);
+        if (!written.ok) {
+            Utils::LogError(L"Failed to save configuration to: " + fullPath +
+                            L" (error " + std::to_wstring(written.error) + L")");
+            co_return false;
         }
         
         Utils::LogInfo(L"Configuration saved successfully to: " + fullPath);
-        return true;
+        co_return true;
         
     } catch (...) {
         Utils::LogError(L"Failed to save configuration to: " + fullPath);
-        return false;
+        co_return false;
     }
 }
 
 void ConfigManager::UpdateConfig(const OverlayConfig& config) {
     std::lock_guard<std::mutex> lock(g_configMutex);
     m_config = config;
+    m_dirty = true;
+}
+
+bool ConfigManager::SaveIfDirty(const std::wstring& configPath) {
+    if (m_saveInFlight.load()) return false;
+    if (!m_dirty.exchange(false)) return true;
+    
+    m_saveInFlight = true;
+    Spawn(FlushAsync(configPath));
+    return true;
+}
+
+Task<void> ConfigManager::FlushAsync(std::wstring configPath) {
+    bool saved = co_await SaveConfigAsync(std::move(configPath));
+    if (!saved) {
+        m_dirty = true;  // Retry on the next flush
+    }
+    m_saveInFlight = false;
 }
 
 int ConfigManager::GetScaledFontSize() const {
@@ -139,59 +281,220 @@ void ConfigManager::GetScreenResolution(int& width, int& height) const {
     height = GetSystemMetrics(SM_CYSCREEN);
 }
 
-// INI file helper functions implementation
+// INI lookups; names are ASCII, values UTF-8 in the file
 std::wstring ConfigManager::ReadIniString(const std::wstring& section, const std::wstring& key,
-                                         const std::wstring& defaultValue, const std::wstring& filePath) {
-    wchar_t buffer[1024];
-    DWORD result = GetPrivateProfileStringW(section.c_str(), key.c_str(), defaultValue.c_str(),
-                                           buffer, sizeof(buffer) / sizeof(wchar_t), filePath.c_str());
-    return std::wstring(buffer);
+                                         const std::wstring& defaultValue, const IniFile& ini) {
+    const std::string* value = ini.Find(Utils::WideToUtf8(section), Utils::WideToUtf8(key));
+    return value ? Utils::Utf8ToWide(*value) : defaultValue;
 }
 
 int ConfigManager::ReadIniInt(const std::wstring& section, const std::wstring& key,
-                             int defaultValue, const std::wstring& filePath) {
-    return GetPrivateProfileIntW(section.c_str(), key.c_str(), defaultValue, filePath.c_str());
+                             int defaultValue, const IniFile& ini) {
+    return ini.GetInt(Utils::WideToUtf8(section), Utils::WideToUtf8(key), defaultValue);
 }
 
 bool ConfigManager::ReadIniBool(const std::wstring& section, const std::wstring& key,
-                               bool defaultValue, const std::wstring& filePath) {
-    int value = ReadIniInt(section, key, defaultValue ? 1 : 0, filePath);
+                               bool defaultValue, const IniFile& ini) {
+    int value = ReadIniInt(section, key, defaultValue ? 1 : 0, ini);
     return value != 0;
 }
 
 float ConfigManager::ReadIniFloat(const std::wstring& section, const std::wstring& key,
-                                 float defaultValue, const std::wstring& filePath) {
-    std::wstring valueStr = ReadIniString(section, key, L"", filePath);
-    if (valueStr.empty()) return defaultValue;
-    
-    try {
-        return std::stof(valueStr);
-    } catch (...) {
-        return defaultValue;
-    }
+                                 float defaultValue, const IniFile& ini) {
+    return ini.GetFloat(Utils::WideToUtf8(section), Utils::WideToUtf8(key), defaultValue);
 }
 
-bool ConfigManager::WriteIniString(const std::wstring& section, const std::wstring& key,
-                                  const std::wstring& value, const std::wstring& filePath) {
-    return WritePrivateProfileStringW(section.c_str(), key.c_str(), value.c_str(), filePath.c_str()) != 0;
+std::vector<ConfigManager::IniValue> ConfigManager::CollectIniValues(const OverlayConfig& config) {
+    auto boolStr = [](bool value) { return std::wstring(value ? L"1" : L"0"); };
+    auto priorityStr = [](ThreadPriority priority) { return std::to_wstring(static_cast<int>(priority)); };
+    
+    return {
+        // General settings
+        {L"General", L"Enabled", boolStr(config.enabled)},
+        {L"General", L"UpdateInterval", std::to_wstring(config.updateInterval)},
+        
+        // Appearance settings
+        {L"Appearance", L"Position", std::to_wstring(static_cast<int>(config.position))},
+        {L"Appearance", L"Monitor", std::to_wstring(static_cast<int>(config.monitor))},
+        {L"Appearance", L"FontSize", std::to_wstring(config.fontSize)},
+        {L"Appearance", L"FontName", config.fontName},
+        {L"Appearance", L"OffsetX", std::to_wstring(config.offsetX)},
+        {L"Appearance", L"OffsetY", std::to_wstring(config.offsetY)},
+        {L"Appearance", L"ShowBackground", boolStr(config.showBackground)},
+        
+        // Frame-time graph settings
+        {L"Graph", L"Enabled", boolStr(config.showGraph)},
+        {L"Graph", L"Width", std::to_wstring(config.graphWidth)},
+        {L"Graph", L"Height", std::to_wstring(config.graphHeight)},
+        {L"Graph", L"ScaleMs", std::to_wstring(config.graphScaleMs)},
+        {L"Graph", L"FramesPerColumn", std::to_wstring(config.graphFramesPerColumn)},
+        
+        // Frame-time heatmap settings
+        {L"Heatmap", L"Enabled", boolStr(config.showHeatmap)},
+        {L"Heatmap", L"Width", std::to_wstring(config.heatmapWidth)},
+        {L"Heatmap", L"Height", std::to_wstring(config.heatmapHeight)},
+        {L"Heatmap", L"SliceMs", std::to_wstring(config.heatmapSliceMs)},
+        {L"Heatmap", L"MinMs", std::to_wstring(config.heatmapMinMs)},
+        {L"Heatmap", L"MaxMs", std::to_wstring(config.heatmapMaxMs)},
+        
+        // Widget layout
+        {L"Layout", L"Widgets", config.widgets.ToString()},
+        
+        // Colors
+        {L"Colors", L"TextColor", ColorToString(config.textColor)},
+        {L"Colors", L"BackgroundColor", ColorToString(config.backgroundColor)},
+        
+        // Advanced settings
+        {L"Advanced", L"MinFrameTime", std::to_wstring(config.minFrameTimeMs)},
+        
+        // Pipeline settings
+        {L"Pipeline", L"IngestPolicy", std::to_wstring(static_cast<int>(config.ingestPolicy))},
+        {L"Pipeline", L"NormalizePolicy", std::to_wstring(static_cast<int>(config.normalizePolicy))},
+        {L"Pipeline", L"SinkPolicy", std::to_wstring(static_cast<int>(config.sinkPolicy))},
+        {L"Pipeline", L"QueueCapacity", std::to_wstring(config.queueCapacity)},
+        
+        // Pacing settings
+        {L"Pacing", L"Mode", std::to_wstring(static_cast<int>(config.pacingMode))},
+        {L"Pacing", L"SpinThresholdUs", std::to_wstring(config.spinThresholdUs)},
+        
+        // Idle throttling settings
+        {L"Activity", L"IdleThrottling", boolStr(config.idleThrottling)},
+        {L"Activity", L"IdleAfterMs", std::to_wstring(config.idleAfterMs)},
+        {L"Activity", L"IdlePollMs", std::to_wstring(config.idlePollMs)},
+        {L"Activity", L"GameProcesses", config.gameProcesses},
+        
+        // Thread settings
+        {L"Threads", L"WorkerThreads", std::to_wstring(config.workerThreads)},
+        {L"Threads", L"WorkerAffinityMask", AffinityMaskToString(config.workerAffinityMask)},
+        {L"Threads", L"WorkerPriority", priorityStr(config.workerPriority)},
+        {L"Threads", L"SamplerAffinityMask", AffinityMaskToString(config.samplerAffinityMask)},
+        {L"Threads", L"SamplerPriority", priorityStr(config.samplerPriority)},
+        {L"Threads", L"RenderAffinityMask", AffinityMaskToString(config.renderAffinityMask)},
+        {L"Threads", L"RenderPriority", priorityStr(config.renderPriority)},
+        {L"Threads", L"BackgroundAffinityMask", AffinityMaskToString(config.backgroundAffinityMask)},
+        {L"Threads", L"BackgroundPriority", priorityStr(config.backgroundPriority)},
+        
+        // Plugin settings
+        {L"Plugins", L"Enabled", boolStr(config.pluginsEnabled)},
+        {L"Plugins", L"Directory", config.pluginDirectory},
+    };
 }
 
-bool ConfigManager::WriteIniInt(const std::wstring& section, const std::wstring& key,
-                                int value, const std::wstring& filePath) {
-    std::wstring valueStr = std::to_wstring(value);
-    return WriteIniString(section, key, valueStr, filePath);
+std::string ConfigManager::MergeIniText(const std::string& existing, const std::vector<IniValue>& values) {
+    struct Pending {
+        std::string section;
+        std::string key;
+        std::string value;
+        bool written;
+    };
+    std::vector<Pending> pending;
+    for (const IniValue& value : values) {
+        pending.push_back({Utils::WideToUtf8(value.section), Utils::WideToUtf8(value.key),
+                           Utils::WideToUtf8(value.value), false});
+    }
+    
+    // Keep the file's line endings
+    std::string newline = existing.empty() || existing.find("\r\n") != std::string::npos ? "\r\n" : "\n";
+    
+    std::vector<std::string> lines;
+    size_t pos = 0;
+    while (pos < existing.size()) {
+        size_t end = existing.find('\n', pos);
+        if (end == std::string::npos) end = existing.size();
+        std::string line = existing.substr(pos, end - pos);
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        lines.push_back(line);
+        pos = end + 1;
+    }
+    
+    std::vector<std::string> out;
+    if (lines.empty()) {
+        for (const char* header : CONFIG_FILE_HEADER) {
+            out.push_back(header);
+        }
+    }
+    
+    // Keys this section is missing go after its last non-blank line
+    std::string section;
+    size_t sectionEnd = 0;
+    auto flushSection = [&]() {
+        std::vector<std::string> missing;
+        for (Pending& entry : pending) {
+            if (!entry.written && EqualsNoCase(entry.section, section)) {
+                missing.push_back(entry.key + "=" + entry.value);
+                entry.written = true;
+            }
+        }
+        out.insert(out.begin() + sectionEnd, missing.begin(), missing.end());
+    };
+    
+    for (const std::string& line : lines) {
+        std::string trimmed = TrimAscii(line);
+        if (!trimmed.empty() && trimmed.front() == '[' && trimmed.back() == ']') {
+            flushSection();
+            section = TrimAscii(trimmed.substr(1, trimmed.size() - 2));
+            out.push_back(line);
+            sectionEnd = out.size();
+            continue;
+        }
+        
+        size_t equals = line.find('=');
+        bool isKey = !trimmed.empty() && trimmed.front() != ';' && trimmed.front() != '#' && equals != std::string::npos;
+        if (isKey) {
+            std::string key = TrimAscii(line.substr(0, equals));
+            for (Pending& entry : pending) {
+                if (!entry.written && EqualsNoCase(entry.section, section) && EqualsNoCase(entry.key, key)) {
+                    out.push_back(line.substr(0, equals + 1) + entry.value);
+                    entry.written = true;
+                    isKey = false;
+                    break;
+                }
+            }
+            if (!isKey) {
+                sectionEnd = out.size();
+                continue;
+            }
+        }
+        
+        out.push_back(line);
+        if (!trimmed.empty()) sectionEnd = out.size();
+    }
+    flushSection();
+    
+    // Sections the file doesn't have yet
+    for (size_t i = 0; i < pending.size(); ++i) {
+        if (pending[i].written) continue;
+        if (!out.empty()) out.push_back("");
+        out.push_back("[" + pending[i].section + "]");
+        for (size_t j = i; j < pending.size(); ++j) {
+            if (!pending[j].written && EqualsNoCase(pending[j].section, pending[i].section)) {
+                out.push_back(pending[j].key + "=" + pending[j].value);
+                pending[j].written = true;
+            }
+        }
+    }
+    
+    std::string text;
+    for (size_t i = 0; i < out.size(); ++i) {
+        text += out[i];
+        if (i + 1 < out.size() || (!existing.empty() && existing.back() == '\n') || existing.empty()) {
+            text += newline;
+        }
+    }
+    return text;
 }
 
-bool ConfigManager::WriteIniBool(const std::wstring& section, const std::wstring& key,
-                                 bool value, const std::wstring& filePath) {
-    return WriteIniInt(section, key, value ? 1 : 0, filePath);
+uint64_t ConfigManager::ParseAffinityMask(const std::wstring& maskStr) {
+    std::wstring value = Utils::ToLower(Utils::Trim(maskStr));
+    if (value == L"auto") return THREAD_AFFINITY_AUTO;
+    return std::wcstoull(value.c_str(), nullptr, 16);
 }
 
-bool ConfigManager::WriteIniFloat(const std::wstring& section, const std::wstring& key,
-                                  float value, const std::wstring& filePath) {
+std::wstring ConfigManager::AffinityMaskToString(uint64_t mask) {
+    if (mask == THREAD_AFFINITY_AUTO) return L"auto";
     std::wostringstream oss;
-    oss << std::fixed << std::setprecision(3) << value;
-    return WriteIniString(section, key, oss.str(), filePath);
+    oss << std::hex << std::uppercase << mask;
+    return oss.str();
 }
 
 Color ConfigManager::ParseColor(const std::wstring& colorStr, const Color& defaultColor) {
@@ -0,0 +1,180 @@
+#include "damage_tracker.h"
+
+#include <algorithm>
+#include <cstring>
+
+DamageRect DamageRect::Union(const DamageRect& a, const DamageRect& b) {
+    if (a.IsEmpty()) return b;
+    if (b.IsEmpty()) return a;
+    DamageRect result;
+    result.x = std::min(a.x, b.x);
+    result.y = std::min(a.y, b.y);
+    result.width = std::max(a.x + a.width, b.x + b.width) - result.x;
+    result.height = std::max(a.y + a.height, b.y + b.height) - result.y;
+    return result;
+}
+
+DamageRect DamageRect::Intersect(const DamageRect& a, const DamageRect& b) {
+    DamageRect result;
+    result.x = std::max(a.x, b.x);
+    result.y = std::max(a.y, b.y);
+    result.width = std::min(a.x + a.width, b.x + b.width) - result.x;
+    result.height = std::min(a.y + a.height, b.y + b.height) - result.y;
+    if (result.IsEmpty()) return DamageRect();
+    return result;
+}
+
+DamageTracker::DamageTracker()
+    : m_fullFrame(true)
+    , m_invalidated(true)
+{
+    m_dirty.reserve(DAMAGE_MAX_RECTS);
+}
+
+void DamageTracker::BeginFrame(int width, int height) {
+    DamageRect surface;
+    surface.width = width;
+    surface.height = height;
+
+    m_fullFrame = m_invalidated || !(surface == m_surface);
+    m_invalidated = false;
+    m_surface = surface;
+    m_dirty.clear();
+}
+
+void DamageTracker::Invalidate() {
+    m_invalidated = true;
+}
+
+bool DamageTracker::Update(size_t widget, const void* content, size_t size, uint64_t style,
+                           const DamageRect& bounds) {
+    WidgetState& state = Widget(widget);
+    const uint8_t* bytes = static_cast<const uint8_t*>(content);
+    bool changed = !state.valid || state.style != style || !(state.bounds == bounds) ||
+                   state.content.size() != size || (size > 0 && std::memcmp(state.content.data(), bytes, size) != 0);
+    if (!changed) return false;
+
+    if (state.valid) {
+        AddDirty(state.bounds);
+    }
+    AddDirty(bounds);
+
+    state.valid = true;
+    state.style = style;
+    state.bounds = bounds;
+    state.content.assign(bytes, bytes + size);
+    return true;
+}
+
+bool DamageTracker::UpdateText(size_t widget, const GlyphAtlas& atlas, const wchar_t* text, int length,
+                               uint64_t style, const DamageRect& bounds, int textX) {
+    WidgetState& state = Widget(widget);
+    if (!state.valid || state.style != style || !(state.bounds == bounds) || state.textX != textX) {
+        // Moved or restyled: the whole widget, old and new place
+        if (state.valid) {
+            AddDirty(state.bounds);
+        }
+        AddDirty(bounds);
+    } else {
+        const wchar_t* previous = state.text.data();
+        int previousLength = static_cast<int>(state.text.size());
+        int prefix = 0;
+        int common = std::min(length, previousLength);
+        while (prefix < common && previous[prefix] == text[prefix]) {
+            ++prefix;
+        }
+        if (prefix == length && prefix == previousLength) return false;
+
+        // From the first changed glyph to the end of the longer text, plus
+        // whatever ink can reach past the glyph advances
+        int start = textX + atlas.MeasureText(text, prefix);
+        int end = textX + std::max(atlas.MeasureText(text, length), atlas.MeasureText(previous, previousLength));
+        int overhang = atlas.Overhang();
+        DamageRect span;
+        span.x = start - overhang;
+        span.y = bounds.y;
+        span.width = end - start + 2 * overhang;
+        span.height = bounds.height;
+        AddDirty(DamageRect::Intersect(span, bounds));
+    }
+
+    state.valid = true;
+    state.style = style;
+    state.bounds = bounds;
+    state.textX = textX;
+    state.text.assign(text, text + length);
+    return true;
+}
+
+DamageKind DamageTracker::EndFrame() {
+    DamageKind kind;
+    if (m_fullFrame) {
+        m_dirty.clear();
+        if (!m_surface.IsEmpty()) {
+            m_dirty.push_back(m_surface);
+        }
+        kind = DamageKind::FULL;
+    } else if (m_dirty.empty()) {
+        kind = DamageKind::NONE;
+    } else if (m_dirty.size() == 1 && m_dirty[0] == m_surface) {
+        kind = DamageKind::FULL;
+    } else {
+        kind = DamageKind::PARTIAL;
+    }
+
+    ++m_stats.frames;
+    switch (kind) {
+        case DamageKind::NONE: ++m_stats.skipped; break;
+        case DamageKind::PARTIAL: ++m_stats.partial; break;
+        case DamageKind::FULL: ++m_stats.full; break;
+    }
+    for (const DamageRect& rect : m_dirty) {
+        m_stats.dirtyPixels += static_cast<uint64_t>(rect.Area());
+    }
+    m_stats.surfacePixels += static_cast<uint64_t>(m_surface.Area());
+    return kind;
+}
+
+DamageRect DamageTracker::DirtyBounds() const {
+    DamageRect bounds;
+    for (const DamageRect& rect : m_dirty) {
+        bounds = DamageRect::Union(bounds, rect);
+    }
+    return bounds;
+}
+
+// Private methods implementation
+DamageTracker::WidgetState& DamageTracker::Widget(size_t widget) {
+    if (widget >= m_widgets.size()) {
+        m_widgets.resize(widget + 1);
+    }
+    return m_widgets[widget];
+}
+
+void DamageTracker::AddDirty(const DamageRect& rect) {
+    if (m_fullFrame) return;  // Already everything
+
+    DamageRect merged = DamageRect::Intersect(rect, m_surface);
+    if (merged.IsEmpty()) return;
+
+    // Keep the list non-overlapping: absorb every rectangle the new one
+    // touches, then recheck against the grown result
+    for (size_t i = 0; i < m_dirty.size();) {
+        if (!DamageRect::Intersect(m_dirty[i], merged).IsEmpty()) {
+            merged = DamageRect::Union(merged, m_dirty[i]);
+            m_dirty[i] = m_dirty.back();
+            m_dirty.pop_back();
+            i = 0;
+        } else {
+            ++i;
+        }
+    }
+
+    if (m_dirty.size() == DAMAGE_MAX_RECTS) {
+        for (const DamageRect& dirty : m_dirty) {
+            merged = DamageRect::Union(merged, dirty);
+        }
+        m_dirty.clear();
+    }
+    m_dirty.push_back(merged);
+}
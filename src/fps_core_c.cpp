@@ -0,0 +1,217 @@
+#include "fps_core_c.h"
+#include "capture_file.h"
+#include "frame_histogram.h"
+#include "frame_pipeline.h"
+#include "plugin_host.h"
+#include "seqlock.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+    // Rolling histogram on its own sink thread; every batch republishes the
+    // percentiles through a seqlock for lock-free readers. Like the stats,
+    // they follow the pipeline's current stats source.
+    class PercentileSink : public IFrameSink {
+    public:
+        PercentileSink(const FramePipeline& pipeline, size_t windowFrames)
+            : m_pipeline(pipeline), m_histogram(windowFrames), m_source(FRAME_SOURCE_SAMPLER), m_sequence(0) {}
+
+        void Consume(const FrameStats&) override {}
+
+        void ConsumeBatch(const FrameBatchRef& batch) override {
+            uint32_t source = m_pipeline.GetLatestStats().sourceId;
+            if (source != m_source) {
+                m_histogram.Clear();
+                m_source = source;
+            }
+            for (size_t i = 0; i < batch->Count(); ++i) {
+                if ((*batch)[i].sourceId == source) m_histogram.Add((*batch)[i].frameTime * 1000.0f);
+            }
+
+            FpsPercentiles percentiles = {};
+            percentiles.size = sizeof(percentiles);
+            percentiles.frames = static_cast<uint32_t>(m_histogram.Count());
+            percentiles.p50Ms = m_histogram.Percentile(50.0f);
+            percentiles.p90Ms = m_histogram.Percentile(90.0f);
+            percentiles.p99Ms = m_histogram.Percentile(99.0f);
+            percentiles.p999Ms = m_histogram.Percentile(99.9f);
+            percentiles.sequence = ++m_sequence;
+            m_published.Publish(percentiles);
+        }
+
+        FpsPercentiles Read() const { return m_published.Read(); }
+
+    private:
+        const FramePipeline& m_pipeline;
+        FrameHistogram m_histogram;  // Sink thread
+        uint32_t m_source;
+        uint64_t m_sequence;
+        Seqlock<FpsPercentiles> m_published;
+    };
+
+    PipelineConfig ToPipelineConfig(const FpsCoreConfig& config) {
+        PipelineConfig pipelineConfig;
+        pipelineConfig.ingestCapacity = std::max<size_t>(16, config.queueCapacity);
+        pipelineConfig.normalizeCapacity = pipelineConfig.ingestCapacity;
+        pipelineConfig.averageWindow = std::max<size_t>(1, config.averageWindow);
+        pipelineConfig.percentileWindow = std::max<size_t>(1, config.percentileWindow);
+        pipelineConfig.minFrameTime = std::max(config.minFrameTimeMs, 0.0f) / 1000.0f;
+        pipelineConfig.rejectFrameTime = std::max(config.rejectFrameTimeMs, 0.0f) / 1000.0f;
+        pipelineConfig.hitchFactor = config.hitchFactor > 1.0f ? config.hitchFactor : 2.0f;
+        return pipelineConfig;
+    }
+}
+
+struct FpsCore {
+    explicit FpsCore(const FpsCoreConfig& config)
+        : pipeline(ToPipelineConfig(config))
+        , percentiles(pipeline, std::max<size_t>(1, config.percentileWindow))
+        , state(State::CREATED)
+    {
+        pipeline.AddSink(&percentiles);
+        if (config.capturePath && *config.capturePath) {
+            auto utf8 = reinterpret_cast<const char8_t*>(config.capturePath);
+            capture = std::make_unique<CaptureSink>(std::filesystem::path(utf8));
+            pipeline.AddSink(capture.get(), BackpressurePolicy::BLOCK);
+        }
+    }
+
+    enum class State { CREATED, RUNNING, STOPPED };
+
+    FramePipeline pipeline;
+    PercentileSink percentiles;
+    std::unique_ptr<CaptureSink> capture;
+    std::vector<std::unique_ptr<PluginSink>> sinks;
+    State state;  // Owner thread
+};
+
+void fps_core_default_config(FpsCoreConfig* config) {
+    if (!config) return;
+
+    PipelineConfig defaults;
+    FpsCoreConfig out = {};
+    out.size = sizeof(out);
+    out.queueCapacity = static_cast<uint32_t>(defaults.ingestCapacity);
+    out.averageWindow = static_cast<uint32_t>(defaults.averageWindow);
+    out.percentileWindow = static_cast<uint32_t>(defaults.percentileWindow);
+    out.minFrameTimeMs = defaults.minFrameTime * 1000.0f;
+    out.rejectFrameTimeMs = 0.0f;  // Embedders report real presents, not polls
+    out.hitchFactor = defaults.hitchFactor;
+    out.capturePath = nullptr;
+    CopyVersionedOut(out, config);
+}
+
+FpsCore* fps_core_create(const FpsCoreConfig* config) {
+    FpsCoreConfig resolved = {};
+    resolved.size = sizeof(resolved);
+    fps_core_default_config(&resolved);
+    if (config) {
+        // Fields an older caller doesn't know keep their defaults
+        std::memcpy(&resolved, config, std::min<size_t>(config->size, sizeof(resolved)));
+        resolved.size = sizeof(resolved);
+    }
+
+    try {
+        return new FpsCore(resolved);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void fps_core_destroy(FpsCore* core) {
+    if (!core) return;
+    fps_core_stop(core);
+    delete core;
+}
+
+int fps_core_add_sink(FpsCore* core, const FpsSinkV1* sink) {
+    if (!core || !sink || core->state != FpsCore::State::CREATED) return FPS_PLUGIN_ERROR;
+
+    FpsSinkV1 copy = CopyVersioned(sink);
+    if (!copy.consume_batch) return FPS_PLUGIN_ERROR;
+
+    try {
+        core->sinks.push_back(std::make_unique<PluginSink>(copy));
+    } catch (...) {
+        return FPS_PLUGIN_ERROR;
+    }
+    core->pipeline.AddSink(core->sinks.back().get());
+    return FPS_PLUGIN_OK;
+}
+
+int fps_core_start(FpsCore* core) {
+    if (!core || core->state != FpsCore::State::CREATED) return FPS_PLUGIN_ERROR;
+    if (!core->pipeline.Start()) return FPS_PLUGIN_ERROR;
+    core->state = FpsCore::State::RUNNING;
+    return FPS_PLUGIN_OK;
+}
+
+void fps_core_stop(FpsCore* core) {
+    if (!core || core->state != FpsCore::State::RUNNING) return;
+    core->pipeline.Stop();
+    if (core->capture) core->capture->Close();
+    core->state = FpsCore::State::STOPPED;
+}
+
+uint64_t fps_core_now_ns(void) {
+    return MonotonicNowNs();
+}
+
+uint32_t fps_core_push_presents(FpsCore* core, uint32_t sourceId, const uint64_t* timestampsNs, uint32_t count) {
+    if (!core || !timestampsNs || sourceId >= MAX_FRAME_SOURCES) return 0;
+
+    uint32_t accepted = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (core->pipeline.PushPresent(timestampsNs[i], sourceId)) ++accepted;
+    }
+    return accepted;
+}
+
+int fps_core_read_stats(const FpsCore* core, FpsStats* stats) {
+    if (!core || !stats) return FPS_PLUGIN_ERROR;
+    CopyVersionedOut(ToPluginStats(core->pipeline.GetLatestStats()), stats);
+    return FPS_PLUGIN_OK;
+}
+
+int fps_core_read_percentiles(const FpsCore* core, FpsPercentiles* percentiles) {
+    if (!core || !percentiles) return FPS_PLUGIN_ERROR;
+    CopyVersionedOut(core->percentiles.Read(), percentiles);
+    return FPS_PLUGIN_OK;
+}
+
+int fps_core_read_counters(const FpsCore* core, FpsCoreCounters* counters) {
+    if (!core || !counters) return FPS_PLUGIN_ERROR;
+
+    PipelineMetrics metrics = core->pipeline.GetMetrics();
+    FpsCoreCounters out = {};
+    out.size = sizeof(out);
+    out.presentsAccepted = metrics.ingest.pushed;
+    out.presentsDropped = metrics.ingest.dropped;
+    out.framesRejected = metrics.rejectedFrames;
+    if (core->capture) {
+        CaptureStats capture = core->capture->GetStats();
+        out.captureFramesWritten = capture.framesWritten;
+        out.captureFailedWrites = capture.failedWrites;
+    }
+    CopyVersionedOut(out, counters);
+    return FPS_PLUGIN_OK;
+}
+
+int64_t fps_core_read_capture(const char* path, FpsFrame* frames, uint64_t capacity) {
+    if (!path) return -1;
+
+    try {
+        std::vector<NormalizedFrame> capture;
+        if (!ReadCaptureFile(std::filesystem::path(reinterpret_cast<const char8_t*>(path)), capture)) return -1;
+        if (frames) {
+            size_t copied = static_cast<size_t>(std::min<uint64_t>(capacity, capture.size()));
+            std::copy(capture.begin(), capture.begin() + copied, reinterpret_cast<NormalizedFrame*>(frames));
+        }
+        return static_cast<int64_t>(capture.size());
+    } catch (...) {
+        return -1;
+    }
+}
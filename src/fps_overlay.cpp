@@ -1,23 +1,25 @@
 #include "fps_overlay.h"
 #include "utils.h"
+#include <algorithm>
+#include <future>
 #include <iostream>
 
 FPSOverlay::FPSOverlay()
     : m_running(false)
+    , m_stopped(true)
     , m_initialized(false)
-    , m_currentFPS(0.0f)
-    , m_frameTimeIndex(0)
+    , m_publishedSequence(0)
+    , m_statsTaskId(0)
+    , m_probeWindow(nullptr)
+    , m_probeWindowIsGame(false)
     , m_memoryUsage(0)
 {
-    // Initialize frame time buffer
-    m_frameTimes.resize(FPS_SAMPLE_COUNT, 0.0f);
-    m_lastFrameTime = std::chrono::high_resolution_clock::now();
-    m_lastUpdateTime = std::chrono::high_resolution_clock::now();
-    
     // Create component managers
+    auto phase = m_startup.Phase("components");
     m_configManager = std::make_unique<ConfigManager>();
     m_hookManager = std::make_unique<HookManager>();
-    m_renderer = std::make_unique<Renderer>();
+    m_renderThread = std::make_unique<RenderThread>(*m_configManager);
+    m_scheduler = std::make_unique<Scheduler>();
 }
 
 FPSOverlay::~FPSOverlay() {
@@ -30,33 +32,105 @@ bool FPSOverlay::Initialize() {
     Utils::LogInfo(L"Initializing FPS Overlay");
     
     // Check system compatibility
-    if (!CheckSystemCompatibility()) {
-        Utils::LogError(L"System compatibility check failed");
-        return false;
+    {
+        auto phase = m_startup.Phase("os-check");
+        if (!CheckSystemCompatibility()) {
+            Utils::LogError(L"System compatibility check failed");
+            return false;
+        }
     }
     
     // Setup exception handling
     SetupExceptionHandling();
     
-    // Load configuration
-    if (!m_configManager->LoadConfig()) {
-        Utils::LogWarning(L"Failed to load configuration, using defaults");
+    // API detection (three probe loads and a module snapshot) needs nothing
+    // else, so it runs while the config is read and the window is created
+    std::future<bool> hooks = std::async(std::launch::async, [this]() {
+        auto phase = m_startup.Phase("hooks");
+        return m_hookManager->Initialize();
+    });
+    
+    // Load configuration; everything below depends on it
+    {
+        auto phase = m_startup.Phase("config");
+        if (!m_configManager->LoadConfig()) {
+            Utils::LogWarning(L"Failed to load configuration, using defaults");
+        }
+    }
+    const OverlayConfig& config = m_configManager->GetConfig();
+    
+    // Start the render thread; it creates the overlay window and pumps
+    // its messages. Fonts are resolved there on first draw.
+    std::future<bool> window = std::async(std::launch::async, [this]() {
+        auto phase = m_startup.Phase("window");
+        return m_renderThread->Start();
+    });
+    
+    // Build the frame pipeline; the overlay reads its stats snapshot on the
+    // scheduler, so sinks are only needed for per-frame consumers
+    {
+        auto phase = m_startup.Phase("pipeline");
+        m_pipeline = std::make_unique<FramePipeline>(BuildPipelineConfig(config));
+        m_samplerPacer = std::make_unique<FramePacer>(SAMPLER_INTERVAL_US * 1000ull, config.pacingMode,
+                                                      static_cast<uint32_t>(config.spinThresholdUs));
+        if (m_samplerPacer->GetMode() != config.pacingMode) {
+            Utils::LogWarning(L"No high-resolution timer, sampler pacing falls back to coarse sleeps");
+        }
+        
+        // Hooked presents are the activity signal; a game-like window in the
+        // foreground stands in for them when hooks are unavailable
+        m_gameProcesses.clear();
+        size_t start = 0;
+        while (start <= config.gameProcesses.size()) {
+            size_t end = config.gameProcesses.find(L';', start);
+            if (end == std::wstring::npos) end = config.gameProcesses.size();
+            std::wstring name = Utils::ToLower(Utils::Trim(config.gameProcesses.substr(start, end - start)));
+            if (!name.empty()) m_gameProcesses.push_back(name);
+            start = end + 1;
+        }
+        
+        ActivityConfig activityConfig;
+        activityConfig.idleAfterMs = static_cast<uint32_t>(config.idleAfterMs);
+        activityConfig.idlePollMs = static_cast<uint32_t>(config.idlePollMs);
+        m_activity = std::make_unique<ActivityGovernor>(activityConfig);
+        m_activity->SetProbe([this]() { return ProbeForegroundActivity(); });
+        m_activity->SetStateCallback([this](ActivityState state) { OnActivityChanged(state); });
     }
     
-    // Initialize hook manager
-    if (!m_hookManager->Initialize()) {
-        Utils::LogWarning(L"Hook manager initialization failed, using fallback FPS calculation");
+    // Plugin sinks must be added before the pipeline starts, and so must
+    // the render thread when it draws the frame-time graph or heatmap
+    {
+        auto phase = m_startup.Phase("plugins");
+        LoadPlugins(config);
+        if (config.showGraph || config.showHeatmap) {
+            m_pipeline->AddSink(m_renderThread.get(), BackpressurePolicy::DROP);
+        }
     }
     
-    // Initialize renderer
-    GraphicsAPI detectedAPI = m_hookManager->GetCurrentAPI();
-    if (!m_renderer->Initialize(detectedAPI)) {
+    // Join the concurrent steps before anything can feed the pipeline
+    bool hooksReady = hooks.get();
+    bool windowReady = window.get();
+    if (!windowReady) {
         Utils::LogError(L"Failed to initialize renderer");
         return false;
     }
+    if (Utils::GetAvailableGraphicsAPIs().empty()) {
+        Utils::LogError(L"No compatible graphics APIs found");
+        m_renderThread->Stop();
+        return false;
+    }
+    if (!hooksReady) {
+        Utils::LogWarning(L"Hook manager initialization failed, using fallback FPS calculation");
+    }
+    m_hookManager->SetFramePipeline(m_pipeline.get());
+    m_hookManager->SetActivityGovernor(m_activity.get());
+    
+    RegisterPeriodicTasks(config);
+    OnActivityChanged(m_activity->GetState());
     
     m_initialized = true;
     Utils::LogInfo(L"FPS Overlay initialized successfully");
+    Utils::LogInfo(L"Startup phases:\n" + Utils::Utf8ToWide(m_startup.Format()));
     return true;
 }
 
@@ -73,17 +147,37 @@ bool FPSOverlay::Start() {
     
     Utils::LogInfo(L"Starting FPS Overlay");
     
+    {
+        std::lock_guard<std::mutex> lock(m_stopMutex);
+        m_stopped = false;
+    }
     m_running = true;
     g_running = true;
+    auto phase = m_startup.Phase("start");
+    
+    // Start pipeline stages before the sampler begins pushing frames
+    m_pipeline->Start();
+    m_plugins->StartSources();
     
-    // Start update thread
+    // Start sampler thread
     m_updateThread = std::thread(&FPSOverlay::UpdateWorker, this);
     
+    // Start periodic maintenance (stats publish, hooks, memory, flush); it
+    // and the file I/O thread stay off the game's cores with the pipeline
+    const OverlayConfig& config = m_configManager->GetConfig();
+    m_scheduler->SetThreadSettings(config.backgroundAffinityMask, config.backgroundPriority);
+    IoExecutor::Shared()->SetThreadSettings(config.backgroundAffinityMask, config.backgroundPriority);
+    m_scheduler->Start();
+    
     Utils::LogInfo(L"FPS Overlay started successfully");
     return true;
 }
 
 void FPSOverlay::Stop() {
+    // Ctrl+C stops the overlay from the console handler's thread while the
+    // main thread waits to stop and destroy it; whoever comes second blocks
+    // here until the first has finished tearing down
+    std::lock_guard<std::mutex> teardown(m_teardownMutex);
     if (!m_running) return;
     
     Utils::LogInfo(L"Stopping FPS Overlay");
@@ -91,36 +185,73 @@ void FPSOverlay::Stop() {
     m_running = false;
     g_running = false;
     
-    // Wait for update thread to finish
+    // Stop periodic tasks first; nothing is published after this returns
+    m_scheduler->Stop();
+    
+    // The sampler may be parked in an idle wait
+    if (m_activity) {
+        m_activity->Wake();
+    }
+    
+    // Wait for sampler thread to finish
     if (m_updateThread.joinable()) {
         m_updateThread.join();
     }
     
-    // Cleanup components
-    if (m_renderer) {
-        m_renderer->Cleanup();
+    // Let queued bulk work finish before the components it may use go away
+    {
+        std::lock_guard<std::mutex> lock(m_workerPoolMutex);
+        m_workerPool.reset();
+    }
+    
+    // Drain pipeline stages; plugin sources stop feeding it first and the
+    // libraries unload once no sink thread can call into them
+    if (m_pipeline) {
+        m_plugins->StopSources();
+        m_hookManager->SetFramePipeline(nullptr);
+        m_hookManager->SetActivityGovernor(nullptr);
+        m_pipeline->Stop();
+        m_plugins->Unload();
+    }
+    
+    // Cleanup components; the render thread destroys its own window
+    if (m_renderThread) {
+        m_renderThread->Stop();
     }
     
     if (m_hookManager) {
         m_hookManager->Cleanup();
     }
     
+    // Only now may a waiting thread go on to destroy the overlay
+    {
+        std::lock_guard<std::mutex> lock(m_stopMutex);
+        m_stopped = true;
+    }
+    m_stopCv.notify_all();
+    
     Utils::LogInfo(L"FPS Overlay stopped");
 }
 
+void FPSOverlay::WaitForStop() {
+    std::unique_lock<std::mutex> lock(m_stopMutex);
+    m_stopCv.wait(lock, [this]() { return m_stopped; });
+}
+
 void FPSOverlay::UpdateFPS() {
-    auto currentTime = std::chrono::high_resolution_clock::now();
-    auto deltaTime = std::chrono::duration<float>(currentTime - m_lastFrameTime).count();
-    
-    m_lastFrameTime = currentTime;
-    
-    // Calculate FPS using rolling average
-    CalculateFPS(deltaTime);
+    // The pipeline derives frame time from consecutive timestamps
+    if (m_pipeline) {
+        m_pipeline->PushPresent(MonotonicNowNs(), FRAME_SOURCE_SAMPLER);
+    }
 }
 
 float FPSOverlay::GetCurrentFPS() const {
-    std::lock_guard<std::mutex> lock(m_fpsMutex);
-    return m_currentFPS;
+    return GetCurrentStats().fps;
+}
+
+FrameStats FPSOverlay::GetCurrentStats() const {
+    // Seqlock read: never blocks the aggregate stage, never sees torn data
+    return m_pipeline ? m_pipeline->GetLatestStats() : FrameStats();
 }
 
 bool FPSOverlay::ProcessCommandLine(int argc, wchar_t* argv[]) {
@@ -152,152 +283,215 @@ bool FPSOverlay::ProcessCommandLine(int argc, wchar_t* argv[]) {
     return true;
 }
 
-void FPSOverlay::Update() {
-    if (!m_running || !m_initialized) return;
-    
-    // Update FPS calculation continuously (this gets called frequently)
-    UpdateFPS();
-    
-    // Only do heavy operations less frequently
-    auto currentTime = std::chrono::high_resolution_clock::now();
-    auto timeSinceLastUpdate = std::chrono::duration_cast<std::chrono::milliseconds>(
-        currentTime - m_lastUpdateTime).count();
-    
-    // Update memory usage and other heavy operations less frequently
-    if (timeSinceLastUpdate >= 1000) { // Every 1 second
-        MonitorMemoryUsage();
-        m_lastUpdateTime = currentTime;
-        
-        // Refresh hooks if needed
-        if (m_hookManager && m_hookManager->IsActive()) {
-            m_hookManager->RefreshHooks();
-        }
-    }
-    
-    // Render overlay (this should be lightweight)
-    if (m_renderer && m_renderer->IsInitialized()) {
+PipelineMetrics FPSOverlay::GetPipelineMetrics() const {
+    return m_pipeline ? m_pipeline->GetMetrics() : PipelineMetrics();
+}
+
+WorkStealingPool& FPSOverlay::GetWorkerPool() {
+    // Most sessions never need it, so don't start idle threads up front
+    std::lock_guard<std::mutex> lock(m_workerPoolMutex);
+    if (!m_workerPool) {
         const OverlayConfig& config = m_configManager->GetConfig();
-        if (config.enabled) {
-            m_renderer->RenderOverlay(GetCurrentFPS(), config);
-        }
+        m_workerPool = std::make_unique<WorkStealingPool>(static_cast<size_t>(config.workerThreads),
+                                                          config.workerAffinityMask, config.workerPriority);
+        Utils::LogInfo(L"Worker pool started with " + std::to_wstring(m_workerPool->WorkerCount()) +
+                       L" threads");
     }
+    return *m_workerPool;
+}
+
+ActivityMetrics FPSOverlay::GetActivityMetrics() const {
+    return m_activity ? m_activity->GetMetrics() : ActivityMetrics();
+}
+
+JitterStats FPSOverlay::GetSamplerJitter() const {
+    return m_samplerPacer ? m_samplerPacer->GetJitter() : JitterStats();
+}
+
+RenderThreadStats FPSOverlay::GetRenderStats() const {
+    return m_renderThread ? m_renderThread->GetStats() : RenderThreadStats();
+}
+
+std::vector<ScheduledTaskStats> FPSOverlay::GetSchedulerStats() const {
+    return m_scheduler->GetTaskStats();
+}
+
+uint64_t FPSOverlay::GetSchedulerWakeups() const {
+    return m_scheduler->GetWakeupCount();
 }
 
 // Private methods implementation
 void FPSOverlay::UpdateWorker() {
-    Utils::LogInfo(L"FPS Overlay update thread started");
+    Utils::LogInfo(L"FPS Overlay sampler thread started");
+    
+    // Keep off the game's cores (E-cores or the last CPU by default)
+    const OverlayConfig& config = m_configManager->GetConfig();
+    if (!ThreadAffinity::ApplyToCurrentThread(config.samplerAffinityMask, config.samplerPriority)) {
+        Utils::LogWarning(L"Could not apply sampler thread affinity/priority");
+    }
     
-    // Use a high frequency update for proper FPS detection (16ms ≈ 60fps)
-    const int highFrequencyInterval = 16; // milliseconds
+    // Fallback FPS is derived from these tick timestamps, so pace against
+    // absolute deadlines instead of sleep_for, which overshoots and drifts
+    m_samplerPacer->Reset();
     
     while (m_running) {
         try {
-            Update();
+            if (m_activity->Update(MonotonicNowNs()) != ActivityState::ACTIVE) {
+                // Nothing is presenting: park until a hooked frame rings the
+                // governor or the next cooling/idle poll
+                m_activity->WaitForActivity();
+                continue;
+            }
+            
+            // Source stage: only timestamps the tick, never waits on sinks
+            UpdateFPS();
             
-            // Sleep for a short interval to allow proper frame detection
-            std::this_thread::sleep_for(std::chrono::milliseconds(highFrequencyInterval));
+            // Sleep until the next deadline; lateness feeds the jitter meter
+            m_samplerPacer->Wait();
             
         } catch (const std::exception& e) {
-            Utils::LogError(L"Exception in update worker: " + Utils::Utf8ToWide(e.what()));
+            Utils::LogError(L"Exception in sampler worker: " + Utils::Utf8ToWide(e.what()));
             break;
         } catch (...) {
-            Utils::LogError(L"Unknown exception in update worker");
+            Utils::LogError(L"Unknown exception in sampler worker");
             break;
         }
     }
     
-    Utils::LogInfo(L"FPS Overlay update thread stopped");
+    Utils::LogInfo(L"FPS Overlay sampler thread stopped");
 }
 
-void FPSOverlay::CalculateFPS(float deltaTime) {
-    std::lock_guard<std::mutex> lock(m_fpsMutex);
-    
-    // Clamp delta time to prevent division by zero and handle spikes
-    deltaTime = std::max(deltaTime, MIN_FRAME_TIME);
-    
-    // Skip extremely small delta times that might be from too-frequent polling
-    if (deltaTime < 0.008f) { // Less than 8ms (125fps+)
-        return; // Don't update FPS for very small intervals
+void FPSOverlay::RegisterPeriodicTasks(const OverlayConfig& config) {
+    // Slack lets the slower tasks piggyback on the display tick instead of
+    // waking the thread on their own. Drawing happens on the render thread.
+    uint32_t displayInterval = static_cast<uint32_t>(std::max(1, config.updateInterval));
+    m_statsTaskId = m_scheduler->AddPeriodic("stats", displayInterval, 1,
+                                             [this]() { PublishDisplayStats(); });
+    m_scheduler->AddPeriodic("hooks", 1000, 50, [this]() { RefreshHooks(); });
+    m_scheduler->AddPeriodic("memory", 5000, 250, [this]() { MonitorMemoryUsage(); });
+    m_scheduler->AddPeriodic("flush", 30000, 1000, [this]() { m_configManager->SaveIfDirty(); });
+}
+
+void FPSOverlay::OnActivityChanged(ActivityState state) {
+    // Runs on the sampler thread inside ActivityGovernor::Update()
+    uint32_t displayInterval = static_cast<uint32_t>(std::max(1, m_configManager->GetConfig().updateInterval));
+    
+    switch (state) {
+        case ActivityState::ACTIVE:
+            Utils::LogInfo(L"Frames detected, sampling at full rate");
+            // The gap the sampler was parked for is not a frame
+            m_pipeline->ResetSource(FRAME_SOURCE_SAMPLER, MonotonicNowNs());
+            m_samplerPacer->Reset();
+            m_scheduler->SetInterval(m_statsTaskId, displayInterval, 1);
+            break;
+            
+        case ActivityState::COOLING:
+            // Keep the display cadence so the last frames still show up
+            break;
+            
+        case ActivityState::IDLE:
+            // Nothing new to draw; piggyback on the memory check's wakeups
+            Utils::LogInfo(L"No frames presented, throttling to idle");
+            m_scheduler->SetInterval(m_statsTaskId, std::max<uint32_t>(displayInterval, IDLE_DISPLAY_INTERVAL), 250);
+            break;
     }
-    
-    // Store frame time in circular buffer
-    m_frameTimes[m_frameTimeIndex] = deltaTime;
-    m_frameTimeIndex = (m_frameTimeIndex + 1) % FPS_SAMPLE_COUNT;
-    
-    // Calculate average frame time from recent samples
-    float totalTime = 0.0f;
-    int validSamples = 0;
-    
-    for (size_t i = 0; i < m_frameTimes.size(); ++i) {
-        if (m_frameTimes[i] > 0.0f) {
-            totalTime += m_frameTimes[i];
-            validSamples++;
-        }
+}
+
+bool FPSOverlay::ProbeForegroundActivity() const {
+    if (!m_configManager->GetConfig().idleThrottling) return true;
+    
+    // Hooks don't deliver presents yet, so a game-like window in front
+    // counts: one covering its monitor (fullscreen or borderless), or one
+    // from a GameProcesses executable. A browser or editor in front is idle.
+    HWND foreground = Utils::GetForegroundGameWindow();
+    if (!foreground || IsIconic(foreground) || foreground == GetConsoleWindow() ||
+        Utils::IsShellWindow(foreground)) {
+        return false;
     }
-    
-    if (validSamples > 0) {
-        float averageFrameTime = totalTime / validSamples;
-        float newFPS = 1.0f / averageFrameTime;
-        
-        // Smooth the FPS to reduce jitter
-        if (m_currentFPS > 0.0f) {
-            m_currentFPS = m_currentFPS * 0.9f + newFPS * 0.1f; // Exponential moving average
-        } else {
-            m_currentFPS = newFPS;
+    if (Utils::IsFullscreenWindow(foreground)) return true;
+    
+    // The process is only looked up when the foreground window changes
+    if (foreground != m_probeWindow) {
+        m_probeWindow = foreground;
+        m_probeWindowIsGame = false;
+        if (!m_gameProcesses.empty()) {
+            std::wstring process = Utils::GetWindowProcessName(foreground);
+            m_probeWindowIsGame = std::find(m_gameProcesses.begin(), m_gameProcesses.end(), process) !=
+                                  m_gameProcesses.end();
         }
-        
-        // Clamp FPS to reasonable range
-        m_currentFPS = std::max(0.1f, std::min(m_currentFPS, 9999.0f));
     }
-    
-    // Update global FPS counter
-    g_currentFPS = m_currentFPS;
+    return m_probeWindowIsGame;
+}
+
+void FPSOverlay::PublishDisplayStats() {
+    // Seqlock read; the aggregate stage keeps running at frame rate. Skip
+    // the handoff (and the redraw) when no new frames were aggregated.
+    FrameStats stats = GetCurrentStats();
+    if (stats.sequence == m_publishedSequence) return;
+    
+    // Wait-free; the render thread draws it whenever it gets to it
+    m_renderThread->Publish(stats);
+    m_publishedSequence = stats.sequence;
+}
+
+void FPSOverlay::RefreshHooks() {
+    if (m_hookManager && m_hookManager->IsActive()) {
+        m_hookManager->RefreshHooks();
+    }
+}
+
+PipelineConfig FPSOverlay::BuildPipelineConfig(const OverlayConfig& config) const {
+    PipelineConfig pipelineConfig;
+    pipelineConfig.ingestPolicy = config.ingestPolicy;
+    pipelineConfig.normalizePolicy = config.normalizePolicy;
+    pipelineConfig.ingestCapacity = static_cast<size_t>(std::max(16, config.queueCapacity));
+    pipelineConfig.normalizeCapacity = pipelineConfig.ingestCapacity;
+    pipelineConfig.minFrameTime = std::max(config.minFrameTimeMs, 0) / 1000.0f;
+    if (pipelineConfig.minFrameTime <= 0.0f) {
+        pipelineConfig.minFrameTime = MIN_FRAME_TIME;
+    }
+    pipelineConfig.averageWindow = FPS_SAMPLE_COUNT;
+    pipelineConfig.threadAffinityMask = config.backgroundAffinityMask;
+    pipelineConfig.threadPriority = config.backgroundPriority;
+    return pipelineConfig;
+}
+
+void FPSOverlay::LoadPlugins(const OverlayConfig& config) {
+    m_plugins = std::make_unique<PluginHost>(*m_pipeline, m_activity.get());
+    m_plugins->SetLogCallback([](int level, const std::string& message) {
+        std::wstring text = L"Plugin: " + Utils::Utf8ToWide(message);
+        if (level >= FPS_PLUGIN_LOG_ERROR) Utils::LogError(text);
+        else if (level == FPS_PLUGIN_LOG_WARNING) Utils::LogWarning(text);
+        else Utils::LogInfo(text);
+    });
+    if (!config.pluginsEnabled) return;
+
+    std::filesystem::path directory(config.pluginDirectory);
+    if (directory.is_relative()) {
+        directory = std::filesystem::path(Utils::GetExecutableDirectory()) / directory;
+    }
+    m_plugins->LoadDirectory(directory, config.sinkPolicy);
 }
 
 void FPSOverlay::MonitorMemoryUsage() {
-    auto currentTime = std::chrono::high_resolution_clock::now();
-    auto timeSinceLastCheck = std::chrono::duration_cast<std::chrono::seconds>(
-        currentTime - m_lastUpdateTime).count();
-    
-    // Check memory usage every 5 seconds
-    if (timeSinceLastCheck >= 5) {
-        m_memoryUsage = Utils::GetProcessMemoryUsage();
-        m_lastUpdateTime = currentTime;
-        
-        // Check if memory usage exceeds limit
-        size_t memoryUsageMB = m_memoryUsage / (1024 * 1024);
-        if (memoryUsageMB > MAX_MEMORY_USAGE / (1024 * 1024)) {
-            Utils::LogWarning(L"Memory usage exceeds limit: " + std::to_wstring(memoryUsageMB) + L"MB");
-        }
+    // Runs every 5 seconds on the scheduler
+    m_memoryUsage = Utils::GetProcessMemoryUsage();
+    
+    // Check if memory usage exceeds limit
+    size_t memoryUsageMB = m_memoryUsage / (1024 * 1024);
+    if (memoryUsageMB > MAX_MEMORY_USAGE / (1024 * 1024)) {
+        Utils::LogWarning(L"Memory usage exceeds limit: " + std::to_wstring(memoryUsageMB) + L"MB");
     }
 }
 
 bool FPSOverlay::CheckSystemCompatibility() {
-    // Check Windows version
+    // Check Windows version. Graphics APIs are probed by the hook manager,
+    // concurrently with the rest of startup.
     if (!Utils::IsWindows7OrLater()) {
         Utils::LogError(L"Windows 7 or later required");
         return false;
     }
     
-    // Check available graphics APIs
-    auto availableAPIs = Utils::GetAvailableGraphicsAPIs();
-    if (availableAPIs.empty()) {
-        Utils::LogError(L"No compatible graphics APIs found");
-        return false;
-    }
-    
-    // Log available APIs
-    std::wstring apiList = L"Available graphics APIs: ";
-    for (auto api : availableAPIs) {
-        switch (api) {
-            case GraphicsAPI::D3D9:  apiList += L"DirectX9 "; break;
-            case GraphicsAPI::D3D11: apiList += L"DirectX11 "; break;
-            case GraphicsAPI::OPENGL: apiList += L"OpenGL "; break;
-            default: break;
-        }
-    }
-    Utils::LogInfo(apiList);
-    
     return true;
 }
 
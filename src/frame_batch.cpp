@@ -0,0 +1,111 @@
+#include "frame_batch.h"
+
+// FrameBatchRef implementation
+FrameBatchRef::FrameBatchRef(const FrameBatchRef& other)
+    : m_batch(other.m_batch)
+{
+    if (m_batch) {
+        m_batch->m_refCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+FrameBatchRef& FrameBatchRef::operator=(const FrameBatchRef& other) {
+    if (this != &other) {
+        if (other.m_batch) {
+            other.m_batch->m_refCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        Reset();
+        m_batch = other.m_batch;
+    }
+    return *this;
+}
+
+FrameBatchRef& FrameBatchRef::operator=(FrameBatchRef&& other) noexcept {
+    if (this != &other) {
+        Reset();
+        m_batch = other.m_batch;
+        other.m_batch = nullptr;
+    }
+    return *this;
+}
+
+void FrameBatchRef::Reset() {
+    if (!m_batch) return;
+
+    FrameBatch* batch = m_batch;
+    m_batch = nullptr;
+    if (batch->m_refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        batch->m_pool->Recycle(batch);
+    }
+}
+
+uint32_t FrameBatchRef::UseCount() const {
+    return m_batch ? m_batch->m_refCount.load(std::memory_order_relaxed) : 0;
+}
+
+// FrameBatchPool implementation
+FrameBatchPool::FrameBatchPool(size_t batchCount)
+    : m_storage(new FrameBatch[batchCount])
+    , m_capacity(batchCount)
+    , m_freeList(batchCount)
+    , m_exhausted(0)
+{
+    for (size_t i = 0; i < m_capacity; ++i) {
+        m_storage[i].m_pool = this;
+        m_freeList.TryPush(&m_storage[i]);
+    }
+}
+
+FrameBatchPool::~FrameBatchPool() {
+    // All references must be released before the pool goes away
+}
+
+FrameBatch* FrameBatchPool::Acquire() {
+    FrameBatch* batch = nullptr;
+    if (!m_freeList.TryPop(batch)) {
+        m_exhausted.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    batch->m_count = 0;
+    batch->m_sequence = 0;
+    return batch;
+}
+
+void FrameBatchPool::Recycle(FrameBatch* batch) {
+    m_freeList.TryPush(batch);
+}
+
+// FrameBatchWriter implementation
+FrameBatchWriter::FrameBatchWriter(FrameBatchPool& pool)
+    : m_pool(pool)
+    , m_batch(nullptr)
+    , m_nextSequence(1)
+{
+}
+
+FrameBatchWriter::~FrameBatchWriter() {
+    if (m_batch) {
+        m_pool.Recycle(m_batch);
+    }
+}
+
+bool FrameBatchWriter::Append(const NormalizedFrame& frame) {
+    if (!m_batch) {
+        m_batch = m_pool.Acquire();
+        if (!m_batch) return false;  // Every batch is still held by sinks
+    }
+    if (m_batch->m_count == FRAME_BATCH_CAPACITY) return false;
+
+    m_batch->m_frames[m_batch->m_count++] = frame;
+    return true;
+}
+
+FrameBatchRef FrameBatchWriter::Publish() {
+    if (Empty()) return FrameBatchRef();
+
+    FrameBatch* batch = m_batch;
+    m_batch = nullptr;
+    batch->m_sequence = m_nextSequence++;
+    batch->m_refCount.store(1, std::memory_order_release);
+    return FrameBatchRef(batch);
+}
@@ -0,0 +1,68 @@
+#include "frame_histogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // ln(max/min) spread over the bucket range
+    float LogRange() {
+        static const float range = std::log(HISTOGRAM_MAX_MS / HISTOGRAM_MIN_MS);
+        return range;
+    }
+}
+
+FrameHistogram::FrameHistogram(size_t windowFrames)
+    : m_buckets(HISTOGRAM_BUCKET_COUNT, 0)
+    , m_window(std::max<size_t>(1, windowFrames), 0)
+    , m_windowIndex(0)
+    , m_count(0)
+{
+}
+
+void FrameHistogram::Add(float frameTimeMs) {
+    // Evict the frame that falls out of the window
+    if (m_count == m_window.size()) {
+        m_buckets[m_window[m_windowIndex]]--;
+    } else {
+        m_count++;
+    }
+
+    size_t bucket = BucketForMs(frameTimeMs);
+    m_buckets[bucket]++;
+    m_window[m_windowIndex] = static_cast<uint16_t>(bucket);
+    m_windowIndex = (m_windowIndex + 1) % m_window.size();
+}
+
+void FrameHistogram::Clear() {
+    std::fill(m_buckets.begin(), m_buckets.end(), 0);
+    m_windowIndex = 0;
+    m_count = 0;
+}
+
+float FrameHistogram::Percentile(float percentile) const {
+    if (m_count == 0) return 0.0f;
+
+    percentile = std::max(0.0f, std::min(percentile, 100.0f));
+    uint64_t target = static_cast<uint64_t>(std::ceil(m_count * percentile / 100.0f));
+    target = std::max<uint64_t>(1, target);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < m_buckets.size(); ++i) {
+        seen += m_buckets[i];
+        if (seen >= target) return BucketUpperMs(i);
+    }
+    return HISTOGRAM_MAX_MS;
+}
+
+size_t FrameHistogram::BucketForMs(float frameTimeMs) {
+    if (frameTimeMs <= HISTOGRAM_MIN_MS) return 0;
+    if (frameTimeMs >= HISTOGRAM_MAX_MS) return HISTOGRAM_BUCKET_COUNT - 1;
+
+    float position = std::log(frameTimeMs / HISTOGRAM_MIN_MS) / LogRange();
+    size_t bucket = static_cast<size_t>(position * HISTOGRAM_BUCKET_COUNT);
+    return std::min<size_t>(bucket, HISTOGRAM_BUCKET_COUNT - 1);
+}
+
+float FrameHistogram::BucketUpperMs(size_t bucket) {
+    float position = static_cast<float>(bucket + 1) / HISTOGRAM_BUCKET_COUNT;
+    return HISTOGRAM_MIN_MS * std::exp(position * LogRange());
+}
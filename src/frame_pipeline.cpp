@@ -0,0 +1,364 @@
+#include "frame_pipeline.h"
+#include <algorithm>
+
+// How long an idle stage sleeps before re-checking the running flag. Stop()
+// rings every doorbell, so stages with nothing pending can park for long;
+// the short wait is only for the aggregate stage's partial-batch flush.
+#define STAGE_IDLE_WAIT std::chrono::microseconds(50000)
+#define STAGE_PARKED_WAIT std::chrono::microseconds(1000000)
+
+FramePipeline::FramePipeline(const PipelineConfig& config)
+    : m_config(config)
+    , m_running(false)
+    , m_sinksActive(false)
+    , m_batchPool(std::max<size_t>(1, config.batchPoolSize))
+    , m_ingestQueue(config.ingestCapacity, config.ingestPolicy)
+    , m_normalizeQueue(config.normalizeCapacity, config.normalizePolicy)
+    , m_rejectedFrames(0)
+    , m_statsSource(FRAME_SOURCE_SAMPLER)
+    , m_frameTimeIndex(0)
+    , m_smoothedFPS(0.0f)
+    , m_frameCount(0)
+    , m_hitchCount(0)
+    , m_publishSequence(0)
+    , m_histogram(config.percentileWindow)
+    , m_batchWriter(m_batchPool)
+    , m_batchesPublished(0)
+    , m_unbatchedFrames(0)
+    , m_threadSettingFailures(0)
+{
+    std::fill(std::begin(m_lastTimestamp), std::end(m_lastTimestamp), 0);
+    std::fill(std::begin(m_sourceSeenNs), std::end(m_sourceSeenNs), 0);
+    for (auto& reset : m_resetTimestamp) {
+        reset.store(0, std::memory_order_relaxed);
+    }
+    m_frameTimes.resize(std::max<size_t>(1, m_config.averageWindow), 0.0f);
+}
+
+FramePipeline::~FramePipeline() {
+    Stop();
+}
+
+void FramePipeline::AddSink(IFrameSink* sink, BackpressurePolicy policy) {
+    if (!sink || IsRunning()) return;
+
+    auto slot = std::make_unique<SinkSlot>();
+    slot->sink = sink;
+    slot->queue = std::make_unique<StageQueue<SinkEvent, SpscQueue>>(m_config.sinkCapacity, policy);
+    m_sinks.push_back(std::move(slot));
+}
+
+bool FramePipeline::Start() {
+    if (IsRunning()) return true;
+
+    m_running.store(true, std::memory_order_release);
+    m_sinksActive.store(true, std::memory_order_release);
+
+    for (auto& slot : m_sinks) {
+        slot->thread = std::thread(&FramePipeline::SinkWorker, this, slot.get());
+    }
+    m_aggregateThread = std::thread(&FramePipeline::AggregateWorker, this);
+    m_normalizeThread = std::thread(&FramePipeline::NormalizeWorker, this);
+    return true;
+}
+
+void FramePipeline::Stop() {
+    if (!IsRunning()) return;
+
+    m_running.store(false, std::memory_order_release);
+
+    // Wake every stage so blocked pushes and idle waits notice the stop
+    m_ingestQueue.Wake();
+    m_normalizeQueue.Wake();
+    for (auto& slot : m_sinks) {
+        slot->queue->Wake();
+    }
+
+    if (m_normalizeThread.joinable()) m_normalizeThread.join();
+    if (m_aggregateThread.joinable()) m_aggregateThread.join();
+
+    // Upstream is quiet now; let sinks drain and exit
+    m_sinksActive.store(false, std::memory_order_release);
+    for (auto& slot : m_sinks) {
+        slot->queue->Wake();
+        if (slot->thread.joinable()) slot->thread.join();
+    }
+}
+
+bool FramePipeline::PushPresent(uint64_t timestampNs, uint32_t sourceId) {
+    if (!IsRunning()) return false;
+
+    FrameSample sample;
+    sample.timestampNs = timestampNs;
+    sample.sourceId = sourceId < MAX_FRAME_SOURCES ? sourceId : FRAME_SOURCE_SAMPLER;
+    return m_ingestQueue.Push(sample, m_running);
+}
+
+void FramePipeline::ResetSource(uint32_t sourceId, uint64_t timestampNs) {
+    if (sourceId >= MAX_FRAME_SOURCES) sourceId = FRAME_SOURCE_SAMPLER;
+    m_resetTimestamp[sourceId].store(timestampNs, std::memory_order_relaxed);
+}
+
+PipelineMetrics FramePipeline::GetMetrics() const {
+    PipelineMetrics metrics;
+    metrics.ingest = m_ingestQueue.GetStats();
+    metrics.normalize = m_normalizeQueue.GetStats();
+    for (const auto& slot : m_sinks) {
+        metrics.sinks.push_back(slot->queue->GetStats());
+    }
+    metrics.rejectedFrames = m_rejectedFrames.load(std::memory_order_relaxed);
+    metrics.batchPoolCapacity = m_batchPool.Capacity();
+    metrics.batchPoolAvailable = m_batchPool.Available();
+    metrics.batchesPublished = m_batchesPublished.load(std::memory_order_relaxed);
+    metrics.unbatchedFrames = m_unbatchedFrames.load(std::memory_order_relaxed);
+    metrics.threadSettingFailures = m_threadSettingFailures.load(std::memory_order_relaxed);
+    return metrics;
+}
+
+// Stage workers
+void FramePipeline::ApplyThreadSettings() {
+    // These threads do the per-present work, so they keep off the game's
+    // cores like the sampler does
+    if (!ThreadAffinity::ApplyToCurrentThread(m_config.threadAffinityMask, m_config.threadPriority)) {
+        m_threadSettingFailures.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void FramePipeline::NormalizeWorker() {
+    ApplyThreadSettings();
+    FrameSample sample;
+    NormalizedFrame frame;
+
+    while (IsRunning()) {
+        bool worked = false;
+        while (m_ingestQueue.TryPop(sample)) {
+            worked = true;
+            if (Normalize(sample, frame)) {
+                m_normalizeQueue.Push(frame, m_running);
+            }
+        }
+
+        if (!worked) {
+            m_ingestQueue.WaitForItems(STAGE_PARKED_WAIT);
+        }
+    }
+}
+
+void FramePipeline::AggregateWorker() {
+    ApplyThreadSettings();
+    NormalizedFrame frame;
+    SinkEvent event;
+
+    bool fresh = false;  // event.stats has frames not yet published
+
+    while (IsRunning()) {
+        bool worked = false;
+        while (m_normalizeQueue.TryPop(frame)) {
+            worked = true;
+            fresh |= Aggregate(frame, event.stats);
+            if (!m_batchWriter.Append(frame)) {
+                m_unbatchedFrames.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (m_batchWriter.Full()) {
+                if (fresh) PublishStats(event.stats);
+                fresh = false;
+                event.batch = TakeBatchIfReady(0, true);
+                FanOut(event);
+            }
+        }
+
+        if (!worked) {
+            m_normalizeQueue.WaitForItems(m_batchWriter.Empty() ? STAGE_PARKED_WAIT : STAGE_IDLE_WAIT);
+
+            // Don't let a partial batch sit forever once frames stop arriving
+            event.batch = TakeBatchIfReady(MonotonicNowNs(), false);
+            if (event.batch) {
+                FanOut(event);
+            }
+            continue;
+        }
+
+        // Publish and fan the newest stats (and a finished batch, if any) out
+        // once per drained burst. Each sink gets a reference, never a copy.
+        if (fresh) PublishStats(event.stats);
+        fresh = false;
+        event.batch = TakeBatchIfReady(MonotonicNowNs(), false);
+        FanOut(event);
+    }
+
+    // Queue the last partial batch; sinks drain their queues before exiting
+    event.batch = TakeBatchIfReady(0, true);
+    if (event.batch) {
+        FanOut(event);
+    }
+}
+
+void FramePipeline::SinkWorker(SinkSlot* slot) {
+    ApplyThreadSettings();
+    while (m_sinksActive.load(std::memory_order_acquire)) {
+        if (!DrainSink(slot)) {
+            slot->queue->WaitForItems(STAGE_PARKED_WAIT);
+        }
+    }
+
+    // Deliver whatever the upstream stages queued before they stopped
+    DrainSink(slot);
+}
+
+bool FramePipeline::DrainSink(SinkSlot* slot) {
+    SinkEvent event;
+    FrameStats stats;
+
+    // Every batch that reached this queue is delivered (a DROP sink loses
+    // the ones FanOut couldn't queue), but only the newest stats matter
+    bool haveStats = false;
+    while (slot->queue->TryPop(event)) {
+        if (event.batch) {
+            slot->sink->ConsumeBatch(event.batch);
+            event.batch.Reset();
+        }
+        stats = event.stats;
+        haveStats = true;
+    }
+
+    if (haveStats) {
+        slot->sink->Consume(stats);
+    }
+    return haveStats;
+}
+
+// Stage bodies
+bool FramePipeline::Normalize(const FrameSample& sample, NormalizedFrame& frame) {
+    // The first present after a reset has no frame before it, however
+    // long ago the previous one was
+    uint64_t& last = m_lastTimestamp[sample.sourceId];
+    uint64_t reset = m_resetTimestamp[sample.sourceId].load(std::memory_order_relaxed);
+    if (last == 0 || sample.timestampNs <= last || (last < reset && sample.timestampNs >= reset)) {
+        last = sample.timestampNs;
+        return false;
+    }
+
+    float deltaTime = static_cast<float>(sample.timestampNs - last) / 1e9f;
+    last = sample.timestampNs;
+
+    // Clamp delta time to prevent division by zero and handle spikes
+    deltaTime = std::max(deltaTime, m_config.minFrameTime);
+
+    // Skip extremely small delta times that come from too-frequent polling
+    if (deltaTime < m_config.rejectFrameTime) {
+        m_rejectedFrames.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    frame.timestampNs = sample.timestampNs;
+    frame.frameTime = deltaTime;
+    frame.sourceId = sample.sourceId;
+    return true;
+}
+
+bool FramePipeline::FollowSource(const NormalizedFrame& frame) {
+    uint32_t current = m_statsSource;
+    m_sourceSeenNs[frame.sourceId] = std::max(m_sourceSeenNs[frame.sourceId], frame.timestampNs);
+    if (frame.sourceId == current) return true;
+
+    // Real presents beat sampler polls; otherwise stay with the current
+    // source until it goes quiet
+    uint64_t timeoutNs = static_cast<uint64_t>(m_config.sourceTimeoutMs) * 1000000ull;
+    bool samplerOnly = current == FRAME_SOURCE_SAMPLER && frame.sourceId != FRAME_SOURCE_SAMPLER;
+    bool quiet = m_sourceSeenNs[current] == 0 || frame.timestampNs > m_sourceSeenNs[current] + timeoutNs;
+    if (!samplerOnly && !quiet) return false;
+
+    // A new series: nothing of the old source's average, range or lows carries over
+    m_statsSource = frame.sourceId;
+    std::fill(m_frameTimes.begin(), m_frameTimes.end(), 0.0f);
+    m_frameTimeIndex = 0;
+    m_smoothedFPS = 0.0f;
+    m_histogram.Clear();
+    return true;
+}
+
+bool FramePipeline::Aggregate(const NormalizedFrame& frame, FrameStats& stats) {
+    if (!FollowSource(frame)) return false;
+
+    // Hitches are judged against the average before this frame is included
+    if (m_smoothedFPS > 0.0f && frame.frameTime * m_smoothedFPS > m_config.hitchFactor) {
+        m_hitchCount++;
+    }
+
+    // Store frame time in circular buffer
+    m_frameTimes[m_frameTimeIndex] = frame.frameTime;
+    m_frameTimeIndex = (m_frameTimeIndex + 1) % m_frameTimes.size();
+    m_frameCount++;
+    m_histogram.Add(frame.frameTime * 1000.0f);
+
+    // Calculate average, min and max frame time from recent samples
+    float totalTime = 0.0f;
+    float minTime = 0.0f;
+    float maxTime = 0.0f;
+    int validSamples = 0;
+    for (float frameTime : m_frameTimes) {
+        if (frameTime > 0.0f) {
+            totalTime += frameTime;
+            minTime = validSamples ? std::min(minTime, frameTime) : frameTime;
+            maxTime = std::max(maxTime, frameTime);
+            validSamples++;
+        }
+    }
+
+    if (validSamples > 0) {
+        float averageFrameTime = totalTime / validSamples;
+        float newFPS = 1.0f / averageFrameTime;
+
+        // Smooth the FPS to reduce jitter
+        if (m_smoothedFPS > 0.0f) {
+            m_smoothedFPS = m_smoothedFPS * 0.9f + newFPS * 0.1f; // Exponential moving average
+        } else {
+            m_smoothedFPS = newFPS;
+        }
+
+        // Clamp FPS to reasonable range
+        m_smoothedFPS = std::max(0.1f, std::min(m_smoothedFPS, 9999.0f));
+    }
+
+    stats = FrameStats();
+    stats.fps = m_smoothedFPS;
+    stats.frameTimeMs = m_smoothedFPS > 0.0f ? 1000.0f / m_smoothedFPS : 0.0f;
+    stats.minFrameTimeMs = minTime * 1000.0f;
+    stats.maxFrameTimeMs = maxTime * 1000.0f;
+    stats.frameCount = m_frameCount;
+    stats.hitchCount = m_hitchCount;
+    stats.timestampNs = frame.timestampNs;
+    stats.sourceId = m_statsSource;
+    return true;
+}
+
+void FramePipeline::PublishStats(FrameStats& stats) {
+    // Percentiles scan the histogram, so only do it once per burst
+    float p99 = m_histogram.Percentile(99.0f);
+    float p999 = m_histogram.Percentile(99.9f);
+    stats.low1Fps = p99 > 0.0f ? 1000.0f / p99 : 0.0f;
+    stats.low01Fps = p999 > 0.0f ? 1000.0f / p999 : 0.0f;
+    stats.sequence = ++m_publishSequence;
+
+    m_publishedStats.Publish(stats);
+}
+
+void FramePipeline::FanOut(SinkEvent& event) {
+    for (auto& slot : m_sinks) {
+        slot->queue->Push(event, m_running);
+    }
+    event.batch.Reset();
+}
+
+FrameBatchRef FramePipeline::TakeBatchIfReady(uint64_t nowNs, bool force) {
+    if (m_batchWriter.Empty()) return FrameBatchRef();
+
+    uint64_t flushNs = static_cast<uint64_t>(m_config.batchFlushMs) * 1000000ull;
+    bool due = m_batchWriter.Full() ||
+               (nowNs > m_batchWriter.FirstTimestampNs() &&
+                nowNs - m_batchWriter.FirstTimestampNs() >= flushNs);
+    if (!force && !due) return FrameBatchRef();
+
+    m_batchesPublished.fetch_add(1, std::memory_order_relaxed);
+    return m_batchWriter.Publish();
+}
@@ -0,0 +1,147 @@
+#include "frame_time_graph.h"
+
+#include <algorithm>
+
+FrameTimeGraph::FrameTimeGraph()
+    : m_width(0)
+    , m_height(0)
+    , m_head(0)
+    , m_pending(0)
+    , m_fullRedraw(true)
+    , m_version(0)
+    , m_currentFrames(0)
+    , m_guideColor(0)
+    , m_guideRow(-1)
+{
+}
+
+void FrameTimeGraph::Resize(int width, int height) {
+    width = std::max(width, 0);
+    height = std::max(height, 0);
+    if (width == m_width && height == m_height) return;
+
+    // Keep the newest columns, now in order from index 0
+    std::vector<Column> columns(static_cast<size_t>(width));
+    int kept = std::min(width, m_width);
+    for (int i = 0; i < kept; ++i) {
+        int from = (m_head + m_width - kept + i) % m_width;
+        columns[static_cast<size_t>(width - kept + i)] = m_columns[static_cast<size_t>(from)];
+    }
+    m_columns.swap(columns);
+    m_image.Resize(width, height, m_style.background);
+    m_width = width;
+    m_height = height;
+    m_head = 0;
+    m_pending = 0;
+    m_fullRedraw = true;
+    UpdateStyleCache();
+}
+
+void FrameTimeGraph::SetStyle(const FrameTimeGraphStyle& style) {
+    FrameTimeGraphStyle clamped = style;
+    clamped.framesPerColumn = std::max(clamped.framesPerColumn, 1);
+    if (clamped == m_style) return;
+    if (clamped.framesPerColumn != m_style.framesPerColumn) {
+        m_current = Column();
+        m_currentFrames = 0;
+    }
+    m_style = clamped;
+    m_fullRedraw = true;
+    UpdateStyleCache();
+}
+
+void FrameTimeGraph::AddFrameTime(float frameTimeMs) {
+    ++m_stats.frames;
+    if (m_current.IsEmpty()) {
+        m_current.minMs = frameTimeMs;
+        m_current.maxMs = frameTimeMs;
+    } else {
+        m_current.minMs = std::min(m_current.minMs, frameTimeMs);
+        m_current.maxMs = std::max(m_current.maxMs, frameTimeMs);
+    }
+    if (++m_currentFrames < m_style.framesPerColumn) return;
+
+    ++m_stats.columns;
+    if (m_width > 0) {
+        m_columns[static_cast<size_t>(m_head)] = m_current;
+        m_head = (m_head + 1) % m_width;
+        m_pending = std::min(m_pending + 1, m_width);
+    }
+    m_current = Column();
+    m_currentFrames = 0;
+}
+
+void FrameTimeGraph::Invalidate() {
+    m_fullRedraw = true;
+}
+
+bool FrameTimeGraph::Update() {
+    if (m_width == 0 || m_height == 0) return false;
+
+    if (m_fullRedraw) {
+        for (int i = 0; i < m_width; ++i) {
+            PlotColumn(i);
+        }
+        m_stats.plottedColumns += static_cast<uint64_t>(m_width);
+        ++m_stats.fullRedraws;
+        m_fullRedraw = false;
+    } else if (m_pending > 0) {
+        // Only what arrived since last time; every older column is already
+        // in the image where it belongs
+        for (int i = m_width - m_pending; i < m_width; ++i) {
+            PlotColumn((m_head + i) % m_width);
+        }
+        m_stats.plottedColumns += static_cast<uint64_t>(m_pending);
+    } else {
+        return false;
+    }
+
+    m_pending = 0;
+    ++m_version;
+    return true;
+}
+
+void FrameTimeGraph::Draw(PixelBuffer& target, int x, int y) const {
+    m_image.Draw(target, x, y, m_head);
+}
+
+// Private methods implementation
+void FrameTimeGraph::UpdateStyleCache() {
+    // Premultiplied colours mix per channel, alpha included
+    uint32_t mixed = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        uint32_t background = (m_style.background >> shift) & 0xFFu;
+        uint32_t line = (m_style.line >> shift) & 0xFFu;
+        mixed |= ((background * 3 + line + 2) / 4) << shift;
+    }
+    m_guideColor = mixed;
+
+    bool guide = m_style.guideMs > 0.0f && m_style.guideMs <= m_style.scaleMs && m_height > 0;
+    m_guideRow = guide ? RowFor(m_style.guideMs) : -1;
+}
+
+int FrameTimeGraph::RowFor(float frameTimeMs) const {
+    if (!(m_style.scaleMs > 0.0f) || !(frameTimeMs > 0.0f)) return m_height - 1;
+    float ratio = std::min(frameTimeMs / m_style.scaleMs, 1.0f);
+    int row = m_height - 1 - static_cast<int>(ratio * static_cast<float>(m_height - 1) + 0.5f);
+    return std::max(row, 0);
+}
+
+void FrameTimeGraph::PlotColumn(int index) {
+    const Column& column = m_columns[static_cast<size_t>(index)];
+    int top = m_height;  // Empty column: no bar
+    int bottom = m_height - 1;
+    if (!column.IsEmpty()) {
+        top = RowFor(column.maxMs);
+        bottom = RowFor(column.minMs);
+    }
+
+    uint32_t* pixel = m_image.Column(index);
+    for (int row = 0; row < m_height; ++row, pixel += m_width) {
+        if (row >= top && row <= bottom) {
+            *pixel = m_style.line;
+        } else {
+            *pixel = row == m_guideRow ? m_guideColor : m_style.background;
+        }
+    }
+}
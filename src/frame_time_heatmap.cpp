@@ -0,0 +1,201 @@
+#include "frame_time_heatmap.h"
+#include "frame_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    uint32_t Mix(uint32_t from, uint32_t to, float amount) {
+        // Premultiplied colours mix per channel, alpha included
+        uint32_t mixed = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            float a = static_cast<float>((from >> shift) & 0xFFu);
+            float b = static_cast<float>((to >> shift) & 0xFFu);
+            mixed |= static_cast<uint32_t>(a + (b - a) * amount + 0.5f) << shift;
+        }
+        return mixed;
+    }
+}
+
+FrameTimeHeatmap::FrameTimeHeatmap()
+    : m_width(0)
+    , m_height(0)
+    , m_head(0)
+    , m_pending(0)
+    , m_fullRedraw(true)
+    , m_version(0)
+    , m_currentFrames(0)
+    , m_currentMs(0.0f)
+    , m_bucketRow(HISTOGRAM_BUCKET_COUNT, 0)
+    , m_palette()
+{
+    UpdatePalette();
+}
+
+void FrameTimeHeatmap::Resize(int width, int height) {
+    width = std::max(width, 0);
+    height = std::max(height, 0);
+    if (width == m_width && height == m_height) return;
+
+    if (height != m_height) {
+        m_width = width;
+        m_height = height;
+        m_levels.assign(static_cast<size_t>(width) * height, 0);
+        Restart();
+    } else {
+        // Keep the newest slices, now in order from column 0
+        std::vector<uint8_t> levels(static_cast<size_t>(width) * height, 0);
+        int kept = std::min(width, m_width);
+        for (int i = 0; i < kept; ++i) {
+            int from = (m_head + m_width - kept + i) % m_width;
+            std::copy_n(m_levels.begin() + static_cast<size_t>(from) * height, height,
+                        levels.begin() + static_cast<size_t>(width - kept + i) * height);
+        }
+        m_levels.swap(levels);
+        m_width = width;
+        m_head = 0;
+    }
+    m_image.Resize(width, height, m_style.background);
+    m_pending = 0;
+    m_fullRedraw = true;
+}
+
+void FrameTimeHeatmap::SetStyle(const FrameTimeHeatmapStyle& style) {
+    FrameTimeHeatmapStyle clamped = style;
+    clamped.minMs = std::max(clamped.minMs, HISTOGRAM_MIN_MS);
+    clamped.maxMs = std::min(std::max(clamped.maxMs, clamped.minMs * 2.0f), HISTOGRAM_MAX_MS);
+    clamped.sliceMs = std::max(clamped.sliceMs, 1.0f);
+    if (clamped == m_style) return;
+
+    bool range = clamped.minMs != m_style.minMs || clamped.maxMs != m_style.maxMs;
+    bool colors = clamped.background != m_style.background || clamped.color != m_style.color;
+    m_style = clamped;
+    if (range) {
+        std::fill(m_levels.begin(), m_levels.end(), 0);
+        Restart();
+        m_pending = 0;
+        m_fullRedraw = true;
+    }
+    if (colors) {
+        UpdatePalette();
+        m_fullRedraw = true;
+    }
+}
+
+void FrameTimeHeatmap::AddFrameTime(float frameTimeMs) {
+    ++m_stats.frames;
+    if (m_height > 0) {
+        ++m_current[m_bucketRow[FrameHistogram::BucketForMs(frameTimeMs)]];
+        ++m_currentFrames;
+    }
+    m_currentMs += frameTimeMs;
+    if (m_currentMs >= m_style.sliceMs) {
+        CloseSlice();
+    }
+}
+
+void FrameTimeHeatmap::AddSlice(const uint32_t* bucketCounts) {
+    if (m_height > 0) {
+        for (size_t bucket = 0; bucket < HISTOGRAM_BUCKET_COUNT; ++bucket) {
+            m_current[m_bucketRow[bucket]] += bucketCounts[bucket];
+            m_currentFrames += bucketCounts[bucket];
+            m_stats.frames += bucketCounts[bucket];
+        }
+    }
+    CloseSlice();
+}
+
+void FrameTimeHeatmap::Invalidate() {
+    m_fullRedraw = true;
+}
+
+bool FrameTimeHeatmap::Update() {
+    if (m_width == 0 || m_height == 0) return false;
+
+    if (m_fullRedraw) {
+        for (int i = 0; i < m_width; ++i) {
+            PlotColumn(i);
+        }
+        m_stats.plottedColumns += static_cast<uint64_t>(m_width);
+        ++m_stats.fullRedraws;
+        m_fullRedraw = false;
+    } else if (m_pending > 0) {
+        for (int i = m_width - m_pending; i < m_width; ++i) {
+            PlotColumn((m_head + i) % m_width);
+        }
+        m_stats.plottedColumns += static_cast<uint64_t>(m_pending);
+    } else {
+        return false;
+    }
+
+    m_pending = 0;
+    ++m_version;
+    return true;
+}
+
+void FrameTimeHeatmap::Draw(PixelBuffer& target, int x, int y) const {
+    m_image.Draw(target, x, y, m_head);
+}
+
+// Private methods implementation
+void FrameTimeHeatmap::Restart() {
+    // Rows moved: the slice being filled and the bucket table start over
+    m_head = 0;
+    m_current.assign(static_cast<size_t>(m_height), 0);
+    m_currentFrames = 0;
+    m_currentMs = 0.0f;
+
+    float logRange = std::log(m_style.maxMs / m_style.minMs);
+    for (size_t bucket = 0; bucket < HISTOGRAM_BUCKET_COUNT; ++bucket) {
+        float lower = bucket == 0 ? HISTOGRAM_MIN_MS : FrameHistogram::BucketUpperMs(bucket - 1);
+        float center = std::sqrt(lower * FrameHistogram::BucketUpperMs(bucket));
+        float position = std::log(center / m_style.minMs) / logRange;
+        int row = m_height - 1 - static_cast<int>(std::floor(position * static_cast<float>(m_height)));
+        m_bucketRow[bucket] = static_cast<uint16_t>(std::min(std::max(row, 0), std::max(m_height - 1, 0)));
+    }
+}
+
+void FrameTimeHeatmap::UpdatePalette() {
+    // Index = share of the slice's frames in the cell, 1-255. The square
+    // root lifts rare frames (one hitch among a hundred) to a visible shade;
+    // a cell holding most of the slice runs on towards white.
+    m_palette[0] = m_style.background;
+    for (int i = 1; i < HEATMAP_PALETTE_SIZE; ++i) {
+        float t = std::sqrt(static_cast<float>(i) / static_cast<float>(HEATMAP_PALETTE_SIZE - 1));
+        if (t < 0.7f) {
+            m_palette[i] = Mix(m_style.background, m_style.color, 0.3f + 0.7f * t / 0.7f);
+        } else {
+            m_palette[i] = Mix(m_style.color, 0xFFFFFFFFu, 0.6f * (t - 0.7f) / 0.3f);
+        }
+    }
+}
+
+void FrameTimeHeatmap::CloseSlice() {
+    ++m_stats.slices;
+    if (m_width > 0 && m_height > 0) {
+        uint8_t* levels = m_levels.data() + static_cast<size_t>(m_head) * m_height;
+        uint64_t total = m_currentFrames;
+        for (int row = 0; row < m_height; ++row) {
+            uint64_t count = m_current[static_cast<size_t>(row)];
+            uint64_t level = 0;
+            if (count > 0) {
+                level = (count * (HEATMAP_PALETTE_SIZE - 1) + total / 2) / total;
+                level = std::max<uint64_t>(level, 1);
+            }
+            levels[row] = static_cast<uint8_t>(level);
+        }
+        m_head = (m_head + 1) % m_width;
+        m_pending = std::min(m_pending + 1, m_width);
+    }
+    std::fill(m_current.begin(), m_current.end(), 0);
+    m_currentFrames = 0;
+    m_currentMs = 0.0f;
+}
+
+void FrameTimeHeatmap::PlotColumn(int index) {
+    const uint8_t* levels = m_levels.data() + static_cast<size_t>(index) * m_height;
+    uint32_t* pixel = m_image.Column(index);
+    for (int row = 0; row < m_height; ++row, pixel += m_width) {
+        *pixel = m_palette[levels[row]];
+    }
+}
@@ -0,0 +1,159 @@
+#include "gdi_render_backend.h"
+#include "utils.h"
+
+GdiRenderBackend::GdiRenderBackend()
+    : m_memDC(CreateCompatibleDC(nullptr))
+    , m_originalBitmap(nullptr)
+{
+    if (!m_memDC) {
+        Utils::LogError(L"Failed to create overlay memory DC: " + Utils::GetLastErrorString());
+    }
+}
+
+GdiRenderBackend::~GdiRenderBackend() {
+    if (m_memDC) {
+        DeleteDC(m_memDC);
+    }
+}
+
+bool GdiRenderBackend::CreateSurface(int width, int height, RenderSurface& surface) {
+    if (!m_memDC) return false;
+
+    BITMAPINFO info = {};
+    info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    info.bmiHeader.biWidth = width;
+    info.bmiHeader.biHeight = -height;  // Top-down
+    info.bmiHeader.biPlanes = 1;
+    info.bmiHeader.biBitCount = 32;
+    info.bmiHeader.biCompression = BI_RGB;
+
+    void* bits = nullptr;
+    HBITMAP bitmap = CreateDIBSection(m_memDC, &info, DIB_RGB_COLORS, &bits, nullptr, 0);
+    if (!bitmap || !bits) {
+        Utils::LogError(L"Failed to create overlay backbuffer: " + Utils::GetLastErrorString());
+        return false;
+    }
+
+    // Stays selected until it is replaced
+    HGDIOBJ previous = SelectObject(m_memDC, bitmap);
+    if (!m_originalBitmap) {
+        m_originalBitmap = previous;
+    }
+
+    surface.handle = bitmap;
+    surface.pixels = static_cast<uint32_t*>(bits);
+    surface.width = width;
+    surface.height = height;
+    return true;
+}
+
+void GdiRenderBackend::DestroySurface(RenderSurface& surface) {
+    // A bitmap can't be deleted while a DC has it selected
+    if (m_originalBitmap) {
+        SelectObject(m_memDC, m_originalBitmap);
+        m_originalBitmap = nullptr;
+    }
+    DeleteObject(static_cast<HBITMAP>(surface.handle));
+    surface = RenderSurface();
+}
+
+RenderHandle GdiRenderBackend::CreateFontFace(const std::wstring& name, int pixelHeight) {
+    HFONT font = CreateFontW(
+        pixelHeight,                 // height
+        0,                          // width
+        0,                          // escapement
+        0,                          // orientation
+        FW_NORMAL,                  // weight
+        FALSE,                      // italic
+        FALSE,                      // underline
+        FALSE,                      // strikeout
+        DEFAULT_CHARSET,            // charset
+        OUT_DEFAULT_PRECIS,         // output precision
+        CLIP_DEFAULT_PRECIS,        // clipping precision
+        CLEARTYPE_QUALITY,          // quality
+        DEFAULT_PITCH | FF_DONTCARE,// pitch and family
+        name.c_str()                // face name
+    );
+    if (!font) {
+        Utils::LogWarning(L"Failed to create font: " + name);
+    }
+    return font;
+}
+
+void GdiRenderBackend::DestroyFontFace(RenderHandle font) {
+    DeleteObject(static_cast<HFONT>(font));
+}
+
+RenderHandle GdiRenderBackend::CreateBrush(uint32_t rgb) {
+    // COLORREF is 0x00BBGGRR
+    return CreateSolidBrush(RGB((rgb >> 16) & 0xFF, (rgb >> 8) & 0xFF, rgb & 0xFF));
+}
+
+void GdiRenderBackend::DestroyBrush(RenderHandle brush) {
+    DeleteObject(static_cast<HBRUSH>(brush));
+}
+
+int GdiRenderBackend::QueryDpi() const {
+    if (!m_memDC) return RENDER_DEFAULT_DPI;
+    int dpi = GetDeviceCaps(m_memDC, LOGPIXELSY);
+    return dpi > 0 ? dpi : RENDER_DEFAULT_DPI;
+}
+
+// GdiGlyphRasterizer implementation
+GdiGlyphRasterizer::GdiGlyphRasterizer(HDC dc, HFONT font)
+    : m_dc(dc)
+    , m_oldFont(SelectObject(dc, font))
+    , m_metrics()
+    , m_hasMetrics(false)
+{
+    m_hasMetrics = GetTextMetricsW(m_dc, &m_metrics) != FALSE;
+}
+
+GdiGlyphRasterizer::~GdiGlyphRasterizer() {
+    SelectObject(m_dc, m_oldFont);
+}
+
+bool GdiGlyphRasterizer::GetLineMetrics(int& ascent, int& lineHeight) {
+    if (!m_hasMetrics) return false;
+    ascent = m_metrics.tmAscent;
+    lineHeight = m_metrics.tmHeight;
+    return true;
+}
+
+bool GdiGlyphRasterizer::Rasterize(wchar_t ch, GlyphBitmap& glyph) {
+    const MAT2 identity = {{0, 1}, {0, 0}, {0, 0}, {0, 1}};
+    GLYPHMETRICS metrics = {};
+    DWORD size = GetGlyphOutlineW(m_dc, ch, GGO_GRAY8_BITMAP, &metrics, 0, nullptr, &identity);
+    if (size == GDI_ERROR) return false;
+
+    glyph.advance = metrics.gmCellIncX;
+    glyph.left = metrics.gmptGlyphOrigin.x;
+    glyph.top = m_metrics.tmAscent - metrics.gmptGlyphOrigin.y;  // Origin is above the baseline
+    if (size == 0) {
+        // Nothing to draw (space); GDI still reports a 1x1 black box
+        glyph.width = 0;
+        glyph.height = 0;
+        glyph.coverage.clear();
+        return true;
+    }
+
+    m_outline.resize(size);
+    if (GetGlyphOutlineW(m_dc, ch, GGO_GRAY8_BITMAP, &metrics, size, m_outline.data(), &identity) == GDI_ERROR) {
+        return false;
+    }
+
+    glyph.width = metrics.gmBlackBoxX;
+    glyph.height = metrics.gmBlackBoxY;
+    size_t pitch = (metrics.gmBlackBoxX + 3) & ~3u;
+    if (pitch * glyph.height > m_outline.size()) return false;
+
+    glyph.coverage.resize(static_cast<size_t>(glyph.width) * glyph.height);
+    for (int y = 0; y < glyph.height; ++y) {
+        for (int x = 0; x < glyph.width; ++x) {
+            // 0..64 to 0..255
+            uint32_t level = m_outline[y * pitch + x];
+            glyph.coverage[static_cast<size_t>(y) * glyph.width + x] = static_cast<uint8_t>((level * 255 + 32) / 64);
+        }
+    }
+    return true;
+}
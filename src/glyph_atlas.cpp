@@ -0,0 +1,160 @@
+#include "glyph_atlas.h"
+
+#include <algorithm>
+
+namespace {
+    const int GLYPH_COUNT = GLYPH_ATLAS_LAST - GLYPH_ATLAS_FIRST + 1;
+
+    // Classic 5x7 font, 0x20..0x7E. Five columns per glyph, left to right;
+    // bit 0 is the top row.
+    const uint8_t BITMAP_FONT[GLYPH_COUNT][5] = {
+        {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00}, {0x00, 0x07, 0x00, 0x07, 0x00},
+        {0x14, 0x7F, 0x14, 0x7F, 0x14}, {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62},
+        {0x36, 0x49, 0x55, 0x22, 0x50}, {0x00, 0x05, 0x03, 0x00, 0x00}, {0x00, 0x1C, 0x22, 0x41, 0x00},
+        {0x00, 0x41, 0x22, 0x1C, 0x00}, {0x08, 0x2A, 0x1C, 0x2A, 0x08}, {0x08, 0x08, 0x3E, 0x08, 0x08},
+        {0x00, 0x50, 0x30, 0x00, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, {0x00, 0x60, 0x60, 0x00, 0x00},
+        {0x20, 0x10, 0x08, 0x04, 0x02}, {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00},
+        {0x42, 0x61, 0x51, 0x49, 0x46}, {0x21, 0x41, 0x45, 0x4B, 0x31}, {0x18, 0x14, 0x12, 0x7F, 0x10},
+        {0x27, 0x45, 0x45, 0x45, 0x39}, {0x3C, 0x4A, 0x49, 0x49, 0x30}, {0x01, 0x71, 0x09, 0x05, 0x03},
+        {0x36, 0x49, 0x49, 0x49, 0x36}, {0x06, 0x49, 0x49, 0x29, 0x1E}, {0x00, 0x36, 0x36, 0x00, 0x00},
+        {0x00, 0x56, 0x36, 0x00, 0x00}, {0x08, 0x14, 0x22, 0x41, 0x00}, {0x14, 0x14, 0x14, 0x14, 0x14},
+        {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x51, 0x09, 0x06}, {0x32, 0x49, 0x79, 0x41, 0x3E},
+        {0x7E, 0x11, 0x11, 0x11, 0x7E}, {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22},
+        {0x7F, 0x41, 0x41, 0x22, 0x1C}, {0x7F, 0x49, 0x49, 0x49, 0x41}, {0x7F, 0x09, 0x09, 0x01, 0x01},
+        {0x3E, 0x41, 0x41, 0x51, 0x32}, {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00},
+        {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41}, {0x7F, 0x40, 0x40, 0x40, 0x40},
+        {0x7F, 0x02, 0x04, 0x02, 0x7F}, {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E},
+        {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E}, {0x7F, 0x09, 0x19, 0x29, 0x46},
+        {0x46, 0x49, 0x49, 0x49, 0x31}, {0x01, 0x01, 0x7F, 0x01, 0x01}, {0x3F, 0x40, 0x40, 0x40, 0x3F},
+        {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x7F, 0x20, 0x18, 0x20, 0x7F}, {0x63, 0x14, 0x08, 0x14, 0x63},
+        {0x03, 0x04, 0x78, 0x04, 0x03}, {0x61, 0x51, 0x49, 0x45, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x00},
+        {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x7F, 0x00}, {0x04, 0x02, 0x01, 0x02, 0x04},
+        {0x40, 0x40, 0x40, 0x40, 0x40}, {0x00, 0x01, 0x02, 0x04, 0x00}, {0x20, 0x54, 0x54, 0x54, 0x78},
+        {0x7F, 0x48, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x20}, {0x38, 0x44, 0x44, 0x48, 0x7F},
+        {0x38, 0x54, 0x54, 0x54, 0x18}, {0x08, 0x7E, 0x09, 0x01, 0x02}, {0x08, 0x14, 0x54, 0x54, 0x3C},
+        {0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00}, {0x20, 0x40, 0x44, 0x3D, 0x00},
+        {0x00, 0x7F, 0x10, 0x28, 0x44}, {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x18, 0x04, 0x78},
+        {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38}, {0x7C, 0x14, 0x14, 0x14, 0x08},
+        {0x08, 0x14, 0x14, 0x18, 0x7C}, {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x20},
+        {0x04, 0x3F, 0x44, 0x40, 0x20}, {0x3C, 0x40, 0x40, 0x20, 0x7C}, {0x1C, 0x20, 0x40, 0x20, 0x1C},
+        {0x3C, 0x40, 0x30, 0x40, 0x3C}, {0x44, 0x28, 0x10, 0x28, 0x44}, {0x0C, 0x50, 0x50, 0x50, 0x3C},
+        {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00}, {0x00, 0x00, 0x7F, 0x00, 0x00},
+        {0x00, 0x41, 0x36, 0x08, 0x00}, {0x08, 0x04, 0x08, 0x10, 0x08},
+    };
+
+    // Cell layout in font pixels: one blank row above the 7 glyph rows and
+    // one below, one blank column after the 5 glyph columns
+    const int CELL_COLUMNS = 5;
+    const int CELL_ROWS = 7;
+    const int CELL_ADVANCE = 6;
+    const int CELL_LINE = 9;
+}
+
+GlyphAtlas::GlyphAtlas()
+    : m_ascent(0)
+    , m_lineHeight(0)
+    , m_overhang(0)
+    , m_tabularDigits(false)
+{
+}
+
+bool GlyphAtlas::Build(IGlyphRasterizer& rasterizer) {
+    m_coverage.clear();
+    m_ascent = 0;
+    m_lineHeight = 0;
+    m_overhang = 0;
+    m_tabularDigits = false;
+
+    int ascent = 0;
+    int lineHeight = 0;
+    if (!rasterizer.GetLineMetrics(ascent, lineHeight) || lineHeight <= 0) return false;
+
+    GlyphBitmap bitmap;
+    int overhang = 0;
+    for (int i = 0; i < GLYPH_COUNT; ++i) {
+        bitmap = GlyphBitmap();
+        if (!rasterizer.Rasterize(static_cast<wchar_t>(GLYPH_ATLAS_FIRST + i), bitmap) ||
+            bitmap.width < 0 || bitmap.height < 0 ||
+            bitmap.coverage.size() < static_cast<size_t>(bitmap.width) * bitmap.height) {
+            m_coverage.clear();
+            return false;
+        }
+
+        GlyphInfo& glyph = m_glyphs[i];
+        glyph.width = static_cast<int16_t>(bitmap.width);
+        glyph.height = static_cast<int16_t>(bitmap.height);
+        glyph.left = static_cast<int16_t>(bitmap.left);
+        glyph.top = static_cast<int16_t>(bitmap.top);
+        glyph.advance = static_cast<int16_t>(bitmap.advance);
+        glyph.offset = static_cast<uint32_t>(m_coverage.size());
+        if (bitmap.width > 0) {
+            overhang = std::max(overhang, std::max(-bitmap.left, bitmap.left + bitmap.width - bitmap.advance));
+        }
+        m_coverage.insert(m_coverage.end(), bitmap.coverage.begin(),
+                          bitmap.coverage.begin() + static_cast<size_t>(bitmap.width) * bitmap.height);
+    }
+
+    m_ascent = ascent;
+    m_lineHeight = lineHeight;
+    m_overhang = overhang;
+    m_tabularDigits = true;
+    for (wchar_t digit = L'1'; digit <= L'9'; ++digit) {
+        m_tabularDigits = m_tabularDigits && Find(digit)->advance == Find(L'0')->advance;
+    }
+    return true;
+}
+
+int GlyphAtlas::MeasureText(const wchar_t* text, int length) const {
+    const GlyphInfo* fallback = Find(L'?');
+    int width = 0;
+    for (int i = 0; i < length; ++i) {
+        const GlyphInfo* glyph = Find(text[i]);
+        width += (glyph ? glyph : fallback)->advance;
+    }
+    return width;
+}
+
+// BitmapFontRasterizer implementation
+BitmapFontRasterizer::BitmapFontRasterizer(int pixelHeight)
+    : m_scale(std::max(1, (pixelHeight + CELL_LINE / 2) / CELL_LINE))
+{
+}
+
+bool BitmapFontRasterizer::GetLineMetrics(int& ascent, int& lineHeight) {
+    ascent = (CELL_ROWS + 1) * m_scale;
+    lineHeight = CELL_LINE * m_scale;
+    return true;
+}
+
+bool BitmapFontRasterizer::Rasterize(wchar_t ch, GlyphBitmap& glyph) {
+    if (ch < GLYPH_ATLAS_FIRST || ch > GLYPH_ATLAS_LAST) return false;
+
+    const uint8_t* columns = BITMAP_FONT[ch - GLYPH_ATLAS_FIRST];
+    glyph.advance = CELL_ADVANCE * m_scale;
+    glyph.left = 0;
+    glyph.top = m_scale;
+
+    bool blank = true;
+    for (int c = 0; c < CELL_COLUMNS; ++c) {
+        blank = blank && columns[c] == 0;
+    }
+    if (blank) {
+        glyph.width = 0;
+        glyph.height = 0;
+        glyph.coverage.clear();
+        return true;
+    }
+
+    glyph.width = CELL_COLUMNS * m_scale;
+    glyph.height = CELL_ROWS * m_scale;
+    glyph.coverage.assign(static_cast<size_t>(glyph.width) * glyph.height, 0);
+    for (int y = 0; y < glyph.height; ++y) {
+        int row = y / m_scale;
+        for (int x = 0; x < glyph.width; ++x) {
+            if (columns[x / m_scale] & (1u << row)) {
+                glyph.coverage[static_cast<size_t>(y) * glyph.width + x] = 255;
+            }
+        }
+    }
+    return true;
+}
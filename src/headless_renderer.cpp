@@ -0,0 +1,108 @@
+#include "headless_renderer.h"
+
+#include <cstdio>
+
+HeadlessRenderer::HeadlessRenderer()
+    : m_resources(m_backend)
+    , m_atlasPixelHeight(0)
+{
+}
+
+void HeadlessRenderer::AddFrameTime(float frameTimeMs) {
+    m_painter.AddFrameTime(frameTimeMs);
+}
+
+DamageKind HeadlessRenderer::Render(const FrameStats& stats, const HeadlessRenderConfig& config) {
+    // Scaled like the resource cache's fonts; the bitmap font then rounds
+    // to whole font pixels
+    m_resources.SetDpi(config.dpi);
+    int pixelHeight = (config.fontSize * m_resources.GetDpi() + RENDER_DEFAULT_DPI / 2) / RENDER_DEFAULT_DPI;
+    if (pixelHeight != m_atlasPixelHeight) {
+        BitmapFontRasterizer rasterizer(pixelHeight);
+        m_atlas.Build(rasterizer);
+        m_atlasPixelHeight = pixelHeight;
+        m_painter.Invalidate();
+    }
+
+    // Placed only when the widgets, font or graph sizes change, as Renderer
+    // does; there is no window to place
+    WidgetMetrics metrics;
+    metrics.font = static_cast<uint64_t>(pixelHeight);
+    metrics.lineHeight = m_atlas.LineHeight();
+    metrics.graphWidth = config.graphWidth;
+    metrics.graphHeight = config.graphHeight;
+    metrics.heatmapWidth = config.heatmapWidth;
+    metrics.heatmapHeight = config.heatmapHeight;
+    m_layout.Configure(config.widgets, metrics,
+                       [this](const wchar_t* text, int length) { return m_atlas.MeasureText(text, length); });
+    m_layout.Update(stats);
+    m_painter.Prepare(m_layout, config.style);
+
+    // A grown backbuffer may come back at the old address; it still holds
+    // none of the old pixels
+    uint64_t creates = m_resources.GetStats().surfaceCreates;
+    const RenderSurface* surface = m_resources.Surface(m_layout.Width(), m_layout.Height());
+    if (!surface) {
+        m_framebuffer = PixelBuffer();
+        return DamageKind::NONE;
+    }
+    if (m_resources.GetStats().surfaceCreates != creates) {
+        m_painter.Invalidate();
+    }
+
+    m_framebuffer.pixels = surface->pixels;
+    m_framebuffer.width = m_layout.Width();
+    m_framebuffer.height = m_layout.Height();
+    m_framebuffer.stride = surface->width;
+    return m_painter.Paint(m_framebuffer, &m_atlas, m_layout, 0);
+}
+
+void HeadlessRenderer::Invalidate() {
+    m_painter.Invalidate();
+}
+
+void HeadlessRenderer::CopyRgba(uint8_t* rgba) const {
+    for (int y = 0; y < m_framebuffer.height; ++y) {
+        const uint32_t* row = m_framebuffer.pixels + static_cast<size_t>(y) * m_framebuffer.stride;
+        for (int x = 0; x < m_framebuffer.width; ++x, rgba += 4) {
+            rgba[0] = static_cast<uint8_t>(row[x] >> 16);
+            rgba[1] = static_cast<uint8_t>(row[x] >> 8);
+            rgba[2] = static_cast<uint8_t>(row[x]);
+            rgba[3] = static_cast<uint8_t>(row[x] >> 24);
+        }
+    }
+}
+
+uint64_t HeadlessRenderer::Hash() const {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](uint32_t value) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            hash = (hash ^ ((value >> shift) & 0xFFu)) * 1099511628211ull;
+        }
+    };
+    mix(static_cast<uint32_t>(m_framebuffer.width));
+    mix(static_cast<uint32_t>(m_framebuffer.height));
+    for (int y = 0; y < m_framebuffer.height; ++y) {
+        const uint32_t* row = m_framebuffer.pixels + static_cast<size_t>(y) * m_framebuffer.stride;
+        for (int x = 0; x < m_framebuffer.width; ++x) {
+            mix(row[x]);
+        }
+    }
+    return hash;
+}
+
+bool HeadlessRenderer::WritePpm(const std::string& path) const {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+
+    bool ok = std::fprintf(file, "P6\n%d %d\n255\n", m_framebuffer.width, m_framebuffer.height) > 0;
+    for (int y = 0; ok && y < m_framebuffer.height; ++y) {
+        const uint32_t* row = m_framebuffer.pixels + static_cast<size_t>(y) * m_framebuffer.stride;
+        for (int x = 0; ok && x < m_framebuffer.width; ++x) {
+            uint8_t rgb[3] = {static_cast<uint8_t>(row[x] >> 16), static_cast<uint8_t>(row[x] >> 8),
+                              static_cast<uint8_t>(row[x])};
+            ok = std::fwrite(rgb, 1, sizeof(rgb), file) == sizeof(rgb);
+        }
+    }
+    return std::fclose(file) == 0 && ok;
+}
@@ -8,6 +8,8 @@ static HookManager* g_hookManager = nullptr;
 HookManager::HookManager()
     : m_active(false)
     , m_detectedAPI(GraphicsAPI::UNKNOWN)
+    , m_framePipeline(nullptr)
+    , m_activityGovernor(nullptr)
     , m_d3d9PresentAddr(nullptr)
     , m_d3d11PresentAddr(nullptr)
     , m_swapBuffersAddr(nullptr)
@@ -68,7 +70,7 @@ void HookManager::Cleanup() {
 
 GraphicsAPI HookManager::DetectGraphicsAPI() {
     // Check for loaded graphics libraries in the current process
-    std::vector<GraphicsAPI> availableAPIs = Utils::GetAvailableGraphicsAPIs();
+    const std::vector<GraphicsAPI>& availableAPIs = Utils::GetAvailableGraphicsAPIs();
     
     if (availableAPIs.empty()) {
         return GraphicsAPI::UNKNOWN;
@@ -88,18 +90,20 @@ GraphicsAPI HookManager::DetectGraphicsAPI() {
     
     if (Module32FirstW(hSnapshot, &moduleEntry)) {
         do {
-            std::wstring moduleName = Utils::ToLower(moduleEntry.szModule);
+            // Lowercase in place: this runs every second from the scheduler
+            // and must not allocate a string per module
+            wchar_t* moduleName = moduleEntry.szModule;
+            CharLowerW(moduleName);
             
-            if (moduleName.find(L"d3d11") != std::wstring::npos ||
-                moduleName.find(L"dxgi") != std::wstring::npos) {
+            if (wcsstr(moduleName, L"d3d11") || wcsstr(moduleName, L"dxgi")) {
                 detectedAPI = GraphicsAPI::D3D11;
                 break;
             }
-            else if (moduleName.find(L"d3d9") != std::wstring::npos) {
+            else if (wcsstr(moduleName, L"d3d9")) {
                 detectedAPI = GraphicsAPI::D3D9;
                 break;
             }
-            else if (moduleName.find(L"opengl32") != std::wstring::npos) {
+            else if (wcsstr(moduleName, L"opengl32")) {
                 detectedAPI = GraphicsAPI::OPENGL;
                 break;
             }
@@ -165,8 +169,8 @@ HRESULT WINAPI HookManager::D3D9PresentHook(IDirect3DDevice9* device, CONST RECT
                                            CONST RECT* pDestRect, HWND hDestWindowOverride,
                                            CONST RGNDATA* pDirtyRegion) {
     if (g_hookManager && g_hookManager->m_originalD3D9Present) {
-        // Update FPS counter
-        g_currentFPS = g_currentFPS + 1.0f; // Simple increment for demonstration
+        // Report the present to the frame pipeline
+        g_hookManager->ReportPresent();
         
         // Call original function
         return g_hookManager->m_originalD3D9Present(device, pSourceRect, pDestRect, 
@@ -178,8 +182,8 @@ HRESULT WINAPI HookManager::D3D9PresentHook(IDirect3DDevice9* device, CONST RECT
 
 HRESULT WINAPI HookManager::D3D11PresentHook(IDXGISwapChain* swapChain, UINT SyncInterval, UINT Flags) {
     if (g_hookManager && g_hookManager->m_originalD3D11Present) {
-        // Update FPS counter
-        g_currentFPS = g_currentFPS + 1.0f; // Simple increment for demonstration
+        // Report the present to the frame pipeline
+        g_hookManager->ReportPresent();
         
         // Call original function
         return g_hookManager->m_originalD3D11Present(swapChain, SyncInterval, Flags);
@@ -190,8 +194,8 @@ HRESULT WINAPI HookManager::D3D11PresentHook(IDXGISwapChain* swapChain, UINT Syn
 
 BOOL WINAPI HookManager::SwapBuffersHook(HDC hdc) {
     if (g_hookManager && g_hookManager->m_originalSwapBuffers) {
-        // Update FPS counter
-        g_currentFPS = g_currentFPS + 1.0f; // Simple increment for demonstration
+        // Report the present to the frame pipeline
+        g_hookManager->ReportPresent();
         
         // Call original function
         return g_hookManager->m_originalSwapBuffers(hdc);
@@ -201,6 +205,20 @@ BOOL WINAPI HookManager::SwapBuffersHook(HDC hdc) {
 }
 
 // Helper functions implementation
+void HookManager::ReportPresent() {
+    // Lock-free ingestion; hook threads never wait on the pipeline
+    uint64_t now = MonotonicNowNs();
+    FramePipeline* pipeline = m_framePipeline.load(std::memory_order_acquire);
+    if (pipeline) {
+        pipeline->PushPresent(now, FRAME_SOURCE_HOOK);
+    }
+    
+    ActivityGovernor* governor = m_activityGovernor.load(std::memory_order_acquire);
+    if (governor) {
+        governor->NotifyActivity(now);
+    }
+}
+
 void* HookManager::GetProcAddressFromModule(const wchar_t* moduleName, const char* procName) {
     HMODULE hModule = GetModuleHandleW(moduleName);
     if (!hModule) {
@@ -246,17 +264,16 @@ bool HookManager::RemoveHook(void* targetFunction, void* originalFunction) {
 // Process detection functions
 bool HookManager::IsTargetProcess() {
     // Check if current process is a target for FPS monitoring
-    std::wstring processName = GetCurrentProcessName();
+    std::wstring processName = Utils::ToLower(GetCurrentProcessName());
     
-    // Avoid hooking into system processes
-    std::vector<std::wstring> excludedProcesses = {
+    // Avoid hooking into system processes (already lowercase)
+    static const wchar_t* const excludedProcesses[] = {
         L"explorer.exe", L"dwm.exe", L"winlogon.exe", L"csrss.exe",
         L"smss.exe", L"services.exe", L"lsass.exe", L"svchost.exe"
     };
     
-    processName = Utils::ToLower(processName);
-    for (const auto& excluded : excludedProcesses) {
-        if (processName.find(Utils::ToLower(excluded)) != std::wstring::npos) {
+    for (const wchar_t* excluded : excludedProcesses) {
+        if (processName.find(excluded) != std::wstring::npos) {
             return false;
         }
     }
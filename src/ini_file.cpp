@@ -0,0 +1,100 @@
+#include "ini_file.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+
+namespace {
+    std::string_view Trim(std::string_view str) {
+        size_t first = str.find_first_not_of(" \t\r");
+        if (first == std::string_view::npos) return std::string_view();
+        size_t last = str.find_last_not_of(" \t\r");
+        return str.substr(first, last - first + 1);
+    }
+
+    void AppendLower(std::string& out, std::string_view str) {
+        for (char c : str) {
+            out.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+        }
+    }
+}
+
+IniFile IniFile::Parse(std::string_view text) {
+    IniFile ini;
+    if (text.substr(0, 3) == "\xEF\xBB\xBF") text.remove_prefix(3);
+
+    std::string section;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = text.find('\n', pos);
+        if (end == std::string_view::npos) end = text.size();
+        std::string_view line = Trim(text.substr(pos, end - pos));
+        pos = end + 1;
+
+        if (line.empty() || line.front() == ';' || line.front() == '#') continue;
+
+        if (line.front() == '[') {
+            size_t close = line.find(']');
+            section = std::string(Trim(line.substr(1, close == std::string_view::npos ? line.size() - 1 : close - 1)));
+            continue;
+        }
+
+        size_t equals = line.find('=');
+        if (equals == std::string_view::npos) continue;
+
+        std::string_view value = Trim(line.substr(equals + 1));
+        if (value.size() >= 2 && (value.front() == '"' || value.front() == '\'') && value.back() == value.front()) {
+            value = value.substr(1, value.size() - 2);
+        }
+        ini.m_values.emplace(MakeKey(section, Trim(line.substr(0, equals))), std::string(value));
+    }
+    return ini;
+}
+
+bool IniFile::Load(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    *this = Parse(text);
+    return true;
+}
+
+const std::string* IniFile::Find(std::string_view section, std::string_view key) const {
+    auto it = m_values.find(MakeKey(section, key));
+    return it != m_values.end() ? &it->second : nullptr;
+}
+
+std::string IniFile::GetString(std::string_view section, std::string_view key, std::string_view defaultValue) const {
+    const std::string* value = Find(section, key);
+    return value ? *value : std::string(defaultValue);
+}
+
+int IniFile::GetInt(std::string_view section, std::string_view key, int defaultValue) const {
+    const std::string* value = Find(section, key);
+    if (!value) return defaultValue;
+    return static_cast<int>(std::strtol(value->c_str(), nullptr, 10));
+}
+
+bool IniFile::GetBool(std::string_view section, std::string_view key, bool defaultValue) const {
+    return GetInt(section, key, defaultValue ? 1 : 0) != 0;
+}
+
+float IniFile::GetFloat(std::string_view section, std::string_view key, float defaultValue) const {
+    const std::string* value = Find(section, key);
+    if (!value || value->empty()) return defaultValue;
+
+    char* end = nullptr;
+    float result = std::strtof(value->c_str(), &end);
+    return end != value->c_str() ? result : defaultValue;
+}
+
+std::string IniFile::MakeKey(std::string_view section, std::string_view key) {
+    std::string out;
+    out.reserve(section.size() + key.size() + 1);
+    AppendLower(out, section);
+    out.push_back('\n');
+    AppendLower(out, key);
+    return out;
+}
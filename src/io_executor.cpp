@@ -0,0 +1,462 @@
+#include "io_executor.h"
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+#ifdef _WIN32
+    // Completion keys
+    const ULONG_PTR IO_KEY_SUBMIT = 1;
+    const ULONG_PTR IO_KEY_FILE = 2;
+    const ULONG_PTR IO_KEY_STOP = 3;
+
+    // Largest single ReadFile/WriteFile; bigger buffers are split
+    const size_t IO_MAX_CHUNK = 64u << 20;
+#endif
+
+    std::filesystem::path TempPathFor(const std::filesystem::path& path) {
+        std::filesystem::path temp = path;
+        temp += ".tmp";
+        return temp;
+    }
+}
+
+enum class IoKind {
+    WRITE,
+    READ
+};
+
+#ifdef _WIN32
+struct IoOverlapped : OVERLAPPED {
+    IoExecutor::Request* request;
+};
+#endif
+
+struct IoExecutor::Request {
+    IoKind kind = IoKind::WRITE;
+    IoWriteMode mode = IoWriteMode::REPLACE;
+    std::filesystem::path path;
+    std::vector<char> data;
+    IoResult result;
+    std::coroutine_handle<> awaiting;
+    size_t done = 0;  // Bytes transferred so far
+
+#ifdef _WIN32
+    IoOverlapped overlapped = {};
+    HANDLE file = INVALID_HANDLE_VALUE;
+#endif
+};
+
+// Operation implementation
+IoExecutor::Operation::Operation(IoExecutor* executor, std::unique_ptr<Request> request)
+    : m_executor(executor)
+    , m_request(std::move(request))
+{
+}
+
+IoExecutor::Operation::Operation(Operation&&) noexcept = default;
+
+IoExecutor::Operation::~Operation() = default;
+
+void IoExecutor::Operation::await_suspend(std::coroutine_handle<> awaiting) {
+    m_request->awaiting = awaiting;
+    m_executor->Submit(m_request.get());
+}
+
+IoResult IoExecutor::Operation::await_resume() {
+    if (m_request->kind == IoKind::READ && m_request->result.ok) {
+        m_request->data.resize(m_request->done);
+        m_request->result.data = std::move(m_request->data);
+    }
+    return std::move(m_request->result);
+}
+
+// IoExecutor implementation
+IoExecutor::IoExecutor()
+    : m_port(nullptr)
+    , m_stopping(false)
+    , m_affinityMask(THREAD_AFFINITY_NONE)
+    , m_priority(ThreadPriority::NORMAL)
+    , m_threadSettingsChanged(false)
+    , m_inFlight(0)
+    , m_submitted(0)
+    , m_completed(0)
+    , m_failed(0)
+    , m_bytesWritten(0)
+    , m_bytesRead(0)
+{
+#ifdef _WIN32
+    m_port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1);
+#endif
+    m_thread = std::thread(&IoExecutor::IoWorker, this);
+}
+
+IoExecutor::~IoExecutor() {
+    Drain();
+
+    m_stopping = true;
+#ifdef _WIN32
+    if (m_port) {
+        PostQueuedCompletionStatus(static_cast<HANDLE>(m_port), 0, IO_KEY_STOP, nullptr);
+    }
+#else
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+    }
+    m_cv.notify_all();
+#endif
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+#ifdef _WIN32
+    if (m_port) {
+        CloseHandle(static_cast<HANDLE>(m_port));
+    }
+#endif
+}
+
+std::shared_ptr<IoExecutor> IoExecutor::Shared() {
+    // Created on first use; lives as long as the longest holder
+    static std::mutex mutex;
+    static std::weak_ptr<IoExecutor> instance;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<IoExecutor> executor = instance.lock();
+    if (!executor) {
+        executor = std::make_shared<IoExecutor>();
+        instance = executor;
+    }
+    return executor;
+}
+
+IoExecutor::Operation IoExecutor::WriteFile(const std::filesystem::path& path, std::vector<char> data,
+                                            IoWriteMode mode) {
+    auto request = std::make_unique<Request>();
+    request->kind = IoKind::WRITE;
+    request->mode = mode;
+    request->path = path;
+    request->data = std::move(data);
+    return Operation(this, std::move(request));
+}
+
+IoExecutor::Operation IoExecutor::ReadFile(const std::filesystem::path& path) {
+    auto request = std::make_unique<Request>();
+    request->kind = IoKind::READ;
+    request->path = path;
+    return Operation(this, std::move(request));
+}
+
+void IoExecutor::Drain() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_drainCv.wait(lock, [this]() { return m_inFlight == 0; });
+}
+
+void IoExecutor::SetThreadSettings(uint64_t affinityMask, ThreadPriority priority) {
+    m_affinityMask.store(affinityMask, std::memory_order_relaxed);
+    m_priority.store(priority, std::memory_order_relaxed);
+    m_threadSettingsChanged.store(true, std::memory_order_release);
+}
+
+void IoExecutor::ApplyThreadSettings() {
+    if (!m_threadSettingsChanged.exchange(false, std::memory_order_acquire)) return;
+    ThreadAffinity::ApplyToCurrentThread(m_affinityMask.load(std::memory_order_relaxed),
+                                         m_priority.load(std::memory_order_relaxed));
+}
+
+IoExecutorStats IoExecutor::GetStats() const {
+    IoExecutorStats stats;
+    stats.submitted = m_submitted.load(std::memory_order_relaxed);
+    stats.completed = m_completed.load(std::memory_order_relaxed);
+    stats.failed = m_failed.load(std::memory_order_relaxed);
+    stats.bytesWritten = m_bytesWritten.load(std::memory_order_relaxed);
+    stats.bytesRead = m_bytesRead.load(std::memory_order_relaxed);
+    stats.inFlight = static_cast<size_t>(stats.submitted - stats.completed);
+    return stats;
+}
+
+// Private methods implementation
+void IoExecutor::Submit(Request* request) {
+    m_submitted.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_inFlight++;
+#ifndef _WIN32
+        m_pending.push_back(request);
+#endif
+    }
+
+#ifdef _WIN32
+    // Open and issue on the completion thread; CreateFile itself can block
+    request->overlapped.request = request;
+    if (!PostQueuedCompletionStatus(static_cast<HANDLE>(m_port), 0, IO_KEY_SUBMIT,
+                                    &request->overlapped)) {
+        request->result.error = GetLastError();
+        Complete(request);
+    }
+#else
+    m_cv.notify_one();
+#endif
+}
+
+void IoExecutor::Complete(Request* request) {
+    bool ok = request->result.ok;
+    if (ok) {
+        request->result.bytes = request->done;
+        if (request->kind == IoKind::WRITE) {
+            m_bytesWritten.fetch_add(request->done, std::memory_order_relaxed);
+        } else {
+            m_bytesRead.fetch_add(request->done, std::memory_order_relaxed);
+        }
+    } else {
+        m_failed.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_completed.fetch_add(1, std::memory_order_relaxed);
+
+    // The coroutine may destroy the request (and submit new ones) while
+    // resumed, so this is the last touch
+    request->awaiting.resume();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (--m_inFlight == 0) {
+        m_drainCv.notify_all();
+    }
+}
+
+#ifdef _WIN32
+
+namespace {
+    // Issue the next chunk; completion (or failure) arrives on the port
+    bool IssueChunk(IoExecutor::Request* request, IoKind kind, IoWriteMode mode, size_t done,
+                    std::vector<char>& data) {
+        OVERLAPPED& ov = request->overlapped;
+        ov.Internal = 0;
+        ov.InternalHigh = 0;
+        ov.hEvent = nullptr;
+        if (kind == IoKind::WRITE && mode == IoWriteMode::APPEND) {
+            ov.Offset = 0xFFFFFFFF;
+            ov.OffsetHigh = 0xFFFFFFFF;
+        } else {
+            ov.Offset = static_cast<DWORD>(done & 0xFFFFFFFFull);
+            ov.OffsetHigh = static_cast<DWORD>(static_cast<uint64_t>(done) >> 32);
+        }
+
+        DWORD chunk = static_cast<DWORD>(std::min(data.size() - done, IO_MAX_CHUNK));
+        BOOL issued = kind == IoKind::WRITE
+            ? ::WriteFile(request->file, data.data() + done, chunk, nullptr, &ov)
+            : ::ReadFile(request->file, data.data() + done, chunk, nullptr, &ov);
+        return issued || GetLastError() == ERROR_IO_PENDING;
+    }
+}
+
+void IoExecutor::IoWorker() {
+    HANDLE port = static_cast<HANDLE>(m_port);
+    while (true) {
+        DWORD bytes = 0;
+        ULONG_PTR key = 0;
+        OVERLAPPED* ov = nullptr;
+        BOOL success = GetQueuedCompletionStatus(port, &bytes, &key, &ov, INFINITE);
+        if (key == IO_KEY_STOP || (!success && !ov)) break;
+
+        Request* request = static_cast<IoOverlapped*>(ov)->request;
+        if (key == IO_KEY_SUBMIT) {
+            ApplyThreadSettings();
+            Start(request);
+            continue;
+        }
+
+        // A finished chunk of a file operation
+        if (!success && !(request->kind == IoKind::READ && GetLastError() == ERROR_HANDLE_EOF)) {
+            request->result.error = GetLastError();
+        } else {
+            request->done += bytes;
+            bool more = bytes > 0 && request->done < request->data.size();
+            if (more && IssueChunk(request, request->kind, request->mode, request->done, request->data)) {
+                continue;
+            }
+            request->result.ok = !more;
+            if (more) request->result.error = GetLastError();
+        }
+
+        // Replacement must not leave a truncated file behind after a crash:
+        // the data reaches the disk before the rename does
+        if (request->result.ok && request->kind == IoKind::WRITE && request->mode == IoWriteMode::REPLACE &&
+            !FlushFileBuffers(request->file)) {
+            request->result.ok = false;
+            request->result.error = GetLastError();
+        }
+        CloseHandle(request->file);
+        request->file = INVALID_HANDLE_VALUE;
+
+        if (request->result.ok && request->kind == IoKind::WRITE && request->mode == IoWriteMode::REPLACE) {
+            std::filesystem::path temp = TempPathFor(request->path);
+            if (!MoveFileExW(temp.c_str(), request->path.c_str(),
+                             MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+                request->result.ok = false;
+                request->result.error = GetLastError();
+            }
+        }
+        Complete(request);
+    }
+}
+
+void IoExecutor::Start(Request* request) {
+    HANDLE file = INVALID_HANDLE_VALUE;
+    if (request->kind == IoKind::READ) {
+        file = CreateFileW(request->path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                           nullptr, OPEN_EXISTING, FILE_FLAG_OVERLAPPED, nullptr);
+    } else if (request->mode == IoWriteMode::APPEND) {
+        file = CreateFileW(request->path.c_str(), FILE_APPEND_DATA, FILE_SHARE_READ,
+                           nullptr, OPEN_ALWAYS, FILE_FLAG_OVERLAPPED, nullptr);
+    } else {
+        std::filesystem::path temp = TempPathFor(request->path);
+        file = CreateFileW(temp.c_str(), GENERIC_WRITE, 0,
+                           nullptr, CREATE_ALWAYS, FILE_FLAG_OVERLAPPED, nullptr);
+    }
+
+    if (file == INVALID_HANDLE_VALUE ||
+        !CreateIoCompletionPort(file, static_cast<HANDLE>(m_port), IO_KEY_FILE, 0)) {
+        request->result.error = GetLastError();
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        Complete(request);
+        return;
+    }
+    request->file = file;
+
+    if (request->kind == IoKind::READ) {
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            request->result.error = GetLastError();
+            CloseHandle(file);
+            Complete(request);
+            return;
+        }
+        request->data.resize(static_cast<size_t>(size.QuadPart));
+    }
+
+    // Nothing to transfer: finish straight away
+    if (request->data.empty()) {
+        CloseHandle(file);
+        request->file = INVALID_HANDLE_VALUE;
+        request->result.ok = true;
+        if (request->kind == IoKind::WRITE && request->mode == IoWriteMode::REPLACE) {
+            std::filesystem::path temp = TempPathFor(request->path);
+            request->result.ok = MoveFileExW(temp.c_str(), request->path.c_str(),
+                                             MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+            if (!request->result.ok) request->result.error = GetLastError();
+        }
+        Complete(request);
+        return;
+    }
+
+    if (!IssueChunk(request, request->kind, request->mode, 0, request->data)) {
+        request->result.error = GetLastError();
+        CloseHandle(file);
+        request->file = INVALID_HANDLE_VALUE;
+        Complete(request);
+    }
+}
+
+void IoExecutor::RunBlocking(Request*) {
+    // Windows requests complete through the port
+}
+
+#else
+
+void IoExecutor::IoWorker() {
+    while (true) {
+        Request* request = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return !m_pending.empty() || m_stopping.load(); });
+            if (m_pending.empty()) break;
+            request = m_pending.front();
+            m_pending.pop_front();
+        }
+        ApplyThreadSettings();
+        Start(request);
+    }
+}
+
+void IoExecutor::Start(Request* request) {
+    RunBlocking(request);
+    Complete(request);
+}
+
+void IoExecutor::RunBlocking(Request* request) {
+    IoResult& result = request->result;
+
+    if (request->kind == IoKind::READ) {
+        int fd = open(request->path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            result.error = static_cast<uint32_t>(errno);
+            return;
+        }
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            request->data.resize(static_cast<size_t>(info.st_size));
+        }
+        while (true) {
+            if (request->done == request->data.size()) {
+                request->data.resize(request->data.size() + 4096);  // File grew
+            }
+            ssize_t n = read(fd, request->data.data() + request->done, request->data.size() - request->done);
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0) {
+                result.error = static_cast<uint32_t>(errno);
+                close(fd);
+                return;
+            }
+            if (n == 0) break;
+            request->done += static_cast<size_t>(n);
+        }
+        close(fd);
+        result.ok = true;
+        return;
+    }
+
+    bool replace = request->mode == IoWriteMode::REPLACE;
+    std::filesystem::path target = replace ? TempPathFor(request->path) : request->path;
+    int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (replace ? O_TRUNC : O_APPEND);
+    int fd = open(target.c_str(), flags, 0644);
+    if (fd < 0) {
+        result.error = static_cast<uint32_t>(errno);
+        return;
+    }
+
+    while (request->done < request->data.size()) {
+        ssize_t n = write(fd, request->data.data() + request->done, request->data.size() - request->done);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) {
+            result.error = static_cast<uint32_t>(errno);
+            close(fd);
+            return;
+        }
+        request->done += static_cast<size_t>(n);
+    }
+
+    // Replacement must not leave a truncated file behind after a crash
+    if (replace && fdatasync(fd) != 0) {
+        result.error = static_cast<uint32_t>(errno);
+        close(fd);
+        return;
+    }
+    close(fd);
+
+    if (replace && std::rename(target.c_str(), request->path.c_str()) != 0) {
+        result.error = static_cast<uint32_t>(errno);
+        return;
+    }
+    result.ok = true;
+}
+
+#endif
@@ -0,0 +1,60 @@
+#include "layout_cache.h"
+
+#include <algorithm>
+
+LayoutCache::LayoutCache()
+    : m_useClock(0)
+{
+    m_slots.reserve(LAYOUT_CACHE_ENTRIES);
+}
+
+const LayoutEntry* LayoutCache::Find(const LayoutKey& key) {
+    m_useClock++;
+    for (Slot& slot : m_slots) {
+        if (slot.key == key) {
+            slot.lastUse = m_useClock;
+            m_stats.hits++;
+            return &slot.entry;
+        }
+    }
+    m_stats.misses++;
+    return nullptr;
+}
+
+void LayoutCache::Store(const LayoutKey& key, const LayoutEntry& entry) {
+    m_useClock++;
+    for (Slot& slot : m_slots) {
+        if (slot.key == key) {
+            slot.entry = entry;
+            slot.lastUse = m_useClock;
+            return;
+        }
+    }
+
+    if (m_slots.size() >= LAYOUT_CACHE_ENTRIES) {
+        auto oldest = std::min_element(m_slots.begin(), m_slots.end(),
+            [](const Slot& a, const Slot& b) { return a.lastUse < b.lastUse; });
+        m_slots.erase(oldest);
+    }
+
+    Slot slot;
+    slot.key = key;
+    slot.entry = entry;
+    slot.lastUse = m_useClock;
+    m_slots.push_back(slot);
+}
+
+void LayoutCache::Invalidate() {
+    m_slots.clear();
+    m_stats.invalidations++;
+}
+
+uint64_t LayoutCache::WidthClass(const wchar_t* text, int length, bool foldDigits) {
+    uint64_t hash = Mix(14695981039346656037ull, static_cast<uint64_t>(length));
+    for (int i = 0; i < length; ++i) {
+        wchar_t ch = text[i];
+        if (foldDigits && ch >= L'0' && ch <= L'9') ch = L'0';
+        hash = Mix(hash, static_cast<uint64_t>(ch));
+    }
+    return hash;
+}
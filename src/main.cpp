@@ -5,7 +5,6 @@
 
 // Global state variables
 std::atomic<bool> g_running(false);
-std::atomic<float> g_currentFPS(0.0f);
 std::mutex g_configMutex;
 
 // Global overlay instance
@@ -66,6 +65,7 @@ int wmain(int argc, wchar_t* argv[]) {
     bool menuMode = false;
     bool showHelp = false;
     bool showVersion = false;
+    bool startupBench = false;
     
     for (int i = 1; i < argc; i++) {
         std::wstring arg = argv[i];
@@ -75,6 +75,8 @@ int wmain(int argc, wchar_t* argv[]) {
             showHelp = true;
         } else if (arg == L"--version" || arg == L"-v") {
             showVersion = true;
+        } else if (arg == L"--startup-bench") {
+            startupBench = true;
         }
     }
     
@@ -86,6 +88,7 @@ int wmain(int argc, wchar_t* argv[]) {
         std::wcout << L"  --menu, -m     Launch interactive control panel" << std::endl;
         std::wcout << L"  --help, -h     Show this help message" << std::endl;
         std::wcout << L"  --version, -v  Show version information" << std::endl;
+        std::wcout << L"  --startup-bench Start the overlay, print per-phase startup timings and exit" << std::endl;
         std::wcout << L"  (no args)      Launch FPS overlay directly" << std::endl;
         return 0;
     }
@@ -156,17 +159,22 @@ int wmain(int argc, wchar_t* argv[]) {
         }
         
         Utils::LogInfo(L"FPS Overlay started successfully");
+        
+        if (startupBench) {
+            std::wcout << L"Startup phases:\n" << Utils::Utf8ToWide(g_overlay->GetStartupTimeline().Format());
+            g_overlay->Stop();
+            g_overlay.reset();
+            Utils::ReleaseMutex();
+            return 0;
+        }
+        
         std::wcout << L"FPS Overlay is running. Press Ctrl+C to exit." << std::endl;
         
         g_running = true;
         
-        // Main application loop
-        while (g_running && g_overlay->IsRunning()) {
-            Sleep(100); // Sleep for 100ms to reduce CPU usage
-            
-            // Update the overlay
-            g_overlay->Update();
-        }
+        // Sampling, rendering and maintenance run on the overlay's own
+        // threads; block until Ctrl+C (or a fatal error) stops it
+        g_overlay->WaitForStop();
         
         // Cleanup
         Utils::LogInfo(L"Shutting down FPS Overlay");
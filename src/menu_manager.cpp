@@ -104,10 +104,13 @@ void MenuManager::DisplayHeader() {
     std::wcout << CreateSeparator() << std::endl;
     std::wcout << CenterText(L"FPS MONITOR - CONTROL PANEL") << std::endl;
     std::wcout << CreateSeparator() << std::endl;
-    std::wcout << GetUserInfo() << std::endl;
-    std::wcout << GetComputerInfo() << std::endl;
-    std::wcout << GetSystemInfo() << std::endl;
-    std::wcout << GetTimeZoneInfo() << std::endl;
+    // User, machine, OS and time zone don't change while the menu is open;
+    // look them up on the first draw instead of every redraw
+    if (m_headerInfo.empty()) {
+        m_headerInfo = GetUserInfo() + L"\n" + GetComputerInfo() + L"\n" + GetSystemInfo() + L"\n" +
+                       GetTimeZoneInfo();
+    }
+    std::wcout << m_headerInfo << std::endl;
     std::wcout << CreateSeparator() << std::endl;
     std::wcout << CenterText(L"FOLLOW US: HTTPS://GITHUB.COM/ELCAPITANOE/FPS-MONITOR-WIN") << std::endl;
     std::wcout << CreateSeparator() << std::endl;
@@ -0,0 +1,154 @@
+#include "overlay_painter.h"
+
+#include <algorithm>
+
+OverlayPainter::OverlayPainter()
+    : m_textColor(0)
+    , m_panelColor(0)
+    , m_damagedSurface(nullptr)
+    , m_damagedLayout(0)
+    , m_damagedStyle(0)
+    , m_paintedVersions()
+{
+}
+
+void OverlayPainter::AddFrameTime(float frameTimeMs) {
+    m_graph.AddFrameTime(frameTimeMs);
+    m_heatmap.AddFrameTime(frameTimeMs);
+}
+
+void OverlayPainter::Prepare(const WidgetLayout& layout, const OverlayPaintStyle& style) {
+    m_style = style;
+    m_textColor = Compositor::Premultiply(style.textColor);
+    m_panelColor = style.showBackground ? Compositor::Premultiply(style.backgroundColor) : 0;
+
+    // Bringing the graph and heatmap up to date only plots the columns
+    // completed since the last call
+    for (int i = 0; i < layout.Count(); ++i) {
+        const WidgetCell& cell = layout.Cell(i);
+        if (cell.widget == OverlayWidget::GRAPH) {
+            FrameTimeGraphStyle graph = style.graph;
+            graph.background = m_panelColor;
+            graph.line = m_textColor;
+            m_graph.SetStyle(graph);
+            m_graph.Resize(cell.bounds.width, cell.bounds.height);
+            m_graph.Update();
+        } else if (cell.widget == OverlayWidget::HEATMAP) {
+            FrameTimeHeatmapStyle heatmap = style.heatmap;
+            heatmap.background = m_panelColor;
+            heatmap.color = m_textColor;
+            m_heatmap.SetStyle(heatmap);
+            m_heatmap.Resize(cell.bounds.width, cell.bounds.height);
+            m_heatmap.Update();
+        }
+    }
+}
+
+DamageKind OverlayPainter::Paint(PixelBuffer& surface, const GlyphAtlas* atlas, const WidgetLayout& layout,
+                                 uint64_t styleKey) {
+    int width = std::min(layout.Width(), surface.width);
+    int height = std::min(layout.Height(), surface.height);
+
+    // A new backbuffer, placement or style retains nothing, and then every
+    // widget is reported so the tracker holds what is shown
+    uint64_t style = StyleKey(styleKey);
+    bool everything = surface.pixels != m_damagedSurface || layout.Key() != m_damagedLayout ||
+                      style != m_damagedStyle;
+    if (everything) {
+        m_damage.Invalidate();
+        m_damagedSurface = surface.pixels;
+        m_damagedLayout = layout.Key();
+        m_damagedStyle = style;
+    }
+
+    m_damage.BeginFrame(width, height);
+    for (int i = 0; i < layout.Count(); ++i) {
+        const WidgetCell& cell = layout.Cell(i);
+        if (!cell.IsText()) {
+            uint64_t version = cell.widget == OverlayWidget::GRAPH ? m_graph.Version() : m_heatmap.Version();
+            m_damage.Update(static_cast<size_t>(i), &version, sizeof(version), 0, cell.bounds);
+        } else if (everything || cell.version != m_paintedVersions[i]) {
+            // Text that kept its version isn't even compared: the tracker
+            // still holds it from when it was last reported
+            if (atlas) {
+                m_damage.UpdateText(static_cast<size_t>(i), *atlas, cell.text, cell.length, 0, InkBounds(cell, *atlas),
+                                    cell.bounds.x);
+            } else {
+                m_damage.Update(static_cast<size_t>(i), cell.text, cell.length * sizeof(wchar_t), 0, cell.bounds);
+            }
+            m_paintedVersions[i] = cell.version;
+        }
+    }
+    DamageKind damage = m_damage.EndFrame();
+    if (damage == DamageKind::NONE) return damage;
+
+    PixelBuffer buffer = surface;
+    buffer.width = width;
+    buffer.height = height;
+    if (!atlas) {
+        // The caller's text goes over all of it
+        Compositor::Fill(buffer, 0, 0, width, height, m_panelColor);
+        for (int i = 0; i < layout.Count(); ++i) {
+            const WidgetCell& cell = layout.Cell(i);
+            if (cell.widget == OverlayWidget::GRAPH) {
+                m_graph.Draw(buffer, cell.bounds.x, cell.bounds.y);
+            } else if (cell.widget == OverlayWidget::HEATMAP) {
+                m_heatmap.Draw(buffer, cell.bounds.x, cell.bounds.y);
+            }
+        }
+        return DamageKind::FULL;
+    }
+
+    // Only the dirty rectangles are repainted; the rest of the backbuffer
+    // is still current. Each starts out transparent, then gets its part of
+    // the panel, the text blended over it and the graphs (drawn on the
+    // panel's colour already) copied in, from every widget reaching into it.
+    for (const DamageRect& dirty : m_damage.DirtyRects()) {
+        PixelBuffer clip = buffer;
+        clip.pixels += static_cast<size_t>(dirty.y) * buffer.stride + dirty.x;
+        clip.width = dirty.width;
+        clip.height = dirty.height;
+        Compositor::Fill(clip, 0, 0, dirty.width, dirty.height, 0);
+        if (m_panelColor != 0) {
+            Compositor::FillRoundedRect(clip, -dirty.x, -dirty.y, width, height, m_style.cornerRadius, m_panelColor);
+        }
+        for (int i = 0; i < layout.Count(); ++i) {
+            const WidgetCell& cell = layout.Cell(i);
+            DamageRect reach = cell.IsText() ? InkBounds(cell, *atlas) : cell.bounds;
+            if (DamageRect::Intersect(reach, dirty).IsEmpty()) continue;
+
+            int x = cell.bounds.x - dirty.x;
+            int y = cell.bounds.y - dirty.y;
+            if (cell.widget == OverlayWidget::GRAPH) {
+                m_graph.Draw(clip, x, y);
+            } else if (cell.widget == OverlayWidget::HEATMAP) {
+                m_heatmap.Draw(clip, x, y);
+            } else {
+                Compositor::DrawString(clip, *atlas, x, y, cell.text, cell.length, m_textColor);
+            }
+        }
+    }
+    return damage;
+}
+
+void OverlayPainter::Invalidate() {
+    m_damagedSurface = nullptr;
+}
+
+// Private methods implementation
+uint64_t OverlayPainter::StyleKey(uint64_t styleKey) const {
+    uint64_t key = styleKey;
+    key = key * 1099511628211ull + m_style.textColor;
+    key = key * 1099511628211ull + m_style.backgroundColor;
+    key = key * 1099511628211ull + (m_style.showBackground ? 1u : 0u);
+    key = key * 1099511628211ull + static_cast<uint32_t>(m_style.cornerRadius);
+    return key;
+}
+
+DamageRect OverlayPainter::InkBounds(const WidgetCell& cell, const GlyphAtlas& atlas) {
+    // Glyph ink can reach past the advances on either side
+    DamageRect bounds = cell.bounds;
+    bounds.x -= atlas.Overhang();
+    bounds.width += 2 * atlas.Overhang();
+    return bounds;
+}
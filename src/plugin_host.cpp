@@ -0,0 +1,341 @@
+#include "plugin_host.h"
+#include "activity_governor.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <system_error>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+// Sinks receive the pipeline's batches in place, so the ABI frame must be
+// the pipeline's frame
+static_assert(sizeof(FpsFrame) == sizeof(NormalizedFrame), "FpsFrame must match NormalizedFrame");
+static_assert(offsetof(FpsFrame, timestampNs) == offsetof(NormalizedFrame, timestampNs) &&
+              offsetof(FpsFrame, frameTime) == offsetof(NormalizedFrame, frameTime) &&
+              offsetof(FpsFrame, sourceId) == offsetof(NormalizedFrame, sourceId),
+              "FpsFrame must match NormalizedFrame");
+
+namespace {
+#if defined(_WIN32)
+    const char* LIBRARY_EXTENSION = ".dll";
+
+    void* OpenLibrary(const std::filesystem::path& file, std::string& error) {
+        // Altered search path: the plugin's own dependencies resolve next to it
+        HMODULE module = LoadLibraryExW(file.c_str(), nullptr, LOAD_WITH_ALTERED_SEARCH_PATH);
+        if (!module) error = "LoadLibrary failed (error " + std::to_string(GetLastError()) + ")";
+        return module;
+    }
+
+    void* FindSymbol(void* library, const char* name) {
+        return reinterpret_cast<void*>(GetProcAddress(static_cast<HMODULE>(library), name));
+    }
+
+    void CloseLibrary(void* library) {
+        FreeLibrary(static_cast<HMODULE>(library));
+    }
+#else
+#if defined(__APPLE__)
+    const char* LIBRARY_EXTENSION = ".dylib";
+#else
+    const char* LIBRARY_EXTENSION = ".so";
+#endif
+
+    void* OpenLibrary(const std::filesystem::path& file, std::string& error) {
+        void* library = dlopen(file.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (!library) {
+            const char* reason = dlerror();
+            error = reason ? reason : "dlopen failed";
+        }
+        return library;
+    }
+
+    void* FindSymbol(void* library, const char* name) {
+        return dlsym(library, name);
+    }
+
+    void CloseLibrary(void* library) {
+        dlclose(library);
+    }
+#endif
+
+    std::string PathToUtf8(const std::filesystem::path& path) {
+        auto utf8 = path.u8string();
+        return std::string(utf8.begin(), utf8.end());
+    }
+}
+
+PluginSink::PluginSink(const FpsSinkV1& sink)
+    : m_sink(sink), m_name(sink.name ? sink.name : "unnamed") {}
+
+void PluginSink::Consume(const FrameStats& stats) {
+    if (!m_sink.consume_stats) return;
+    FpsStats out = ToPluginStats(stats);
+    m_sink.consume_stats(m_sink.context, &out);
+}
+
+void PluginSink::ConsumeBatch(const FrameBatchRef& batch) {
+    FpsFrameBatch out = {};
+    out.size = sizeof(out);
+    out.count = static_cast<uint32_t>(batch->Count());
+    out.sequence = batch->Sequence();
+    out.frames = reinterpret_cast<const FpsFrame*>(batch->Frames());
+    m_sink.consume_batch(m_sink.context, &out);
+}
+
+FpsStats ToPluginStats(const FrameStats& stats) {
+    FpsStats out = {};
+    out.size = sizeof(out);
+    out.fps = stats.fps;
+    out.frameTimeMs = stats.frameTimeMs;
+    out.minFrameTimeMs = stats.minFrameTimeMs;
+    out.maxFrameTimeMs = stats.maxFrameTimeMs;
+    out.low1Fps = stats.low1Fps;
+    out.low01Fps = stats.low01Fps;
+    out.frameCount = stats.frameCount;
+    out.hitchCount = stats.hitchCount;
+    out.sequence = stats.sequence;
+    out.timestampNs = stats.timestampNs;
+    out.sourceId = stats.sourceId;
+    return out;
+}
+
+struct PluginHost::Source {
+    FpsSourceV1 source;
+    std::string name;
+    uint32_t id = 0;
+    bool started = false;
+};
+
+struct PluginHost::Plugin {
+    std::filesystem::path path;
+    std::string name;
+    void* library = nullptr;
+    FpsPluginShutdownFn shutdown = nullptr;
+    std::vector<std::unique_ptr<PluginSink>> sinks;
+    std::vector<Source> sources;
+};
+
+PluginHost::PluginHost(FramePipeline& pipeline, ActivityGovernor* activity)
+    : m_pipeline(pipeline)
+    , m_activity(activity)
+    , m_loading(nullptr)
+    , m_nextSourceId(FRAME_SOURCE_PLUGIN_FIRST)
+    , m_sourcesStarted(false)
+{
+    std::memset(&m_api, 0, sizeof(m_api));
+    m_api.size = sizeof(m_api);
+    m_api.abiVersion = FPS_PLUGIN_ABI_VERSION;
+    m_api.host = this;
+    m_api.register_sink = &PluginHost::RegisterSink;
+    m_api.register_source = &PluginHost::RegisterSource;
+    m_api.submit_presents = &PluginHost::SubmitPresents;
+    m_api.now_ns = &PluginHost::NowNs;
+    m_api.log = &PluginHost::PluginLog;
+}
+
+PluginHost::~PluginHost() {
+    Unload();
+}
+
+size_t PluginHost::LoadDirectory(const std::filesystem::path& directory, BackpressurePolicy sinkPolicy) {
+    std::error_code error;
+    if (!std::filesystem::is_directory(directory, error)) return 0;
+
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        if (entry.is_regular_file(error) && entry.path().extension() == LIBRARY_EXTENSION) {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    size_t loaded = 0;
+    for (const auto& file : files) {
+        if (Load(file, sinkPolicy)) ++loaded;
+    }
+    return loaded;
+}
+
+bool PluginHost::Load(const std::filesystem::path& file, BackpressurePolicy sinkPolicy) {
+    auto plugin = std::make_unique<Plugin>();
+    plugin->path = file;
+    plugin->name = PathToUtf8(file.filename());
+
+    if (m_pipeline.IsRunning()) {
+        Log(FPS_PLUGIN_LOG_ERROR, plugin->name + ": plugins must be loaded before the pipeline starts");
+        return false;
+    }
+
+    std::string error;
+    plugin->library = OpenLibrary(file, error);
+    if (!plugin->library) {
+        Log(FPS_PLUGIN_LOG_ERROR, plugin->name + ": " + error);
+        return false;
+    }
+
+    auto abiVersion = reinterpret_cast<FpsPluginAbiVersionFn>(FindSymbol(plugin->library, FPS_PLUGIN_ABI_VERSION_SYMBOL));
+    auto init = reinterpret_cast<FpsPluginInitFn>(FindSymbol(plugin->library, FPS_PLUGIN_INIT_SYMBOL));
+    plugin->shutdown = reinterpret_cast<FpsPluginShutdownFn>(FindSymbol(plugin->library, FPS_PLUGIN_SHUTDOWN_SYMBOL));
+    if (!abiVersion || !init || !plugin->shutdown) {
+        Log(FPS_PLUGIN_LOG_ERROR, plugin->name + ": not a plugin (missing fps_plugin_* exports)");
+        CloseLibrary(plugin->library);
+        return false;
+    }
+
+    uint32_t version = abiVersion();
+    if (version != FPS_PLUGIN_ABI_VERSION) {
+        Log(FPS_PLUGIN_LOG_ERROR, plugin->name + ": built for plugin ABI " + std::to_string(version) +
+                                  ", expected " + std::to_string(FPS_PLUGIN_ABI_VERSION));
+        CloseLibrary(plugin->library);
+        return false;
+    }
+
+    // Registrations are only collected here; nothing reaches the pipeline
+    // unless init succeeds
+    uint32_t firstSourceId = m_nextSourceId;
+    m_loading = plugin.get();
+    int result = init(&m_api);
+    m_loading = nullptr;
+
+    if (result != FPS_PLUGIN_OK) {
+        Log(FPS_PLUGIN_LOG_ERROR, plugin->name + ": fps_plugin_init failed (" + std::to_string(result) + ")");
+        m_nextSourceId = firstSourceId;
+        plugin->sinks.clear();
+        CloseLibrary(plugin->library);
+        return false;
+    }
+
+    for (const auto& sink : plugin->sinks) {
+        m_pipeline.AddSink(sink.get(), sinkPolicy);
+    }
+    Log(FPS_PLUGIN_LOG_INFO, "Loaded plugin " + plugin->name + " (" + std::to_string(plugin->sinks.size()) +
+                             " sinks, " + std::to_string(plugin->sources.size()) + " sources)");
+    m_plugins.push_back(std::move(plugin));
+    return true;
+}
+
+void PluginHost::StartSources() {
+    if (m_sourcesStarted) return;
+    m_sourcesStarted = true;
+
+    for (auto& plugin : m_plugins) {
+        for (Source& source : plugin->sources) {
+            int result = source.source.start(source.source.context, source.id);
+            source.started = result == FPS_PLUGIN_OK;
+            if (!source.started) {
+                Log(FPS_PLUGIN_LOG_WARNING, plugin->name + ": source " + source.name + " failed to start (" +
+                                            std::to_string(result) + ")");
+            }
+        }
+    }
+}
+
+void PluginHost::StopSources() {
+    if (!m_sourcesStarted) return;
+    m_sourcesStarted = false;
+
+    for (auto plugin = m_plugins.rbegin(); plugin != m_plugins.rend(); ++plugin) {
+        for (auto source = (*plugin)->sources.rbegin(); source != (*plugin)->sources.rend(); ++source) {
+            if (!source->started) continue;
+            source->source.stop(source->source.context);
+            source->started = false;
+        }
+    }
+}
+
+void PluginHost::Unload() {
+    if (m_plugins.empty()) return;
+
+    StopSources();
+
+    // Sink threads call straight into the libraries
+    if (m_pipeline.IsRunning()) {
+        m_pipeline.Stop();
+    }
+
+    while (!m_plugins.empty()) {
+        std::unique_ptr<Plugin> plugin = std::move(m_plugins.back());
+        m_plugins.pop_back();
+        plugin->shutdown();
+        plugin->sinks.clear();
+        CloseLibrary(plugin->library);
+    }
+}
+
+std::vector<PluginInfo> PluginHost::GetPlugins() const {
+    std::vector<PluginInfo> plugins;
+    for (const auto& plugin : m_plugins) {
+        PluginInfo info;
+        info.path = plugin->path;
+        for (const auto& sink : plugin->sinks) info.sinks.push_back(sink->Name());
+        for (const Source& source : plugin->sources) info.sources.push_back(source.name);
+        plugins.push_back(std::move(info));
+    }
+    return plugins;
+}
+
+std::vector<IFrameSink*> PluginHost::GetSinks() const {
+    std::vector<IFrameSink*> sinks;
+    for (const auto& plugin : m_plugins) {
+        for (const auto& sink : plugin->sinks) sinks.push_back(sink.get());
+    }
+    return sinks;
+}
+
+void PluginHost::Log(int level, const std::string& message) const {
+    if (m_log) m_log(level, message);
+}
+
+int PluginHost::RegisterSink(void* host, const FpsSinkV1* sink) {
+    auto* self = static_cast<PluginHost*>(host);
+    if (!self->m_loading || !sink) return FPS_PLUGIN_ERROR;
+
+    FpsSinkV1 copy = CopyVersioned(sink);
+    if (!copy.consume_batch) return FPS_PLUGIN_ERROR;
+
+    self->m_loading->sinks.push_back(std::make_unique<PluginSink>(copy));
+    return FPS_PLUGIN_OK;
+}
+
+int PluginHost::RegisterSource(void* host, const FpsSourceV1* source) {
+    auto* self = static_cast<PluginHost*>(host);
+    if (!self->m_loading || !source) return FPS_PLUGIN_ERROR;
+
+    FpsSourceV1 copy = CopyVersioned(source);
+    if (!copy.start || !copy.stop) return FPS_PLUGIN_ERROR;
+    if (self->m_nextSourceId >= MAX_FRAME_SOURCES) return FPS_PLUGIN_UNSUPPORTED;
+
+    Source entry;
+    entry.source = copy;
+    entry.name = copy.name ? copy.name : "unnamed";
+    entry.id = self->m_nextSourceId++;
+    self->m_loading->sources.push_back(std::move(entry));
+    return FPS_PLUGIN_OK;
+}
+
+uint32_t PluginHost::SubmitPresents(void* host, uint32_t sourceId, const uint64_t* timestampsNs, uint32_t count) {
+    auto* self = static_cast<PluginHost*>(host);
+    if (!timestampsNs || sourceId < FRAME_SOURCE_PLUGIN_FIRST || sourceId >= self->m_nextSourceId) return 0;
+
+    uint32_t accepted = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (self->m_pipeline.PushPresent(timestampsNs[i], sourceId)) ++accepted;
+    }
+    if (accepted && self->m_activity) {
+        self->m_activity->NotifyActivity(timestampsNs[count - 1]);
+    }
+    return accepted;
+}
+
+uint64_t PluginHost::NowNs(void*) {
+    return MonotonicNowNs();
+}
+
+void PluginHost::PluginLog(void* host, int level, const char* message) {
+    static_cast<PluginHost*>(host)->Log(level, message ? message : "");
+}
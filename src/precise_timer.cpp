@@ -0,0 +1,259 @@
+#include "precise_timer.h"
+#include "frame_types.h"
+
+#include <algorithm>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#else
+#include <cerrno>
+#include <time.h>
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h>
+#define PACING_CPU_RELAX() _mm_pause()
+#else
+#define PACING_CPU_RELAX() std::this_thread::yield()
+#endif
+
+// JitterMeter implementation
+JitterMeter::JitterMeter() {
+    Reset();
+}
+
+void JitterMeter::Record(uint64_t latenessNs) {
+    // Single writer, so the max update needs no CAS loop; readers only
+    // need each counter to be untorn
+    m_buckets[BucketFor(latenessNs)].fetch_add(1, std::memory_order_relaxed);
+    m_samples.fetch_add(1, std::memory_order_relaxed);
+    m_totalNs.fetch_add(latenessNs, std::memory_order_relaxed);
+    if (latenessNs > m_maxNs.load(std::memory_order_relaxed)) {
+        m_maxNs.store(latenessNs, std::memory_order_relaxed);
+    }
+}
+
+void JitterMeter::RecordMissed(uint64_t periods) {
+    m_missed.fetch_add(periods, std::memory_order_relaxed);
+}
+
+void JitterMeter::Reset() {
+    for (auto& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_samples.store(0, std::memory_order_relaxed);
+    m_totalNs.store(0, std::memory_order_relaxed);
+    m_maxNs.store(0, std::memory_order_relaxed);
+    m_missed.store(0, std::memory_order_relaxed);
+}
+
+JitterStats JitterMeter::GetStats() const {
+    JitterStats stats;
+    stats.samples = m_samples.load(std::memory_order_relaxed);
+    stats.missedDeadlines = m_missed.load(std::memory_order_relaxed);
+    stats.maxUs = m_maxNs.load(std::memory_order_relaxed) / 1000.0f;
+    if (stats.samples == 0) return stats;
+
+    stats.meanUs = static_cast<float>(
+        m_totalNs.load(std::memory_order_relaxed) / 1000.0 / stats.samples);
+
+    // Counts can move while we walk the buckets; percentiles are taken
+    // against the total seen in this pass
+    uint64_t counts[BUCKET_COUNT];
+    uint64_t total = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        counts[i] = m_buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+
+    uint64_t p50Target = (total * 50 + 99) / 100;
+    uint64_t p99Target = (total * 99 + 99) / 100;
+    uint64_t running = 0;
+    bool p50Found = false;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        running += counts[i];
+        if (!p50Found && running >= p50Target) {
+            stats.p50Us = BucketUpperNs(i) / 1000.0f;
+            p50Found = true;
+        }
+        if (running >= p99Target) {
+            stats.p99Us = BucketUpperNs(i) / 1000.0f;
+            break;
+        }
+    }
+
+    // Bucket upper bounds can exceed the exact maximum
+    stats.p50Us = std::min(stats.p50Us, stats.maxUs);
+    stats.p99Us = std::min(stats.p99Us, stats.maxUs);
+    return stats;
+}
+
+size_t JitterMeter::BucketFor(uint64_t ns) {
+    // Values below 2^SUB_BUCKET_BITS map 1:1; above that, the leading bit
+    // selects the octave and the next SUB_BUCKET_BITS bits the sub-bucket
+    if (ns < (1u << SUB_BUCKET_BITS)) return static_cast<size_t>(ns);
+
+    size_t octave = 63;
+    while (!(ns >> octave)) --octave;
+    size_t sub = static_cast<size_t>(ns >> (octave - SUB_BUCKET_BITS)) & ((1u << SUB_BUCKET_BITS) - 1);
+    return ((octave - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS) + sub;
+}
+
+uint64_t JitterMeter::BucketUpperNs(size_t bucket) {
+    if (bucket < (1u << SUB_BUCKET_BITS)) return bucket;
+
+    size_t octave = (bucket >> SUB_BUCKET_BITS) + SUB_BUCKET_BITS - 1;
+    uint64_t sub = bucket & ((1u << SUB_BUCKET_BITS) - 1);
+    uint64_t step = 1ull << (octave - SUB_BUCKET_BITS);
+    return (1ull << octave) + (sub + 1) * step - 1;
+}
+
+// PreciseTimer implementation
+PreciseTimer::PreciseTimer(PacingMode mode, uint32_t spinThresholdUs, uint64_t periodNs)
+    : m_mode(mode)
+    , m_spinThresholdUs(std::min<uint32_t>(spinThresholdUs, PACING_MAX_SPIN_US))
+    , m_timer(nullptr)
+    , m_highResolution(false)
+    , m_overshootNs(0)
+    , m_maxMarginNs(PACING_MAX_SPIN_US * 1000ull)
+{
+    if (periodNs > 0) {
+        m_maxMarginNs = std::min(m_maxMarginNs, periodNs / 2);
+    }
+
+#ifdef _WIN32
+    m_timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                                     TIMER_ALL_ACCESS);
+    m_highResolution = m_timer != nullptr;
+    if (!m_timer) {
+        // Older than Windows 10 1803: fall back to a regular timer
+        m_timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+    }
+#else
+    m_highResolution = true;
+#endif
+
+    // A 15.6 ms timer would have HYBRID spin for most of every period
+    if (m_mode == PacingMode::HYBRID && !m_highResolution) {
+        m_mode = PacingMode::COARSE;
+    }
+}
+
+PreciseTimer::~PreciseTimer() {
+#ifdef _WIN32
+    if (m_timer) {
+        CloseHandle(static_cast<HANDLE>(m_timer));
+    }
+#endif
+}
+
+uint64_t PreciseTimer::SleepUntil(uint64_t deadlineNs) {
+    switch (m_mode) {
+        case PacingMode::COARSE:
+            CoarseSleepUntil(deadlineNs);
+            break;
+
+        case PacingMode::HYBRID: {
+            uint64_t margin = std::max<uint64_t>(m_spinThresholdUs * 1000ull, m_overshootNs);
+            margin = std::min(margin, m_maxMarginNs);
+            bool slept = false;
+            if (deadlineNs > margin) {
+                uint64_t wakeTarget = deadlineNs - margin;
+                if (MonotonicNowNs() < wakeTarget) {
+                    CoarseSleepUntil(wakeTarget);
+                    slept = true;
+
+                    // Track how far past its target the OS woke us
+                    uint64_t now = MonotonicNowNs();
+                    uint64_t overshoot = now > wakeTarget ? now - wakeTarget : 0;
+                    overshoot = std::min(overshoot + overshoot / 4, m_maxMarginNs);
+                    if (overshoot > m_overshootNs) {
+                        m_overshootNs = overshoot;
+                    } else {
+                        m_overshootNs -= (m_overshootNs - overshoot) / 16;
+                    }
+                }
+            }
+            if (!slept) {
+                // Nothing to measure (the deadline was already inside the
+                // margin); decay anyway so a late wake can't pin us spinning
+                m_overshootNs -= m_overshootNs / 16;
+            }
+            SpinUntil(deadlineNs, false);
+            break;
+        }
+
+        case PacingMode::SPIN:
+            SpinUntil(deadlineNs, true);
+            break;
+    }
+    return MonotonicNowNs();
+}
+
+void PreciseTimer::CoarseSleepUntil(uint64_t deadlineNs) {
+#ifdef _WIN32
+    uint64_t now = MonotonicNowNs();
+    if (now >= deadlineNs) return;
+
+    if (m_timer) {
+        // Negative due time = relative, in 100 ns units
+        LARGE_INTEGER dueTime;
+        dueTime.QuadPart = -static_cast<LONGLONG>((deadlineNs - now) / 100);
+        if (SetWaitableTimer(static_cast<HANDLE>(m_timer), &dueTime, 0, nullptr, nullptr, FALSE)) {
+            WaitForSingleObject(static_cast<HANDLE>(m_timer), INFINITE);
+            return;
+        }
+    }
+    Sleep(static_cast<DWORD>((deadlineNs - now) / 1000000));
+#else
+    // steady_clock (MonotonicNowNs) is CLOCK_MONOTONIC on Linux, so the
+    // absolute deadline can be handed to the kernel directly
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(deadlineNs / 1000000000ull);
+    ts.tv_nsec = static_cast<long>(deadlineNs % 1000000000ull);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+    }
+#endif
+}
+
+void PreciseTimer::SpinUntil(uint64_t deadlineNs, bool yield) {
+    while (MonotonicNowNs() < deadlineNs) {
+        if (yield) {
+            std::this_thread::yield();
+        } else {
+            PACING_CPU_RELAX();
+        }
+    }
+}
+
+// FramePacer implementation
+FramePacer::FramePacer(uint64_t periodNs, PacingMode mode, uint32_t spinThresholdUs)
+    : m_timer(mode, spinThresholdUs, std::max<uint64_t>(1, periodNs))
+    , m_periodNs(std::max<uint64_t>(1, periodNs))
+    , m_nextDeadlineNs(0)
+{
+    Reset();
+}
+
+uint64_t FramePacer::Wait() {
+    uint64_t wake = m_timer.SleepUntil(m_nextDeadlineNs);
+    m_jitter.Record(wake - m_nextDeadlineNs);
+
+    // Next deadline follows the previous one; if we already overran it,
+    // skip whole periods instead of firing back-to-back to catch up
+    m_nextDeadlineNs += m_periodNs;
+    if (wake >= m_nextDeadlineNs) {
+        uint64_t missed = (wake - m_nextDeadlineNs) / m_periodNs + 1;
+        m_nextDeadlineNs += missed * m_periodNs;
+        m_jitter.RecordMissed(missed);
+    }
+    return wake;
+}
+
+void FramePacer::Reset() {
+    m_nextDeadlineNs = MonotonicNowNs() + m_periodNs;
+}
@@ -0,0 +1,181 @@
+#include "render_resources.h"
+
+#include <algorithm>
+
+RenderResourceCache::RenderResourceCache(IRenderResourceBackend& backend)
+    : m_backend(backend)
+    , m_dpi(RENDER_DEFAULT_DPI)
+    , m_useClock(0)
+{
+    m_fonts.reserve(RENDER_MAX_CACHED_FONTS);
+    m_brushes.reserve(RENDER_MAX_CACHED_BRUSHES);
+}
+
+RenderResourceCache::~RenderResourceCache() {
+    Invalidate();
+}
+
+const RenderSurface* RenderResourceCache::Surface(int width, int height) {
+    if (width <= 0 || height <= 0) return nullptr;
+
+    if (m_surface.pixels && m_surface.width >= width && m_surface.height >= height) {
+        m_stats.surfaceHits++;
+        return &m_surface;
+    }
+
+    // Grow to cover both the old and the new size, so alternating between
+    // a wide and a tall request doesn't rebuild every time
+    int newWidth = std::max(width, m_surface.width);
+    int newHeight = std::max(height, m_surface.height);
+    if (m_surface.pixels) {
+        m_backend.DestroySurface(m_surface);
+        m_surface = RenderSurface();
+    }
+
+    m_stats.surfaceCreates++;
+    if (!m_backend.CreateSurface(newWidth, newHeight, m_surface)) {
+        m_surface = RenderSurface();
+        return nullptr;
+    }
+    return &m_surface;
+}
+
+RenderHandle RenderResourceCache::Font(const std::wstring& name, int size) {
+    m_useClock++;
+    for (FontEntry& entry : m_fonts) {
+        if (entry.size == size && entry.name == name) {
+            entry.lastUse = m_useClock;
+            m_stats.fontHits++;
+            return entry.handle;
+        }
+    }
+
+    m_stats.fontCreates++;
+    int pixelHeight = (size * m_dpi + RENDER_DEFAULT_DPI / 2) / RENDER_DEFAULT_DPI;
+    RenderHandle handle = m_backend.CreateFontFace(name, pixelHeight);
+    if (!handle) return nullptr;
+
+    if (m_fonts.size() >= RENDER_MAX_CACHED_FONTS) {
+        auto oldest = std::min_element(m_fonts.begin(), m_fonts.end(),
+            [](const FontEntry& a, const FontEntry& b) { return a.lastUse < b.lastUse; });
+        m_backend.DestroyFontFace(oldest->handle);
+        m_fonts.erase(oldest);
+    }
+
+    FontEntry entry;
+    entry.name = name;
+    entry.size = size;
+    entry.handle = handle;
+    entry.lastUse = m_useClock;
+    m_fonts.push_back(std::move(entry));
+    return handle;
+}
+
+RenderHandle RenderResourceCache::Brush(uint32_t rgb) {
+    m_useClock++;
+    for (BrushEntry& entry : m_brushes) {
+        if (entry.rgb == rgb) {
+            entry.lastUse = m_useClock;
+            m_stats.brushHits++;
+            return entry.handle;
+        }
+    }
+
+    m_stats.brushCreates++;
+    RenderHandle handle = m_backend.CreateBrush(rgb);
+    if (!handle) return nullptr;
+
+    if (m_brushes.size() >= RENDER_MAX_CACHED_BRUSHES) {
+        auto oldest = std::min_element(m_brushes.begin(), m_brushes.end(),
+            [](const BrushEntry& a, const BrushEntry& b) { return a.lastUse < b.lastUse; });
+        m_backend.DestroyBrush(oldest->handle);
+        m_brushes.erase(oldest);
+    }
+
+    BrushEntry entry;
+    entry.rgb = rgb;
+    entry.handle = handle;
+    entry.lastUse = m_useClock;
+    m_brushes.push_back(entry);
+    return handle;
+}
+
+void RenderResourceCache::SetDpi(int dpi) {
+    if (dpi <= 0) dpi = RENDER_DEFAULT_DPI;
+    if (dpi == m_dpi) return;
+
+    m_dpi = dpi;
+    ReleaseFonts();
+    m_stats.invalidations++;
+}
+
+void RenderResourceCache::Invalidate() {
+    if (m_surface.pixels) {
+        m_backend.DestroySurface(m_surface);
+        m_surface = RenderSurface();
+    }
+    ReleaseFonts();
+    ReleaseBrushes();
+    m_stats.invalidations++;
+}
+
+// Private methods implementation
+void RenderResourceCache::ReleaseFonts() {
+    for (FontEntry& entry : m_fonts) {
+        m_backend.DestroyFontFace(entry.handle);
+    }
+    m_fonts.clear();
+}
+
+void RenderResourceCache::ReleaseBrushes() {
+    for (BrushEntry& entry : m_brushes) {
+        m_backend.DestroyBrush(entry.handle);
+    }
+    m_brushes.clear();
+}
+
+// Headless backend
+namespace {
+    // What a headless font or brush handle points at
+    struct HeadlessObject {
+        uint32_t value;
+    };
+}
+
+bool HeadlessRenderBackend::CreateSurface(int width, int height, RenderSurface& surface) {
+    surface.pixels = new uint32_t[static_cast<size_t>(width) * height]();
+    surface.handle = surface.pixels;
+    surface.width = width;
+    surface.height = height;
+    m_creates++;
+    m_live++;
+    return true;
+}
+
+void HeadlessRenderBackend::DestroySurface(RenderSurface& surface) {
+    delete[] surface.pixels;
+    surface = RenderSurface();
+    m_live--;
+}
+
+RenderHandle HeadlessRenderBackend::CreateFontFace(const std::wstring& name, int pixelHeight) {
+    m_creates++;
+    m_live++;
+    return new HeadlessObject{static_cast<uint32_t>(name.size() * 131 + pixelHeight)};
+}
+
+void HeadlessRenderBackend::DestroyFontFace(RenderHandle font) {
+    delete static_cast<HeadlessObject*>(font);
+    m_live--;
+}
+
+RenderHandle HeadlessRenderBackend::CreateBrush(uint32_t rgb) {
+    m_creates++;
+    m_live++;
+    return new HeadlessObject{rgb};
+}
+
+void HeadlessRenderBackend::DestroyBrush(RenderHandle brush) {
+    delete static_cast<HeadlessObject*>(brush);
+    m_live--;
+}
@@ -0,0 +1,178 @@
+#include "render_thread.h"
+#include "config_manager.h"
+#include "utils.h"
+
+// Frame times waiting for the graph and heatmap: a few seconds at high frame rates,
+// drained on every draw
+static const size_t RENDER_FRAME_TIME_CAPACITY = 4096;
+
+RenderThread::RenderThread(const ConfigManager& configManager)
+    : m_configManager(configManager)
+    , m_running(false)
+    , m_stopping(false)
+    , m_wakeEvent(nullptr)
+    , m_frameTimes(RENDER_FRAME_TIME_CAPACITY)
+    , m_published(0)
+    , m_rendered(0)
+    , m_superseded(0)
+    , m_unchanged(0)
+    , m_partial(0)
+    , m_graphDropped(0)
+{
+}
+
+RenderThread::~RenderThread() {
+    Stop();
+}
+
+bool RenderThread::Start() {
+    if (m_running) return true;
+
+    m_wakeEvent = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+    if (!m_wakeEvent) {
+        Utils::LogError(L"Failed to create render wake event: " + Utils::GetLastErrorString());
+        return false;
+    }
+
+    // The window must be created on the thread that pumps its messages, so
+    // wait here for the render thread to report how that went
+    std::promise<bool> started;
+    std::future<bool> result = started.get_future();
+    m_stopping = false;
+    m_thread = std::thread(&RenderThread::RenderLoop, this, &started);
+
+    if (!result.get()) {
+        m_thread.join();
+        CloseHandle(static_cast<HANDLE>(m_wakeEvent));
+        m_wakeEvent = nullptr;
+        return false;
+    }
+
+    m_running = true;
+    return true;
+}
+
+void RenderThread::Stop() {
+    if (!m_thread.joinable()) return;
+
+    m_stopping = true;
+    SetEvent(static_cast<HANDLE>(m_wakeEvent));
+    m_thread.join();
+    m_running = false;
+
+    CloseHandle(static_cast<HANDLE>(m_wakeEvent));
+    m_wakeEvent = nullptr;
+}
+
+void RenderThread::Publish(const FrameStats& stats) {
+    RenderSnapshot& snapshot = m_snapshots.Back();
+    snapshot.stats = stats;
+    snapshot.publishedNs = MonotonicNowNs();
+    if (m_snapshots.Publish()) {
+        m_superseded.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_published.fetch_add(1, std::memory_order_relaxed);
+
+    if (m_wakeEvent) {
+        SetEvent(static_cast<HANDLE>(m_wakeEvent));
+    }
+}
+
+void RenderThread::ConsumeBatch(const FrameBatchRef& batch) {
+    // Dropped rather than waited for; a full queue means nothing is drawing
+    uint64_t dropped = 0;
+    for (size_t i = 0; i < batch->Count(); ++i) {
+        if (!m_frameTimes.TryPush((*batch)[i].frameTime * 1000.0f)) {
+            ++dropped;
+        }
+    }
+    if (dropped) {
+        m_graphDropped.fetch_add(dropped, std::memory_order_relaxed);
+    }
+}
+
+RenderThreadStats RenderThread::GetStats() const {
+    RenderThreadStats stats;
+    stats.published = m_published.load(std::memory_order_relaxed);
+    stats.rendered = m_rendered.load(std::memory_order_relaxed);
+    stats.superseded = m_superseded.load(std::memory_order_relaxed);
+    stats.unchanged = m_unchanged.load(std::memory_order_relaxed);
+    stats.partial = m_partial.load(std::memory_order_relaxed);
+    stats.graphDropped = m_graphDropped.load(std::memory_order_relaxed);
+    stats.renderTime = m_renderTime.GetStats();
+    stats.snapshotAge = m_snapshotAge.GetStats();
+    return stats;
+}
+
+// Private methods implementation
+void RenderThread::RenderLoop(std::promise<bool>* started) {
+    const OverlayConfig& config = m_configManager.GetConfig();
+    if (!ThreadAffinity::ApplyToCurrentThread(config.renderAffinityMask, config.renderPriority)) {
+        Utils::LogWarning(L"Could not apply render thread affinity/priority");
+    }
+
+    m_renderer = std::make_unique<Renderer>();
+    if (!m_renderer->Initialize(GraphicsAPI::UNKNOWN)) {
+        m_renderer.reset();
+        started->set_value(false);
+        return;
+    }
+    started->set_value(true);  // `started` is gone after this
+    Utils::LogInfo(L"Render thread started");
+
+    HANDLE wakeEvent = static_cast<HANDLE>(m_wakeEvent);
+    while (!m_stopping) {
+        // Sleep until a snapshot arrives or the window gets a message
+        DWORD result = MsgWaitForMultipleObjectsEx(1, &wakeEvent, INFINITE, QS_ALLINPUT,
+                                                   MWMO_INPUTAVAILABLE);
+        if (result == WAIT_FAILED) {
+            Utils::LogError(L"Render thread wait failed: " + Utils::GetLastErrorString());
+            break;
+        }
+
+        if (!PumpMessages()) break;
+        DrawNewest();
+    }
+
+    // The window belongs to this thread, so it is destroyed here too
+    m_renderer->Cleanup();
+    m_renderer.reset();
+    Utils::LogInfo(L"Render thread stopped");
+}
+
+bool RenderThread::PumpMessages() {
+    MSG msg;
+    while (PeekMessageW(&msg, nullptr, 0, 0, PM_REMOVE)) {
+        if (msg.message == WM_QUIT) return false;
+        TranslateMessage(&msg);
+        DispatchMessageW(&msg);
+    }
+    return true;
+}
+
+void RenderThread::DrawNewest() {
+    if (!m_snapshots.Acquire()) return;
+
+    const RenderSnapshot& snapshot = m_snapshots.Front();
+    uint64_t start = MonotonicNowNs();
+    m_snapshotAge.Record(start > snapshot.publishedNs ? start - snapshot.publishedNs : 0);
+
+    // Even while hidden, so the graphs are current when they show again
+    float frameTimeMs;
+    while (m_frameTimes.TryPop(frameTimeMs)) {
+        m_renderer->AddFrameTime(frameTimeMs);
+    }
+
+    const OverlayConfig& config = m_configManager.GetConfig();
+    if (config.enabled && m_renderer->IsInitialized()) {
+        DamageKind damage = m_renderer->RenderOverlay(snapshot.stats, config);
+        if (damage == DamageKind::NONE) {
+            m_unchanged.fetch_add(1, std::memory_order_relaxed);
+        } else if (damage == DamageKind::PARTIAL) {
+            m_partial.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    m_renderTime.Record(MonotonicNowNs() - start);
+    m_rendered.fetch_add(1, std::memory_order_relaxed);
+}
@@ -1,11 +1,16 @@
 #include "renderer.h"
 #include "utils.h"
-#include <sstream>
-#include <iomanip>
 
 // Window class name for overlay
 #define OVERLAY_CLASS_NAME L"FPSOverlayWindow"
 
+// Draws between looks at which monitor the target window is on
+#define MONITOR_RECHECK_DRAWS 60
+
+#ifndef WM_DPICHANGED
+#define WM_DPICHANGED 0x02E0
+#endif
+
 Renderer::Renderer()
     : m_initialized(false)
     , m_currentAPI(GraphicsAPI::UNKNOWN)
@@ -19,7 +24,13 @@ Renderer::Renderer()
     , m_glHDC(nullptr)
     , m_glContext(nullptr)
     , m_glFont(nullptr)
-    , m_font(nullptr)
+    , m_fontNameHash(0)
+    , m_atlasFontSize(0)
+    , m_atlasDpi(0)
+    , m_monitor(nullptr)
+    , m_monitorRect()
+    , m_targetWindow(nullptr)
+    , m_monitorChecks(0)
     , m_overlayWindow(nullptr)
 {
 }
@@ -45,6 +56,16 @@ bool Renderer::Initialize(GraphicsAPI api, void* device) {
         return false;
     }
     
+    // Created on the render thread and kept until Cleanup()
+    m_gdi = std::make_unique<GdiRenderBackend>();
+    m_resources = std::make_unique<RenderResourceCache>(*m_gdi);
+    m_resources->SetDpi(m_gdi->QueryDpi());
+    m_painter = std::make_unique<OverlayPainter>();
+    m_layouts = std::make_unique<LayoutCache>();
+    m_widgets = std::make_unique<WidgetLayout>();
+    m_monitor = nullptr;
+    m_targetWindow = nullptr;
+    
     m_initialized = true;
     Utils::LogInfo(L"Renderer initialized successfully");
     return true;
@@ -76,10 +97,36 @@ void Renderer::Cleanup() {
     }
     
     // Cleanup GDI resources
-    if (m_font) {
-        DeleteObject(m_font);
-        m_font = nullptr;
+    if (m_resources) {
+        RenderResourceStats stats = m_resources->GetStats();
+        Utils::LogInfo(L"Render resources: " + std::to_wstring(stats.Hits()) + L" of " +
+                       std::to_wstring(stats.Lookups()) + L" lookups reused");
+        m_resources.reset();
+    }
+    if (m_painter) {
+        DamageStats damage = m_painter->GetDamageStats();
+        Utils::LogInfo(L"Overlay updates: " + std::to_wstring(damage.skipped) + L" skipped, " +
+                       std::to_wstring(damage.partial) + L" partial of " + std::to_wstring(damage.frames));
+        FrameTimeGraphStats graph = m_painter->GetGraphStats();
+        Utils::LogInfo(L"Frame-time graph: " + std::to_wstring(graph.plottedColumns) + L" columns plotted for " +
+                       std::to_wstring(graph.columns));
+        m_painter.reset();
+    }
+    if (m_layouts) {
+        LayoutCacheStats layouts = m_layouts->GetStats();
+        Utils::LogInfo(L"Overlay layouts: " + std::to_wstring(layouts.hits) + L" cached of " +
+                       std::to_wstring(layouts.hits + layouts.misses));
+        m_layouts.reset();
     }
+    if (m_widgets) {
+        WidgetLayoutStats widgets = m_widgets->GetStats();
+        Utils::LogInfo(L"Overlay widgets: " + std::to_wstring(widgets.formats) + L" formatted over " +
+                       std::to_wstring(widgets.updates) + L" frames, " + std::to_wstring(widgets.layouts) +
+                       L" layouts");
+        m_widgets.reset();
+    }
+    m_atlas.reset();
+    m_gdi.reset();
     if (m_glFont) {
         DeleteObject(m_glFont);
         m_glFont = nullptr;
@@ -92,45 +139,116 @@ void Renderer::Cleanup() {
     Utils::LogInfo(L"Renderer cleanup completed");
 }
 
-void Renderer::RenderOverlay(float fps, const OverlayConfig& config) {
-    if (!m_initialized || !m_overlayWindow) return;
-    
-    // Format FPS text
-    std::wstring fpsText = FormatFPS(fps);
-    
-    // Update overlay window position and content
-    HDC hdc = GetDC(m_overlayWindow);
-    if (!hdc) return;
-    
-    // Create compatible bitmap for layered window
-    HDC memDC = CreateCompatibleDC(hdc);
-    HBITMAP hBitmap = CreateCompatibleBitmap(hdc, 200, 50);
-    HBITMAP hOldBitmap = (HBITMAP)SelectObject(memDC, hBitmap);
-    
-    // Clear background
-    RECT rect = {0, 0, 200, 50};
-    HBRUSH hBrush = CreateSolidBrush(RGB(0, 0, 0));
-    FillRect(memDC, &rect, hBrush);
-    DeleteObject(hBrush);
-    
-    // Create font
-    CreateFont(config.fontName, config.fontSize);
-    HFONT hOldFont = (HFONT)SelectObject(memDC, m_font);
+DamageKind Renderer::RenderOverlay(const FrameStats& stats, const OverlayConfig& config) {
+    if (!m_initialized || !m_overlayWindow || !m_resources) return DamageKind::NONE;
+    
+    HDC memDC = m_gdi->GetMemoryDC();
+    if (!memDC) return DamageKind::NONE;
+    
+    // Cached font; only rebuilt when the configured face/size or DPI changes
+    HFONT font = ResolveFont(config.fontName, config.fontSize);
+    const GlyphAtlas* atlas = ResolveAtlas(font, config.fontSize);
+    HFONT hOldFont = (HFONT)SelectObject(memDC, font);
+    
+    // Widgets are placed only when the list, font, DPI or graph sizes
+    // change; after that a frame just reformats the readings that moved
+    WidgetMetrics metrics;
+    metrics.font = LayoutCache::Mix(m_fontNameHash, (uint32_t)config.fontSize);
+    metrics.font = LayoutCache::Mix(metrics.font, (uint32_t)m_resources->GetDpi());
+    metrics.font = LayoutCache::Mix(metrics.font, atlas ? 1 : 0);  // Atlas and GDI measure differently
+    metrics.lineHeight = 20;
+    SIZE digitSize;
+    if (atlas) {
+        metrics.lineHeight = atlas->LineHeight();
+    } else if (GetTextExtentPoint32W(memDC, L"0", 1, &digitSize)) {
+        metrics.lineHeight = digitSize.cy;
+    }
+    metrics.graphWidth = config.graphWidth;
+    metrics.graphHeight = config.graphHeight;
+    metrics.heatmapWidth = config.heatmapWidth;
+    metrics.heatmapHeight = config.heatmapHeight;
+    TextMeasure measure;
+    if (atlas) {
+        measure = [atlas](const wchar_t* text, int length) { return atlas->MeasureText(text, length); };
+    } else {
+        measure = [memDC](const wchar_t* text, int length) {
+            SIZE size;
+            return GetTextExtentPoint32W(memDC, text, length, &size) ? (int)size.cx : 0;
+        };
+    }
+    m_widgets->Configure(config.widgets, metrics, measure);
+    m_widgets->Update(stats);
+    m_painter->Prepare(*m_widgets, PaintStyle(config, atlas != nullptr));
+    int width = m_widgets->Width();
+    int height = m_widgets->Height();
+    
+    // Place only when the layout, the placement or the display changed;
+    // readings never resize the overlay, so a steady one is never moved
+    ResolveMonitor(config);
+    LayoutKey layoutKey = LayoutKeyFor(config);
+    const LayoutEntry* cached = m_layouts->Find(layoutKey);
+    int x, y;
+    if (cached) {
+        x = cached->x;
+        y = cached->y;
+    } else {
+        GetTextPosition(config, width, height, x, y);
+        LayoutEntry placed;
+        placed.textWidth = width;
+        placed.lineHeight = metrics.lineHeight;
+        placed.lines = m_widgets->Count();
+        placed.x = x;
+        placed.y = y;
+        m_layouts->Store(layoutKey, placed);
+    }
     
-    // Set text properties
-    SetTextColor(memDC, RGB(
-        (BYTE)(config.textColor.r * 255),
-        (BYTE)(config.textColor.g * 255),
-        (BYTE)(config.textColor.b * 255)
-    ));
-    SetBkMode(memDC, TRANSPARENT);
+    // Persistent backbuffer, already selected into memDC; only grows. A
+    // grown one may come back at the old address without the old pixels.
+    uint64_t surfaceCreates = m_resources->GetStats().surfaceCreates;
+    const RenderSurface* surface = m_resources->Surface(width, height);
+    if (!surface) {
+        SelectObject(memDC, hOldFont);
+        return DamageKind::NONE;
+    }
+    if (m_resources->GetStats().surfaceCreates != surfaceCreates) {
+        m_painter->Invalidate();
+    }
     
-    // Draw text
-    DrawTextW(memDC, fpsText.c_str(), -1, &rect, DT_LEFT | DT_TOP | DT_SINGLELINE);
+    // Compare with what's on screen; a capped game mostly shows the same
+    // readings again, and then there is nothing to draw or hand to the window.
+    // Otherwise straight into the DIB section's pixels, dirty rectangles
+    // only, premultiplied with per-pixel alpha: a translucent panel and
+    // opaque text need no second window.
+    GdiFlush();
+    PixelBuffer buffer;
+    buffer.pixels = surface->pixels;
+    buffer.width = width;
+    buffer.height = height;
+    buffer.stride = surface->width;
+    DamageKind damage = m_painter->Paint(buffer, atlas, *m_widgets, StyleKey(config, x, y));
+    if (damage == DamageKind::NONE) {
+        SelectObject(memDC, hOldFont);
+        return damage;
+    }
     
-    // Calculate position
-    int x, y, width, height;
-    GetTextPosition(config, fpsText, x, y, width, height);
+    if (!atlas) {
+        // GDI text over the painted background and graphs. GDI leaves alpha
+        // alone (zero under the text), so this path stays opaque and fades
+        // with the window's constant alpha.
+        SetTextColor(memDC, RGB(
+            (BYTE)(config.textColor.r * 255),
+            (BYTE)(config.textColor.g * 255),
+            (BYTE)(config.textColor.b * 255)
+        ));
+        SetBkMode(memDC, TRANSPARENT);
+        
+        for (int i = 0; i < m_widgets->Count(); ++i) {
+            const WidgetCell& cell = m_widgets->Cell(i);
+            if (!cell.IsText()) continue;
+            RECT rect = {cell.bounds.x, cell.bounds.y, width, height};
+            DrawTextW(memDC, cell.text, cell.length, &rect, DT_LEFT | DT_TOP | DT_SINGLELINE);
+        }
+    }
     
     // Update layered window
     POINT ptSrc = {0, 0};
@@ -139,17 +257,26 @@ void Renderer::RenderOverlay(float fps, const OverlayConfig& config) {
     BLENDFUNCTION blend = {0};
     blend.BlendOp = AC_SRC_OVER;
     blend.BlendFlags = 0;
-    blend.SourceConstantAlpha = (BYTE)(config.textColor.a * 255);
-    blend.AlphaFormat = 0;
-    
-    UpdateLayeredWindow(m_overlayWindow, hdc, &ptDst, &sizeWnd, memDC, &ptSrc, 0, &blend, ULW_ALPHA);
-    
-    // Cleanup
+    blend.SourceConstantAlpha = atlas ? 255 : (BYTE)(config.textColor.a * 255);
+    blend.AlphaFormat = atlas ? AC_SRC_ALPHA : 0;
+    
+    // Let the window manager know how little changed on partial updates
+    DamageRect dirty = m_painter->GetDamage().DirtyBounds();
+    RECT dirtyRect = {dirty.x, dirty.y, dirty.x + dirty.width, dirty.y + dirty.height};
+    UPDATELAYEREDWINDOWINFO update = {0};
+    update.cbSize = sizeof(update);
+    update.pptDst = &ptDst;
+    update.psize = &sizeWnd;
+    update.hdcSrc = memDC;
+    update.pptSrc = &ptSrc;
+    update.pblend = &blend;
+    update.dwFlags = ULW_ALPHA;
+    update.prcDirty = damage == DamageKind::PARTIAL ? &dirtyRect : nullptr;
+    UpdateLayeredWindowIndirect(m_overlayWindow, &update);
+    
+    // Fonts can't be deleted while selected, so don't leave one selected
     SelectObject(memDC, hOldFont);
-    SelectObject(memDC, hOldBitmap);
-    DeleteObject(hBitmap);
-    DeleteDC(memDC);
-    ReleaseDC(m_overlayWindow, hdc);
+    return damage;
 }
 
 void Renderer::UpdateScreenDimensions(int width, int height) {
@@ -157,6 +284,45 @@ void Renderer::UpdateScreenDimensions(int width, int height) {
     m_screenHeight = height;
 }
 
+void Renderer::OnDisplayChanged() {
+    UpdateScreenDimensions(GetSystemMetrics(SM_CXSCREEN), GetSystemMetrics(SM_CYSCREEN));
+    if (m_resources) {
+        m_resources->SetDpi(m_gdi->QueryDpi());
+    }
+    if (m_painter) {
+        m_painter->Invalidate();
+    }
+    
+    // Monitors may have moved, resized or gone
+    if (m_layouts) {
+        m_layouts->Invalidate();
+    }
+    m_monitor = nullptr;
+    m_targetWindow = nullptr;
+}
+
+RenderResourceStats Renderer::GetResourceStats() const {
+    return m_resources ? m_resources->GetStats() : RenderResourceStats();
+}
+
+DamageStats Renderer::GetDamageStats() const {
+    return m_painter ? m_painter->GetDamageStats() : DamageStats();
+}
+
+LayoutCacheStats Renderer::GetLayoutStats() const {
+    return m_layouts ? m_layouts->GetStats() : LayoutCacheStats();
+}
+
+WidgetLayoutStats Renderer::GetWidgetStats() const {
+    return m_widgets ? m_widgets->GetStats() : WidgetLayoutStats();
+}
+
+void Renderer::AddFrameTime(float frameTimeMs) {
+    if (m_painter) {
+        m_painter->AddFrameTime(frameTimeMs);
+    }
+}
+
 bool Renderer::CreateOverlayWindow() {
     // Register window class
     WNDCLASSEXW wcex = {0};
@@ -216,6 +382,16 @@ LRESULT CALLBACK Renderer::OverlayWndProc(HWND hwnd, UINT msg, WPARAM wParam, LP
     case WM_DESTROY:
         return 0;
         
+    case WM_DISPLAYCHANGE:
+    case WM_DPICHANGED:
+        {
+            Renderer* renderer = (Renderer*)GetWindowLongPtrW(hwnd, GWLP_USERDATA);
+            if (renderer) {
+                renderer->OnDisplayChanged();
+            }
+        }
+        return 0;
+        
     case WM_PAINT:
         {
             PAINTSTRUCT ps;
@@ -231,55 +407,89 @@ LRESULT CALLBACK Renderer::OverlayWndProc(HWND hwnd, UINT msg, WPARAM wParam, LP
 }
 
 // Helper function implementations
-void Renderer::CreateFont(const std::wstring& fontName, int fontSize) {
-    if (m_font) {
-        DeleteObject(m_font);
-        m_font = nullptr;
-    }
-    
-    m_font = CreateFontW(
-        fontSize,                    // height
-        0,                          // width
-        0,                          // escapement
-        0,                          // orientation
-        FW_NORMAL,                  // weight
-        FALSE,                      // italic
-        FALSE,                      // underline
-        FALSE,                      // strikeout
-        DEFAULT_CHARSET,            // charset
-        OUT_DEFAULT_PRECIS,         // output precision
-        CLIP_DEFAULT_PRECIS,        // clipping precision
-        CLEARTYPE_QUALITY,          // quality
-        DEFAULT_PITCH | FF_DONTCARE,// pitch and family
-        fontName.c_str()            // face name
-    );
-    
-    if (!m_font) {
-        Utils::LogWarning(L"Failed to create font: " + fontName);
-        // Create default font
-        m_font = (HFONT)GetStockObject(DEFAULT_GUI_FONT);
+HFONT Renderer::ResolveFont(const std::wstring& fontName, int fontSize) {
+    // Check the face against the installed fonts on first use rather than
+    // at startup, and again only when the configured name changes
+    if (fontName != m_requestedFontName) {
+        m_requestedFontName = fontName;
+        m_fontName = fontName;
+        if (!Utils::IsFontInstalled(fontName)) {
+            m_fontName = Utils::GetBestAvailableFont({L"Consolas", L"Courier New", L"Arial"});
+            Utils::LogWarning(L"Font not found, using fallback: " + m_fontName);
+        }
+        m_fontNameHash = LayoutCache::WidthClass(m_fontName.c_str(), (int)m_fontName.size(), false);
     }
+    
+    HFONT font = (HFONT)m_resources->Font(m_fontName, fontSize);
+    return font ? font : (HFONT)GetStockObject(DEFAULT_GUI_FONT);
 }
 
-void Renderer::GetTextPosition(const OverlayConfig& config, const std::wstring& text,
-                              int& x, int& y, int& width, int& height) {
-    // Calculate text dimensions
-    HDC hdc = GetDC(nullptr);
-    if (hdc) {
-        HFONT hOldFont = (HFONT)SelectObject(hdc, m_font);
-        
-        SIZE textSize;
-        GetTextExtentPoint32W(hdc, text.c_str(), (int)text.length(), &textSize);
-        
-        width = textSize.cx + 20;  // Add padding
-        height = textSize.cy + 10; // Add padding
+const GlyphAtlas* Renderer::ResolveAtlas(HFONT font, int fontSize) {
+    int dpi = m_resources->GetDpi();
+    if (!m_atlas || m_atlasFontName != m_fontName || m_atlasFontSize != fontSize || m_atlasDpi != dpi) {
+        m_atlasFontName = m_fontName;
+        m_atlasFontSize = fontSize;
+        m_atlasDpi = dpi;
+        if (!m_atlas) {
+            m_atlas = std::make_unique<GlyphAtlas>();
+        }
         
-        SelectObject(hdc, hOldFont);
-        ReleaseDC(nullptr, hdc);
-    } else {
-        width = 100;
-        height = 30;
+        // A failed build leaves the atlas empty until the next change
+        m_painter->Invalidate();
+        GdiGlyphRasterizer rasterizer(m_gdi->GetMemoryDC(), font);
+        if (!m_atlas->Build(rasterizer)) {
+            Utils::LogWarning(L"Glyph atlas build failed, drawing text with GDI: " + m_fontName);
+        }
+    }
+    return m_atlas->IsEmpty() ? nullptr : m_atlas.get();
+}
+
+void Renderer::ResolveMonitor(const OverlayConfig& config) {
+    if (config.monitor != OverlayMonitor::TARGET) {
+        m_monitor = nullptr;
+        m_targetWindow = nullptr;
+        return;
+    }
+    
+    // Asking for the foreground window is cheap; which monitor it is on
+    // only needs asking when it changes, and now and then in case it moved
+    HWND target = Utils::GetForegroundGameWindow();
+    if (!target || target == m_overlayWindow) return;
+    if (target == m_targetWindow && ++m_monitorChecks < MONITOR_RECHECK_DRAWS) return;
+    m_targetWindow = target;
+    m_monitorChecks = 0;
+    
+    HMONITOR monitor = MonitorFromWindow(target, MONITOR_DEFAULTTOPRIMARY);
+    if (!monitor || monitor == m_monitor) return;
+    MONITORINFO info = {0};
+    info.cbSize = sizeof(info);
+    if (!GetMonitorInfoW(monitor, &info)) return;
+    m_monitor = monitor;
+    m_monitorRect = info.rcMonitor;
+}
+
+LayoutKey Renderer::LayoutKeyFor(const OverlayConfig& config) const {
+    // The widget layout's key already covers the widgets, font, DPI and
+    // graph sizes, so it stands in for the text's shape
+    LayoutKey key;
+    key.monitor = (uint64_t)(uintptr_t)m_monitor;
+    key.dpi = m_resources->GetDpi();
+    key.font = LayoutCache::Mix(m_fontNameHash, (uint32_t)config.fontSize);
+    key.placement = LayoutCache::Mix(0, (uint32_t)config.position);
+    key.placement = LayoutCache::Mix(key.placement, (uint32_t)config.offsetX);
+    key.placement = LayoutCache::Mix(key.placement, (uint32_t)config.offsetY);
+    key.widthClass = m_widgets->Key();
+    return key;
+}
+
+void Renderer::GetTextPosition(const OverlayConfig& config, int width, int height, int& x, int& y) {
+    // The primary monitor starts at the virtual screen's origin
+    RECT bounds = {0, 0, m_screenWidth, m_screenHeight};
+    if (m_monitor) {
+        bounds = m_monitorRect;
     }
+    int screenWidth = bounds.right - bounds.left;
+    int screenHeight = bounds.bottom - bounds.top;
     
     // Calculate position based on overlay position setting
     switch (config.position) {
@@ -289,18 +499,18 @@ void Renderer::GetTextPosition(const OverlayConfig& config, const std::wstring&
         break;
         
     case OverlayPosition::TOP_RIGHT:
-        x = m_screenWidth - width - config.offsetX;
+        x = screenWidth - width - config.offsetX;
         y = config.offsetY;
         break;
         
     case OverlayPosition::BOTTOM_LEFT:
         x = config.offsetX;
-        y = m_screenHeight - height - config.offsetY;
+        y = screenHeight - height - config.offsetY;
         break;
         
     case OverlayPosition::BOTTOM_RIGHT:
-        x = m_screenWidth - width - config.offsetX;
-        y = m_screenHeight - height - config.offsetY;
+        x = screenWidth - width - config.offsetX;
+        y = screenHeight - height - config.offsetY;
         break;
         
     default:
@@ -309,9 +519,49 @@ void Renderer::GetTextPosition(const OverlayConfig& config, const std::wstring&
         break;
     }
     
-    // Ensure position is within screen bounds
-    x = std::max(0, std::min(x, m_screenWidth - width));
-    y = std::max(0, std::min(y, m_screenHeight - height));
+    // Ensure position is within the monitor's bounds
+    x = bounds.left + std::max(0, std::min(x, screenWidth - width));
+    y = bounds.top + std::max(0, std::min(y, screenHeight - height));
+}
+
+uint64_t Renderer::StyleKey(const OverlayConfig& config, int x, int y) {
+    // Everything besides the text that changes the window's pixels or place
+    uint64_t key = ColorToARGB(config.textColor);
+    key = key * 1099511628211ull + ColorToARGB(config.backgroundColor);
+    key = key * 1099511628211ull + (config.showBackground ? 1u : 0u);
+    key = key * 1099511628211ull + (uint32_t)config.fontSize;
+    key = key * 1099511628211ull + (uint32_t)x;
+    key = key * 1099511628211ull + (uint32_t)y;
+    return key;
+}
+
+OverlayPaintStyle Renderer::PaintStyle(const OverlayConfig& config, bool perPixelAlpha) {
+    // Without per-pixel alpha (GDI text) everything is opaque and square;
+    // the window's constant alpha does the fading
+    OverlayPaintStyle style;
+    if (perPixelAlpha) {
+        style.textColor = ColorToARGB(config.textColor);
+        style.backgroundColor = ColorToARGB(config.backgroundColor);
+        style.showBackground = config.showBackground;
+    } else {
+        style.textColor = 0xFF000000 | ColorToRGB(config.textColor);
+        style.backgroundColor = 0xFF000000 | ColorToRGB(config.backgroundColor);
+        style.cornerRadius = 0;
+    }
+    style.graph.scaleMs = static_cast<float>(config.graphScaleMs);
+    style.graph.framesPerColumn = config.graphFramesPerColumn;
+    style.heatmap.minMs = static_cast<float>(config.heatmapMinMs);
+    style.heatmap.maxMs = static_cast<float>(config.heatmapMaxMs);
+    style.heatmap.sliceMs = static_cast<float>(config.heatmapSliceMs);
+    return style;
+}
+
+uint32_t Renderer::ColorToRGB(const Color& color) {
+    return ((uint32_t)(color.r * 255) << 16) | ((uint32_t)(color.g * 255) << 8) | (uint32_t)(color.b * 255);
+}
+
+uint32_t Renderer::ColorToARGB(const Color& color) {
+    return ((uint32_t)(color.a * 255) << 24) | ColorToRGB(color);
 }
 
 DWORD Renderer::ColorToD3DColor(const Color& color) {
@@ -323,12 +573,6 @@ DWORD Renderer::ColorToD3DColor(const Color& color) {
     );
 }
 
-std::wstring Renderer::FormatFPS(float fps) {
-    std::wostringstream oss;
-    oss << L"FPS: " << std::fixed << std::setprecision(1) << fps;
-    return oss.str();
-}
-
 // Graphics API specific implementations (simplified for this version)
 bool Renderer::InitializeD3D9(IDirect3DDevice9* device) {
     m_d3d9Device = device;
@@ -352,17 +596,17 @@ bool Renderer::InitializeOpenGL(HDC hdc) {
     return true;
 }
 
-void Renderer::RenderD3D9(const std::wstring& text, const OverlayConfig& config) {
+void Renderer::RenderD3D9(const wchar_t* text, const OverlayConfig& config) {
     // DirectX 9 specific rendering would go here
     // For now, fallback to window overlay
 }
 
-void Renderer::RenderD3D11(const std::wstring& text, const OverlayConfig& config) {
+void Renderer::RenderD3D11(const wchar_t* text, const OverlayConfig& config) {
     // DirectX 11 specific rendering would go here
     // For now, fallback to window overlay
 }
 
-void Renderer::RenderOpenGL(const std::wstring& text, const OverlayConfig& config) {
+void Renderer::RenderOpenGL(const wchar_t* text, const OverlayConfig& config) {
     // OpenGL specific rendering would go here
     // For now, fallback to window overlay
 }
\ No newline at end of file
@@ -0,0 +1,257 @@
+#include "scheduler.h"
+#include <algorithm>
+
+Scheduler::Scheduler(SchedulerClock clock)
+    : m_epoch(std::chrono::steady_clock::now())
+    , m_clock(std::move(clock))
+    , m_running(false)
+    , m_wakeups(0)
+    , m_affinityMask(THREAD_AFFINITY_NONE)
+    , m_priority(ThreadPriority::NORMAL)
+{
+}
+
+Scheduler::~Scheduler() {
+    Stop();
+}
+
+uint32_t Scheduler::AddPeriodic(const std::string& name, uint32_t intervalMs, uint32_t slackMs,
+                                std::function<void()> task) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Task entry;
+    entry.stats.name = name;
+    entry.stats.intervalMs = std::max<uint32_t>(SCHEDULER_TICK_MS, intervalMs);
+    entry.slackMs = std::max<uint32_t>(SCHEDULER_TICK_MS, slackMs);
+    entry.active = true;
+    entry.fn = std::make_shared<const std::function<void()>>(std::move(task));
+    m_tasks.push_back(std::move(entry));
+
+    // Size the bookkeeping for the task count now rather than on the
+    // scheduler thread later
+    m_deadlines.reserve(m_tasks.size());
+    m_wheel.Reserve(m_tasks.size());
+
+    uint32_t taskId = static_cast<uint32_t>(m_tasks.size() - 1);
+    ScheduleLocked(taskId, NowTick());
+    m_cv.notify_one();
+    return taskId;
+}
+
+void Scheduler::SetInterval(uint32_t taskId, uint32_t intervalMs, uint32_t slackMs) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (taskId >= m_tasks.size() || !m_tasks[taskId].active) return;
+
+    Task& task = m_tasks[taskId];
+    intervalMs = std::max<uint32_t>(SCHEDULER_TICK_MS, intervalMs);
+    slackMs = slackMs ? std::max<uint32_t>(SCHEDULER_TICK_MS, slackMs) : task.slackMs;
+    if (task.stats.intervalMs == intervalMs && task.slackMs == slackMs) return;
+
+    // Invalidate the pending entry and reschedule with the new period
+    task.stats.intervalMs = intervalMs;
+    task.slackMs = slackMs;
+    task.generation++;
+    ScheduleLocked(taskId, NowTick());
+    m_cv.notify_one();
+}
+
+void Scheduler::Cancel(uint32_t taskId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (taskId >= m_tasks.size()) return;
+
+    m_tasks[taskId].active = false;
+    m_tasks[taskId].generation++;
+}
+
+void Scheduler::SetThreadSettings(uint64_t affinityMask, ThreadPriority priority) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_affinityMask = affinityMask;
+    m_priority = priority;
+}
+
+bool Scheduler::Start() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_running) return true;
+    if (m_clock) return false;
+
+    m_running = true;
+    m_thread = std::thread(&Scheduler::SchedulerWorker, this);
+    return true;
+}
+
+void Scheduler::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running) return;
+        m_running = false;
+    }
+    m_cv.notify_one();
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void Scheduler::RunDue() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_running) return;
+
+    m_wakeups.fetch_add(1, std::memory_order_relaxed);
+    RunDueLocked(lock);
+}
+
+std::vector<ScheduledTaskStats> Scheduler::GetTaskStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<ScheduledTaskStats> stats;
+    for (const Task& task : m_tasks) {
+        if (task.active) stats.push_back(task.stats);
+    }
+    return stats;
+}
+
+// Private methods implementation
+void Scheduler::SchedulerWorker() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    ThreadAffinity::ApplyToCurrentThread(m_affinityMask, m_priority);
+    while (m_running) {
+        // Sleep until the earliest deadline (or until a task is added)
+        uint64_t next = m_wheel.NextExpiry();
+        if (next == UINT64_MAX) {
+            m_cv.wait(lock);
+        } else {
+            auto wakeAt = m_epoch + std::chrono::milliseconds(next * SCHEDULER_TICK_MS);
+            m_cv.wait_until(lock, wakeAt);
+        }
+        if (!m_running) break;
+
+        m_wakeups.fetch_add(1, std::memory_order_relaxed);
+        RunDueLocked(lock);
+    }
+}
+
+void Scheduler::RunDueLocked(std::unique_lock<std::mutex>& lock) {
+    // Rescheduled tasks leave stale entries behind, so allow for two each
+    m_expired.reserve(m_tasks.size() * 2);
+    m_due.reserve(m_tasks.size() * 2);
+
+    m_expired.clear();
+    m_wheel.Advance(NowTick(), m_expired);
+    if (m_expired.empty()) return;
+
+    for (const TimerEntry& entry : m_expired) {
+        ReleaseDeadline(entry.expiry);
+    }
+
+    // Drop cancelled/rescheduled entries; run in registration order
+    m_due.clear();
+    for (const TimerEntry& entry : m_expired) {
+        const Task& task = m_tasks[entry.id];
+        if (task.active && task.generation == entry.generation) {
+            m_due.push_back(entry);
+        }
+    }
+    std::sort(m_due.begin(), m_due.end(), [](const TimerEntry& a, const TimerEntry& b) {
+        return a.id < b.id;
+    });
+
+    for (const TimerEntry& entry : m_due) {
+        // An earlier task this tick may have cancelled or re-timed this one
+        if (!m_tasks[entry.id].active || m_tasks[entry.id].generation != entry.generation) continue;
+
+        std::shared_ptr<const std::function<void()>> fn = m_tasks[entry.id].fn;
+        lock.unlock();
+
+        uint64_t startNs = NowNs();
+        try {
+            (*fn)();
+        } catch (...) {
+            // A failing task must not take the scheduler down
+        }
+        uint64_t endNs = NowNs();
+
+        lock.lock();
+        Task& task = m_tasks[entry.id];
+        uint64_t deadlineNs = entry.expiry * SCHEDULER_TICK_MS * 1000000ull;
+        uint64_t runNs = endNs - startNs;
+        uint64_t latenessNs = startNs > deadlineNs ? startNs - deadlineNs : 0;
+
+        task.stats.runs++;
+        task.stats.totalRunNs += runNs;
+        task.stats.maxRunNs = std::max(task.stats.maxRunNs, runNs);
+        task.stats.totalLatenessNs += latenessNs;
+        task.stats.maxLatenessNs = std::max(task.stats.maxLatenessNs, latenessNs);
+
+        // Reschedule unless cancelled or re-timed while it was running.
+        // Periods are measured from the deadline so they don't drift off
+        // the shared grid; whole periods missed while late are skipped.
+        if (task.active && task.generation == entry.generation) {
+            uint64_t from = entry.expiry;
+            uint64_t now = NowTick();
+            uint64_t interval = task.stats.intervalMs / SCHEDULER_TICK_MS;
+            if (from + interval <= now) {
+                from += ((now - from) / interval) * interval;
+            }
+            ScheduleLocked(entry.id, from);
+        }
+    }
+}
+
+uint64_t Scheduler::NowNs() const {
+    if (m_clock) return m_clock();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - m_epoch).count());
+}
+
+uint64_t Scheduler::NowTick() const {
+    return NowNs() / (SCHEDULER_TICK_MS * 1000000ull);
+}
+
+uint64_t Scheduler::AlignedDeadline(uint64_t fromTick, const Task& task) const {
+    uint64_t nominal = fromTick + task.stats.intervalMs / SCHEDULER_TICK_MS;
+    uint64_t slack = task.slackMs / SCHEDULER_TICK_MS;
+
+    // Join a wakeup that is already booked within the slack window
+    size_t booked = FindDeadline(nominal);
+    if (booked < m_deadlines.size() && m_deadlines[booked].first <= nominal + slack) {
+        return m_deadlines[booked].first;
+    }
+
+    // Otherwise round up to the task's slack grid, so tasks whose grids line
+    // up (e.g. 1 s and 5 s with 50 ms slack) keep landing on the same tick
+    uint64_t grid = std::max<uint64_t>(1, slack);
+    return ((nominal + grid - 1) / grid) * grid;
+}
+
+void Scheduler::ScheduleLocked(uint32_t taskId, uint64_t fromTick) {
+    Task& task = m_tasks[taskId];
+
+    TimerEntry entry;
+    entry.id = taskId;
+    entry.generation = task.generation;
+    entry.expiry = AlignedDeadline(fromTick, task);
+    m_wheel.Insert(entry);
+
+    size_t booked = FindDeadline(entry.expiry);
+    if (booked < m_deadlines.size() && m_deadlines[booked].first == entry.expiry) {
+        m_deadlines[booked].second++;
+    } else {
+        m_deadlines.insert(m_deadlines.begin() + booked, std::make_pair(entry.expiry, 1u));
+    }
+}
+
+void Scheduler::ReleaseDeadline(uint64_t tick) {
+    size_t booked = FindDeadline(tick);
+    if (booked < m_deadlines.size() && m_deadlines[booked].first == tick &&
+        --m_deadlines[booked].second == 0) {
+        m_deadlines.erase(m_deadlines.begin() + booked);
+    }
+}
+
+size_t Scheduler::FindDeadline(uint64_t tick) const {
+    auto booked = std::lower_bound(m_deadlines.begin(), m_deadlines.end(), tick,
+                                   [](const std::pair<uint64_t, uint32_t>& entry, uint64_t t) {
+                                       return entry.first < t;
+                                   });
+    return static_cast<size_t>(booked - m_deadlines.begin());
+}
@@ -0,0 +1,42 @@
+#include "scrolling_image.h"
+
+#include <algorithm>
+#include <cstring>
+
+ScrollingImage::ScrollingImage()
+    : m_width(0)
+    , m_height(0)
+{
+}
+
+void ScrollingImage::Resize(int width, int height, uint32_t fill) {
+    m_width = std::max(width, 0);
+    m_height = std::max(height, 0);
+    m_pixels.assign(static_cast<size_t>(m_width) * m_height, fill);
+}
+
+void ScrollingImage::Draw(PixelBuffer& target, int x, int y, int oldest) const {
+    if (m_width == 0 || m_height == 0) return;
+
+    // [oldest, width), then [0, oldest)
+    CopyColumns(target, x, y, oldest, m_width - oldest);
+    CopyColumns(target, x + m_width - oldest, y, 0, oldest);
+}
+
+// Private methods implementation
+void ScrollingImage::CopyColumns(PixelBuffer& target, int x, int y, int firstColumn, int count) const {
+    int left = std::max(x, 0);
+    int right = std::min(x + count, target.width);
+    int top = std::max(y, 0);
+    int bottom = std::min(y + m_height, target.height);
+    if (left >= right || top >= bottom) return;
+
+    const uint32_t* source = m_pixels.data() + static_cast<size_t>(top - y) * m_width + firstColumn + (left - x);
+    uint32_t* destination = target.pixels + static_cast<size_t>(top) * target.stride + left;
+    size_t bytes = static_cast<size_t>(right - left) * sizeof(uint32_t);
+    for (int row = top; row < bottom; ++row) {
+        std::memcpy(destination, source, bytes);
+        source += m_width;
+        destination += target.stride;
+    }
+}
@@ -0,0 +1,79 @@
+#include "startup_timeline.h"
+
+#include <algorithm>
+#include <cstdio>
+
+StartupTimeline::StartupTimeline()
+    : m_originNs(MonotonicNowNs())
+{
+}
+
+StartupTimeline::Scope::Scope(StartupTimeline& timeline, const char* name)
+    : m_timeline(timeline)
+    , m_name(name)
+    , m_startNs(MonotonicNowNs())
+{
+}
+
+StartupTimeline::Scope::~Scope() {
+    m_timeline.Record(m_name, m_startNs, MonotonicNowNs());
+}
+
+void StartupTimeline::Record(const char* name, uint64_t startNs, uint64_t endNs) {
+    std::thread::id self = std::this_thread::get_id();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = std::find(m_threads.begin(), m_threads.end(), self);
+    if (it == m_threads.end()) it = m_threads.insert(m_threads.end(), self);
+
+    StartupPhase phase;
+    phase.name = name;
+    phase.startNs = startNs > m_originNs ? startNs - m_originNs : 0;
+    phase.endNs = endNs > m_originNs ? endNs - m_originNs : 0;
+    phase.thread = static_cast<uint32_t>(it - m_threads.begin());
+    m_phases.push_back(std::move(phase));
+}
+
+std::vector<StartupPhase> StartupTimeline::GetPhases() const {
+    std::vector<StartupPhase> phases;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        phases = m_phases;
+    }
+    std::stable_sort(phases.begin(), phases.end(),
+                     [](const StartupPhase& a, const StartupPhase& b) { return a.startNs < b.startNs; });
+    return phases;
+}
+
+uint64_t StartupTimeline::TotalNs() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint64_t total = 0;
+    for (const StartupPhase& phase : m_phases) {
+        total = std::max(total, phase.endNs);
+    }
+    return total;
+}
+
+uint64_t StartupTimeline::SerialNs() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint64_t total = 0;
+    for (const StartupPhase& phase : m_phases) {
+        total += phase.endNs - phase.startNs;
+    }
+    return total;
+}
+
+std::string StartupTimeline::Format() const {
+    std::string out;
+    char line[128];
+    std::snprintf(line, sizeof(line), "  %-20s %6s %10s %10s\n", "phase", "thread", "start ms", "ms");
+    out += line;
+    for (const StartupPhase& phase : GetPhases()) {
+        std::snprintf(line, sizeof(line), "  %-20s %6u %10.2f %10.2f\n", phase.name.c_str(), phase.thread,
+                      phase.startNs / 1e6, (phase.endNs - phase.startNs) / 1e6);
+        out += line;
+    }
+    std::snprintf(line, sizeof(line), "  total %.2f ms (phases sum to %.2f ms)\n", TotalNs() / 1e6, SerialNs() / 1e6);
+    out += line;
+    return out;
+}
@@ -0,0 +1,285 @@
+#include "thread_affinity.h"
+#include <algorithm>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <cerrno>
+#include <cstdio>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    uint64_t HighestCpu(uint64_t mask) {
+        if (!mask) return 0;
+        int cpu = 63;
+        while (!(mask >> cpu)) --cpu;
+        return 1ull << cpu;
+    }
+
+    unsigned CountCpus(uint64_t mask) {
+        unsigned count = 0;
+        for (; mask; mask &= mask - 1) ++count;
+        return count;
+    }
+
+#ifdef _WIN32
+    uint64_t ProcessMask() {
+        DWORD_PTR processMask = 0;
+        DWORD_PTR systemMask = 0;
+        if (!GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask)) return 1;
+        return static_cast<uint64_t>(processMask);
+    }
+
+    // Cores with a lower EfficiencyClass than the best one are E-cores
+    uint64_t DetectEfficiencyMask() {
+        DWORD length = 0;
+        GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &length);
+        if (GetLastError() != ERROR_INSUFFICIENT_BUFFER || length == 0) return 0;
+
+        std::vector<char> buffer(length);
+        auto* info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data());
+        if (!GetLogicalProcessorInformationEx(RelationProcessorCore, info, &length)) return 0;
+
+        struct Core {
+            uint64_t mask;
+            BYTE efficiencyClass;
+        };
+        std::vector<Core> cores;
+        BYTE highest = 0;
+        for (DWORD offset = 0; offset < length;) {
+            auto* entry = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+            if (entry->Relationship == RelationProcessorCore && entry->Processor.GroupMask[0].Group == 0) {
+                cores.push_back({static_cast<uint64_t>(entry->Processor.GroupMask[0].Mask),
+                                 entry->Processor.EfficiencyClass});
+                highest = std::max(highest, entry->Processor.EfficiencyClass);
+            }
+            offset += entry->Size;
+        }
+
+        uint64_t efficiency = 0;
+        for (const Core& core : cores) {
+            if (core.efficiencyClass < highest) efficiency |= core.mask;
+        }
+        return efficiency;
+    }
+#elif defined(__linux__)
+    uint64_t ProcessMask() {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) != 0) return 1;
+
+        uint64_t mask = 0;
+        for (int cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) mask |= 1ull << cpu;
+        }
+        return mask ? mask : 1;
+    }
+
+    // Parse a sysfs CPU list such as "0-3,8,10-11"
+    bool ReadCpuList(const char* path, uint64_t& mask) {
+        FILE* file = std::fopen(path, "r");
+        if (!file) return false;
+
+        mask = 0;
+        unsigned first = 0;
+        unsigned last = 0;
+        int separator = 0;
+        while (std::fscanf(file, "%u", &first) == 1) {
+            last = first;
+            separator = std::fgetc(file);
+            if (separator == '-') {
+                if (std::fscanf(file, "%u", &last) != 1) break;
+                separator = std::fgetc(file);
+            }
+            for (unsigned cpu = first; cpu <= last && cpu < 64; ++cpu) {
+                mask |= 1ull << cpu;
+            }
+            if (separator != ',') break;
+        }
+        std::fclose(file);
+        return true;
+    }
+
+    // Intel hybrid parts expose the E-cores as the cpu_atom PMU; ARM
+    // big.LITTLE reports a lower cpu_capacity for the little cores
+    uint64_t DetectEfficiencyMask(uint64_t allMask) {
+        uint64_t atom = 0;
+        if (ReadCpuList("/sys/devices/cpu_atom/cpus", atom)) {
+            return atom & allMask;
+        }
+
+        unsigned capacities[64] = {};
+        unsigned highest = 0;
+        for (int cpu = 0; cpu < 64; ++cpu) {
+            if (!(allMask & (1ull << cpu))) continue;
+            char path[96];
+            std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpu_capacity", cpu);
+            FILE* file = std::fopen(path, "r");
+            if (!file) return 0;
+            if (std::fscanf(file, "%u", &capacities[cpu]) != 1) capacities[cpu] = 0;
+            std::fclose(file);
+            highest = std::max(highest, capacities[cpu]);
+        }
+
+        uint64_t efficiency = 0;
+        for (int cpu = 0; cpu < 64; ++cpu) {
+            if ((allMask & (1ull << cpu)) && capacities[cpu] < highest) efficiency |= 1ull << cpu;
+        }
+        return efficiency;
+    }
+
+    pid_t CurrentTid() {
+        return static_cast<pid_t>(syscall(SYS_gettid));
+    }
+
+    int NiceFor(ThreadPriority priority) {
+        switch (priority) {
+            case ThreadPriority::BELOW_NORMAL: return 5;
+            case ThreadPriority::ABOVE_NORMAL: return -5;
+            case ThreadPriority::HIGHEST: return -10;
+            default: return 0;
+        }
+    }
+#endif
+
+    CpuTopology DetectTopology() {
+        CpuTopology topology;
+#if defined(_WIN32)
+        topology.allMask = ProcessMask();
+        topology.efficiencyMask = DetectEfficiencyMask() & topology.allMask;
+#elif defined(__linux__)
+        topology.allMask = ProcessMask();
+        topology.efficiencyMask = DetectEfficiencyMask(topology.allMask);
+#endif
+        topology.logicalCpus = std::max(1u, CountCpus(topology.allMask));
+        topology.hybrid = topology.efficiencyMask != 0 && topology.efficiencyMask != topology.allMask;
+        if (!topology.hybrid) topology.efficiencyMask = 0;
+        return topology;
+    }
+}
+
+namespace ThreadAffinity {
+
+const CpuTopology& GetTopology() {
+    static const CpuTopology topology = DetectTopology();
+    return topology;
+}
+
+uint64_t AutoMask(const CpuTopology& topology) {
+    return topology.hybrid ? topology.efficiencyMask : HighestCpu(topology.allMask);
+}
+
+uint64_t ResolveMask(uint64_t mask) {
+    if (mask == THREAD_AFFINITY_NONE) return THREAD_AFFINITY_NONE;
+
+    const CpuTopology& topology = GetTopology();
+    if (mask == THREAD_AFFINITY_AUTO) return AutoMask(topology);
+
+    // None of the requested CPUs exist: fall back to auto rather than fail
+    uint64_t usable = mask & topology.allMask;
+    return usable ? usable : AutoMask(topology);
+}
+
+bool PinCurrentThread(uint64_t mask) {
+    if (!mask) return false;
+#if defined(_WIN32)
+    return SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(mask)) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; ++cpu) {
+        if (mask & (1ull << cpu)) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+uint64_t GetCurrentAffinity() {
+#if defined(_WIN32)
+    // Read-only, unlike SetThreadAffinityMask's returned previous mask. The
+    // topology only covers group 0, so a thread elsewhere reports unknown.
+    GROUP_AFFINITY affinity = {};
+    if (!GetThreadGroupAffinity(GetCurrentThread(), &affinity) || affinity.Group != 0) return 0;
+    return static_cast<uint64_t>(affinity.Mask);
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) != 0) return 0;
+
+    uint64_t mask = 0;
+    for (int cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &set)) mask |= 1ull << cpu;
+    }
+    return mask;
+#else
+    return 0;
+#endif
+}
+
+bool SetCurrentPriority(ThreadPriority priority) {
+#if defined(_WIN32)
+    return SetThreadPriority(GetCurrentThread(), static_cast<int>(priority)) != 0;
+#elif defined(__linux__)
+    // SCHED_IDLE only runs when a CPU would otherwise idle: the least
+    // intrusive setting. Everything else is SCHED_OTHER with a nice value.
+    sched_param param = {};
+    int policy = priority == ThreadPriority::LOWEST ? SCHED_IDLE : SCHED_OTHER;
+    if (pthread_setschedparam(pthread_self(), policy, &param) != 0) return false;
+    if (priority == ThreadPriority::LOWEST) return true;
+
+    // Nice is per thread on Linux when addressed by thread id
+    return setpriority(PRIO_PROCESS, static_cast<id_t>(CurrentTid()), NiceFor(priority)) == 0;
+#else
+    return priority == ThreadPriority::NORMAL;
+#endif
+}
+
+ThreadPriority GetCurrentPriority() {
+#if defined(_WIN32)
+    return PriorityFromInt(GetThreadPriority(GetCurrentThread()));
+#elif defined(__linux__)
+    int policy = SCHED_OTHER;
+    sched_param param = {};
+    if (pthread_getschedparam(pthread_self(), &policy, &param) == 0 && policy == SCHED_IDLE) {
+        return ThreadPriority::LOWEST;
+    }
+
+    errno = 0;
+    int nice = getpriority(PRIO_PROCESS, static_cast<id_t>(CurrentTid()));
+    if (errno != 0) return ThreadPriority::NORMAL;
+    if (nice <= -8) return ThreadPriority::HIGHEST;
+    if (nice <= -3) return ThreadPriority::ABOVE_NORMAL;
+    if (nice >= 3) return ThreadPriority::BELOW_NORMAL;
+    return ThreadPriority::NORMAL;
+#else
+    return ThreadPriority::NORMAL;
+#endif
+}
+
+bool ApplyToCurrentThread(uint64_t mask, ThreadPriority priority) {
+    bool ok = true;
+    uint64_t resolved = ResolveMask(mask);
+    if (resolved != THREAD_AFFINITY_NONE) {
+        ok = PinCurrentThread(resolved);
+    }
+    if (priority != ThreadPriority::NORMAL) {
+        ok = SetCurrentPriority(priority) && ok;
+    }
+    return ok;
+}
+
+ThreadPriority PriorityFromInt(int value) {
+    return static_cast<ThreadPriority>(std::min(std::max(value, -2), 2));
+}
+
+} // namespace ThreadAffinity
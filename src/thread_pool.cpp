@@ -0,0 +1,242 @@
+#include "thread_pool.h"
+#include <algorithm>
+#include <exception>
+
+namespace {
+    // Which pool/worker the current thread belongs to (none for callers)
+    thread_local const WorkStealingPool* t_pool = nullptr;
+    thread_local size_t t_worker = 0;
+
+    const size_t NO_WORKER = static_cast<size_t>(-1);
+}
+
+// Shared state of one ParallelFor call. Tasks hold a reference, so the last
+// piece may finish after the caller has returned.
+struct WorkStealingPool::ForJob {
+    const std::function<void(size_t, size_t)>* body = nullptr;
+    size_t grain = 1;
+    std::atomic<size_t> remaining{0};  // Items not yet processed
+    std::atomic<bool> failed{false};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+};
+
+WorkStealingPool::WorkStealingPool(size_t workerCount, uint64_t affinityMask, ThreadPriority priority)
+    : m_queued(0)
+    , m_inFlight(0)
+    , m_sleepers(0)
+    , m_stopping(false)
+    , m_nextQueue(0)
+    , m_executed(0)
+    , m_stolen(0)
+    , m_failed(0)
+{
+    if (workerCount == 0) {
+        // Leave a hardware thread for the game
+        unsigned hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 1;
+    }
+    workerCount = std::min<size_t>(workerCount, THREAD_POOL_MAX_WORKERS);
+
+    for (size_t i = 0; i < workerCount; ++i) {
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (size_t i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back(&WorkStealingPool::WorkerLoop, this, i, affinityMask, priority);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    WaitIdle();
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping = true;
+    }
+    m_sleepCv.notify_all();
+
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void WorkStealingPool::Submit(std::function<void()> task) {
+    Push([this, task = std::move(task)]() {
+        try {
+            task();
+        } catch (...) {
+            m_failed.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+}
+
+void WorkStealingPool::ParallelFor(size_t begin, size_t end, size_t grain,
+                                   const std::function<void(size_t, size_t)>& body) {
+    if (begin >= end) return;
+
+    size_t count = end - begin;
+    if (grain == 0) {
+        // About eight pieces per thread (workers plus the caller) leaves
+        // room for stealing to even out uneven pieces
+        grain = std::max<size_t>(1, count / ((WorkerCount() + 1) * 8));
+    }
+
+    auto job = std::make_shared<ForJob>();
+    job->body = &body;
+    job->grain = grain;
+    job->remaining = count;
+
+    // Split and run on this thread; the halves pushed on the way are stolen
+    RunRange(job, begin, end);
+
+    // Help with whatever is left instead of blocking
+    size_t home = CurrentWorker(this);
+    while (job->remaining.load(std::memory_order_acquire) > 0) {
+        if (!TryRunOne(home)) {
+            std::this_thread::yield();
+        }
+    }
+
+    if (job->error) {
+        std::rethrow_exception(job->error);
+    }
+}
+
+void WorkStealingPool::WaitIdle() {
+    // Help drain, then sleep until running tasks finish. Must not be called
+    // from inside a task: that task keeps the pool from ever being idle.
+    size_t home = CurrentWorker(this);
+    while (TryRunOne(home)) {
+    }
+
+    std::unique_lock<std::mutex> lock(m_sleepMutex);
+    m_idleCv.wait(lock, [this]() { return m_inFlight.load() == 0; });
+}
+
+ThreadPoolStats WorkStealingPool::GetStats() const {
+    ThreadPoolStats stats;
+    stats.workers = m_workers.size();
+    stats.executed = m_executed.load(std::memory_order_relaxed);
+    stats.stolen = m_stolen.load(std::memory_order_relaxed);
+    stats.failed = m_failed.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// Private methods implementation
+void WorkStealingPool::WorkerLoop(size_t index, uint64_t affinityMask, ThreadPriority priority) {
+    t_pool = this;
+    t_worker = index;
+    ThreadAffinity::ApplyToCurrentThread(affinityMask, priority);
+
+    while (true) {
+        if (TryRunOne(index)) continue;
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleepers.fetch_add(1);
+        m_sleepCv.wait(lock, [this]() { return m_queued.load() > 0 || m_stopping.load(); });
+        m_sleepers.fetch_sub(1);
+        if (m_stopping && m_queued.load() == 0) break;
+    }
+}
+
+void WorkStealingPool::RunRange(const std::shared_ptr<ForJob>& job, size_t begin, size_t end) {
+    // Give away the upper half until the piece is small enough to run
+    while (end - begin > job->grain) {
+        size_t mid = begin + (end - begin) / 2;
+        Push([this, job, mid, end]() { RunRange(job, mid, end); });
+        end = mid;
+    }
+
+    if (!job->failed.load(std::memory_order_relaxed)) {
+        try {
+            (*job->body)(begin, end);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(job->errorMutex);
+            if (!job->error) {
+                job->error = std::current_exception();
+            }
+            job->failed = true;
+        }
+    }
+
+    // Last touch of the job; the caller may return as soon as this hits zero
+    job->remaining.fetch_sub(end - begin, std::memory_order_acq_rel);
+}
+
+void WorkStealingPool::Push(std::function<void()> task) {
+    size_t index = CurrentWorker(this);
+    if (index == NO_WORKER) {
+        index = m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+    }
+
+    m_inFlight.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+        m_queues[index]->tasks.push_back(std::move(task));
+    }
+    m_queued.fetch_add(1);
+    Notify();
+}
+
+bool WorkStealingPool::TryRunOne(size_t home) {
+    std::function<void()> task;
+    if (!TryPop(home, task)) return false;
+
+    task();
+    m_executed.fetch_add(1, std::memory_order_relaxed);
+
+    if (m_inFlight.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_idleCv.notify_all();
+    }
+    return true;
+}
+
+bool WorkStealingPool::TryPop(size_t home, std::function<void()>& task) {
+    if (m_queued.load() == 0) return false;
+
+    // Own deque first, newest task (still in cache)
+    if (home != NO_WORKER) {
+        WorkerQueue& own = *m_queues[home];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            m_queued.fetch_sub(1);
+            return true;
+        }
+    }
+
+    // Steal the oldest task from the next non-empty deque
+    size_t start = home != NO_WORKER ? home + 1 : m_nextQueue.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < m_queues.size(); ++i) {
+        size_t victim = (start + i) % m_queues.size();
+        if (victim == home) continue;
+
+        WorkerQueue& other = *m_queues[victim];
+        std::lock_guard<std::mutex> lock(other.mutex);
+        if (!other.tasks.empty()) {
+            task = std::move(other.tasks.front());
+            other.tasks.pop_front();
+            m_queued.fetch_sub(1);
+            m_stolen.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::Notify() {
+    // Sleepers re-check m_queued under the mutex, so skipping the lock when
+    // nobody sleeps cannot lose a wakeup (both sides are seq_cst)
+    if (m_sleepers.load() > 0) {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_sleepCv.notify_one();
+    }
+}
+
+size_t WorkStealingPool::CurrentWorker(const WorkStealingPool* pool) {
+    return t_pool == pool ? t_worker : NO_WORKER;
+}
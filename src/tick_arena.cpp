@@ -0,0 +1,28 @@
+#include "tick_arena.h"
+
+#include <algorithm>
+
+TickArena::TickArena(size_t capacityBytes)
+    : m_buffer(new unsigned char[capacityBytes])
+    , m_capacity(capacityBytes)
+    , m_used(0)
+    , m_highWater(0)
+    , m_overflows(0)
+{
+}
+
+void* TickArena::Allocate(size_t bytes, size_t alignment) {
+    // Align the address, not the offset; the buffer itself is only
+    // guaranteed max_align_t alignment
+    uintptr_t base = reinterpret_cast<uintptr_t>(m_buffer.get());
+    uintptr_t start = (base + m_used + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+    size_t end = static_cast<size_t>(start - base) + bytes;
+    if (end > m_capacity) {
+        m_overflows++;
+        return nullptr;
+    }
+
+    m_used = end;
+    m_highWater = std::max(m_highWater, m_used);
+    return reinterpret_cast<void*>(start);
+}
@@ -0,0 +1,124 @@
+#include "timer_wheel.h"
+#include <algorithm>
+
+TimerWheel::TimerWheel(uint64_t startTick)
+    : m_currentTick(startTick)
+    , m_size(0)
+{
+}
+
+unsigned TimerWheel::Shift(int level) {
+    return level == 0 ? 0 : TIMER_WHEEL_L0_BITS + (level - 1) * TIMER_WHEEL_LN_BITS;
+}
+
+unsigned TimerWheel::SlotCount(int level) {
+    return level == 0 ? (1u << TIMER_WHEEL_L0_BITS) : (1u << TIMER_WHEEL_LN_BITS);
+}
+
+void TimerWheel::Insert(const TimerEntry& entry) {
+    Place(entry);
+    m_size++;
+}
+
+void TimerWheel::Place(const TimerEntry& entry) {
+    if (entry.expiry <= m_currentTick) {
+        m_overdue.push_back(entry);
+        return;
+    }
+
+    uint64_t delta = entry.expiry - m_currentTick;
+    for (int level = 0; level < TIMER_WHEEL_LEVELS; ++level) {
+        unsigned bits = level == 0 ? TIMER_WHEEL_L0_BITS : TIMER_WHEEL_LN_BITS;
+        if (delta < (1ull << (Shift(level) + bits))) {
+            size_t slot = (entry.expiry >> Shift(level)) & (SlotCount(level) - 1);
+            m_levels[level][slot].push_back(entry);
+            return;
+        }
+    }
+
+    // Beyond the wheel's range: park in the furthest top-level slot; it is
+    // re-placed when that slot cascades
+    int top = TIMER_WHEEL_LEVELS - 1;
+    uint64_t parkedTick = m_currentTick + (1ull << (Shift(top) + TIMER_WHEEL_LN_BITS)) - 1;
+    size_t slot = (parkedTick >> Shift(top)) & (SlotCount(top) - 1);
+    m_levels[top][slot].push_back(entry);
+}
+
+void TimerWheel::Cascade(int level) {
+    size_t slot = (m_currentTick >> Shift(level)) & (SlotCount(level) - 1);
+    // Trade buffers with the scratch list rather than a fresh vector, so the
+    // slot keeps a reserved buffer
+    m_cascade.swap(m_levels[level][slot]);
+    for (const TimerEntry& entry : m_cascade) {
+        Place(entry);
+    }
+    m_cascade.clear();
+}
+
+void TimerWheel::Reserve(size_t entriesPerSlot) {
+    for (int level = 0; level < TIMER_WHEEL_LEVELS; ++level) {
+        for (unsigned slot = 0; slot < SlotCount(level); ++slot) {
+            m_levels[level][slot].reserve(entriesPerSlot);
+        }
+    }
+    m_overdue.reserve(entriesPerSlot);
+    m_cascade.reserve(entriesPerSlot);
+}
+
+void TimerWheel::Advance(uint64_t nowTick, std::vector<TimerEntry>& expired) {
+    if (m_size == 0) {
+        m_currentTick = std::max(m_currentTick, nowTick);
+        return;
+    }
+
+    while (m_currentTick < nowTick) {
+        m_currentTick++;
+
+        // Higher levels first so cascaded entries can cascade again this tick
+        for (int level = TIMER_WHEEL_LEVELS - 1; level > 0; --level) {
+            if ((m_currentTick & ((1ull << Shift(level)) - 1)) == 0) {
+                Cascade(level);
+            }
+        }
+
+        // Entries due on a slot boundary cascade down on their own tick and
+        // land in m_overdue; expire them now so the output stays in order
+        expired.insert(expired.end(), m_overdue.begin(), m_overdue.end());
+        m_size -= m_overdue.size();
+        m_overdue.clear();
+
+        std::vector<TimerEntry>& slot = m_levels[0][m_currentTick & (SlotCount(0) - 1)];
+        expired.insert(expired.end(), slot.begin(), slot.end());
+        m_size -= slot.size();
+        slot.clear();
+    }
+
+    expired.insert(expired.end(), m_overdue.begin(), m_overdue.end());
+    m_size -= m_overdue.size();
+    m_overdue.clear();
+}
+
+uint64_t TimerWheel::NextExpiry() const {
+    if (!m_overdue.empty()) return m_currentTick;
+
+    uint64_t next = UINT64_MAX;
+
+    // Level 0 slots hold exactly one tick each
+    for (uint64_t tick = m_currentTick + 1; tick < m_currentTick + SlotCount(0); ++tick) {
+        if (!m_levels[0][tick & (SlotCount(0) - 1)].empty()) {
+            next = tick;
+            break;
+        }
+    }
+
+    // Upper levels hold ranges; entries there can still be earlier than the
+    // first level 0 hit, so check their exact expiries
+    for (int level = 1; level < TIMER_WHEEL_LEVELS; ++level) {
+        for (unsigned slot = 0; slot < SlotCount(level); ++slot) {
+            for (const TimerEntry& entry : m_levels[level][slot]) {
+                next = std::min(next, entry.expiry);
+            }
+        }
+    }
+    return next;
+}
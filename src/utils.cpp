@@ -204,19 +204,22 @@ bool IsOpenGLAvailable() {
     return false;
 }
 
-std::vector<GraphicsAPI> GetAvailableGraphicsAPIs() {
-    std::vector<GraphicsAPI> apis;
-    
-    if (IsDirectX9Available()) {
-        apis.push_back(GraphicsAPI::D3D9);
-    }
-    if (IsDirectX11Available()) {
-        apis.push_back(GraphicsAPI::D3D11);
-    }
-    if (IsOpenGLAvailable()) {
-        apis.push_back(GraphicsAPI::OPENGL);
-    }
-    
+const std::vector<GraphicsAPI>& GetAvailableGraphicsAPIs() {
+    // Three probe loads; the answer doesn't change while we run, so only the
+    // first caller (usually the hook manager, off the startup path) pays
+    static const std::vector<GraphicsAPI> apis = []() {
+        std::vector<GraphicsAPI> found;
+        if (IsDirectX9Available()) {
+            found.push_back(GraphicsAPI::D3D9);
+        }
+        if (IsDirectX11Available()) {
+            found.push_back(GraphicsAPI::D3D11);
+        }
+        if (IsOpenGLAvailable()) {
+            found.push_back(GraphicsAPI::OPENGL);
+        }
+        return found;
+    }();
     return apis;
 }
 
@@ -248,16 +251,48 @@ DWORD GetWindowProcessId(HWND hwnd) {
 }
 
 bool IsFullscreenWindow(HWND hwnd) {
-    RECT windowRect, screenRect;
-    GetWindowRect(hwnd, &windowRect);
-    GetWindowRect(GetDesktopWindow(), &screenRect);
+    // Against the monitor the window is on, so borderless games on a
+    // secondary screen count too
+    RECT windowRect;
+    MONITORINFO monitor = {};
+    monitor.cbSize = sizeof(monitor);
+    if (!GetWindowRect(hwnd, &windowRect) ||
+        !GetMonitorInfoW(MonitorFromWindow(hwnd, MONITOR_DEFAULTTONEAREST), &monitor)) {
+        return false;
+    }
     
+    const RECT& screenRect = monitor.rcMonitor;
     return (windowRect.left <= screenRect.left &&
             windowRect.top <= screenRect.top &&
             windowRect.right >= screenRect.right &&
             windowRect.bottom >= screenRect.bottom);
 }
 
+bool IsShellWindow(HWND hwnd) {
+    if (hwnd == GetShellWindow() || hwnd == GetDesktopWindow()) return true;
+    
+    // Polled while idle: a stack buffer, no string
+    wchar_t className[32];
+    if (!GetClassNameW(hwnd, className, 32)) return false;
+    return wcscmp(className, L"Progman") == 0 || wcscmp(className, L"WorkerW") == 0 ||
+           wcscmp(className, L"Shell_TrayWnd") == 0 || wcscmp(className, L"Shell_SecondaryTrayWnd") == 0;
+}
+
+std::wstring GetWindowProcessName(HWND hwnd) {
+    HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, GetWindowProcessId(hwnd));
+    if (!process) return L"";
+    
+    wchar_t path[MAX_PATH];
+    DWORD length = MAX_PATH;
+    BOOL ok = QueryFullProcessImageNameW(process, 0, path, &length);
+    CloseHandle(process);
+    if (!ok) return L"";
+    
+    std::wstring name(path, length);
+    size_t slash = name.find_last_of(L"\\/");
+    return ToLower(slash == std::wstring::npos ? name : name.substr(slash + 1));
+}
+
 // Performance Timer implementation
 PerformanceTimer::PerformanceTimer() : m_running(false) {}
 
@@ -309,19 +344,39 @@ std::wstring GetLastErrorString() {
     return message;
 }
 
+// Converts straight into a per-thread buffer so logging from a running
+// thread never touches the heap; overlong messages are truncated
+static void LogWithPrefix(const char* prefix, const std::wstring& message) {
+    thread_local char buffer[2048];
+    const int capacity = static_cast<int>(sizeof(buffer));
+
+    int length = 0;
+    while (prefix[length]) {
+        buffer[length] = prefix[length];
+        length++;
+    }
+
+    // A UTF-16 unit is at most 3 UTF-8 bytes, so this many always fit
+    int units = std::min(static_cast<int>(message.size()), (capacity - 1 - length) / 3);
+    if (units > 0) {
+        length += WideCharToMultiByte(CP_UTF8, 0, message.data(), units,
+                                      buffer + length, capacity - 1 - length, nullptr, nullptr);
+    }
+
+    buffer[length] = '\0';
+    OutputDebugStringA(buffer);
+}
+
 void LogError(const std::wstring& message) {
-    std::string utf8Msg = WideToUtf8(L"[ERROR] " + message);
-    OutputDebugStringA(utf8Msg.c_str());
+    LogWithPrefix("[ERROR] ", message);
 }
 
 void LogInfo(const std::wstring& message) {
-    std::string utf8Msg = WideToUtf8(L"[INFO] " + message);
-    OutputDebugStringA(utf8Msg.c_str());
+    LogWithPrefix("[INFO] ", message);
 }
 
 void LogWarning(const std::wstring& message) {
-    std::string utf8Msg = WideToUtf8(L"[WARNING] " + message);
-    OutputDebugStringA(utf8Msg.c_str());
+    LogWithPrefix("[WARNING] ", message);
 }
 
 // Application utilities
@@ -352,23 +407,16 @@ void ReleaseMutex() {
 
 // Font utilities
 bool IsFontInstalled(const std::wstring& fontName) {
-    HDC hdc = GetDC(nullptr);
-    if (!hdc) return false;
-    
-    LOGFONTW logFont;
-    ZeroMemory(&logFont, sizeof(LOGFONTW));
-    wcscpy_s(logFont.lfFaceName, fontName.c_str());
-    logFont.lfCharSet = DEFAULT_CHARSET;
-    
-    bool found = false;
-    EnumFontFamiliesExW(hdc, &logFont, [](const LOGFONTW*, const TEXTMETRICW*, DWORD, LPARAM lParam) -> int {
-        bool* pFound = reinterpret_cast<bool*>(lParam);
-        *pFound = true;
-        return 0; // Stop enumeration
-    }, reinterpret_cast<LPARAM>(&found), 0);
-    
-    ReleaseDC(nullptr, hdc);
-    return found;
+    // One enumeration of every family on first use instead of one per query
+    static const std::vector<std::wstring> catalog = []() {
+        std::vector<std::wstring> fonts = GetAvailableSystemFonts();
+        for (std::wstring& font : fonts) {
+            font = ToLower(font);
+        }
+        std::sort(fonts.begin(), fonts.end());
+        return fonts;
+    }();
+    return std::binary_search(catalog.begin(), catalog.end(), ToLower(fontName));
 }
 
 std::vector<std::wstring> GetAvailableSystemFonts() {
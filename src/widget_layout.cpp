@@ -0,0 +1,267 @@
+#include "widget_layout.h"
+#include "text_format.h"
+
+#include <algorithm>
+#include <cwctype>
+
+namespace {
+    struct WidgetName {
+        const wchar_t* name;
+        OverlayWidget widget;
+    };
+
+    const WidgetName WIDGET_NAMES[] = {
+        {L"fps", OverlayWidget::FPS},
+        {L"frametime", OverlayWidget::FRAME_TIME},
+        {L"low1", OverlayWidget::LOW_1},
+        {L"low01", OverlayWidget::LOW_01},
+        {L"hitches", OverlayWidget::HITCHES},
+        {L"range", OverlayWidget::FRAME_RANGE},
+        {L"graph", OverlayWidget::GRAPH},
+        {L"heatmap", OverlayWidget::HEATMAP},
+    };
+
+    // The widest text of each text widget, '#' standing for a digit; values
+    // are clamped to fit (see ShownValue)
+    const wchar_t* WidestText(OverlayWidget widget) {
+        switch (widget) {
+            case OverlayWidget::FPS: return L"FPS: ####.#";
+            case OverlayWidget::FRAME_TIME: return L"###.## ms";
+            case OverlayWidget::LOW_1: return L"1%: ####";
+            case OverlayWidget::LOW_01: return L"0.1%: ####";
+            case OverlayWidget::HITCHES: return L"Hitches: ######";
+            case OverlayWidget::FRAME_RANGE: return L"###.#-###.# ms";
+            default: return L"";
+        }
+    }
+
+    bool IsSeparator(wchar_t ch) {
+        return ch == L' ' || ch == L'\t' || ch == L',' || ch == L'|';
+    }
+
+    uint64_t Mix(uint64_t hash, uint64_t value) {
+        return (hash ^ value) * 1099511628211ull;
+    }
+
+    // Rounded the way the text shows it, and clamped to what its cell has
+    // room for
+    int64_t Rounded(float value, double scale, int64_t max) {
+        if (!(value > 0.0f)) return 0;
+        double scaled = static_cast<double>(value) * scale + 0.5;
+        return scaled >= static_cast<double>(max) ? max : static_cast<int64_t>(scaled);
+    }
+}
+
+bool WidgetList::Contains(OverlayWidget widget) const {
+    for (int i = 0; i < count; ++i) {
+        if (widgets[i] == widget) return true;
+    }
+    return false;
+}
+
+void WidgetList::AppendRow(OverlayWidget widget) {
+    if (count >= WIDGET_LAYOUT_MAX_WIDGETS) return;
+    rowStarts |= 1u << count;
+    widgets[count++] = widget;
+}
+
+bool WidgetList::Parse(const std::wstring& text, WidgetList& list) {
+    WidgetList parsed;
+    parsed.count = 0;
+    parsed.rowStarts = 0;
+    bool rowStart = true;
+    size_t i = 0;
+    while (i < text.size()) {
+        if (text[i] == L'|') rowStart = true;
+        if (IsSeparator(text[i])) {
+            ++i;
+            continue;
+        }
+
+        size_t end = i;
+        while (end < text.size() && !IsSeparator(text[end])) ++end;
+        std::wstring name = text.substr(i, end - i);
+        std::transform(name.begin(), name.end(), name.begin(),
+                       [](wchar_t ch) { return static_cast<wchar_t>(std::towlower(ch)); });
+        const WidgetName* found = nullptr;
+        for (const WidgetName& known : WIDGET_NAMES) {
+            if (name == known.name) found = &known;
+        }
+        if (!found || parsed.count == WIDGET_LAYOUT_MAX_WIDGETS) return false;
+
+        if (rowStart) parsed.rowStarts |= 1u << parsed.count;
+        rowStart = false;
+        parsed.widgets[parsed.count++] = found->widget;
+        i = end;
+    }
+    if (parsed.count == 0) return false;
+
+    list = parsed;
+    return true;
+}
+
+std::wstring WidgetList::ToString() const {
+    std::wstring text;
+    for (int i = 0; i < count; ++i) {
+        if (i > 0) text += (rowStarts >> i) & 1u ? L" | " : L" ";
+        for (const WidgetName& known : WIDGET_NAMES) {
+            if (known.widget == widgets[i]) text += known.name;
+        }
+    }
+    return text;
+}
+
+WidgetLayout::WidgetLayout()
+    : m_count(0)
+    , m_width(0)
+    , m_height(0)
+    , m_key(0)
+{
+}
+
+bool WidgetLayout::Configure(const WidgetList& widgets, const WidgetMetrics& metrics, const TextMeasure& measure) {
+    if (m_key != 0 && widgets == m_widgets && metrics == m_metrics) return false;
+    m_widgets = widgets;
+    m_metrics = metrics;
+    m_count = std::min(std::max(widgets.count, 0), WIDGET_LAYOUT_MAX_WIDGETS);
+
+    // Cells are sized with every digit as wide as the widest one, so any
+    // value fits without the layout changing
+    wchar_t widestDigit = L'0';
+    int widestDigitWidth = -1;
+    for (wchar_t digit = L'0'; digit <= L'9'; ++digit) {
+        int width = measure(&digit, 1);
+        if (width > widestDigitWidth) {
+            widestDigit = digit;
+            widestDigitWidth = width;
+        }
+    }
+    int gap = measure(L"  ", 2);
+
+    // Rows top to bottom, widgets left to right within them, top-aligned
+    int left = OVERLAY_PADDING_X / 2;
+    int y = OVERLAY_PADDING_Y / 2;
+    int contentWidth = 0;
+    bool previousImage = false;
+    for (int start = 0; start < m_count;) {
+        int end = start + 1;
+        while (end < m_count && !((widgets.rowStarts >> end) & 1u)) ++end;
+
+        bool image = false;
+        for (int i = start; i < end; ++i) {
+            image |= widgets.widgets[i] == OverlayWidget::GRAPH || widgets.widgets[i] == OverlayWidget::HEATMAP;
+        }
+        if (start > 0 && (image || previousImage)) y += OVERLAY_WIDGET_SPACING;
+
+        int x = left;
+        int rowHeight = 0;
+        for (int i = start; i < end; ++i) {
+            WidgetCell& cell = m_cells[i];
+            cell = WidgetCell();
+            cell.widget = widgets.widgets[i];
+            cell.bounds.x = x;
+            cell.bounds.y = y;
+            if (cell.widget == OverlayWidget::GRAPH) {
+                cell.bounds.width = std::max(metrics.graphWidth, 0);
+                cell.bounds.height = std::max(metrics.graphHeight, 0);
+            } else if (cell.widget == OverlayWidget::HEATMAP) {
+                cell.bounds.width = std::max(metrics.heatmapWidth, 0);
+                cell.bounds.height = std::max(metrics.heatmapHeight, 0);
+            } else {
+                wchar_t widest[WIDGET_TEXT_CAPACITY] = {};
+                int length = 0;
+                for (const wchar_t* ch = WidestText(cell.widget); *ch && length < WIDGET_TEXT_CAPACITY - 1; ++ch) {
+                    widest[length++] = *ch == L'#' ? widestDigit : *ch;
+                }
+                cell.bounds.width = measure(widest, length);
+                cell.bounds.height = metrics.lineHeight;
+            }
+            x += cell.bounds.width + gap;
+            rowHeight = std::max(rowHeight, cell.bounds.height);
+        }
+        contentWidth = std::max(contentWidth, x - gap - left);
+        y += rowHeight;
+        previousImage = image;
+        start = end;
+    }
+    m_width = contentWidth + OVERLAY_PADDING_X;
+    m_height = y + OVERLAY_PADDING_Y - OVERLAY_PADDING_Y / 2;
+
+    // The same widgets and metrics get the same key back, so caches keyed
+    // on it (the window position) survive switching back and forth
+    uint64_t key = 14695981039346656037ull;
+    for (int i = 0; i < m_count; ++i) {
+        key = Mix(key, static_cast<uint64_t>(widgets.widgets[i]));
+    }
+    key = Mix(key, widgets.rowStarts);
+    key = Mix(key, metrics.font);
+    key = Mix(key, static_cast<uint32_t>(metrics.lineHeight));
+    key = Mix(key, static_cast<uint32_t>(metrics.graphWidth));
+    key = Mix(key, static_cast<uint32_t>(metrics.graphHeight));
+    key = Mix(key, static_cast<uint32_t>(metrics.heatmapWidth));
+    key = Mix(key, static_cast<uint32_t>(metrics.heatmapHeight));
+    m_key = key != 0 ? key : 1;
+    m_stats.layouts++;
+    return true;
+}
+
+int WidgetLayout::Update(const FrameStats& stats) {
+    int formatted = 0;
+    for (int i = 0; i < m_count; ++i) {
+        WidgetCell& cell = m_cells[i];
+        if (!cell.IsText()) continue;
+        int64_t shown = ShownValue(cell.widget, stats);
+        if (shown == cell.shown) continue;
+
+        cell.length = Format(cell.widget, shown, cell.text);
+        cell.shown = shown;
+        cell.version++;
+        ++formatted;
+    }
+    m_stats.updates++;
+    m_stats.formats += static_cast<uint64_t>(formatted);
+    return formatted;
+}
+
+// Private methods implementation
+int64_t WidgetLayout::ShownValue(OverlayWidget widget, const FrameStats& stats) {
+    switch (widget) {
+        case OverlayWidget::FPS: return Rounded(stats.fps, 10.0, 99999);
+        case OverlayWidget::FRAME_TIME: return Rounded(stats.frameTimeMs, 100.0, 99999);
+        case OverlayWidget::LOW_1: return Rounded(stats.low1Fps, 1.0, 9999);
+        case OverlayWidget::LOW_01: return Rounded(stats.low01Fps, 1.0, 9999);
+        case OverlayWidget::HITCHES: return static_cast<int64_t>(std::min<uint64_t>(stats.hitchCount, 999999));
+        case OverlayWidget::FRAME_RANGE:
+            return Rounded(stats.minFrameTimeMs, 10.0, 9999) * 10000 + Rounded(stats.maxFrameTimeMs, 10.0, 9999);
+        default: return 0;
+    }
+}
+
+int WidgetLayout::Format(OverlayWidget widget, int64_t shown, wchar_t* text) {
+    const size_t capacity = WIDGET_TEXT_CAPACITY;
+    int length = 0;
+    switch (widget) {
+        case OverlayWidget::FPS:
+            length = TextFormat::Format<"FPS: {:.1f}">(text, capacity, static_cast<double>(shown) / 10.0);
+            break;
+        case OverlayWidget::FRAME_TIME:
+            length = TextFormat::Format<"{:.2f} ms">(text, capacity, static_cast<double>(shown) / 100.0);
+            break;
+        case OverlayWidget::LOW_1:
+            length = TextFormat::Format<"1%: {:d}">(text, capacity, shown);
+            break;
+        case OverlayWidget::LOW_01:
+            length = TextFormat::Format<"0.1%: {:d}">(text, capacity, shown);
+            break;
+        case OverlayWidget::HITCHES:
+            length = TextFormat::Format<"Hitches: {:d}">(text, capacity, shown);
+            break;
+        case OverlayWidget::FRAME_RANGE:
+            length = TextFormat::Format<"{:.1f}-{:.1f} ms">(text, capacity, static_cast<double>(shown / 10000) / 10.0,
+                                                            static_cast<double>(shown % 10000) / 10.0);
+            break;
+        default:
+            break;
+    }
+    return length < 0 ? 0 : length;  // Negative when it doesn't fit
+}